@@ -2,11 +2,16 @@
 
 #include <bitbishop/bitboard.hpp>
 #include <bitbishop/color.hpp>
+#include <bitbishop/fen.hpp>
+#include <bitbishop/material.hpp>
 #include <bitbishop/move.hpp>
 #include <bitbishop/piece.hpp>
+#include <bitbishop/psqt.hpp>
 #include <bitbishop/square.hpp>
 #include <bitbishop/zobrist.hpp>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <vector>
 
 struct BoardState {
@@ -69,6 +74,20 @@ class Board {
   // Game state
   BoardState m_state;
   Zobrist::Key m_zobrist_hash = Zobrist::NULL_HASH;
+  Zobrist::Key m_pawn_hash = Zobrist::NULL_HASH;  ///< Zobrist hash of the pawns only
+
+  // Packed midgame/endgame material + piece-square score (white minus black) and game phase, updated with the pieces
+  Eval::Score m_psqt_score = 0;
+  int m_phase = 0;
+  Material::Key m_material_key = 0;  ///< Piece counts, see Material::Key
+
+  /**
+   * @brief Removes all pieces and sets the game state, leaving hashes and scores consistent with the empty board.
+   */
+  void reset(BoardState state) noexcept;
+
+  friend Fen::Error Fen::parse(std::string_view fen, Board& board) noexcept;
+  friend Fen::Error Fen::parse_epd(std::string_view epd, Board& board, std::string_view& operations) noexcept;
 
  public:
   /**
@@ -86,6 +105,7 @@ class Board {
   /**
    * @brief Constructs a board from a FEN string.
    * @param fen Forsyth–Edwards Notation describing a chess position.
+   * @throw std::invalid_argument If the FEN is invalid, see Fen::parse for a non-throwing alternative
    *
    * @see https://www.chess.com/terms/fen-chess
    */
@@ -232,6 +252,26 @@ class Board {
    */
   [[nodiscard]] Bitboard queens(Color side) const { return (side == Color::WHITE) ? m_w_queens : m_b_queens; }
 
+  /**
+   * @brief Returns a bitboard representing all pieces of the given type and color.
+   *
+   * @param piece Piece type and color to select.
+   * @return Bitboard containing all squares occupied by that piece.
+   */
+  [[nodiscard]] Bitboard pieces(Piece piece) const {
+    const Color side = piece.color();
+    switch (piece.type()) {
+      // clang-format off
+      case Piece::PAWN:   return pawns(side);
+      case Piece::KNIGHT: return knights(side);
+      case Piece::BISHOP: return bishops(side);
+      case Piece::ROOK:   return rooks(side);
+      case Piece::QUEEN:  return queens(side);
+      default:            return king(side);
+      // clang-format on
+    }
+  }
+
   /**
    * @brief Returns a bitboard of all enemy pieces relative to the given side to move.
    *
@@ -338,9 +378,42 @@ class Board {
 
   [[nodiscard]] Zobrist::Key get_zobrist_hash() const noexcept { return m_zobrist_hash; }
 
+  /**
+   * @brief Retrieves the Zobrist hash of the pawn structure, updated incrementally like the position hash.
+   *
+   * @see Zobrist::compute_pawn_hash
+   */
+  [[nodiscard]] Zobrist::Key get_pawn_hash() const noexcept { return m_pawn_hash; }
+
+  /**
+   * @brief Retrieves the packed midgame/endgame material + piece-square score of the board.
+   *
+   * The score is updated incrementally each time a piece is set or removed (see Eval::PIECE_SQUARE_SCORES),
+   * so reading it is O(1).
+   *
+   * @return Packed score with positive values in favour of white and negative values in favour of black.
+   */
+  [[nodiscard]] Eval::Score get_psqt_score() const noexcept { return m_psqt_score; }
+
+  /**
+   * @brief Retrieves the game phase, the sum of Eval::PHASE_WEIGHTS of all pieces on board.
+   *
+   * Updated incrementally like the piece-square score. May exceed Eval::MAX_PHASE after promotions.
+   */
+  [[nodiscard]] int get_phase() const noexcept { return m_phase; }
+
+  /**
+   * @brief Retrieves the material signature of the board: the count of each piece (see Material::Key).
+   *
+   * Updated incrementally like the piece-square score, reading it is O(1).
+   */
+  [[nodiscard]] Material::Key get_material_key() const noexcept { return m_material_key; }
+
   /**
    * @brief Retrieves Board's FEN.
    * @return FEN built from to the internal board representation.
+   *
+   * @see Fen::format_to to write it without allocating
    */
   [[nodiscard]] std::string get_fen() const noexcept;
 
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <bitbishop/board.hpp>
+#include <bitbishop/config.hpp>
+#include <bitbishop/engine/nnue.hpp>
+#include <bitbishop/move.hpp>
+#include <bitbishop/zobrist.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @namespace Book
+ * @brief Polyglot opening books: `.bin` files of moves played from known positions, with their weights.
+ *
+ * A book is a sorted array of 16-byte big-endian entries (see Entry), keyed by the Polyglot key of the position
+ * (Zobrist::compute_polyglot_key). Positions with several moves have consecutive entries.
+ *
+ * @see http://hgm.nubati.net/book_format.html
+ */
+namespace Book {
+
+CX_INLINE std::size_t ENTRY_SIZE = 16;
+
+/**
+ * @brief One book move of a position.
+ *
+ * Moves are encoded as: destination square in bits 0-5, origin square in bits 6-11, promotion type in bits 12-14
+ * (1 knight to 4 queen). Castling moves are encoded as the king capturing its own rook (e1h1 for e1g1).
+ */
+struct Entry {
+  Zobrist::Key key = 0;
+  std::uint16_t move = 0;
+  std::uint16_t weight = 0;  ///< Relative probability of the move among those of the position
+  std::uint32_t learn = 0;   ///< Unused by the engine, kept when rewriting books
+};
+
+/**
+ * @brief Polyglot encoding of a move.
+ */
+[[nodiscard]] std::uint16_t encode_move(const Move& move) noexcept;
+
+/**
+ * @brief Legal move of a board matching a Polyglot move.
+ * @return std::nullopt if no legal move matches, e.g. on a key collision
+ */
+[[nodiscard]] std::optional<Move> decode_move(const Board& board, std::uint16_t move);
+
+/**
+ * @brief Reads the big-endian entry starting at `data`.
+ */
+[[nodiscard]] Entry read_entry(const std::byte* data) noexcept;
+
+/**
+ * @brief Writes an entry in big-endian order.
+ */
+void write_entry(std::ostream& out, const Entry& entry);
+
+/**
+ * @brief Read-only Polyglot book, memory-mapped.
+ */
+class PolyglotBook {
+ private:
+  std::unique_ptr<Nnue::MappedFile> m_file;
+  std::string m_path;
+
+ public:
+  /**
+   * @brief Maps a book file, replacing the book opened before.
+   * @return false, leaving the book closed, if the file cannot be mapped or is not a whole number of entries
+   */
+  [[nodiscard]] bool open(const std::string& path);
+
+  void close() noexcept;
+
+  [[nodiscard]] bool is_open() const noexcept { return m_file != nullptr; }
+  [[nodiscard]] const std::string& path() const noexcept { return m_path; }
+
+  /** @brief Number of entries of the book, 0 when closed. */
+  [[nodiscard]] std::size_t size() const noexcept;
+
+  [[nodiscard]] Entry entry(std::size_t index) const noexcept;
+
+  /**
+   * @brief Entries of a key, found by binary search, in book order.
+   */
+  [[nodiscard]] std::vector<Entry> find(Zobrist::Key key) const;
+
+  /**
+   * @brief Picks a book move of a board with a probability proportional to its weight.
+   *
+   * Entries whose move is not legal on the board, or whose weight is 0, are never picked.
+   *
+   * @param random Random value choosing the move, any 64-bit value
+   * @return std::nullopt if the board is out of book
+   */
+  [[nodiscard]] std::optional<Move> pick(const Board& board, std::uint64_t random) const;
+};
+
+}  // namespace Book
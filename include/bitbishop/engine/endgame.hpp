@@ -0,0 +1,88 @@
+#pragma once
+
+#include <bitbishop/board.hpp>
+#include <bitbishop/color.hpp>
+#include <bitbishop/config.hpp>
+#include <bitbishop/material.hpp>
+
+namespace Eval {
+
+/**
+ * @brief Score of a known won endgame, added to the winning side's material.
+ *
+ * Above any score the generic evaluation gives, below Eval::MATE_THRESHOLD.
+ */
+CX_INLINE int KNOWN_WIN = 10'000;
+
+/** Scale factor leaving the generic evaluation unchanged. */
+CX_INLINE int SCALE_FACTOR_NORMAL = 64;
+
+/** Scale factor of a dead drawn endgame. */
+CX_INLINE int SCALE_FACTOR_DRAW = 0;
+
+/**
+ * @brief Specialised evaluation of an endgame.
+ *
+ * @param board Board with exactly the material of the endgame
+ * @param strong Side with the extra material
+ * @return Score in centipawns, positive in favour of the strong side
+ */
+using EndgameValueFunction = int (*)(const Board& board, Color strong) noexcept;
+
+/**
+ * @brief Scaling function of an endgame, for material the generic evaluation overrates.
+ *
+ * @param board Board with exactly the material of the endgame
+ * @param strong Side with the extra material
+ * @return Factor in [SCALE_FACTOR_DRAW, SCALE_FACTOR_NORMAL] applied to the generic evaluation
+ */
+using EndgameScaleFunction = int (*)(const Board& board, Color strong) noexcept;
+
+/**
+ * @brief Specialised knowledge of one material signature, with exactly one of `value` and `scale` set.
+ */
+struct Endgame {
+  Material::Key key = 0;
+  Color strong = Color::WHITE;
+  EndgameValueFunction value = nullptr;
+  EndgameScaleFunction scale = nullptr;
+  bool exact = false;  ///< The value is the game theoretical result: the search needs not look further
+};
+
+/**
+ * @brief Looks up the specialised evaluation of a material signature.
+ *
+ * Recognised endgames, registered for both colors:
+ * - KQK, KRK: drive the lone king to the edge, kings close together.
+ * - KBNK: drive the lone king to a corner of the bishop's color.
+ * - KQKR: the queen wins, same driving terms.
+ * - KPK (exact): looked up in the retrograde bitbase, see Lookups::kpk_is_win().
+ * - KNNK: draw, the lone king cannot be forced into mate.
+ * - KBPK (scaling): a rook pawn with a bishop not covering the promotion square is a draw when the defending king
+ *   reaches the corner.
+ *
+ * The table is indexed by a hash of the material key, so the lookup is a single probe.
+ *
+ * @return Entry of the material key, or nullptr when the endgame has no specialised evaluation
+ */
+[[nodiscard]] const Endgame* find_endgame(Material::Key key) noexcept;
+
+/** @brief King and major piece(s) against a lone king. */
+[[nodiscard]] int evaluate_kxk(const Board& board, Color strong) noexcept;
+
+/** @brief King, bishop and knight against a lone king. */
+[[nodiscard]] int evaluate_kbnk(const Board& board, Color strong) noexcept;
+
+/** @brief King and queen against king and rook. */
+[[nodiscard]] int evaluate_kqkr(const Board& board, Color strong) noexcept;
+
+/** @brief King and pawn against king. */
+[[nodiscard]] int evaluate_kpk(const Board& board, Color strong) noexcept;
+
+/** @brief King and two knights against king. */
+[[nodiscard]] int evaluate_knnk(const Board& board, Color strong) noexcept;
+
+/** @brief King, bishop and pawn against king: detects the wrong rook pawn. */
+[[nodiscard]] int scale_kbpk(const Board& board, Color strong) noexcept;
+
+}  // namespace Eval
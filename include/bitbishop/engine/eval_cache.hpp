@@ -0,0 +1,80 @@
+#pragma once
+
+#include <bitbishop/board.hpp>
+#include <bitbishop/config.hpp>
+#include <bitbishop/moves/position.hpp>
+#include <bitbishop/zobrist.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Eval {
+
+/**
+ * @brief Direct-mapped cache of static evaluations, indexed by position Zobrist hash.
+ *
+ * Quiescence search evaluates the same positions again and again (transpositions, iterative deepening).
+ * Each entry stores the full 64-bit key next to the score, so a hit is only returned for the same position.
+ * Entries also carry the cache generation they were written in: clearing the cache bumps the generation, which
+ * invalidates every entry at once without touching the table.
+ *
+ * A cache is not thread-safe: each search thread uses its own (see thread_eval_cache()).
+ */
+class EvalCache {
+ public:
+  /**
+   * Default number of entries (power of two): 16384 entries of 16 bytes each, 256 KiB, small enough to stay in L2.
+   */
+  static CX_VALUE std::size_t DEFAULT_SIZE = 16384;
+
+ private:
+  struct Entry {
+    Zobrist::Key key = Zobrist::NULL_HASH;
+    std::int32_t score = 0;
+    std::uint32_t generation = 0;  ///< Generation the entry was written in, 0 for never written
+  };
+
+  std::vector<Entry> entries;
+  std::size_t mask;
+  std::uint32_t generation = 1;
+  std::uint64_t probes_count = 0;
+  std::uint64_t hits_count = 0;
+
+ public:
+  /**
+   * @param size Number of entries, must be a power of two
+   */
+  explicit EvalCache(std::size_t size = DEFAULT_SIZE);
+
+  /**
+   * @brief Returns the static evaluation of the board (see Eval::evaluate), computing and storing it on a miss.
+   */
+  [[nodiscard]] int probe(const Board& board) noexcept;
+
+  /**
+   * @brief Returns the static evaluation of a search position (see Eval::evaluate(const Position&)), computing and
+   * storing it on a miss.
+   */
+  [[nodiscard]] int probe(const Position& position) noexcept;
+
+  /**
+   * @brief Empties the cache and resets its statistics.
+   *
+   * Must be called whenever Eval::evaluate changes (e.g. a network is loaded), since cached scores would be stale.
+   */
+  void clear() noexcept;
+
+  /** @brief Number of probes since construction or last clear. */
+  [[nodiscard]] std::uint64_t probes() const noexcept { return probes_count; }
+
+  /** @brief Number of probes answered from the cache since construction or last clear. */
+  [[nodiscard]] std::uint64_t hits() const noexcept { return hits_count; }
+};
+
+/**
+ * @brief Returns the evaluation cache of the calling thread (see thread_tables()).
+ *
+ * Each search thread gets its own cache, so probes need no synchronisation.
+ */
+[[nodiscard]] EvalCache& thread_eval_cache() noexcept;
+
+}  // namespace Eval
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <bitbishop/engine/eval_cache.hpp>
+#include <bitbishop/engine/nnue.hpp>
+#include <bitbishop/engine/pawn_structure.hpp>
+
+namespace Eval {
+
+/**
+ * @brief Evaluation tables used by one search thread.
+ *
+ * A search owner (see Uci::SearchSession) keeps one instance alive across searches and binds it to each new search
+ * thread with ThreadTablesScope, so the tables stay warm from one `go` to the next even though every search runs on
+ * a fresh std::thread. Threads with no bound tables use a thread-local default instance.
+ */
+struct ThreadTables {
+  PawnHashTable pawn_table;  ///< Pawn structure evaluations, see thread_pawn_hash_table()
+  EvalCache eval_cache;      ///< Static evaluations, see thread_eval_cache()
+  Nnue::AccumulatorStack nnue_accumulators;  ///< Network accumulators along the search path
+  Nnue::RefreshCache nnue_refresh_cache;     ///< Network accumulators per king bucket
+
+  /**
+   * @brief Empties the pawn table and evaluation cache and resets their statistics.
+   *
+   * Network accumulators need no clearing: they are tagged with the network generation they were computed with.
+   */
+  void clear() noexcept;
+};
+
+/**
+ * @brief Binds tables to the calling thread for the lifetime of the scope.
+ *
+ * The previous binding is restored on destruction. Tables must not be bound to two threads at once.
+ */
+class ThreadTablesScope {
+  ThreadTables* previous;
+
+ public:
+  explicit ThreadTablesScope(ThreadTables& tables) noexcept;
+  ~ThreadTablesScope();
+
+  ThreadTablesScope(const ThreadTablesScope&) = delete;
+  ThreadTablesScope& operator=(const ThreadTablesScope&) = delete;
+};
+
+/**
+ * @brief Returns the tables bound to the calling thread, or its thread-local default tables.
+ */
+[[nodiscard]] ThreadTables& thread_tables() noexcept;
+
+}  // namespace Eval
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <bitbishop/board.hpp>
+#include <bitbishop/config.hpp>
+#include <bitbishop/constants.hpp>
+#include <bitbishop/piece.hpp>
+#include <bitbishop/psqt.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Eval {
+
+/**
+ * @brief Material terms, one per piece type from PAWN to QUEEN (kings carry no material).
+ */
+CX_INLINE std::size_t MATERIAL_TERMS = 0;
+
+/**
+ * @brief Piece-square terms, indexed by `PSQT_TERMS + type * BOARD_SIZE + index`.
+ *
+ * `index` follows the PieceSquareTable layout of white (a8 first), black pieces use the mirrored square.
+ */
+CX_INLINE std::size_t PSQT_TERMS = MATERIAL_TERMS + Piece::KING;
+
+CX_INLINE std::size_t DOUBLED_PAWN_TERM = PSQT_TERMS + (Piece::TYPE_COUNT * Const::BOARD_SIZE);
+CX_INLINE std::size_t ISOLATED_PAWN_TERM = DOUBLED_PAWN_TERM + 1;
+CX_INLINE std::size_t BACKWARD_PAWN_TERM = ISOLATED_PAWN_TERM + 1;
+
+/**
+ * @brief Passed pawn terms, indexed by relative rank (see PASSED_PAWN_BONUS).
+ */
+CX_INLINE std::size_t PASSED_PAWN_TERMS = BACKWARD_PAWN_TERM + 1;
+
+/**
+ * @brief Number of terms of the hand-crafted evaluation.
+ */
+CX_INLINE std::size_t TERM_COUNT = PASSED_PAWN_TERMS + Const::BOARD_WIDTH;
+
+/**
+ * @brief Packed midgame and endgame weight of every evaluation term.
+ */
+using TermWeights = std::array<Score, TERM_COUNT>;
+
+/**
+ * @brief Count of one evaluation term in a position, white minus black.
+ */
+struct TermCoefficient {
+  std::uint16_t term;
+  std::int8_t coefficient;
+};
+
+/**
+ * @brief Weights of the current material, piece-square and pawn structure tables.
+ */
+[[nodiscard]] TermWeights current_term_weights() noexcept;
+
+/**
+ * @brief Appends the non-zero term coefficients of a board.
+ *
+ * The hand-crafted evaluation is linear in its weights: before tapering, the packed score of a board is the sum of
+ * `coefficient * weight` over these terms (see score_terms()). Evaluation tuners use this sparse form to compute
+ * gradients without evaluating boards again.
+ *
+ * @param board Board to decompose
+ * @param coefficients Output, terms are appended in increasing order
+ */
+void extract_terms(const Board& board, std::vector<TermCoefficient>& coefficients);
+
+/**
+ * @brief Packed score of a decomposed board, same as its material, piece-square and pawn structure scores.
+ */
+[[nodiscard]] Score score_terms(const TermWeights& weights, std::span<const TermCoefficient> coefficients) noexcept;
+
+}  // namespace Eval
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <array>
+#include <bitbishop/bitboard.hpp>
+#include <bitbishop/board.hpp>
+#include <bitbishop/color.hpp>
+#include <bitbishop/config.hpp>
+#include <bitbishop/constants.hpp>
+#include <bitbishop/moves/position.hpp>
+#include <bitbishop/piece.hpp>
+#include <bitbishop/simd.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @namespace Nnue
+ * @brief Efficiently updatable neural network evaluation.
+ *
+ * Architecture: HalfKA-style feature transformer with king buckets, followed by a single clipped-ReLU output layer.
+ *
+ * - Each side (perspective) owns an accumulator of L1_SIZE int16 values: the transformer biases plus one weight
+ *   column per active feature.
+ * - A feature is a (king bucket, piece relative to the perspective, square) triple, with the board flipped
+ *   vertically for black so both perspectives share the same weights.
+ * - The output is computed for the side to move: its accumulator is dot-multiplied with the first half of the output
+ *   weights and the opponent's with the second half, after clamping both to [0, ACTIVATION_MAX].
+ *
+ * The loaded network is published through an atomic pointer and may only change while no search runs
+ * (see SearchGuard).
+ *
+ * @see https://www.chessprogramming.org/NNUE
+ */
+namespace Nnue {
+
+/** Number of king buckets, each bucket covers a 2x2 block of squares. */
+CX_INLINE std::size_t KING_BUCKETS = 16;
+
+/** Number of input features per perspective. */
+CX_INLINE std::size_t FEATURES = KING_BUCKETS * Piece::DISTINCT_PIECES_COUNT * Const::BOARD_SIZE;
+
+/** Size of an accumulator (first hidden layer). */
+CX_INLINE std::size_t L1_SIZE = 128;
+
+/** Upper bound of the clipped ReLU activation. */
+CX_INLINE int ACTIVATION_MAX = 127;
+
+/** Divisor converting the network output into centipawns. */
+CX_INLINE int OUTPUT_DIVISOR = 16;
+
+/** Magic bytes at the beginning of a network file. */
+CX_INLINE std::array<char, 4> FILE_MAGIC = {'B', 'B', 'N', 'N'};
+
+/** Version of the network file format. */
+CX_INLINE std::uint32_t FILE_VERSION = 1;
+
+/**
+ * @brief Size in bytes of a network file.
+ *
+ * Layout, all values little-endian:
+ *  - header: magic (4 bytes), version, FEATURES, L1_SIZE (uint32 each)
+ *  - feature biases: L1_SIZE int16
+ *  - feature weights: FEATURES x L1_SIZE int16, one contiguous column per feature
+ *  - output weights: 2 x L1_SIZE int8 (side to move first)
+ *  - output bias: int32
+ */
+CX_INLINE std::size_t FILE_SIZE = 16 + (2 * L1_SIZE) + (2 * FEATURES * L1_SIZE) + (2 * L1_SIZE) + 4;
+
+/**
+ * @brief King bucket of a square, seen from a perspective.
+ */
+CX_FN std::size_t king_bucket(Square king_square, Color perspective) {
+  const int rank = perspective == Color::WHITE ? king_square.rank() : (Const::BOARD_WIDTH - 1 - king_square.rank());
+  return static_cast<std::size_t>(((rank / 2) * 4) + (king_square.file() / 2));
+}
+
+/**
+ * @brief Index of the feature "piece on square" for a perspective whose king stands in `bucket`.
+ */
+CX_FN std::size_t feature_index(std::size_t bucket, Piece piece, Square square, Color perspective) {
+  using namespace Const;
+  const bool own = piece.color() == perspective;
+  const std::size_t relative_piece = static_cast<std::size_t>(piece.type()) + (own ? 0 : Piece::TYPE_COUNT);
+  const int rank = perspective == Color::WHITE ? square.rank() : (BOARD_WIDTH - 1 - square.rank());
+  const auto oriented_square = static_cast<std::size_t>((rank * BOARD_WIDTH) + square.file());
+  return (((bucket * Piece::DISTINCT_PIECES_COUNT) + relative_piece) * BOARD_SIZE) + oriented_square;
+}
+
+/**
+ * @brief Computes sum(clamp(values[i], 0, ACTIVATION_MAX) * weights[i]) with the given instruction set.
+ *
+ * @param level Instruction set to use, must be supported by the running CPU
+ * @param values Accumulator values
+ * @param weights Output weights
+ * @param size Number of values, multiple of 16
+ */
+[[nodiscard]] std::int32_t clipped_dot(Simd::Level level, const std::int16_t* values, const std::int8_t* weights,
+                                       std::size_t size) noexcept;
+
+/**
+ * @brief Adds a feature weight column to accumulator values with the given instruction set.
+ *
+ * @param level Instruction set to use, must be supported by the running CPU
+ * @param values Accumulator values, updated in place
+ * @param column Weight column of the feature
+ * @param size Number of values, multiple of 16
+ */
+void add_column(Simd::Level level, std::int16_t* values, const std::int16_t* column, std::size_t size) noexcept;
+
+/**
+ * @brief Subtracts a feature weight column from accumulator values, see add_column().
+ */
+void sub_column(Simd::Level level, std::int16_t* values, const std::int16_t* column, std::size_t size) noexcept;
+
+/**
+ * @brief Accumulator of one perspective: transformer biases plus the weight columns of the active features.
+ */
+using Accumulator = std::array<std::int16_t, L1_SIZE>;
+
+/**
+ * @brief Accumulators indexed by perspective and king bucket, with the piece placement each was computed for.
+ *
+ * Refreshing an accumulator (its king changed bucket, or no earlier accumulator is known) starts from the entry of
+ * the new bucket and only adds and removes the pieces that differ from it.
+ */
+struct RefreshCache {
+  struct Entry {
+    Accumulator accumulator{};
+    std::array<Bitboard, Piece::DISTINCT_PIECES_COUNT> pieces{};
+    std::uint64_t generation = 0;  ///< Network generation the entry was computed with, 0 for never
+  };
+
+  std::array<std::array<Entry, KING_BUCKETS>, ColorUtil::SIZE> entries{};
+};
+
+/**
+ * @brief Accumulators of the positions along a search path, indexed by perspective and ply.
+ *
+ * The ply of a position is its number of moves played since the Position was created: the stack follows
+ * Position::apply_move / revert_move without hooks, using the executions Position keeps for undo as the list of
+ * pieces each move changed (see evaluate(const Position&, AccumulatorStack&, RefreshCache&)).
+ *
+ * Each frame records the hash of the position it was computed for and the network generation, so a frame left by a
+ * sibling line or an earlier search is never mistaken for the current one.
+ */
+struct AccumulatorStack {
+  static CX_VALUE std::size_t MAX_PLY = 256;  ///< Deeper positions are evaluated through the refresh cache
+
+  struct Frame {
+    Accumulator accumulator{};
+    Zobrist::Key key = Zobrist::NULL_HASH;
+    std::uint64_t generation = 0;  ///< Network generation the frame was computed with, 0 for never
+  };
+
+  std::array<std::vector<Frame>, ColorUtil::SIZE> frames{std::vector<Frame>(MAX_PLY), std::vector<Frame>(MAX_PLY)};
+};
+
+/**
+ * @brief Read-only file mapping: mmap where available, plain read otherwise.
+ */
+class MappedFile {
+ private:
+  const std::byte* mapped = nullptr;
+  std::size_t mapped_size = 0;
+  std::vector<std::byte> fallback;
+
+ public:
+  MappedFile() = default;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile();
+
+  /**
+   * @brief Maps a file in memory.
+   * @return false if the file cannot be opened or mapped.
+   */
+  [[nodiscard]] bool open(const std::string& path);
+
+  [[nodiscard]] const std::byte* data() const noexcept { return mapped != nullptr ? mapped : fallback.data(); }
+  [[nodiscard]] std::size_t size() const noexcept { return mapped != nullptr ? mapped_size : fallback.size(); }
+};
+
+/**
+ * @brief Network parameters, viewed in place inside the mapped network file.
+ */
+struct Network {
+  MappedFile file;
+  std::string path;
+  const std::int16_t* feature_biases = nullptr;
+  const std::int16_t* feature_weights = nullptr;
+  const std::int8_t* output_weights = nullptr;
+  std::int32_t output_bias = 0;
+  Simd::Level simd = Simd::Level::Scalar;
+};
+
+/**
+ * @brief Marks a search as running for the lifetime of the guard.
+ *
+ * Searches read the network without synchronisation: it cannot be loaded or unloaded while a guard is alive.
+ */
+class SearchGuard {
+ public:
+  SearchGuard() noexcept;
+  ~SearchGuard();
+
+  SearchGuard(const SearchGuard&) = delete;
+  SearchGuard& operator=(const SearchGuard&) = delete;
+};
+
+/**
+ * @brief Loads a network file, replacing the current network.
+ *
+ * On failure, the current network is kept.
+ *
+ * @param path Path of the network file
+ * @return true if the file was loaded, false if it is invalid or a search is running (see SearchGuard)
+ */
+[[nodiscard]] bool load_network(const std::string& path);
+
+/**
+ * @brief Unloads the current network: evaluation falls back to the hand-crafted evaluation.
+ *
+ * Does nothing while a search is running (see SearchGuard).
+ */
+void unload_network() noexcept;
+
+/**
+ * @brief Returns the loaded network, or nullptr.
+ */
+[[nodiscard]] const Network* network() noexcept;
+
+/**
+ * @brief Evaluates a board with the loaded network, refreshing both accumulators through the refresh cache.
+ *
+ * @param board Board to evaluate, with both kings on board
+ * @param cache Refresh cache of the calling thread
+ * @return Score in centipawns, positive in favour of white
+ *
+ * @pre A network is loaded.
+ */
+[[nodiscard]] int evaluate(const Board& board, RefreshCache& cache) noexcept;
+
+/**
+ * @brief Evaluates the current position of a search with the loaded network, updating accumulators incrementally.
+ *
+ * For each perspective, the accumulator is derived from the nearest earlier ply whose frame is up to date, by
+ * replaying the pieces changed by the moves in between (a few weight columns per move). A move of the perspective's
+ * king to another bucket invalidates every earlier frame: the accumulator is then refreshed through the refresh
+ * cache, and the frames back to that king move are rebuilt from it by undoing the moves, so sibling lines can
+ * start from them.
+ *
+ * @param position Position to evaluate, with both kings on board
+ * @param stack Accumulator stack of the calling thread
+ * @param cache Refresh cache of the calling thread
+ * @return Score in centipawns, positive in favour of white
+ *
+ * @pre A network is loaded.
+ */
+[[nodiscard]] int evaluate(const Position& position, AccumulatorStack& stack, RefreshCache& cache) noexcept;
+
+/**
+ * @brief Evaluates a position by computing both accumulators from scratch with scalar code.
+ *
+ * Reference implementation of evaluate(), used to validate incremental updates and SIMD kernels.
+ *
+ * @pre A network is loaded.
+ */
+[[nodiscard]] int evaluate_from_scratch(const Board& board) noexcept;
+
+}  // namespace Nnue
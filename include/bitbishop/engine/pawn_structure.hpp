@@ -0,0 +1,134 @@
+#pragma once
+
+#include <array>
+#include <bitbishop/bitboard.hpp>
+#include <bitbishop/board.hpp>
+#include <bitbishop/color.hpp>
+#include <bitbishop/config.hpp>
+#include <bitbishop/psqt.hpp>
+#include <bitbishop/zobrist.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Eval {
+
+/**
+ * @brief Penalty for each pawn with a friendly pawn in front of it on the same file.
+ */
+CX_INLINE Score DOUBLED_PAWN_PENALTY = make_score(-10, -20);
+
+/**
+ * @brief Penalty for each pawn without friendly pawns on the adjacent files.
+ */
+CX_INLINE Score ISOLATED_PAWN_PENALTY = make_score(-10, -15);
+
+/**
+ * @brief Penalty for each pawn whose stop square is controlled by an enemy pawn and can never be defended by a
+ * friendly pawn.
+ */
+CX_INLINE Score BACKWARD_PAWN_PENALTY = make_score(-8, -10);
+
+/**
+ * @brief Bonus of passed pawns, indexed by rank relative to the pawn's side (0 = own back rank).
+ */
+CX_INLINE std::array<Score, Const::BOARD_WIDTH> PASSED_PAWN_BONUS = {
+    make_score(0, 0),   make_score(5, 10),  make_score(10, 15),  make_score(15, 25),
+    make_score(25, 45), make_score(45, 75), make_score(70, 110), make_score(0, 0),
+};
+
+/**
+ * @brief Pawns of one side subject to each pawn structure term.
+ *
+ * Backward pawns are counted by their stop squares, one square in front of the pawns.
+ */
+struct PawnTerms {
+  Bitboard doubled;   ///< Pawns with a friendly pawn in front of them
+  Bitboard isolated;  ///< Pawns without friendly pawns on adjacent files
+  Bitboard backward;  ///< Stop squares of backward pawns
+  Bitboard passed;    ///< Front-most pawns with no enemy pawn ahead on the same or adjacent files
+};
+
+/**
+ * @brief Rank of a square seen from `side` (0 = own back rank), indexing PASSED_PAWN_BONUS.
+ */
+CX_FN int relative_rank(Square square, Color side) {
+  return side == Color::WHITE ? square.rank() : (Const::BOARD_WIDTH - 1 - square.rank());
+}
+
+/**
+ * @brief Finds the pawns of `side` scored by each pawn structure term.
+ *
+ * Shared by evaluate_pawn_structure() and the evaluation terms (see Eval::extract_terms), so both count the same
+ * pawns.
+ */
+[[nodiscard]] PawnTerms find_pawn_terms(const Board& board, Color side) noexcept;
+
+/**
+ * @brief Pawn structure evaluation of a position, only depending on the pawns.
+ */
+struct PawnEntry {
+  Zobrist::Key key = Zobrist::NULL_HASH;  ///< Pawn hash of the evaluated structure
+  Score score = 0;                        ///< Packed pawn structure score, white minus black
+  std::array<Bitboard, ColorUtil::SIZE> passed{};  ///< Passed pawns of each side, indexed by ColorUtil::to_index()
+};
+
+/**
+ * @brief Evaluates doubled, isolated, backward and passed pawns of both sides.
+ *
+ * All terms are computed set-wise with bitboard fills and shifts: the cost does not depend on the number of pawns.
+ *
+ * @param board Board to evaluate the pawn structure of
+ * @return Pawn structure entry, keyed by the board's pawn hash
+ */
+[[nodiscard]] PawnEntry evaluate_pawn_structure(const Board& board) noexcept;
+
+/**
+ * @brief Direct-mapped cache of pawn structure evaluations, indexed by pawn Zobrist hash.
+ *
+ * The pawn structure rarely changes between two nodes of a search, so most evaluations are a single probe.
+ * A table is not thread-safe: each search thread uses its own (see thread_pawn_hash_table()).
+ */
+class PawnHashTable {
+ public:
+  /**
+   * Default number of entries (power of two), 16384 entries of 32 bytes each.
+   */
+  static CX_VALUE std::size_t DEFAULT_SIZE = 16384;
+
+ private:
+  std::vector<PawnEntry> entries;
+  std::size_t mask;
+  std::uint64_t probes_count = 0;
+  std::uint64_t hits_count = 0;
+
+ public:
+  /**
+   * @param size Number of entries, must be a power of two
+   */
+  explicit PawnHashTable(std::size_t size = DEFAULT_SIZE);
+
+  /**
+   * @brief Returns the pawn structure evaluation of the board, computing and storing it on a miss.
+   */
+  [[nodiscard]] const PawnEntry& probe(const Board& board) noexcept;
+
+  /**
+   * @brief Empties the table and resets its statistics.
+   */
+  void clear() noexcept;
+
+  /** @brief Number of probes since construction or last clear. */
+  [[nodiscard]] std::uint64_t probes() const noexcept { return probes_count; }
+
+  /** @brief Number of probes answered from the table since construction or last clear. */
+  [[nodiscard]] std::uint64_t hits() const noexcept { return hits_count; }
+};
+
+/**
+ * @brief Returns the pawn hash table of the calling thread (see thread_tables()).
+ *
+ * Each search thread gets its own table, so probes need no synchronisation.
+ */
+[[nodiscard]] PawnHashTable& thread_pawn_hash_table() noexcept;
+
+}  // namespace Eval
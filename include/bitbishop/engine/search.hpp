@@ -4,6 +4,7 @@
 #include <limits>
 #include <optional>
 #include <stop_token>
+#include <vector>
 
 class Position;
 
@@ -15,6 +16,12 @@ namespace Search {
 struct SearchStats {
   uint64_t negamax_nodes = 0;     ///< Number of explored negamax nodes
   uint64_t quiescence_nodes = 0;  ///< Number of explored quiescence nodes
+  uint64_t pawn_hash_probes = 0;  ///< Number of pawn hash table probes made by evaluations
+  uint64_t pawn_hash_hits = 0;    ///< Number of pawn hash table probes answered from the table
+  uint64_t eval_cache_probes = 0;  ///< Number of evaluation cache probes made by quiescence search
+  uint64_t eval_cache_hits = 0;    ///< Number of evaluation cache probes answered from the cache
+  uint64_t tablebase_hits = 0;     ///< Number of negamax nodes answered by an endgame tablebase
+  uint64_t node_limit = 0;  ///< Negamax and quiescence nodes after which the stop flag is raised, 0 for no limit
 };
 
 // We implement negamax with alpha-beta by flipping the window at each ply:
@@ -40,6 +47,11 @@ struct BestMove {
    * @brief Evaluation for the current side to move
    */
   int score = ALPHA_INIT;
+
+  /**
+   * @brief Principal variation, starting with `move` when one was found
+   */
+  std::vector<Move> pv;
 };
 
 /**
@@ -95,4 +107,34 @@ struct BestMove {
 [[nodiscard]] BestMove negamax(Position& position, std::size_t depth, int alpha, int beta, int ply, SearchStats& stats,
                                std::atomic<bool>* stop_flag = nullptr);
 
+/**
+ * @brief Searches the root position and returns its `multipv` best lines, best first.
+ *
+ * @param position Current position (board + history)
+ * @param depth Search depth
+ * @param multipv Number of lines to return (clamped to the number of root moves)
+ * @param root_moves Legal root moves, searched in order. Reordered on return so the returned lines come first, which
+ * lets the next iterative deepening iteration search the previous best lines first.
+ * @param stats Statistics about the search process
+ *
+ * @return At most `multipv` lines, sorted by decreasing score. When `root_moves` is empty, falls back to `negamax` and
+ * returns its single (move-less) result so mates, stalemates and draws are still scored.
+ *
+ * All root moves are searched in a single pass that shares the move list and the search statistics. Until `multipv`
+ * lines are known, each move is searched with a full window. After that, the score of the worst kept line is used as
+ * alpha: a move failing low cannot enter the list and is cut as cheaply as in a regular alpha-beta search, while a move
+ * beating it gets an exact score. MultiPV=N thus costs far less than N independent searches.
+ *
+ * Limitations of the single pass:
+ * - A move scoring exactly as the worst kept line fails low and is dropped, so the list may miss a move as good as
+ *   its last line.
+ * - A move failing low is not re-searched within the iteration: its score is only known again at the next iteration,
+ *   which searches every root move anew.
+ *
+ * @see https://www.chessprogramming.org/Multi-PV
+ */
+[[nodiscard]] std::vector<BestMove> search_root(Position& position, std::size_t depth, std::size_t multipv,
+                                                std::vector<Move>& root_moves, SearchStats& stats,
+                                                std::atomic<bool>* stop_flag = nullptr);
+
 }  // namespace Search
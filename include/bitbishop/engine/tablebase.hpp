@@ -0,0 +1,182 @@
+#pragma once
+
+#include <array>
+#include <bitbishop/board.hpp>
+#include <bitbishop/config.hpp>
+#include <bitbishop/engine/evaluation.hpp>
+#include <bitbishop/material.hpp>
+#include <bitbishop/move.hpp>
+#include <bitbishop/moves/position.hpp>
+#include <bitbishop/piece.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @namespace Tablebase
+ * @brief Endgame tablebases generated by `bitbishop-tbgen`: exact results of positions with few pieces.
+ *
+ * Each material signature (e.g. "KQvKR") has two files:
+ * - `<code>.bbw`: win/draw/loss of the side to move, 2 bits per position;
+ * - `<code>.bbm`: distance to mate in plies, 1 byte per position (optional).
+ *
+ * Both start with a FileHeader and are memory-mapped by load(). Positions with castling rights or an en passant
+ * square are never probed.
+ */
+namespace Tablebase {
+
+CX_INLINE std::size_t MAX_PIECES = 5;
+CX_INLINE std::uint32_t FILE_VERSION = 1;
+CX_INLINE std::array<char, 4> WDL_MAGIC = {'B', 'B', 'T', 'W'};
+CX_INLINE std::array<char, 4> DTM_MAGIC = {'B', 'B', 'T', 'M'};
+CX_INLINE std::string_view WDL_EXTENSION = ".bbw";
+CX_INLINE std::string_view DTM_EXTENSION = ".bbm";
+
+/**
+ * @brief Score of a tablebase win known from the WDL file only, minus the ply: above evaluations, below mates.
+ */
+CX_INLINE int WIN_SCORE = Eval::MATE_THRESHOLD - 1000;
+
+/**
+ * @brief Result for the side to move, as stored in WDL files.
+ */
+enum class Wdl : std::uint8_t { Draw = 0, Win = 1, Loss = 2, Illegal = 3 };
+
+/**
+ * @brief DTM byte values: distance to mate in plies, offset by DTM_FIRST_PLY.
+ *
+ * An odd distance is a win for the side to move (it gives mate), an even one a loss (it is mated), 0 being mate.
+ */
+CX_INLINE std::uint8_t DTM_UNKNOWN = 0;  ///< Only used during generation
+CX_INLINE std::uint8_t DTM_ILLEGAL = 1;
+CX_INLINE std::uint8_t DTM_DRAW = 2;
+CX_INLINE std::uint8_t DTM_FIRST_PLY = 3;
+CX_INLINE int MAX_DTM_PLIES = 255 - DTM_FIRST_PLY;
+
+CX_FN std::uint8_t dtm_code(int plies) { return static_cast<std::uint8_t>(DTM_FIRST_PLY + plies); }
+
+CX_FN bool is_mate_distance(std::uint8_t code) { return code >= DTM_FIRST_PLY; }
+
+CX_FN int dtm_plies(std::uint8_t code) { return code - DTM_FIRST_PLY; }
+
+CX_FN Wdl wdl_of(std::uint8_t code) {
+  if (is_mate_distance(code)) {
+    return (dtm_plies(code) % 2 == 1) ? Wdl::Win : Wdl::Loss;
+  }
+  return code == DTM_DRAW ? Wdl::Draw : Wdl::Illegal;
+}
+
+/**
+ * @brief Header of both tablebase files, followed by the position data.
+ */
+struct FileHeader {
+  std::array<char, 4> magic{};
+  std::uint32_t version = FILE_VERSION;
+  std::array<char, 16> code{};  ///< Material code, zero padded
+  std::uint64_t positions = 0;
+};
+static_assert(sizeof(FileHeader) == 32, "tablebase headers are read in place");
+
+/**
+ * @brief Enumeration of the positions of one material signature, reduced by symmetry.
+ *
+ * Index layout, from most to least significant: king pair, side to move, then one digit per other piece (64
+ * squares, or 48 for pawns which never stand on the first and last ranks). The king pair puts the white king on
+ * the a1-d1-d4 triangle (10 squares, 8 board symmetries) without pawns, on files a-d (32 squares, left/right
+ * symmetry) with pawns. Identical pieces are stored on increasing squares.
+ *
+ * The "white" side of the layout is the first side of the code: boards with the colors swapped (KvKQ for a KQvK
+ * layout) are indexed with flipped colors.
+ */
+class Layout {
+ private:
+  std::string m_code;
+  Material::Key m_key = 0;
+  std::vector<Piece> m_pieces;  ///< White king, black king, then the other white and black pieces
+  bool m_has_pawns = false;
+  std::size_t m_size = 0;
+
+ public:
+  /**
+   * @throw std::invalid_argument If the code is not a material code with one king per side and at most MAX_PIECES
+   * pieces
+   */
+  explicit Layout(std::string_view code);
+
+  /**
+   * @brief Code of a material key, pieces of each side ordered from queen to pawn (e.g. "KRPvKB").
+   */
+  [[nodiscard]] static std::string code_of(Material::Key key);
+
+  [[nodiscard]] const std::string& code() const noexcept { return m_code; }
+  [[nodiscard]] Material::Key key() const noexcept { return m_key; }
+  [[nodiscard]] const std::vector<Piece>& pieces() const noexcept { return m_pieces; }
+  [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+
+  /**
+   * @brief Index of a board with the material of the layout, or its mirror when `flipped` is set.
+   */
+  [[nodiscard]] std::size_t index(const Board& board, bool flipped) const;
+
+  /**
+   * @brief Square indexes (in pieces() order) and side to move of an index.
+   * @return false when the index is not a canonical placement: pieces sharing a square, identical pieces not in
+   * increasing order.
+   */
+  [[nodiscard]] bool decode(std::size_t index, std::array<int, MAX_PIECES>& squares, Color& side_to_move) const;
+};
+
+/**
+ * @brief Maps the tablebases of a directory, replacing those loaded before.
+ *
+ * Must not be called during a search.
+ *
+ * @return Number of material signatures loaded (WDL files found and valid)
+ */
+std::size_t load(const std::string& directory);
+
+/**
+ * @brief Unmaps all tablebases.
+ */
+void unload();
+
+/**
+ * @brief Largest number of pieces of the loaded tablebases, 0 when none is loaded.
+ */
+[[nodiscard]] std::size_t max_pieces() noexcept;
+
+/**
+ * @brief Result of a position for the side to move.
+ * @return std::nullopt if no loaded tablebase covers the position
+ */
+[[nodiscard]] std::optional<Wdl> probe_wdl(const Board& board) noexcept;
+
+/**
+ * @brief Distance to mate of a position, in plies (odd: the side to move mates, even: it is mated), or -1 for a draw.
+ * @return std::nullopt if no loaded tablebase covers the position with a DTM file
+ */
+[[nodiscard]] std::optional<int> probe_dtm(const Board& board) noexcept;
+
+/**
+ * @brief Search score of a position for the side to move, `ply` plies from the root.
+ *
+ * Mate scores when the DTM is known, WIN_SCORE based scores from the WDL file otherwise, 0 for draws.
+ *
+ * @return std::nullopt if no loaded tablebase covers the position
+ */
+[[nodiscard]] std::optional<int> probe_score(const Board& board, int ply) noexcept;
+
+/**
+ * @brief Keeps only the root moves with the best tablebase result: the fastest mates, or the slowest losses, when
+ * the DTM is known.
+ *
+ * @param position Root position, restored on return
+ * @param moves Legal root moves
+ * @return false, leaving `moves` untouched, if the root or one of its children is not covered
+ */
+bool filter_root_moves(Position& position, std::vector<Move>& moves);
+
+}  // namespace Tablebase
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <bitbishop/config.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// bitbishop/board.hpp builds boards through Fen::parse, which is a friend of Board.
+class Board;
+
+/**
+ * @namespace Fen
+ * @brief Forsyth-Edwards Notation and Extended Position Description, read and written without allocations.
+ *
+ * FEN has 6 space-separated fields: piece placement (rank 8 to 1), side to move, castling rights, en passant
+ * square, halfmove clock and fullmove number. EPD keeps the first 4 fields and follows them with operations (e.g.
+ * `bm Nf3; id "test 1";`).
+ *
+ * @see https://www.chessprogramming.org/Forsyth-Edwards_Notation
+ * @see https://www.chessprogramming.org/Extended_Position_Description
+ */
+namespace Fen {
+
+/** Longest clock written by format_to(), a 32-bit signed integer such as "-2147483648". */
+CX_INLINE std::size_t COUNTER_MAX_LENGTH = 11;
+
+/**
+ * @brief Longest FEN written by format_to(): placement of 64 pieces, 4 castling rights and the longest clocks.
+ */
+CX_INLINE std::size_t MAX_LENGTH = (64 + 7) + 1 + 1 + 1 + 4 + 1 + 2 + 1 + COUNTER_MAX_LENGTH + 1 + COUNTER_MAX_LENGTH;
+
+/**
+ * @brief First invalid field of a FEN or EPD.
+ */
+enum class Error : std::uint8_t {
+  None,
+  Placement,       ///< Not 8 ranks of 8 squares, or an unknown piece letter
+  SideToMove,      ///< Not "w" or "b"
+  Castling,        ///< Not "-" or distinct letters among "KQkq"
+  EnPassant,       ///< Not "-" or a square of the third or sixth rank
+  HalfmoveClock,   ///< Not a number
+  FullmoveNumber,  ///< Not a number
+  TrailingText,    ///< Text after the fullmove number
+};
+
+/**
+ * @brief Human-readable description of an error.
+ */
+[[nodiscard]] std::string_view error_message(Error error) noexcept;
+
+/**
+ * @brief Sets a board to a FEN position.
+ *
+ * Fields may be separated by several spaces. The halfmove clock and fullmove number may be omitted (0 and 1). The
+ * position itself is not checked for legality: kings may be missing, as in tablebase or test positions.
+ *
+ * @return Error::None on success; on error, the board is left unchanged
+ */
+[[nodiscard]] Error parse(std::string_view fen, Board& board) noexcept;
+
+/**
+ * @brief Sets a board to the 4 position fields of an EPD record, and returns its operations.
+ *
+ * The clocks are set to 0 and 1, `hmvc` and `fmvn` operations are not applied.
+ *
+ * @param operations Set to the text after the position fields, spaces trimmed
+ * @return Error::None on success; on error, the board and operations are left unchanged
+ */
+[[nodiscard]] Error parse_epd(std::string_view epd, Board& board, std::string_view& operations) noexcept;
+
+/**
+ * @brief Calls `visit(opcode, operand)` for each operation of an EPD record, in order.
+ *
+ * Operations end with ';', which may also appear in quoted operands (e.g. `id "a;b";`). Opcodes and operands are
+ * trimmed, quotes are kept. The last operation may omit its ';'.
+ *
+ * @param operations Operations returned by parse_epd()
+ * @param visit Callable taking two std::string_view and returning false to stop
+ * @return false if `visit` stopped the walk
+ */
+template <typename Visitor>
+bool for_each_operation(std::string_view operations, Visitor&& visit) {
+  const auto trim = [](std::string_view text) {
+    const std::size_t begin = text.find_first_not_of(" \t\r\n");
+    if (begin == std::string_view::npos) {
+      return std::string_view{};
+    }
+    return text.substr(begin, text.find_last_not_of(" \t\r\n") - begin + 1);
+  };
+  const auto apply = [&](std::string_view operation) {
+    operation = trim(operation);
+    if (operation.empty()) {
+      return true;
+    }
+    const std::size_t space = operation.find(' ');
+    const std::string_view operand = space == std::string_view::npos ? std::string_view{} : operation.substr(space);
+    return static_cast<bool>(visit(operation.substr(0, space), trim(operand)));
+  };
+
+  std::size_t begin = 0;
+  bool quoted = false;
+  for (std::size_t i = 0; i < operations.size(); ++i) {
+    if (operations[i] == '"') {
+      quoted = !quoted;
+    } else if (operations[i] == ';' && !quoted) {
+      if (!apply(operations.substr(begin, i - begin))) {
+        return false;
+      }
+      begin = i + 1;
+    }
+  }
+  return apply(operations.substr(begin));
+}
+
+/**
+ * @brief Writes the FEN of a board, without terminating null character.
+ *
+ * @param out Buffer with room for MAX_LENGTH characters
+ * @return Pointer past the last character written
+ */
+char* format_to(char* out, const Board& board) noexcept;
+
+}  // namespace Fen
@@ -18,11 +18,11 @@ struct SearchReporter {
   /**
    * @brief Called after each completed search iteration.
    *
-   * @param best  Current best move found so far.
+   * @param lines Principal variations found by the iteration, best first (one per MultiPV line).
    * @param depth Depth reached in the current iteration.
    * @param stats Accumulated search statistics.
    */
-  virtual void on_iteration(const Search::BestMove& best, int depth, const Search::SearchStats& stats) {}
+  virtual void on_iteration(const std::vector<Search::BestMove>& lines, int depth, const Search::SearchStats& stats) {}
 
   /**
    * @brief Called once when the search finishes.
@@ -43,17 +43,41 @@ struct SearchReporter {
  * with chess GUIs or other UCI-compatible tools.
  */
 struct UciReporter : SearchReporter {
+  using Clock = std::chrono::steady_clock;
+
+ public:
+  /** Injectable time source. Mainly for testing.
+   * Must be declared *before* start.
+   */
+  std::function<Clock::time_point()> now;
+
  private:
   /** Output stream used for writing UCI messages. */
   std::ostream& out_stream;
 
+  /** Start time of the search, reference of the reported `time` and `nps`. */
+  Clock::time_point start;
+
  public:
   /**
-   * @brief Constructs a UciReporter.
+   * @brief Constructs a UciReporter and records the start time.
    *
    * @param out Output stream where UCI messages will be written.
    */
   UciReporter(std::ostream& out);
+  UciReporter(std::ostream& out, std::function<Clock::time_point()> now_fn);
+
+  /**
+   * @brief Outputs one UCI info line per principal variation.
+   *
+   * Prints lines of the form:
+   *   "info depth <d> multipv <k> score <cp <x> | mate <n>> nodes <n> nps <n> time <ms> pv <move1> <move2> ..."
+   *
+   * @param lines Principal variations, best first.
+   * @param depth Depth reached in the current iteration.
+   * @param stats Accumulated search statistics.
+   */
+  void on_iteration(const std::vector<Search::BestMove>& lines, int depth, const Search::SearchStats& stats) override;
 
   /**
    * @brief Outputs the final best move in UCI format.
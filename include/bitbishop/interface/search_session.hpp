@@ -1,9 +1,13 @@
 #pragma once
 
+#include <bitbishop/engine/book.hpp>
 #include <bitbishop/interface/search_reporter.hpp>
 #include <bitbishop/interface/search_worker.hpp>
+#include <bitbishop/tools/bench.hpp>
+#include <cstdint>
 #include <memory>
 #include <ostream>
+#include <string>
 
 namespace Uci {
 
@@ -12,17 +16,33 @@ namespace Uci {
  *
  * Worker threads only publish events. This class consumes those events on the
  * control thread and forwards them to the configured reporter.
+ *
+ * Each search runs on a new worker thread, but the session owns the evaluation tables and lends them to every
+ * worker, so caches stay warm across `go` commands.
+ *
+ * The session also owns the opening book: book moves are answered at once, without starting a worker.
  */
 class SearchSession {
   std::ostream& out_stream;
   std::unique_ptr<SearchWorker> worker;
   std::unique_ptr<SearchReporter> reporter;
+  std::unique_ptr<Eval::ThreadTables> tables;  ///< Evaluation tables reused by every search of the session
+  Book::PolyglotBook book;                     ///< Opening book, only read on the control thread
+  std::uint64_t book_seed;                     ///< State of the generator choosing between book moves
+
+  struct BenchRun;
+  std::unique_ptr<BenchRun> bench;  ///< Benchmark suite in progress, run instead of a worker
 
   /**
    * @brief Emits pending reports from worker to reporter.
    */
   void emit_reports();
 
+  /**
+   * @brief Joins the benchmark thread and reports its result.
+   */
+  void finish_bench();
+
   /**
    * @brief Finalizes and clears resources if search already finished.
    */
@@ -37,13 +57,22 @@ class SearchSession {
 
   /**
    * @brief Starts a regular UCI search.
+   *
+   * When `options.own_book` is set and the board is in the opening book, a book move is reported as best move
+   * right away and no search is started. Infinite searches (analysis) always search.
+   *
+   * @param zobrist_history Hashes of the game positions leading to the board (see SearchWorker)
    */
-  void start_go(Board board, SearchLimits limits);
+  void start_go(Board board, SearchLimits limits, SearchOptions options = {},
+                std::vector<Zobrist::Key> zobrist_history = {});
 
   /**
-   * @brief Starts a benchmark search.
+   * @brief Starts the benchmark suite (see Tools::run_bench) on a background thread.
+   *
+   * Once done or stopped, reports the nodes of each position, then a BenchReporter summary whose node count is the
+   * signature of the search. The suite uses tables of its own, so the session tables are left untouched.
    */
-  void start_bench(Board board, SearchLimits limits);
+  void start_bench(const Tools::BenchOptions& options);
 
   /**
    * @brief Requests current search to stop (non-blocking).
@@ -63,7 +92,31 @@ class SearchSession {
   /**
    * @brief Returns true when no search is active.
    */
-  [[nodiscard]] bool is_idle() const { return worker == nullptr; }
+  [[nodiscard]] bool is_idle() const { return worker == nullptr && bench == nullptr; }
+
+  /**
+   * @brief Stops the current search if any, then empties the evaluation tables.
+   *
+   * Must be called when the static evaluation changes, since the tables cache its results.
+   */
+  void clear_tables();
+
+  /**
+   * @brief Maps a Polyglot book, used by the searches started with `SearchOptions::own_book`.
+   * @return false, leaving the session without book, if the file is not a valid book
+   */
+  [[nodiscard]] bool open_book(const std::string& path) { return book.open(path); }
+
+  void close_book() noexcept { book.close(); }
+
+  [[nodiscard]] const Book::PolyglotBook& opening_book() const noexcept { return book; }
+
+  /**
+   * @brief Returns the evaluation tables shared by the session searches.
+   *
+   * Only safe to inspect while the session is idle.
+   */
+  [[nodiscard]] const Eval::ThreadTables& thread_tables() const { return *tables; }
 };
 
 }  // namespace Uci
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <atomic>
+#include <bitbishop/engine/eval_tables.hpp>
 #include <bitbishop/engine/search.hpp>
 #include <bitbishop/moves/position.hpp>
+#include <cstdint>
 #include <mutex>
 #include <optional>
 #include <thread>
@@ -20,6 +22,7 @@ struct SearchLimits {
   std::optional<int> movetime;      ///< Move time limit (in milliseconds)
   std::optional<int> wtime, btime;  ///< White/black time limits (in milliseconds)
   std::optional<int> winc, binc;    ///< White/black increment limits (in milliseconds)
+  std::optional<std::uint64_t> nodes;  ///< Negamax and quiescence node limit
   bool infinite = false;            ///< Flag for infinite search mode
 
   /**
@@ -48,6 +51,19 @@ struct SearchLimits {
   [[nodiscard]] std::optional<int> think_time_ms(Color side_to_move) const;
 };
 
+/**
+ * @brief Engine options set through `setoption` that shape how a search runs.
+ *
+ * Unlike SearchLimits, which are given for one `go` command, these persist across searches.
+ */
+struct SearchOptions {
+  static CX_VALUE std::size_t MIN_MULTIPV = 1;
+  static CX_VALUE std::size_t MAX_MULTIPV = 256;
+
+  std::size_t multipv = MIN_MULTIPV;  ///< Number of principal variations to report (`MultiPV` UCI option)
+  bool own_book = false;              ///< Play book moves without searching (`OwnBook` UCI option)
+};
+
 /**
  * @brief Represents an event generated by a search worker.
  *
@@ -66,6 +82,7 @@ struct SearchReport {
   Search::BestMove best;
   int depth = 0;
   Search::SearchStats stats{};
+  std::vector<Search::BestMove> lines;  ///< All principal variations, best first (`best` is the first one)
 };
 
 /**
@@ -81,6 +98,8 @@ class SearchWorker {
   Board board;                         ///< Current chess board
   Position position;                   ///< Game position associated to the current chess board
   SearchLimits limits;                 ///< Current search parameters
+  SearchOptions options;               ///< Engine options applied to this search
+  Eval::ThreadTables* tables;          ///< Evaluation tables bound to the worker thread, may be null
   std::mutex reports_mutex;            ///< Synchronizes report queue access
   std::vector<SearchReport> reports;   ///< FIFO queue of generated search reports
 
@@ -95,7 +114,17 @@ class SearchWorker {
   void push_report(SearchReport report);
 
  public:
-  SearchWorker(Board board, SearchLimits limits);
+  /**
+   * @param board Board to search from
+   * @param limits Search limits
+   * @param options Search options
+   * @param zobrist_history Hashes of the game positions leading to the board, oldest first, ending with the
+   * board's own hash. Lets the search see repetitions of positions played before the root.
+   * @param tables Evaluation tables to search with, owned by the caller and outliving the search. When null, the
+   * worker thread uses its own thread-local tables, which start cold and die with the thread.
+   */
+  SearchWorker(Board board, SearchLimits limits, SearchOptions options = {},
+               std::vector<Zobrist::Key> zobrist_history = {}, Eval::ThreadTables* tables = nullptr);
   ~SearchWorker();
 
   /**
@@ -34,6 +34,7 @@ class UciEngine {
   Position position;            ///< Game position associated to the current chess board
   UciCommandChannel command_channel;  ///< Command listener (input thread + queue)
   SearchSession search_session;       ///< Search lifecycle owner (worker + reporter)
+  SearchOptions search_options;       ///< Options set through `setoption`, applied to every search
   UciCommandRegistry command_registry;  ///< UCI command -> handler registry
   bool is_running;
 
@@ -78,6 +79,7 @@ class UciEngine {
    * - "uci"
    * - "isready"
    * - "ucinewgame"
+   * - "setoption"
    * - "position"
    * - "go"
    * - "stop"
@@ -99,6 +101,23 @@ class UciEngine {
    */
   void handle_uci();
 
+  /**
+   * @brief Parses and handles "setoption" commands.
+   *
+   * Syntax is `setoption name <id> [value <x>]`, option names being case-insensitive.
+   * Unknown options and invalid values are ignored silently.
+   *
+   * Supported options:
+   * - "MultiPV": number of principal variations reported by the search
+   * - "EvalFile": path of an NNUE network file, `<empty>` or no value falling back to the hand-crafted evaluation
+   * - "TablebasePath": directory of tablebase files, `<empty>` or no value disabling tablebases
+   * - "OwnBook": `true` to play book moves without searching
+   * - "BookFile": path of a Polyglot opening book, `<empty>` or no value closing the book
+   *
+   * @param line The input command tokens containing the option name and value
+   */
+  void handle_setoption(const std::vector<std::string> &line);
+
   /**
    * @brief Handles the "ucinewgame" command.
    *
@@ -109,7 +128,8 @@ class UciEngine {
   /**
    * @brief Parses and handles "position" commands.
    *
-   * Processes position setup commands including startpos, fen, and move sequences.
+   * Processes position setup commands including startpos, fen, and move sequences. The FEN spans the tokens up to
+   * "moves", its clocks may be omitted. An invalid FEN leaves the position unchanged.
    *
    * @param line The input command tokens containing the position information
    */
@@ -161,7 +181,7 @@ class UciEngine {
   void send_startup_msg();
 
   /**
-   * @brief Runs a benchmark.
+   * @brief Runs the benchmark suite: `bench [depth <n>] [threads <n>] [hash <mb>]`.
    *
    * @param line The input command tokens containing the benchmark information
    */
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <bitbishop/bitboard.hpp>
+#include <bitbishop/config.hpp>
+#include <bitbishop/constants.hpp>
+#include <bitbishop/lookups/bishop_rays.hpp>
+#include <bitbishop/lookups/king_attacks.hpp>
+#include <bitbishop/lookups/knight_attacks.hpp>
+#include <bitbishop/lookups/queen_rays.hpp>
+#include <bitbishop/lookups/rook_rays.hpp>
+#include <bitbishop/piece.hpp>
+#include <bitbishop/zobrist.hpp>
+#include <cstdint>
+#include <utility>
+
+namespace Lookups {
+
+/**
+ * Number of slots of the cuckoo table (2^13), large enough to hold every reversible move with two hash functions.
+ */
+CX_INLINE std::size_t CUCKOO_TABLE_SIZE = 8192;
+
+/**
+ * Number of reversible moves (non-pawn piece, from, to) on an empty board, counting each square pair once.
+ */
+CX_INLINE std::size_t CUCKOO_MOVES_COUNT = 3668;
+
+/**
+ * @brief First cuckoo hash function (low 13 bits of the key).
+ */
+CX_FN std::size_t cuckoo_h1(Zobrist::Key key) { return static_cast<std::size_t>(key & (CUCKOO_TABLE_SIZE - 1)); }
+
+/**
+ * @brief Second cuckoo hash function (13 bits starting at bit 16 of the key).
+ */
+CX_FN std::size_t cuckoo_h2(Zobrist::Key key) {
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  return static_cast<std::size_t>((key >> 16) & (CUCKOO_TABLE_SIZE - 1));
+}
+
+/**
+ * @brief Cuckoo hash table of all reversible moves, keyed by their Zobrist move key.
+ *
+ * The move key of a piece moving between two squares is the XOR of its two piece-square keys and the side key:
+ * XOR-ing it into a position hash plays the move (either way) and flips the side to move.
+ *
+ * Empty slots have a null key. Squares are stored with the lowest index in `from`.
+ */
+struct CuckooTable {
+  std::array<Zobrist::Key, CUCKOO_TABLE_SIZE> keys{};
+  std::array<std::uint8_t, CUCKOO_TABLE_SIZE> from{};
+  std::array<std::uint8_t, CUCKOO_TABLE_SIZE> to{};
+};
+
+/**
+ * @brief Builds the cuckoo table of reversible moves.
+ *
+ * Every (piece, s1, s2) triple such that the piece attacks s2 from s1 on an empty board is inserted once.
+ * Pawns are skipped since pawn moves are irreversible.
+ *
+ * Insertion evicts the current occupant of the slot, which is moved to its alternate slot, until an empty
+ * slot is found.
+ *
+ * @return Fully populated cuckoo table.
+ */
+CX_FN CuckooTable generate_cuckoo_table() {
+  using namespace Const;
+
+  CuckooTable table{};
+
+  for (const Color color : {Color::WHITE, Color::BLACK}) {
+    for (const Piece::Type type : {Piece::KNIGHT, Piece::BISHOP, Piece::ROOK, Piece::QUEEN, Piece::KING}) {
+      const Piece piece(type, color);
+      const int p_ind = Zobrist::piece_index(piece);
+
+      for (int s1 = 0; s1 < BOARD_SIZE; ++s1) {
+        Bitboard attacks;
+        switch (type) {
+          // clang-format off
+          case Piece::KNIGHT: attacks = KNIGHT_ATTACKS[s1]; break;
+          case Piece::BISHOP: attacks = BISHOP_RAYS[s1];    break;
+          case Piece::ROOK:   attacks = ROOK_RAYS[s1];      break;
+          case Piece::QUEEN:  attacks = QUEEN_RAYS[s1];     break;
+          default:            attacks = KING_ATTACKS[s1];   break;
+          // clang-format on
+        }
+
+        for (int s2 = s1 + 1; s2 < BOARD_SIZE; ++s2) {
+          if (!attacks.test(static_cast<std::uint8_t>(s2))) {
+            continue;
+          }
+
+          Zobrist::Key key = Zobrist::tables.pieces[p_ind][s1] ^ Zobrist::tables.pieces[p_ind][s2] ^ Zobrist::tables.side;
+          auto from = static_cast<std::uint8_t>(s1);
+          auto to = static_cast<std::uint8_t>(s2);
+
+          std::size_t slot = cuckoo_h1(key);
+          while (true) {
+            std::swap(table.keys[slot], key);
+            std::swap(table.from[slot], from);
+            std::swap(table.to[slot], to);
+            if (key == Zobrist::NULL_HASH) {
+              break;
+            }
+            slot = (slot == cuckoo_h1(key)) ? cuckoo_h2(key) : cuckoo_h1(key);
+          }
+        }
+      }
+    }
+  }
+
+  return table;
+}
+
+/**
+ * @brief Precomputed cuckoo table of reversible moves, used for upcoming repetition detection.
+ *
+ * Technique from Marcel van Kervinck's paper "Detecting repetitions with cuckoo hashing".
+ *
+ * @see Position::has_upcoming_repetition
+ */
+CX_INLINE CuckooTable CUCKOO = generate_cuckoo_table();
+
+}  // namespace Lookups
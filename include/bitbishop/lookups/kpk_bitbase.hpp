@@ -0,0 +1,40 @@
+#pragma once
+
+#include <bitbishop/color.hpp>
+#include <bitbishop/config.hpp>
+#include <bitbishop/square.hpp>
+#include <cstddef>
+
+namespace Lookups {
+
+/**
+ * @brief Number of KPK positions in the bitbase: side to move, pawn on files a-d and ranks 2-7, both kings.
+ *
+ * Positions with the pawn on files e-h are mirrored onto files a-d, black pawns are flipped to white ones.
+ */
+CX_INLINE std::size_t KPK_POSITIONS_COUNT = 2 * 24 * 64 * 64;
+
+/**
+ * @brief Exact result of a king and pawn against king position.
+ *
+ * Looks up a win/draw bitbase of KPK_POSITIONS_COUNT bits (24 KiB), built by retrograde analysis on first use:
+ * - positions are first classified when their result is immediate (safe promotion, stalemate, pawn captured);
+ * - the others are then resolved from their successors until nothing changes: the attacker wins when one of its
+ *   moves wins, the defender draws when one of its moves draws. What remains unresolved is a draw.
+ *
+ * The table is built at startup rather than at compile time: the analysis takes about 10^8 evaluation steps, far
+ * beyond the constant evaluation limits of compilers (clang stops at 2^20 steps).
+ *
+ * @param strong Color of the side with the pawn
+ * @param strong_king Square of the king of the side with the pawn
+ * @param pawn Square of the pawn
+ * @param weak_king Square of the lone king
+ * @param side_to_move Color to move
+ * @return true if the side with the pawn wins with best play, false if the position is a draw
+ *
+ * @pre The position is legal (kings not adjacent, the side not to move is not in check).
+ */
+[[nodiscard]] bool kpk_is_win(Color strong, Square strong_king, Square pawn, Square weak_king,
+                              Color side_to_move) noexcept;
+
+}  // namespace Lookups
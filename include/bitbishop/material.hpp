@@ -0,0 +1,70 @@
+#pragma once
+
+#include <bitbishop/color.hpp>
+#include <bitbishop/config.hpp>
+#include <bitbishop/piece.hpp>
+#include <bitbishop/zobrist.hpp>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+/**
+ * @namespace Material
+ * @brief Material signatures: how many pieces of each kind stand on a board, regardless of their squares.
+ */
+namespace Material {
+
+/**
+ * @brief Material signature packing the count of each of the 12 pieces in 4 bits, in Zobrist::piece_index order.
+ *
+ * The key is a plain sum of unit() values: it is updated incrementally by adding or subtracting the unit of the
+ * piece set or removed, and two boards share a key exactly when they have the same material. No legal position has
+ * more than 15 pieces of a kind (10 knights at most, after promotions).
+ */
+using Key = std::uint64_t;
+
+CX_INLINE int BITS_PER_PIECE = 4;
+CX_INLINE Key COUNT_MASK = 0xF;
+CX_INLINE int COLOR_BITS = BITS_PER_PIECE * static_cast<int>(Piece::TYPE_COUNT);  ///< Bits of one color's counts
+CX_INLINE Key COLOR_MASK = (Key{1} << COLOR_BITS) - 1;
+
+/**
+ * @brief Key increment of one piece.
+ */
+CX_FN Key unit(Piece piece) { return Key{1} << (BITS_PER_PIECE * Zobrist::piece_index(piece)); }
+
+/**
+ * @brief Number of pieces of a kind in a material key.
+ */
+CX_FN int count(Key key, Piece piece) {
+  return static_cast<int>((key >> (BITS_PER_PIECE * Zobrist::piece_index(piece))) & COUNT_MASK);
+}
+
+/**
+ * @brief Material key with the colors swapped (e.g. KRvK becomes KvKR).
+ */
+CX_FN Key mirror(Key key) { return ((key & COLOR_MASK) << COLOR_BITS) | (key >> COLOR_BITS); }
+
+/**
+ * @brief Material key of a code such as "KRvK": the white pieces, 'v', then the black pieces, in uppercase.
+ *
+ * @throw std::invalid_argument If the code has no 'v' separator or contains an invalid piece letter
+ */
+CX_FN Key from_code(std::string_view code) {
+  const std::size_t separator = code.find('v');
+  if (separator == std::string_view::npos) {
+    throw std::invalid_argument("material code without 'v' separator");
+  }
+
+  Key key = 0;
+  for (std::size_t i = 0; i < code.size(); ++i) {
+    if (i == separator) {
+      continue;
+    }
+    const Color color = i < separator ? Color::WHITE : Color::BLACK;
+    key += unit(Piece(Piece::type_from_char(code[i]), color));
+  }
+  return key;
+}
+
+}  // namespace Material
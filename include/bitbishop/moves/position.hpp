@@ -22,9 +22,34 @@ class Position {
   /** History of Zobrist hashes for threefold and fivefold repetition rules. */
   std::vector<Zobrist::Key> zobrist_hashes_history;
 
+  /** Number of occurrences of each position of zobrist_hashes_history, up to and including itself. */
+  std::vector<int> repetition_counts;
+
+  /**
+   * @brief Counts the occurrences of the position at `index`, using the counts of earlier positions.
+   * @param index Index of the position in zobrist_hashes_history
+   * @param max_back_plies How far back the same position may have occurred
+   */
+  [[nodiscard]] int count_repetitions_at(std::size_t index, int max_back_plies) const noexcept;
+
  public:
   Position() = delete;  ///< Default construction not allowed
-  Position(Board& board) : board(board) { zobrist_hashes_history.push_back(board.get_zobrist_hash()); }
+  Position(Board& board) : board(board) {
+    zobrist_hashes_history.push_back(board.get_zobrist_hash());
+    repetition_counts.push_back(1);
+  }
+
+  /**
+   * @brief Constructs a position whose repetition tracking also covers earlier game positions.
+   *
+   * Earlier positions cannot be reverted, they are only used to detect repetitions (e.g. the moves of a
+   * UCI `position ... moves ...` command before a search starts).
+   *
+   * @param board Board being managed
+   * @param zobrist_history Hashes of the game positions, oldest first, ending with the board's own hash.
+   * If empty, only the board's current position is tracked.
+   */
+  Position(Board& board, std::vector<Zobrist::Key> zobrist_history);
 
   /**
    * @brief Applies a move to the board and records it for undo.
@@ -50,6 +75,16 @@ class Position {
    */
   [[nodiscard]] const Board& get_board() const { return board; }
 
+  /**
+   * @brief Returns the Zobrist hashes of all tracked positions, oldest first, current position last.
+   */
+  [[nodiscard]] const std::vector<Zobrist::Key>& get_zobrist_history() const { return zobrist_hashes_history; }
+
+  /**
+   * @brief Returns the executions of the moves applied since construction or last reset, oldest first.
+   */
+  [[nodiscard]] const std::vector<MoveExecution>& get_move_history() const { return move_execution_history; }
+
   /**
    * @brief Checks if a move can be reverted.
    * @return true if move history is non-empty
@@ -59,7 +94,8 @@ class Position {
   /**
    * @brief Calculates the frequency of the current position in the game history.
    *
-   * This function performs an optimized lookback to detect repetitions (3-fold, 5-fold).
+   * Occurrence counts are computed once, when a position is reached, so this query is O(1).
+   * The lookback done in apply_move() is optimized to detect repetitions (3-fold, 5-fold):
    *
    * ### Optimization Logic:
    *
@@ -70,12 +106,29 @@ class Position {
    * - Side-to-Move: For a position to be identical, the same player must be on move.
    * The function skips every other ply because positions with different players to move are mathematically distinct.
    *
-   * - Early Exit: The search terminates early if the count reaches the mandatory fivefold repetition count.
+   * - Early Exit: The lookback stops at the most recent occurrence, whose own count is reused.
    *
-   * * @return The number of occurrences found, including the current one (minimum is 1).
+   * * @return The number of occurrences found, including the current one (minimum is 1, maximum is 5).
    */
   [[nodiscard]] int repetition_count() const noexcept;
 
+  /**
+   * @brief Tells if the side to move can reach an earlier position with a single reversible move.
+   *
+   * Uses the cuckoo table of reversible moves (see Lookups::CUCKOO): an earlier position, with the same side to
+   * move after one more ply, differs from the current one by exactly one reversible move when the XOR of both
+   * hashes is a cuckoo move key. The move must also be unobstructed on the current board.
+   *
+   * Cycles completed inside the search tree (`ply` plies from the root) are draws the side to move can claim.
+   * Cycles going back before the root are only accepted when the reached position already repeated.
+   *
+   * @param ply Number of half-moves from the search root
+   * @return true if a draw by repetition can be forced by the side to move
+   *
+   * @see Lookups::CUCKOO
+   */
+  [[nodiscard]] bool has_upcoming_repetition(int ply) const noexcept;
+
   /**
    * @brief Returns true if the current position occurred 3 or more times.
    */
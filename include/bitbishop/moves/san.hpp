@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <bitbishop/board.hpp>
+#include <bitbishop/config.hpp>
+#include <bitbishop/move.hpp>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+/**
+ * @namespace San
+ * @brief Standard Algebraic Notation (e.g. "Nbd7", "exd6", "O-O", "e8=Q+"), as found in PGN files.
+ *
+ * Parsing and writing work on views and fixed buffers: no string is allocated per move.
+ */
+namespace San {
+
+/** Longest SAN move, e.g. "Qa1xb2+" or "exd8=Q#". */
+CX_INLINE std::size_t MAX_LENGTH = 7;
+
+/**
+ * @brief SAN text of a move, stored in place.
+ */
+struct Notation {
+  std::array<char, MAX_LENGTH> chars{};
+  std::size_t size = 0;
+
+  [[nodiscard]] std::string_view view() const noexcept { return {chars.data(), size}; }
+};
+
+/**
+ * @brief Finds the legal move of a board written in SAN.
+ *
+ * Check and annotation suffixes ("+", "#", "!", "?") are ignored, castling may be written with letters or zeros,
+ * and promotions with or without "=". Disambiguation follows the piece letter, as a file, a rank or both.
+ *
+ * @return std::nullopt if the text is not SAN, or matches no legal move or several
+ */
+[[nodiscard]] std::optional<Move> parse(const Board& board, std::string_view san);
+
+/**
+ * @brief Writes a legal move of a board in SAN.
+ *
+ * Moves are disambiguated against the other legal moves of the same piece type to the same square: by file when it
+ * is enough, else by rank, else by both. Pawn captures always start with the pawn file. Checks end with "+", mates
+ * with "#".
+ */
+[[nodiscard]] Notation write(const Board& board, const Move& move);
+
+}  // namespace San
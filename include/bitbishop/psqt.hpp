@@ -0,0 +1,455 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bitbishop/config.hpp>
+#include <bitbishop/constants.hpp>
+#include <bitbishop/piece.hpp>
+#include <bitbishop/zobrist.hpp>
+#include <cstdint>
+
+namespace Eval {
+
+using PieceSquareTable = std::array<int, Const::BOARD_SIZE>;
+
+/**
+ * @brief Flips a chess board index with respect to the ranks.
+ * @note Chess board indexes belongs to [0,63].
+ * @param index Chess board index to flip.
+ * @return Horizontally symmetric index.
+ */
+CX_FN std::size_t flip_index_vertically(std::size_t index) {
+  constexpr std::size_t WIDTH = Const::BOARD_WIDTH;
+  constexpr std::size_t SIZE = Const::BOARD_SIZE;
+  return (SIZE - 1) - (index / WIDTH * WIDTH) - ((SIZE - 1 - index) % WIDTH);
+}
+
+/**
+ * @brief Flips a piece square table with respect to the ranks.
+ * @param psqt piece square table to flip.
+ * @return Horizontally symmetric piece square table.
+ */
+CX_FN PieceSquareTable flip_psqt(const PieceSquareTable& psqt) {
+  using namespace Const;
+  PieceSquareTable result;
+  for (std::size_t i = 0; i < BOARD_SIZE; ++i) {
+    result[flip_index_vertically(i)] = psqt[i];
+  }
+  return result;
+}
+
+/**
+ * @brief Midgame and endgame scores packed into a single integer.
+ *
+ * The endgame value lives in the upper 16 bits and the midgame value in the lower 16 bits, so adding or subtracting
+ * two packed scores updates both halves at once. Each half must fit in a signed 16-bit integer.
+ */
+using Score = std::int32_t;
+
+/**
+ * @brief Packs a midgame and an endgame value into a Score.
+ */
+CX_FN Score make_score(int midgame, int endgame) {
+  return static_cast<Score>(static_cast<std::uint32_t>(endgame) << 16) + midgame;  // NOLINT(readability-magic-numbers)
+}
+
+/**
+ * @brief Extracts the midgame value of a packed Score.
+ */
+CX_FN int mg_value(Score score) { return static_cast<std::int16_t>(static_cast<std::uint16_t>(score)); }
+
+/**
+ * @brief Extracts the endgame value of a packed Score.
+ *
+ * The 0x8000 offset compensates the borrow taken from the upper half when the midgame value is negative.
+ */
+CX_FN int eg_value(Score score) {
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  return static_cast<std::int16_t>(static_cast<std::uint16_t>((static_cast<std::uint32_t>(score) + 0x8000U) >> 16));
+}
+
+/**
+ * @brief Material values in centipawns.
+ */
+enum MaterialValue : std::uint16_t { PAWN = 100, KNIGHT = 320, BISHOP = 330, ROOK = 500, QUEEN = 900, KING = 20'000 };
+
+/**
+ * @brief Endgame material values in centipawns.
+ *
+ * Pawns and rooks gain value as the board empties, minor pieces lose some.
+ */
+enum EndgameMaterialValue : std::uint16_t {
+  PAWN_ENDGAME = 120,
+  KNIGHT_ENDGAME = 300,
+  BISHOP_ENDGAME = 320,
+  ROOK_ENDGAME = 530,
+  QUEEN_ENDGAME = 940
+};
+
+/**
+ * @brief Game phase weight of each piece type, indexed by Piece::Type.
+ *
+ * The phase goes from MAX_PHASE (all minor and major pieces on board, midgame) down to 0 (pawns and kings only,
+ * endgame).
+ */
+CX_INLINE std::array<int, Piece::TYPE_COUNT> PHASE_WEIGHTS = {0, 1, 1, 2, 4, 0};
+
+/**
+ * @brief Game phase of the starting position.
+ */
+CX_INLINE int MAX_PHASE = 24;
+
+/**
+ * @brief Linear interpolation between the midgame and endgame values of a score, according to the game phase.
+ *
+ * @param score Packed score to interpolate
+ * @param phase Game phase (see Board::get_phase), clamped to MAX_PHASE
+ * @return Tapered score
+ */
+CX_FN int taper(Score score, int phase) {
+  phase = std::min(phase, MAX_PHASE);
+  return ((mg_value(score) * phase) + (eg_value(score) * (MAX_PHASE - phase))) / MAX_PHASE;
+}
+
+/**
+ * @brief Piece-Square Tables for pawns.
+ *
+ * - Encourage pawn to go forward (increasing value towards opponent)
+ * - Encourage pawns in front of the castling squares (a2, b2, c2, f2, g2, h2) protecting the king
+ * - Discourage central (d2, e2) pawns to stay there, blocking the opening
+ * - Discourage central (d2, e2) pawns moving one square forward, they could control the center with a double push
+ */
+CX_INLINE PieceSquareTable PAWN_PSQT_WHITE = {
+    // clang-format off
+    0,  0,  0,  0,  0,  0,  0,  0,
+    50, 50, 50, 50, 50, 50, 50, 50,
+    10, 10, 20, 30, 30, 20, 10, 10,
+    5,  5, 10, 25, 25, 10,  5,  5,
+    0,  0,  0, 20, 20,  0,  0,  0,
+    5, -5,-10,  0,  0,-10, -5,  5,
+    5, 10, 10,-20,-20, 10, 10,  5,
+    0,  0,  0,  0,  0,  0,  0,  0
+    // clang-format on
+};
+
+CX_INLINE PieceSquareTable PAWN_PSQT_BLACK = flip_psqt(PAWN_PSQT_WHITE);
+
+/**
+ * @brief Piece-Square Tables for knights.
+ *
+ * - Encourage knights to stay at the center, where they controll more squares
+ * - Discourage strongly corners of the board
+ * - Discourage borders of the board
+ */
+CX_INLINE PieceSquareTable KNIGHT_PSQT_WHITE = {
+    // clang-format off
+    -50,-40,-30,-30,-30,-30,-40,-50,
+    -40,-20,  0,  0,  0,  0,-20,-40,
+    -30,  0, 10, 15, 15, 10,  0,-30,
+    -30,  5, 15, 20, 20, 15,  5,-30,
+    -30,  0, 15, 20, 20, 15,  0,-30,
+    -30,  5, 10, 15, 15, 10,  5,-30,
+    -40,-20,  0,  5,  5,  0,-20,-40,
+    -50,-40,-30,-30,-30,-30,-40,-50,
+    // clang-format on
+};
+
+CX_INLINE PieceSquareTable KNIGHT_PSQT_BLACK = flip_psqt(KNIGHT_PSQT_WHITE);
+
+/**
+ * @brief Piece-Square Tables for bishops.
+ *
+ * - Encourage bishops in a triangle shape in front of the side to move
+ * - Discourage strongly edges
+ * - Discourage borders
+ */
+CX_INLINE PieceSquareTable BISHOP_PSQT_WHITE = {
+    // clang-format off
+    -20,-10,-10,-10,-10,-10,-10,-20,
+    -10,  0,  0,  0,  0,  0,  0,-10,
+    -10,  0,  5, 10, 10,  5,  0,-10,
+    -10,  5,  5, 10, 10,  5,  5,-10,
+    -10,  0, 10, 10, 10, 10,  0,-10,
+    -10, 10, 10, 10, 10, 10, 10,-10,
+    -10,  5,  0,  0,  0,  0,  5,-10,
+    -20,-10,-10,-10,-10,-10,-10,-20,
+    // clang-format on
+};
+
+CX_INLINE PieceSquareTable BISHOP_PSQT_BLACK = flip_psqt(BISHOP_PSQT_WHITE);
+
+/**
+ * @brief Piece-Square Tables for rooks.
+ *
+ * - Encourage central rooks
+ * - Encourage rooks near the enemy on rank 7
+ * - Discourage rooks on file A and H
+ */
+CX_INLINE PieceSquareTable ROOK_PSQT_WHITE = {
+    // clang-format off
+    0,  0,  0,  0,  0,  0,  0,  0,
+    5, 10, 10, 10, 10, 10, 10,  5,
+    -5,  0,  0,  0,  0,  0,  0, -5,
+    -5,  0,  0,  0,  0,  0,  0, -5,
+    -5,  0,  0,  0,  0,  0,  0, -5,
+    -5,  0,  0,  0,  0,  0,  0, -5,
+    -5,  0,  0,  0,  0,  0,  0, -5,
+    0,  0,  0,  5,  5,  0,  0,  0
+    // clang-format on
+};
+
+CX_INLINE PieceSquareTable ROOK_PSQT_BLACK = flip_psqt(ROOK_PSQT_WHITE);
+
+/**
+ * @brief Piece-Square Tables for queens.
+ *
+ * - Encourage central positions
+ * - Discourage strongly corners
+ * - Discourage borders
+ */
+CX_INLINE PieceSquareTable QUEEN_PSQT_WHITE = {
+    // clang-format off
+    -20,-10,-10, -5, -5,-10,-10,-20,
+    -10,  0,  0,  0,  0,  0,  0,-10,
+    -10,  0,  5,  5,  5,  5,  0,-10,
+    -5,  0,  5,  5,  5,  5,  0, -5,
+    0,  0,  5,  5,  5,  5,  0, -5,
+    -10,  5,  5,  5,  5,  5,  0,-10,
+    -10,  0,  5,  0,  0,  0,  0,-10,
+    -20,-10,-10, -5, -5,-10,-10,-20
+    // clang-format on
+};
+
+CX_INLINE PieceSquareTable QUEEN_PSQT_BLACK = flip_psqt(QUEEN_PSQT_WHITE);
+
+/**
+ * @brief Piece-Square Tables for kings in the midgame.
+ *
+ * - Encourage king safety on first ranks on the edges (1, 2)
+ * - Discourage king to go out during the midgame
+ */
+CX_INLINE PieceSquareTable KING_MIDGAME_PSQT_WHITE = {
+    // clang-format off
+    -30,-40,-40,-50,-50,-40,-40,-30,
+    -30,-40,-40,-50,-50,-40,-40,-30,
+    -30,-40,-40,-50,-50,-40,-40,-30,
+    -30,-40,-40,-50,-50,-40,-40,-30,
+    -20,-30,-30,-40,-40,-30,-30,-20,
+    -10,-20,-20,-20,-20,-20,-20,-10,
+    20, 20,  0,  0,  0,  0, 20, 20,
+    20, 30, 10,  0,  0, 10, 30, 20
+    // clang-format on
+};
+
+CX_INLINE PieceSquareTable KING_MIDGAME_PSQT_BLACK = flip_psqt(KING_MIDGAME_PSQT_WHITE);
+
+/**
+ * @brief Piece-Square Tables for pawns in the endgame.
+ *
+ * - Encourage strongly pawns to run for promotion
+ */
+CX_INLINE PieceSquareTable PAWN_ENDGAME_PSQT_WHITE = {
+    // clang-format off
+    0,  0,  0,  0,  0,  0,  0,  0,
+    80, 80, 80, 80, 80, 80, 80, 80,
+    50, 50, 50, 50, 50, 50, 50, 50,
+    30, 30, 30, 30, 30, 30, 30, 30,
+    15, 15, 15, 15, 15, 15, 15, 15,
+    5,  5,  5,  5,  5,  5,  5,  5,
+    0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0
+    // clang-format on
+};
+
+CX_INLINE PieceSquareTable PAWN_ENDGAME_PSQT_BLACK = flip_psqt(PAWN_ENDGAME_PSQT_WHITE);
+
+/**
+ * @brief Piece-Square Tables for knights in the endgame.
+ *
+ * - Encourage knights to stay at the center, without preferring a side of the board
+ */
+CX_INLINE PieceSquareTable KNIGHT_ENDGAME_PSQT_WHITE = {
+    // clang-format off
+    -50,-40,-30,-30,-30,-30,-40,-50,
+    -40,-20, -5,  0,  0, -5,-20,-40,
+    -30, -5, 10, 15, 15, 10, -5,-30,
+    -30,  0, 15, 20, 20, 15,  0,-30,
+    -30,  0, 15, 20, 20, 15,  0,-30,
+    -30, -5, 10, 15, 15, 10, -5,-30,
+    -40,-20, -5,  0,  0, -5,-20,-40,
+    -50,-40,-30,-30,-30,-30,-40,-50,
+    // clang-format on
+};
+
+CX_INLINE PieceSquareTable KNIGHT_ENDGAME_PSQT_BLACK = flip_psqt(KNIGHT_ENDGAME_PSQT_WHITE);
+
+/**
+ * @brief Piece-Square Tables for bishops in the endgame.
+ *
+ * - Encourage central bishops, covering both wings
+ * - Discourage edges
+ */
+CX_INLINE PieceSquareTable BISHOP_ENDGAME_PSQT_WHITE = {
+    // clang-format off
+    -20,-10,-10,-10,-10,-10,-10,-20,
+    -10,  0,  0,  0,  0,  0,  0,-10,
+    -10,  0,  5, 10, 10,  5,  0,-10,
+    -10,  0, 10, 15, 15, 10,  0,-10,
+    -10,  0, 10, 15, 15, 10,  0,-10,
+    -10,  0,  5, 10, 10,  5,  0,-10,
+    -10,  0,  0,  0,  0,  0,  0,-10,
+    -20,-10,-10,-10,-10,-10,-10,-20,
+    // clang-format on
+};
+
+CX_INLINE PieceSquareTable BISHOP_ENDGAME_PSQT_BLACK = flip_psqt(BISHOP_ENDGAME_PSQT_WHITE);
+
+/**
+ * @brief Piece-Square Tables for rooks in the endgame.
+ *
+ * - Encourage rooks on the 7th and 8th ranks, cutting off the enemy king and supporting passed pawns
+ */
+CX_INLINE PieceSquareTable ROOK_ENDGAME_PSQT_WHITE = {
+    // clang-format off
+    10, 10, 10, 10, 10, 10, 10, 10,
+    15, 15, 15, 15, 15, 15, 15, 15,
+    0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0
+    // clang-format on
+};
+
+CX_INLINE PieceSquareTable ROOK_ENDGAME_PSQT_BLACK = flip_psqt(ROOK_ENDGAME_PSQT_WHITE);
+
+/**
+ * @brief Piece-Square Tables for queens in the endgame.
+ *
+ * - Encourage central queens
+ * - Discourage corners
+ */
+CX_INLINE PieceSquareTable QUEEN_ENDGAME_PSQT_WHITE = {
+    // clang-format off
+    -20,-10,-10, -5, -5,-10,-10,-20,
+    -10,  0,  5,  5,  5,  5,  0,-10,
+    -10,  5, 10, 10, 10, 10,  5,-10,
+    -5,  5, 10, 15, 15, 10,  5, -5,
+    -5,  5, 10, 15, 15, 10,  5, -5,
+    -10,  5, 10, 10, 10, 10,  5,-10,
+    -10,  0,  5,  5,  5,  5,  0,-10,
+    -20,-10,-10, -5, -5,-10,-10,-20
+    // clang-format on
+};
+
+CX_INLINE PieceSquareTable QUEEN_ENDGAME_PSQT_BLACK = flip_psqt(QUEEN_ENDGAME_PSQT_WHITE);
+
+/**
+ * @brief Piece-Square Tables for kings in the endgame.
+ *
+ * - Encourage king to centralize and take part in the game
+ * - Discourage corners, where the king can be mated
+ */
+CX_INLINE PieceSquareTable KING_ENDGAME_PSQT_WHITE = {
+    // clang-format off
+    -50,-40,-30,-20,-20,-30,-40,-50,
+    -30,-20,-10,  0,  0,-10,-20,-30,
+    -30,-10, 20, 30, 30, 20,-10,-30,
+    -30,-10, 30, 40, 40, 30,-10,-30,
+    -30,-10, 30, 40, 40, 30,-10,-30,
+    -30,-10, 20, 30, 30, 20,-10,-30,
+    -30,-30,  0,  0,  0,  0,-30,-30,
+    -50,-30,-30,-30,-30,-30,-30,-50
+    // clang-format on
+};
+
+CX_INLINE PieceSquareTable KING_ENDGAME_PSQT_BLACK = flip_psqt(KING_ENDGAME_PSQT_WHITE);
+
+/**
+ * @brief Signed packed material + piece-square scores of every (piece, square) pair, indexed by piece and square.
+ *
+ * Rows follow Zobrist::piece_index(), columns follow Square::flat_index() (bitboard ordering, so PSQT indexes are
+ * already flipped). White entries are positive and black entries negative.
+ */
+using PieceSquareScores = std::array<std::array<Score, Const::BOARD_SIZE>, Piece::DISTINCT_PIECES_COUNT>;
+
+/**
+ * @brief Builds the signed packed material + piece-square score table.
+ *
+ * Kings only carry their piece-square scores, their material value cancels out.
+ *
+ * @return Table usable to update a score when a piece is placed on or removed from a square.
+ */
+CX_FN PieceSquareScores generate_piece_square_scores() {
+  using namespace Const;
+
+  PieceSquareScores scores{};
+
+  for (const Color color : {Color::WHITE, Color::BLACK}) {
+    const bool white = color == Color::WHITE;
+    for (const Piece::Type type : Piece::ALL_TYPES) {
+      const PieceSquareTable* mg_psqt = nullptr;
+      const PieceSquareTable* eg_psqt = nullptr;
+      int mg_material = 0;
+      int eg_material = 0;
+      switch (type) {
+        case Piece::PAWN:
+          mg_psqt = white ? &PAWN_PSQT_WHITE : &PAWN_PSQT_BLACK;
+          eg_psqt = white ? &PAWN_ENDGAME_PSQT_WHITE : &PAWN_ENDGAME_PSQT_BLACK;
+          mg_material = PAWN;
+          eg_material = PAWN_ENDGAME;
+          break;
+        case Piece::KNIGHT:
+          mg_psqt = white ? &KNIGHT_PSQT_WHITE : &KNIGHT_PSQT_BLACK;
+          eg_psqt = white ? &KNIGHT_ENDGAME_PSQT_WHITE : &KNIGHT_ENDGAME_PSQT_BLACK;
+          mg_material = KNIGHT;
+          eg_material = KNIGHT_ENDGAME;
+          break;
+        case Piece::BISHOP:
+          mg_psqt = white ? &BISHOP_PSQT_WHITE : &BISHOP_PSQT_BLACK;
+          eg_psqt = white ? &BISHOP_ENDGAME_PSQT_WHITE : &BISHOP_ENDGAME_PSQT_BLACK;
+          mg_material = BISHOP;
+          eg_material = BISHOP_ENDGAME;
+          break;
+        case Piece::ROOK:
+          mg_psqt = white ? &ROOK_PSQT_WHITE : &ROOK_PSQT_BLACK;
+          eg_psqt = white ? &ROOK_ENDGAME_PSQT_WHITE : &ROOK_ENDGAME_PSQT_BLACK;
+          mg_material = ROOK;
+          eg_material = ROOK_ENDGAME;
+          break;
+        case Piece::QUEEN:
+          mg_psqt = white ? &QUEEN_PSQT_WHITE : &QUEEN_PSQT_BLACK;
+          eg_psqt = white ? &QUEEN_ENDGAME_PSQT_WHITE : &QUEEN_ENDGAME_PSQT_BLACK;
+          mg_material = QUEEN;
+          eg_material = QUEEN_ENDGAME;
+          break;
+        default:
+          mg_psqt = white ? &KING_MIDGAME_PSQT_WHITE : &KING_MIDGAME_PSQT_BLACK;
+          eg_psqt = white ? &KING_ENDGAME_PSQT_WHITE : &KING_ENDGAME_PSQT_BLACK;
+          break;
+      }
+
+      const int p_ind = Zobrist::piece_index(Piece(type, color));
+      const int sign = white ? 1 : -1;
+      for (std::size_t sq = 0; sq < BOARD_SIZE; ++sq) {
+        // flip the index so that vector ordering is compatible with bitboard msb ordering
+        const std::size_t index = flip_index_vertically(sq);
+        scores[p_ind][sq] =
+            make_score(sign * (mg_material + (*mg_psqt)[index]), sign * (eg_material + (*eg_psqt)[index]));
+      }
+    }
+  }
+
+  return scores;
+}
+
+/**
+ * @brief Precomputed signed packed material + piece-square scores, used by Board to keep its evaluation score up to
+ * date.
+ *
+ * @see Board::get_psqt_score
+ */
+CX_INLINE PieceSquareScores PIECE_SQUARE_SCORES = generate_piece_square_scores();
+
+}  // namespace Eval
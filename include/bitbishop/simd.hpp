@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Defined when x86 SIMD kernels can be compiled, each kernel being enabled per function with
+ * `__attribute__((target(...)))` and selected at runtime from Simd::detect_level().
+ */
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BITBISHOP_SIMD_X86 1
+#endif
+
+/**
+ * @namespace Simd
+ * @brief Runtime selection of the instruction sets used by vectorised kernels.
+ */
+namespace Simd {
+
+/**
+ * @brief Instruction sets with dedicated kernels, in increasing order.
+ */
+enum class Level : std::uint8_t { Scalar, Sse2, Avx2 };
+
+/**
+ * @brief Returns the best instruction set supported by the running CPU.
+ */
+[[nodiscard]] Level detect_level() noexcept;
+
+/**
+ * @brief Returns a printable name of an instruction set ("scalar", "sse2" or "avx2").
+ */
+[[nodiscard]] const char* level_name(Level level) noexcept;
+
+}  // namespace Simd
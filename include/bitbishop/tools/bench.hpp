@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <bitbishop/config.hpp>
+#include <bitbishop/engine/search.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Tools {
+
+/**
+ * @brief Depth, concurrency and table size of a benchmark run.
+ */
+struct BenchOptions {
+  static CX_VALUE int DEFAULT_DEPTH = 5;
+
+  int depth = DEFAULT_DEPTH;  ///< Deepest iteration of each position
+  unsigned threads = 1;       ///< Positions searched at once
+  std::size_t hash_mb = 0;    ///< Evaluation cache of each thread in MiB, 0 for the default size
+
+  /**
+   * @brief Parses `bench [depth <n>] [threads <n>] [hash <mb>]`, ignoring unknown or invalid tokens.
+   *
+   * Values are clamped to at least 1 (0 for `hash`).
+   */
+  static BenchOptions from_uci_cmd(const std::vector<std::string>& line);
+};
+
+/**
+ * @brief Node counts and search statistics of a benchmark run.
+ */
+struct BenchResult {
+  std::vector<std::uint64_t> position_nodes;  ///< Nodes of each position, 0 for positions not searched
+  Search::SearchStats stats;                  ///< Sums over the searched positions
+  bool complete = false;                      ///< Whether every position was searched to the full depth
+
+  /**
+   * @brief Negamax and quiescence nodes of all positions: the node signature of the search.
+   */
+  [[nodiscard]] std::uint64_t nodes() const noexcept { return stats.negamax_nodes + stats.quiescence_nodes; }
+};
+
+/**
+ * @brief Positions of the benchmark: openings, middlegames with tactics and castling rights, and endgames.
+ */
+[[nodiscard]] std::span<const std::string_view> bench_positions() noexcept;
+
+/**
+ * @brief Searches every benchmark position by iterative deepening up to `options.depth`.
+ *
+ * Each position starts from fresh state: emptied evaluation tables and no game history. The search is
+ * deterministic, so the total node count is a signature of the search and evaluation: it does not depend on the
+ * number of threads or the table size, only on code changes (and on a loaded network or tablebases).
+ *
+ * @param stop_flag Optional flag interrupting the run; the result is then incomplete
+ */
+[[nodiscard]] BenchResult run_bench(const BenchOptions& options, std::atomic<bool>* stop_flag = nullptr);
+
+}  // namespace Tools
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <bitbishop/engine/book.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Tools {
+
+/**
+ * @brief Cutoffs and resources of a book build.
+ */
+struct BookBuilderOptions {
+  static CX_VALUE std::size_t DEFAULT_MEMORY_BYTES = std::size_t{256} << 20;
+
+  int max_ply = 20;                                 ///< Plies of each game added to the book
+  std::uint32_t min_games = 1;                      ///< Games a move must be played in to enter the book
+  unsigned threads = 0;                             ///< Worker threads, 0 for the hardware concurrency
+  std::size_t memory_bytes = DEFAULT_MEMORY_BYTES;  ///< Aggregation memory, shared by the workers
+  std::string temp_directory;                       ///< Directory of the sorted runs, empty for the system one
+};
+
+/**
+ * @brief Figures of one book build.
+ */
+struct BookBuilderStats {
+  std::size_t games = 0;
+  std::size_t rejected_games = 0;  ///< Games stopped at an invalid FEN or move, their earlier moves are kept
+  std::size_t moves = 0;           ///< Game moves added to the statistics
+  std::size_t runs = 0;            ///< Sorted runs spilled to disk
+  std::size_t entries = 0;         ///< Entries of the written book
+  double seconds = 0.0;
+
+  [[nodiscard]] double games_per_second() const noexcept {
+    return seconds > 0.0 ? static_cast<double>(games) / seconds : 0.0;
+  }
+};
+
+/**
+ * @brief Builds Polyglot books from PGN files.
+ *
+ * The input files are memory-mapped and cut into chunks of whole games, shared between worker threads (see
+ * for_each_game). Workers replay the first plies of each game and count, per (position key, move), the games and
+ * the score of the moving side (2 per win, 1 per draw). When a worker's counts outgrow its share of the memory
+ * budget, they are sorted and spilled to a run file, so archives larger than memory only cost disk space. The runs
+ * are then merged: moves played in fewer than `min_games` games or never scoring are dropped, and the scores of each
+ * position are scaled down to 16-bit weights when needed.
+ */
+class BookBuilder {
+ private:
+  BookBuilderOptions m_options;
+
+ public:
+  explicit BookBuilder(BookBuilderOptions options = {});
+
+  /**
+   * @brief Builds a book from PGN files.
+   *
+   * @throw std::runtime_error If an input file cannot be read, or a run or the book cannot be written
+   */
+  BookBuilderStats build(const std::vector<std::string>& pgn_paths, const std::string& book_path) const;
+};
+
+}  // namespace Tools
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <bitbishop/config.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Tools {
+
+/**
+ * @brief Openings, search effort and adjudication of self-play games.
+ *
+ * Scores are in centipawns. Win and draw adjudication both need their condition to hold on consecutive plies.
+ */
+struct DataGenOptions {
+  static CX_VALUE std::uint64_t DEFAULT_SOFT_NODES = 5000;
+
+  std::size_t games = 100;                       ///< Games to play
+  unsigned threads = 0;                          ///< Concurrent games, 0 for the hardware concurrency
+  std::uint64_t soft_nodes = DEFAULT_SOFT_NODES;  ///< Nodes per move, checked after each deepening iteration
+  int max_depth = 10;                            ///< Deepest iteration of a move search
+  int opening_plies = 8;                         ///< Plies played from the book, or at random out of book
+  std::string book_path;                         ///< Polyglot book of the openings, empty for random openings
+  int win_score = 1000;                          ///< Score adjudicating a win...
+  int win_plies = 6;                             ///< ...held for this many plies
+  int draw_score = 10;                           ///< Score adjudicating a draw...
+  int draw_plies = 12;                           ///< ...held for this many plies...
+  int draw_min_ply = 60;                         ///< ...once this ply is reached
+  int max_plies = 400;                           ///< Games reaching this ply are drawn
+  std::uint64_t seed = 0;                        ///< Seed of the openings, 0 for a time-based seed
+  bool deduplicate = false;                      ///< Skip positions already written
+};
+
+/**
+ * @brief Figures of one generation run.
+ */
+struct DataGenStats {
+  std::size_t games = 0;
+  std::size_t white_wins = 0;
+  std::size_t black_wins = 0;
+  std::size_t draws = 0;
+  std::size_t adjudicated = 0;  ///< Games ended by score adjudication or by the ply limit
+  std::size_t positions = 0;    ///< Positions written
+  std::uint64_t nodes = 0;      ///< Negamax and quiescence nodes of all searches
+  double seconds = 0.0;
+
+  [[nodiscard]] double games_per_hour() const noexcept {
+    return seconds > 0.0 ? static_cast<double>(games) * 3600.0 / seconds : 0.0;  // NOLINT(readability-magic-numbers)
+  }
+  [[nodiscard]] double positions_per_second() const noexcept {
+    return seconds > 0.0 ? static_cast<double>(positions) / seconds : 0.0;
+  }
+};
+
+/**
+ * @brief Plays self-play games in parallel and writes their positions as training data.
+ *
+ * Each thread plays one game at a time, with its own evaluation tables and position: threads only share the
+ * opening book (read-only) and the output file, written one whole game at a time. Games open with `opening_plies`
+ * book or random moves, then every move is the best of an iterative deepening search stopped by `soft_nodes` or
+ * `max_depth`. Games end by checkmate, stalemate, repetition, the fifty-move rule, insufficient material or
+ * adjudication.
+ *
+ * Searched positions are written with their score (side to move), best move and the game result, except the
+ * positions that make poor evaluation targets: in check, with a capture or promotion as best move, or with a mate
+ * score. Output records are PackedPosition (see PackedWriter).
+ */
+class DataGenerator {
+ private:
+  DataGenOptions m_options;
+
+ public:
+  explicit DataGenerator(DataGenOptions options = {});
+
+  /**
+   * @brief Plays the games and writes their positions.
+   *
+   * @throw std::runtime_error If the book cannot be opened or the output cannot be written
+   */
+  DataGenStats generate(const std::string& output_path) const;
+};
+
+}  // namespace Tools
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Tools {
+
+/**
+ * @brief Engine running as a child process, driven through its standard input and output.
+ *
+ * Lines are written with a single system call each and read through a buffer refilled as soon as the child writes,
+ * so the time measured around a request is the engine's own time plus a few microseconds of pipe latency. The
+ * child's standard error goes to the null device.
+ *
+ * Child processes need posix_spawn: on other platforms (Windows) the constructor throws.
+ */
+class EngineProcess {
+ private:
+  int m_pid = -1;
+  int m_input = -1;   ///< Write end of the child's standard input
+  int m_output = -1;  ///< Read end of the child's standard output
+  std::string m_buffer;
+  std::size_t m_line_begin = 0;  ///< Start of the unread data in m_buffer
+
+ public:
+  /**
+   * @brief Starts `path` as a child process.
+   *
+   * @throw std::runtime_error If the process cannot be started
+   */
+  explicit EngineProcess(const std::string& path);
+  EngineProcess(const EngineProcess&) = delete;
+  EngineProcess& operator=(const EngineProcess&) = delete;
+
+  /**
+   * @brief Closes the child's input, then kills the child if it has not exited shortly after.
+   */
+  ~EngineProcess();
+
+  /**
+   * @brief Writes `text` followed by a newline; `text` may hold several lines.
+   *
+   * @throw std::runtime_error If the child has exited
+   */
+  void send(std::string_view text);
+
+  /**
+   * @brief Reads the next line, without its line terminator.
+   *
+   * @return The line, valid until the next call; std::nullopt if `deadline` passed first
+   * @throw std::runtime_error If the child has exited
+   */
+  [[nodiscard]] std::optional<std::string_view> read_line(std::chrono::steady_clock::time_point deadline);
+
+  /**
+   * @brief Reads lines until one starts with `prefix`.
+   *
+   * @return The line, valid until the next read; std::nullopt if `deadline` passed first
+   * @throw std::runtime_error If the child has exited
+   */
+  [[nodiscard]] std::optional<std::string_view> wait_for(std::string_view prefix,
+                                                         std::chrono::steady_clock::time_point deadline);
+};
+
+}  // namespace Tools
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <bitbishop/board.hpp>
+#include <bitbishop/move.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Tools {
+
+/**
+ * @brief One position of a test suite and the moves that solve it.
+ */
+struct EpdTest {
+  std::string id;                 ///< `id` operand without quotes, or the line number when missing
+  Board board;                    ///< Position to search, clocks from `hmvc` and `fmvn` when present
+  std::vector<Move> best_moves;   ///< `bm` moves, one of which must be played
+  std::vector<Move> avoid_moves;  ///< `am` moves, none of which may be played
+};
+
+/**
+ * @brief Parses an EPD record with a `bm` or `am` operation (SAN moves, space separated).
+ *
+ * @return std::nullopt if the record is invalid, has an illegal move, or has neither `bm` nor `am`
+ */
+[[nodiscard]] std::optional<EpdTest> parse_epd_test(std::string_view line);
+
+/**
+ * @brief Reads the tests of an EPD file, skipping blank lines.
+ *
+ * @param invalid_lines Incremented for each line parse_epd_test() rejects
+ * @throw std::runtime_error If the file cannot be read
+ */
+[[nodiscard]] std::vector<EpdTest> load_epd_suite(const std::string& path, std::size_t& invalid_lines);
+
+/**
+ * @brief Search budget of each test and number of concurrent searches.
+ *
+ * At least one of `movetime_ms` and `nodes` should be set, otherwise each search runs to `max_depth`.
+ */
+struct EpdSuiteOptions {
+  unsigned threads = 0;                ///< Concurrent searches, 0 for the hardware concurrency
+  std::optional<int> movetime_ms;      ///< Time budget of each search
+  std::optional<std::uint64_t> nodes;  ///< Node budget of each search
+  int max_depth = 64;                  ///< Deepest iteration of each search
+};
+
+/**
+ * @brief Outcome of one test.
+ *
+ * A test is solved when the best move of the last completed iteration solves it. Its solution is found at the first
+ * iteration after which every iteration agreed on a solving move.
+ */
+struct EpdResult {
+  std::string id;
+  std::optional<Move> move;      ///< Best move of the last completed iteration
+  bool solved = false;
+  int depth = 0;                 ///< Depth of the last completed iteration
+  std::uint64_t nodes = 0;       ///< Nodes searched, including the interrupted iteration
+  double seconds = 0.0;          ///< Search time
+  int solve_depth = 0;           ///< Depth at which the solution was found, if solved
+  std::uint64_t solve_nodes = 0;  ///< Nodes searched when the solution was found, if solved
+  double solve_seconds = 0.0;    ///< Time elapsed when the solution was found, if solved
+};
+
+/**
+ * @brief Runs the tests of a suite, several searches at once.
+ *
+ * Each thread takes the next unsolved test, searches it with its own evaluation tables by iterative deepening (see
+ * Search::search_root) until the time or node budget runs out, and records when the solution appeared. Searches are
+ * independent: the suite costs the same CPU time whatever the number of threads, only faster in wall time.
+ *
+ * @return One result per test, in suite order
+ */
+[[nodiscard]] std::vector<EpdResult> run_epd_suite(const std::vector<EpdTest>& tests, const EpdSuiteOptions& options);
+
+/**
+ * @brief Writes the solved count, the time and node distributions of the solutions, and the unsolved tests.
+ */
+void write_epd_report(std::ostream& out, const std::vector<EpdResult>& results, const EpdSuiteOptions& options);
+
+/**
+ * @brief Writes the same summary as write_epd_report() as a JSON object, with one entry per test.
+ */
+void write_epd_json(std::ostream& out, const std::vector<EpdResult>& results, const EpdSuiteOptions& options);
+
+}  // namespace Tools
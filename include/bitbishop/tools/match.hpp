@@ -0,0 +1,184 @@
+#pragma once
+
+#include <bitbishop/tools/pgn.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Tools {
+
+/**
+ * @brief UCI engine taking part in a match.
+ */
+struct MatchEngine {
+  std::string path;                  ///< Executable, started once per concurrent game slot
+  std::string name;                  ///< Name in reports, the executable path when empty
+  std::vector<std::string> options;  ///< `Name=Value` pairs sent with `setoption` after `uci`
+};
+
+/**
+ * @brief Clock of each side, in milliseconds.
+ */
+struct TimeControl {
+  int base_ms = 1000;      ///< Initial time of each side
+  int increment_ms = 10;   ///< Time added after each move
+  int margin_ms = 25;      ///< Overrun tolerated before a loss on time, for pipe and scheduling latency
+};
+
+/**
+ * @brief Sequential probability ratio test between two Elo hypotheses.
+ *
+ * H0 is "the first engine is `elo0` stronger", H1 is "the first engine is `elo1` stronger". The test stops once
+ * the log-likelihood ratio leaves [log(beta / (1 - alpha)), log((1 - beta) / alpha)].
+ */
+struct SprtOptions {
+  double elo0 = 0.0;
+  double elo1 = 5.0;
+  double alpha = 0.05;  ///< Probability of accepting H1 when H0 holds
+  double beta = 0.05;   ///< Probability of accepting H0 when H1 holds
+};
+
+/**
+ * @brief Engines, games, clocks and openings of a match.
+ */
+struct MatchOptions {
+  MatchEngine first;
+  MatchEngine second;
+  std::size_t games = 1000;            ///< Games to play, unless the SPRT stops the match first
+  unsigned concurrency = 0;            ///< Concurrent games, 0 for the hardware concurrency
+  TimeControl time_control;
+  std::vector<std::string> openings;   ///< FEN of the opening positions, the standard position when empty
+  std::optional<SprtOptions> sprt;     ///< Early stop, none to play every game
+  int max_plies = 600;                 ///< Games reaching this ply are drawn
+  std::uint64_t seed = 0;              ///< Seed of the opening order, 0 to keep the order of `openings`
+};
+
+/**
+ * @brief Wins, draws and losses of the first engine.
+ */
+struct MatchScore {
+  std::size_t wins = 0;
+  std::size_t draws = 0;
+  std::size_t losses = 0;
+
+  [[nodiscard]] std::size_t games() const noexcept { return wins + draws + losses; }
+
+  /**
+   * @brief Points per game of the first engine, in [0, 1].
+   */
+  [[nodiscard]] double score() const noexcept {
+    if (games() == 0) {
+      return 0.5;  // NOLINT(readability-magic-numbers)
+    }
+    return (static_cast<double>(wins) + static_cast<double>(draws) / 2.0) / static_cast<double>(games());
+  }
+};
+
+/**
+ * @brief Elo difference of the first engine over the second.
+ */
+struct EloEstimate {
+  double elo = 0.0;
+  double margin = 0.0;  ///< Half width of the 95% confidence interval
+};
+
+/**
+ * @brief Estimates the Elo difference from the score, with the normal approximation of its error.
+ *
+ * Scores of 0 or 1 are clamped just inside, which keeps the estimate finite.
+ */
+[[nodiscard]] EloEstimate estimate_elo(const MatchScore& score);
+
+/**
+ * @brief Log-likelihood ratio of H1 over H0 for the games so far.
+ *
+ * Uses the normal approximation of the generalized SPRT: N (s1 - s0) (2 s - s0 - s1) / (2 var), where s0 and s1 are
+ * the scores expected under each hypothesis (logistic Elo), s the observed score and var its per-game variance.
+ * Each outcome count gets a pseudo-count of half a game, which keeps the variance positive when only one outcome
+ * occurred and stops a handful of games from deciding the test.
+ *
+ * @return 0 before the first game
+ */
+[[nodiscard]] double sprt_llr(const MatchScore& score, const SprtOptions& sprt);
+
+enum class SprtDecision : std::uint8_t { Continue, AcceptH0, AcceptH1 };
+
+/**
+ * @brief Compares a log-likelihood ratio to the bounds of the test.
+ */
+[[nodiscard]] SprtDecision sprt_decision(double llr, const SprtOptions& sprt);
+
+/**
+ * @brief Why a game ended.
+ */
+enum class GameEnd : std::uint8_t {
+  Checkmate,
+  Stalemate,
+  Repetition,
+  FiftyMoves,
+  InsufficientMaterial,
+  MaxPlies,
+  TimeForfeit,
+  IllegalMove,
+  EngineFailure,  ///< The engine exited or stopped answering
+};
+
+[[nodiscard]] std::string_view game_end_name(GameEnd end) noexcept;
+
+/**
+ * @brief One finished game.
+ */
+struct GameRecord {
+  std::size_t game = 0;         ///< Index of the game in the match
+  std::size_t opening = 0;      ///< Index in MatchOptions::openings
+  bool first_is_white = true;
+  GameResult result = GameResult::Draw;
+  GameEnd end = GameEnd::Checkmate;
+  int plies = 0;
+};
+
+/**
+ * @brief Outcome of a match.
+ */
+struct MatchResult {
+  MatchScore score;
+  std::size_t time_forfeits = 0;
+  double llr = 0.0;  ///< Final log-likelihood ratio, when the SPRT is enabled
+  SprtDecision decision = SprtDecision::Continue;
+  double seconds = 0.0;
+};
+
+/**
+ * @brief Reads opening positions, one FEN or EPD record per line, skipping blank lines.
+ *
+ * @param invalid_lines Incremented for each line that is not a valid position
+ * @throw std::runtime_error If the file cannot be read
+ */
+[[nodiscard]] std::vector<std::string> load_openings(const std::string& path, std::size_t& invalid_lines);
+
+/**
+ * @brief Called after each game, in the order the games finish, with the score so far.
+ */
+using GameCallback = std::function<void(const GameRecord& record, const MatchScore& score)>;
+
+/**
+ * @brief Plays a match between two UCI engines, several games at once.
+ *
+ * Each concurrent slot runs its own process of each engine for the whole match, restarted only after a failure,
+ * and plays one game at a time: consecutive games share an opening with colours swapped. Engines search under
+ * `go wtime btime winc binc`; a move is timed from the write of its `go` command to the read of its `bestmove`
+ * line, and an engine that overruns its clock by more than `margin_ms` loses. Games end by the rules (checkmate,
+ * stalemate, threefold repetition, fifty moves, insufficient material), the ply limit, time forfeit, an illegal
+ * move or an engine failure, all scored as chess results.
+ *
+ * With an SPRT, no game starts once the test has decided; the games in progress are still played and counted.
+ *
+ * @throw std::runtime_error If an engine cannot be started or does not answer the UCI handshake
+ */
+MatchResult run_match(const MatchOptions& options, const GameCallback& on_game = {});
+
+}  // namespace Tools
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <bitbishop/board.hpp>
+#include <bitbishop/config.hpp>
+#include <bitbishop/engine/nnue.hpp>
+#include <bitbishop/move.hpp>
+#include <bitbishop/tools/pgn.hpp>
+#include <bitbishop/zobrist.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace Tools {
+
+/**
+ * @brief Position of a training set, with what is known about it.
+ */
+struct TrainingPosition {
+  Board board;
+  std::optional<std::int16_t> score;  ///< Search score in centipawns, from the side to move
+  GameResult result = GameResult::Unknown;
+  std::optional<Move> best_move;
+};
+
+/**
+ * @brief 32-byte record of a TrainingPosition, little-endian.
+ *
+ * | Bytes | Content                                                                                  |
+ * |-------|------------------------------------------------------------------------------------------|
+ * | 0-7   | Occupancy bitboard                                                                       |
+ * | 8-23  | One 4-bit piece per occupied square, in square order, low nibble first: type, +8 if black |
+ * | 24-25 | Bit 0 black to move, bits 1-4 castling rights KQkq, bits 5-8 en passant file + 1 (0 for   |
+ * |       | none), bits 9-15 halfmove clock (at most 127)                                            |
+ * | 26-27 | Fullmove number (at most 65535)                                                          |
+ * | 28-29 | Score, NO_SCORE when unknown                                                             |
+ * | 30-31 | Best move: origin in bits 0-5, destination in bits 6-11 (same as origin when unknown),   |
+ * |       | promotion in bits 12-13 (knight to queen), game result in bits 14-15 (GameResult)        |
+ *
+ * Positions of more than 32 pieces cannot be packed, which only excludes illegal positions.
+ */
+struct PackedPosition {
+  static CX_VALUE std::size_t SIZE = 32;
+  static CX_VALUE std::size_t MAX_PIECES = 32;
+  static CX_VALUE std::int16_t NO_SCORE = INT16_MIN;
+
+  std::array<std::byte, SIZE> bytes{};
+
+  /**
+   * @brief Packs a position; clocks beyond the record range are clamped, a NO_SCORE score is read back as unknown.
+   * @return std::nullopt if the board has more than MAX_PIECES pieces
+   */
+  [[nodiscard]] static std::optional<PackedPosition> pack(const TrainingPosition& position) noexcept;
+
+  /**
+   * @brief Unpacks a position. The best move is not checked for legality.
+   * @return std::nullopt if the record is corrupted (unknown piece, too many pieces)
+   */
+  [[nodiscard]] std::optional<TrainingPosition> unpack() const;
+};
+
+/**
+ * @brief Reads a text line as a training position: a FEN, or an EPD record.
+ *
+ * EPD operations `hmvc`, `fmvn` (clocks), `ce` (score), `bm` (best move in SAN, the first one if several) and `c9`
+ * (result, e.g. `c9 "1-0";`) are read, the others are ignored.
+ *
+ * @return false if the line is neither a FEN nor an EPD record, or its best move is illegal
+ */
+[[nodiscard]] bool parse_training_line(std::string_view line, TrainingPosition& position);
+
+/**
+ * @brief Writes a training position as an EPD record, with its clocks and the known score, best move and result.
+ */
+[[nodiscard]] std::string format_training_line(const TrainingPosition& position);
+
+/**
+ * @brief Appends positions to a file of PackedPosition records, through a write buffer.
+ *
+ * With deduplication, positions whose Zobrist key (pieces, side to move, castling and en passant) was already
+ * written by this writer are skipped.
+ */
+class PackedWriter {
+ public:
+  static CX_VALUE std::size_t DEFAULT_BUFFER_POSITIONS = std::size_t{1} << 14;
+
+ private:
+  std::ofstream m_out;
+  std::string m_path;
+  std::vector<std::byte> m_buffer;
+  std::size_t m_buffer_positions;
+  bool m_deduplicate;
+  std::unordered_set<Zobrist::Key> m_seen;
+  std::size_t m_written = 0;
+  std::size_t m_duplicates = 0;
+  std::size_t m_rejected = 0;
+
+ public:
+  /**
+   * @throw std::runtime_error If the file cannot be created
+   */
+  explicit PackedWriter(const std::string& path, bool deduplicate = false,
+                        std::size_t buffer_positions = DEFAULT_BUFFER_POSITIONS);
+
+  PackedWriter(const PackedWriter&) = delete;
+  PackedWriter& operator=(const PackedWriter&) = delete;
+
+  /** @brief Flushes the buffer, errors are lost: call close() to see them. */
+  ~PackedWriter();
+
+  /**
+   * @brief Adds a position.
+   * @return false if it is skipped, as a duplicate or as a position that cannot be packed
+   * @throw std::runtime_error If the buffer is full and cannot be written
+   */
+  bool write(const TrainingPosition& position);
+
+  /**
+   * @brief Writes the buffered positions to the file.
+   * @throw std::runtime_error On write failure
+   */
+  void flush();
+
+  /**
+   * @brief Flushes and closes the file.
+   * @throw std::runtime_error On write failure
+   */
+  void close();
+
+  [[nodiscard]] std::size_t written() const noexcept { return m_written; }
+  [[nodiscard]] std::size_t duplicates() const noexcept { return m_duplicates; }
+  [[nodiscard]] std::size_t rejected() const noexcept { return m_rejected; }
+};
+
+/**
+ * @brief Random access to a file of PackedPosition records, memory-mapped.
+ */
+class PackedReader {
+ private:
+  std::unique_ptr<Nnue::MappedFile> m_file;
+  bool m_open = false;
+
+ public:
+  /**
+   * @brief Maps a file, replacing the one opened before.
+   * @return false, leaving the reader closed, if the file cannot be mapped or is not a whole number of records
+   */
+  [[nodiscard]] bool open(const std::string& path);
+
+  void close() noexcept;
+
+  [[nodiscard]] bool is_open() const noexcept { return m_open; }
+
+  /** @brief Number of records, 0 when closed. */
+  [[nodiscard]] std::size_t size() const noexcept;
+
+  [[nodiscard]] PackedPosition record(std::size_t index) const noexcept;
+
+  /** @brief Unpacked record, std::nullopt if corrupted. */
+  [[nodiscard]] std::optional<TrainingPosition> position(std::size_t index) const { return record(index).unpack(); }
+};
+
+}  // namespace Tools
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <bitbishop/engine/nnue.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Tools {
+
+/**
+ * @brief Outcome of a game, as given by its PGN result.
+ */
+enum class GameResult : std::uint8_t { WhiteWin, BlackWin, Draw, Unknown };
+
+/**
+ * @brief Main line of one PGN game, viewed in place in the PGN text.
+ *
+ * The views are only valid while the text is (e.g. while its PgnFile is open).
+ */
+struct PgnGame {
+  std::string_view fen;                 ///< `FEN` tag, empty when the game starts from the standard position
+  std::vector<std::string_view> moves;  ///< Moves in SAN, without move numbers, comments or variations
+  GameResult result = GameResult::Unknown;
+
+  void clear();
+};
+
+/**
+ * @brief Splits PGN text into games, without copying.
+ *
+ * Only the `FEN` and `Result` tags are kept. Comments (`{...}`, `;...`), variations, NAGs, escaped lines and move
+ * numbers are skipped. A game ends with its result token, or when the tags of the next game start.
+ */
+class PgnTokenizer {
+ private:
+  std::string_view m_text;
+  std::size_t m_position = 0;
+
+ public:
+  explicit PgnTokenizer(std::string_view text) : m_text(text) {}
+
+  /**
+   * @brief Reads the next game.
+   * @return false when the text holds no more games
+   */
+  [[nodiscard]] bool next(PgnGame& game);
+};
+
+/**
+ * @brief PGN file mapped in memory.
+ */
+class PgnFile {
+ private:
+  Nnue::MappedFile m_file;
+  bool m_open = false;
+
+ public:
+  /**
+   * @return false if the file cannot be read; empty files open as an empty text
+   */
+  [[nodiscard]] bool open(const std::string& path);
+
+  [[nodiscard]] std::string_view text() const noexcept;
+};
+
+/**
+ * @brief Cuts PGN text into about `parts` chunks of whole games.
+ *
+ * Chunks after the first start at a tag line following a blank line, as games are exported, so no game is shared
+ * by two chunks.
+ */
+[[nodiscard]] std::vector<std::string_view> split_games(std::string_view text, std::size_t parts);
+
+/**
+ * @brief Tokenizes chunks of PGN text on worker threads, calling `visit(thread, game)` for each game.
+ *
+ * Threads take whole chunks, the games of a chunk are visited in order. When a visit throws, the remaining chunks
+ * are skipped and the first exception is rethrown once every thread is done.
+ *
+ * @param threads Worker threads, 0 for the hardware concurrency
+ */
+void for_each_game(const std::vector<std::string_view>& chunks, unsigned threads,
+                   const std::function<void(unsigned, const PgnGame&)>& visit);
+
+}  // namespace Tools
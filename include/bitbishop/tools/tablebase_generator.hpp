@@ -0,0 +1,97 @@
+#pragma once
+
+#include <bitbishop/board.hpp>
+#include <bitbishop/engine/tablebase.hpp>
+#include <bitbishop/material.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Tools {
+
+/**
+ * @brief Figures of one generated tablebase.
+ */
+struct TablebaseStats {
+  std::string code;
+  std::size_t positions = 0;  ///< Indexes of the layout, illegal placements included
+  std::size_t wins = 0;       ///< Positions won by the side to move
+  std::size_t draws = 0;
+  std::size_t losses = 0;
+  std::size_t illegal = 0;
+  int longest_mate = 0;  ///< Longest distance to mate, in plies
+  int passes = 0;        ///< Retrograde passes until no position changed
+  double seconds = 0.0;
+};
+
+/**
+ * @brief Retrograde analysis of endgame tablebases, on top of the legal move generator.
+ *
+ * Positions are enumerated through Tablebase::Layout. The first pass marks illegal positions, mates and stalemates;
+ * pass n then marks the positions won in n plies (odd n: a move reaches a position lost in n - 1 plies) or lost in n
+ * plies (even n: every move reaches a position won in at most n - 1 plies). Captures and promotions reach positions
+ * of other material signatures, whose tablebases are generated first. Positions still unknown when two passes in a
+ * row change nothing are draws.
+ *
+ * Each pass splits the positions between worker threads; results are applied between passes, so a pass only ever
+ * reads the results of the previous ones.
+ */
+class TablebaseGenerator {
+ private:
+  struct Table {
+    explicit Table(std::string_view code) : layout(code) {}
+
+    Tablebase::Layout layout;
+    std::vector<std::uint8_t> codes;  ///< DTM byte of each index
+    int longest_mate = 0;
+  };
+
+  unsigned m_threads;
+  std::map<Material::Key, std::unique_ptr<Table>> m_tables;
+  std::vector<TablebaseStats> m_stats;
+  std::size_t m_memory_bytes = 0;
+  std::size_t m_peak_memory_bytes = 0;
+
+  [[nodiscard]] std::optional<std::uint8_t> child_code(const Board& board) const;
+  void resolve(Table& table, int longest_child_mate);
+
+ public:
+  /**
+   * @param threads Worker threads, 0 for the hardware concurrency
+   */
+  explicit TablebaseGenerator(unsigned threads = 0);
+
+  /**
+   * @brief Generates the tablebase of a material code, and first those its captures and promotions lead to.
+   *
+   * Signatures generated earlier, in either color orientation, are reused.
+   *
+   * @throw std::invalid_argument If the code is not a valid tablebase code
+   * @throw std::runtime_error If a mate is longer than Tablebase::MAX_DTM_PLIES
+   */
+  void generate(std::string_view code);
+
+  /**
+   * @brief Writes the WDL and DTM files of every generated tablebase in a directory.
+   * @return false if a file cannot be written
+   */
+  [[nodiscard]] bool write(const std::string& directory) const;
+
+  /**
+   * @brief DTM byte of a position covered by a generated tablebase.
+   */
+  [[nodiscard]] std::optional<std::uint8_t> lookup(const Board& board) const;
+
+  /** @brief Figures of the generated tablebases, in generation order. */
+  [[nodiscard]] const std::vector<TablebaseStats>& stats() const noexcept { return m_stats; }
+
+  /** @brief Largest amount of result memory held at once: tablebases plus pending pass results. */
+  [[nodiscard]] std::size_t peak_memory_bytes() const noexcept { return m_peak_memory_bytes; }
+};
+
+}  // namespace Tools
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <bitbishop/config.hpp>
+#include <bitbishop/engine/eval_terms.hpp>
+#include <bitbishop/tools/packed_position.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Tools {
+
+/**
+ * @brief Labelled positions reduced to what the evaluation tuner reads: term coefficients, phase and result.
+ *
+ * Positions are stored back to back, about 40 bytes each for a middlegame position, instead of whole boards.
+ */
+class TuningSet {
+ private:
+  std::vector<Eval::TermCoefficient> m_coefficients;
+  std::vector<std::uint32_t> m_offsets{0};
+  std::vector<std::uint8_t> m_phases;
+  std::vector<float> m_results;
+  std::size_t m_skipped = 0;
+
+ public:
+  /**
+   * @brief Adds a position, unless it makes a poor tuning target.
+   *
+   * Skipped positions have no game result, a side in check, or material scored by specialised endgame knowledge
+   * (see Eval::find_endgame) rather than by the tuned terms.
+   *
+   * @return true if the position was added
+   */
+  bool add(const TrainingPosition& position);
+
+  /**
+   * @brief Adds the positions of a file: packed records (`.bin`, see PackedWriter) or FEN/EPD lines (see
+   * parse_training_line).
+   *
+   * @throw std::runtime_error If the file cannot be read
+   */
+  void load(const std::string& path);
+
+  [[nodiscard]] std::size_t size() const noexcept { return m_results.size(); }
+
+  /** @brief Positions skipped by add() or load(), including unreadable ones. */
+  [[nodiscard]] std::size_t skipped() const noexcept { return m_skipped; }
+
+  /** @brief Bytes used by the stored positions. */
+  [[nodiscard]] std::size_t memory_bytes() const noexcept;
+
+  [[nodiscard]] std::span<const Eval::TermCoefficient> coefficients(std::size_t index) const noexcept {
+    return {m_coefficients.data() + m_offsets[index], m_coefficients.data() + m_offsets[index + 1]};
+  }
+
+  /** @brief Game phase of a position, clamped to Eval::MAX_PHASE. */
+  [[nodiscard]] int phase(std::size_t index) const noexcept { return m_phases[index]; }
+
+  /** @brief Game result of a position: 1 for a white win, 0.5 for a draw, 0 for a black win. */
+  [[nodiscard]] double result(std::size_t index) const noexcept { return m_results[index]; }
+};
+
+/**
+ * @brief Optimiser settings of a tuning run.
+ */
+struct TunerOptions {
+  static CX_VALUE std::size_t DEFAULT_BATCH_SIZE = 16384;
+
+  unsigned threads = 0;                          ///< Threads evaluating a batch, 0 for the hardware concurrency
+  std::size_t batch_size = DEFAULT_BATCH_SIZE;  ///< Positions per gradient step
+  double learning_rate = 1.0;                    ///< Adam step size, in centipawns
+  double beta1 = 0.9;                            ///< Adam decay of the gradient average
+  double beta2 = 0.999;                          ///< Adam decay of the squared gradient average
+  double k = 0.0;                                ///< Sigmoid scale of the evaluation, 0 to fit it (see Tuner::fit_k)
+};
+
+/**
+ * @brief Texel-style tuner of the hand-crafted evaluation weights.
+ *
+ * Predicts each game result as `1 / (1 + 10^(-k * eval / 400))`, where `eval` is the tapered sum of the position's
+ * term coefficients times the weights (see Eval::extract_terms), and minimises the mean squared error with Adam,
+ * one mini-batch at a time. Midgame and endgame weights are tuned as separate real values, starting from the
+ * current tables.
+ *
+ * Batches are split into one contiguous slice per thread. Each thread sums the gradient of its slice into its own
+ * buffer, the buffers are added up once the batch is done: no lock nor shared write during evaluation.
+ */
+class Tuner {
+ private:
+  const TuningSet& m_set;
+  TunerOptions m_options;
+  std::vector<double> m_weights;  ///< Midgame weight of term i at 2i, endgame weight at 2i+1
+  std::vector<double> m_mean;
+  std::vector<double> m_variance;
+  std::uint64_t m_steps = 0;
+
+ public:
+  /**
+   * @param set Positions to tune on, must outlive the tuner
+   * @param options Optimiser settings, a zero `k` is fitted here
+   */
+  Tuner(const TuningSet& set, TunerOptions options);
+
+  /**
+   * @brief Finds the sigmoid scale minimising the error of the current weights, by golden-section search.
+   */
+  [[nodiscard]] double fit_k() const;
+
+  /** @brief Sigmoid scale in use. */
+  [[nodiscard]] double k() const noexcept { return m_options.k; }
+
+  /**
+   * @brief Mean squared error of the current weights over the whole set.
+   */
+  [[nodiscard]] double error() const;
+
+  /**
+   * @brief Runs one Adam step per batch over the whole set.
+   */
+  void epoch();
+
+  /**
+   * @brief Current weights, rounded to centipawns.
+   */
+  [[nodiscard]] Eval::TermWeights weights() const;
+};
+
+/**
+ * @brief Writes a header defining tuned tables, named after the tables they replace.
+ *
+ * Tables live in the `Eval::Tuned` namespace: MIDGAME_MATERIAL, ENDGAME_MATERIAL, the twelve white piece-square
+ * tables of psqt.hpp and the pawn structure scores of pawn_structure.hpp.
+ *
+ * @param out Stream to write to
+ * @param weights Weights to write
+ * @param comment Line written at the top of the header, after `// `
+ */
+void write_tuned_header(std::ostream& out, const Eval::TermWeights& weights, const std::string& comment);
+
+}  // namespace Tools
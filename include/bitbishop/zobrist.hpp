@@ -6,6 +6,7 @@
 #include <bitbishop/piece.hpp>
 #include <bitbishop/random.hpp>
 #include <bitbishop/square.hpp>
+#include <cstddef>
 #include <cstdint>
 
 // bitbishop/board.hpp uses Zobrist features and the current Zobrist implementation also uses Board & BoardState.
@@ -107,6 +108,52 @@ CX_FN Tables generate() {
  */
 CX_INLINE Tables tables = generate();
 
+/**
+ * Fixed seed of the Polyglot key table (see PolyglotTables). Do not change this value.
+ */
+CX_INLINE uint64_t POLYGLOT_SEED = 0x5eed0b00c5eed0b0ULL;
+
+/**
+ * @brief Random64 key table of Polyglot opening books, kept apart from Tables.
+ *
+ * Polyglot keys hash the same position features as the engine keys, but with their own layout of 781 values:
+ *
+ *  - [0, 768): pieces, at 64 * kind + square, kind being 2 * type + 1 for white pieces and 2 * type for black ones
+ *    (black pawn 0, white pawn 1, ..., white king 11);
+ *  - [768, 772): white kingside, white queenside, black kingside, black queenside castling rights;
+ *  - [772, 780): en passant file, only hashed when a pawn of the side to move can capture en passant;
+ *  - 780: white to move.
+ *
+ * The values are generated from POLYGLOT_SEED, so books hashed with this table (see Book) are always read back
+ * consistently. Reading third-party books requires the published Polyglot Random64 values in place of generate().
+ */
+struct PolyglotTables {
+  static CX_VALUE std::size_t PIECES_OFFSET = 0;
+  static CX_VALUE std::size_t CASTLING_OFFSET = 768;
+  static CX_VALUE std::size_t EN_PASSANT_OFFSET = 772;
+  static CX_VALUE std::size_t TURN_OFFSET = 780;
+  static CX_VALUE std::size_t SIZE = 781;
+
+  std::array<Key, SIZE> random64{};
+
+  /**
+   * @brief Fills the Random64 values with splitmix64, seeded with POLYGLOT_SEED.
+   */
+  static CX_FN PolyglotTables generate() {
+    PolyglotTables polyglot_tbl{};
+    uint64_t seed = POLYGLOT_SEED;
+    for (Key& value : polyglot_tbl.random64) {
+      value = Random::splitmix64(seed);
+    }
+    return polyglot_tbl;
+  }
+};
+
+/**
+ * @brief Global Polyglot key table, shared by the book reader and writer.
+ */
+CX_INLINE PolyglotTables polyglot_tables = PolyglotTables::generate();
+
 /**
  * @brief Converts a Piece to its Zobrist table index.
  *
@@ -274,4 +321,23 @@ void mutate_en_passant_square(Square epsq, Zobrist::Key& key);
  */
 Zobrist::Key compute_hash(const Board& board);
 
+/**
+ * @brief Computes the pawn-only Zobrist hash of a board from scratch.
+ *
+ * Only pawn placement is hashed (no side to move, castling or en passant), so positions sharing the same pawn
+ * structure share the same key. Used to index pawn structure caches.
+ *
+ * @param board Board position to hash.
+ * @return Zobrist hash key representing the pawn structure.
+ */
+Zobrist::Key compute_pawn_hash(const Board& board);
+
+/**
+ * @brief Computes the Polyglot opening book key of a board position (see PolyglotTables).
+ *
+ * @param board Board position to hash.
+ * @return Polyglot key of the position.
+ */
+Zobrist::Key compute_polyglot_key(const Board& board);
+
 }  // namespace Zobrist
@@ -1,15 +1,34 @@
+#include <bitbishop/interface/search_session.hpp>
 #include <bitbishop/interface/uci_engine.hpp>
+#include <chrono>
 #include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
 
 /**
- * @brief Launch the UCI engine loop.
+ * @brief Launch the UCI engine loop, or run the benchmark suite.
  *
  * Constructs a UCI engine bound to `std::cin`/`std::cout` and runs its
  * main command-processing loop until termination.
  *
+ * `bitbishop bench [depth N] [threads N] [hash MB]` instead runs the benchmark suite, as the UCI `bench` command
+ * does, prints its node signature and exits.
+ *
  * @return Exit code (0 on normal termination).
  */
-int main() {
+int main(int argc, char* argv[]) {
+  const std::vector<std::string> args(argv + 1, argv + argc);
+  if (!args.empty() && args.front() == "bench") {
+    Uci::SearchSession session(std::cout);
+    session.start_bench(Tools::BenchOptions::from_uci_cmd(args));
+    while (!session.is_idle()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      session.poll();
+    }
+    return 0;
+  }
+
   Uci::UciEngine engine(std::cin, std::cout);
   engine.loop();
   return 0;
@@ -0,0 +1,75 @@
+#include <bitbishop/tools/book_builder.hpp>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+void print_usage() {
+  std::cerr << "usage: bitbishop-book [--threads N] [--depth PLIES] [--min-games N] [--memory MIB] [--temp DIR] "
+               "--output FILE PGN...\n";
+}
+
+}  // namespace
+
+/**
+ * @brief Builds a Polyglot opening book from PGN files.
+ *
+ * Usage: bitbishop-book [--threads N] [--depth PLIES] [--min-games N] [--memory MIB] [--temp DIR] --output FILE PGN...
+ *
+ * The first `--depth` plies (default 20) of every game are counted, moves played in fewer than `--min-games` games
+ * (default 1) are left out. Counts larger than `--memory` MiB (default 256) are spilled as sorted runs to `--temp`
+ * (default: system temporary directory) and merged at the end. The book is ready for the engine `BookFile` option.
+ *
+ * @return Exit code (0 on success, 1 on invalid arguments or I/O failure).
+ */
+int main(int argc, char* argv[]) {
+  Tools::BookBuilderOptions options;
+  std::string output;
+  std::vector<std::string> inputs;
+
+  const std::vector<std::string> args(argv + 1, argv + argc);
+  try {
+    for (std::size_t i = 0; i < args.size(); ++i) {
+      const bool has_value = i + 1 < args.size();
+      if (args[i] == "--threads" && has_value) {
+        options.threads = static_cast<unsigned>(std::stoul(args[++i]));
+      } else if (args[i] == "--depth" && has_value) {
+        options.max_ply = std::stoi(args[++i]);
+      } else if (args[i] == "--min-games" && has_value) {
+        options.min_games = static_cast<std::uint32_t>(std::stoul(args[++i]));
+      } else if (args[i] == "--memory" && has_value) {
+        options.memory_bytes = std::stoull(args[++i]) << 20;
+      } else if (args[i] == "--temp" && has_value) {
+        options.temp_directory = args[++i];
+      } else if (args[i] == "--output" && has_value) {
+        output = args[++i];
+      } else {
+        inputs.push_back(args[i]);
+      }
+    }
+  } catch (const std::exception&) {
+    print_usage();
+    return 1;
+  }
+  if (output.empty() || inputs.empty()) {
+    print_usage();
+    return 1;
+  }
+
+  Tools::BookBuilderStats stats;
+  try {
+    stats = Tools::BookBuilder(options).build(inputs, output);
+  } catch (const std::exception& error) {
+    std::cerr << "error: " << error.what() << "\n";
+    return 1;
+  }
+
+  std::cout << "games " << stats.games << " (" << stats.rejected_games << " rejected), moves " << stats.moves
+            << ", runs " << stats.runs << ", entries " << stats.entries << "\n"
+            << "time " << std::fixed << std::setprecision(2) << stats.seconds << "s, " << std::setprecision(0)
+            << stats.games_per_second() << " games/s\n";
+  return 0;
+}
@@ -0,0 +1,83 @@
+#include <bitbishop/tools/datagen.hpp>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+void print_usage() {
+  std::cerr << "usage: bitbishop-datagen [--threads N] [--games N] [--nodes N] [--depth N] [--opening-plies N] "
+               "[--book FILE] [--seed N] [--dedupe] --output FILE\n";
+}
+
+}  // namespace
+
+/**
+ * @brief Generates training positions from self-play games, played in parallel in this process.
+ *
+ * Usage: bitbishop-datagen [--threads N] [--games N] [--nodes N] [--depth N] [--opening-plies N] [--book FILE]
+ * [--seed N] [--dedupe] --output FILE
+ *
+ * Every thread plays one game at a time. Games open with `--opening-plies` (default 8) book moves from `--book`, or
+ * random moves, then search each move for about `--nodes` nodes (default 5000) and at most `--depth` plies (default
+ * 10). Positions are written as packed records (see Tools::PackedPosition): convert them with bitbishop-pack.
+ *
+ * @return Exit code (0 on success, 1 on invalid arguments or I/O failure).
+ */
+int main(int argc, char* argv[]) {
+  Tools::DataGenOptions options;
+  std::string output;
+
+  const std::vector<std::string> args(argv + 1, argv + argc);
+  try {
+    for (std::size_t i = 0; i < args.size(); ++i) {
+      const bool has_value = i + 1 < args.size();
+      if (args[i] == "--threads" && has_value) {
+        options.threads = static_cast<unsigned>(std::stoul(args[++i]));
+      } else if (args[i] == "--games" && has_value) {
+        options.games = std::stoull(args[++i]);
+      } else if (args[i] == "--nodes" && has_value) {
+        options.soft_nodes = std::stoull(args[++i]);
+      } else if (args[i] == "--depth" && has_value) {
+        options.max_depth = std::stoi(args[++i]);
+      } else if (args[i] == "--opening-plies" && has_value) {
+        options.opening_plies = std::stoi(args[++i]);
+      } else if (args[i] == "--book" && has_value) {
+        options.book_path = args[++i];
+      } else if (args[i] == "--seed" && has_value) {
+        options.seed = std::stoull(args[++i]);
+      } else if (args[i] == "--dedupe") {
+        options.deduplicate = true;
+      } else if (args[i] == "--output" && has_value) {
+        output = args[++i];
+      } else {
+        print_usage();
+        return 1;
+      }
+    }
+  } catch (const std::exception&) {
+    print_usage();
+    return 1;
+  }
+  if (output.empty()) {
+    print_usage();
+    return 1;
+  }
+
+  Tools::DataGenStats stats;
+  try {
+    stats = Tools::DataGenerator(options).generate(output);
+  } catch (const std::exception& error) {
+    std::cerr << "error: " << error.what() << "\n";
+    return 1;
+  }
+
+  std::cout << "games " << stats.games << " (+" << stats.white_wins << " -" << stats.black_wins << " =" << stats.draws
+            << ", " << stats.adjudicated << " adjudicated), positions " << stats.positions << ", nodes " << stats.nodes
+            << "\n"
+            << "time " << std::fixed << std::setprecision(2) << stats.seconds << "s, " << std::setprecision(0)
+            << stats.games_per_hour() << " games/hour, " << stats.positions_per_second() << " positions/s\n";
+  return 0;
+}
@@ -0,0 +1,98 @@
+#include <bitbishop/board.hpp>
+#include <bitbishop/config.hpp>
+#include <bitbishop/engine/evaluation.hpp>
+#include <bitbishop/movegen/legal_moves.hpp>
+#include <bitbishop/moves/position.hpp>
+#include <bitbishop/random.hpp>
+#include <bitbishop/simd.hpp>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Boards reached by random games from each start position: varied enough for branch predictors not to learn them
+CX_INLINE std::size_t BOARDS_PER_FEN = 256;
+CX_INLINE int MAX_PLIES = 60;
+
+const std::vector<std::string> FENS = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r1bq1rk1/pp2bppp/2n2n2/2pp4/3P4/2PBPN2/PP1N1PPP/R2QK2R w KQ - 0 8",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+};
+
+std::vector<Board> sample_boards() {
+  std::vector<Board> boards;
+  boards.reserve(FENS.size() * BOARDS_PER_FEN);
+  std::uint64_t seed = 1;
+
+  for (const std::string& fen : FENS) {
+    for (std::size_t i = 0; i < BOARDS_PER_FEN; ++i) {
+      Board board(fen);
+      Position position(board);
+      const auto plies = static_cast<int>(Random::splitmix64(seed) % MAX_PLIES);
+      std::vector<Move> moves;
+      for (int ply = 0; ply < plies; ++ply) {
+        moves.clear();
+        generate_legal_moves(moves, board);
+        if (moves.empty()) {
+          break;
+        }
+        position.apply_move(moves[Random::splitmix64(seed) % moves.size()]);
+      }
+      boards.push_back(board);
+    }
+  }
+  return boards;
+}
+
+/**
+ * Runs `kernel` over all boards `iterations` times, printing the average time per board.
+ */
+template <typename Kernel>
+void run(const std::string& name, const std::vector<Board>& boards, std::size_t iterations, Kernel kernel) {
+  std::int64_t checksum = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < iterations; ++i) {
+    for (const Board& board : boards) {
+      checksum += kernel(board);
+    }
+  }
+  const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+  std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(2) << std::setw(10)
+            << elapsed / static_cast<double>(iterations * boards.size()) << " ns/board  (checksum " << checksum
+            << ")\n";
+}
+
+}  // namespace
+
+/**
+ * @brief Microbenchmark of the full (non-incremental) material and piece-square evaluation kernels.
+ *
+ * Usage: bitbishop-evalbench [iterations], each iteration evaluating 1024 boards sampled from random games.
+ *
+ * @return Exit code (0 on normal termination).
+ */
+int main(int argc, char* argv[]) {
+  const std::size_t iterations = argc > 1 ? std::stoul(argv[1]) : 1'000;
+  const std::vector<Board> boards = sample_boards();
+
+  run("evaluate_psqt (legacy)", boards, iterations, [](const Board& board) {
+    return Eval::evaluate_material(board, Color::WHITE) + Eval::evaluate_psqt(board, Color::WHITE) -
+           Eval::evaluate_material(board, Color::BLACK) - Eval::evaluate_psqt(board, Color::BLACK);
+  });
+  run("kernel scalar", boards, iterations,
+      [](const Board& board) { return Eval::compute_psqt_score(board, Simd::Level::Scalar); });
+  if (Simd::detect_level() == Simd::Level::Avx2) {
+    run("kernel avx2", boards, iterations,
+        [](const Board& board) { return Eval::compute_psqt_score(board, Simd::Level::Avx2); });
+  }
+  run("incremental (Board)", boards, iterations, [](const Board& board) { return board.get_psqt_score(); });
+
+  return 0;
+}
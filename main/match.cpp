@@ -0,0 +1,163 @@
+#include <bitbishop/tools/match.hpp>
+#include <cmath>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+void print_usage() {
+  std::cerr << "usage: bitbishop-match [--games N] [--concurrency N] [--tc BASE+INC] [--margin MS] [--openings FILE] "
+               "[--seed N] [--sprt ELO0 ELO1] [--alpha A] [--beta B] [--max-plies N] [--option1 NAME=VALUE] "
+               "[--option2 NAME=VALUE] ENGINE1 ENGINE2\n";
+}
+
+/**
+ * Parses a "BASE+INC" time control in seconds, e.g. "1+0.01"; throws std::invalid_argument if malformed.
+ */
+Tools::TimeControl parse_time_control(const std::string& text) {
+  CX_CONST double MS_PER_SECOND = 1000.0;
+  const std::size_t plus = text.find('+');
+  Tools::TimeControl control;
+  control.base_ms = static_cast<int>(std::lround(std::stod(text.substr(0, plus)) * MS_PER_SECOND));
+  control.increment_ms =
+      plus == std::string::npos ? 0 : static_cast<int>(std::lround(std::stod(text.substr(plus + 1)) * MS_PER_SECOND));
+  if (control.base_ms <= 0 || control.increment_ms < 0) {
+    throw std::invalid_argument("invalid time control " + text);
+  }
+  return control;
+}
+
+std::string_view sprt_decision_name(Tools::SprtDecision decision) {
+  // clang-format off
+  switch (decision) {
+    case Tools::SprtDecision::AcceptH0: return "H0 accepted";
+    case Tools::SprtDecision::AcceptH1: return "H1 accepted";
+    default:                            return "undecided";
+  }
+  // clang-format on
+}
+
+void print_score(const Tools::MatchScore& score) {
+  const Tools::EloEstimate elo = Tools::estimate_elo(score);
+  std::cout << "+" << score.wins << " =" << score.draws << " -" << score.losses << ", elo " << std::fixed
+            << std::setprecision(1) << elo.elo << " +/- " << elo.margin;
+}
+
+}  // namespace
+
+/**
+ * @brief Plays a match between two UCI engines over pipes, several games at once, with an optional SPRT.
+ *
+ * Usage: bitbishop-match [--games N] [--concurrency N] [--tc BASE+INC] [--margin MS] [--openings FILE] [--seed N]
+ *        [--sprt ELO0 ELO1] [--alpha A] [--beta B] [--max-plies N] [--option1 NAME=VALUE] [--option2 NAME=VALUE]
+ *        ENGINE1 ENGINE2
+ *
+ * ENGINE1 and ENGINE2 are executables speaking UCI, e.g. two builds of bitbishop. The time control is in seconds
+ * (default 1+0.01); `--margin` is the overrun in milliseconds tolerated before a loss on time. Openings are FEN or
+ * EPD lines, each played twice with colours swapped, shuffled when a seed is given. Prints one line per game with
+ * the running score and Elo difference of ENGINE1; with `--sprt`, the match stops once the test decides.
+ *
+ * @return Exit code (0 on success, 1 on invalid arguments, I/O or engine start failure).
+ */
+int main(int argc, char* argv[]) {
+  Tools::MatchOptions options;
+  std::string openings_path;
+  std::vector<std::string> engines;
+
+  const std::vector<std::string> args(argv + 1, argv + argc);
+  try {
+    for (std::size_t i = 0; i < args.size(); ++i) {
+      const bool has_value = i + 1 < args.size();
+      if (args[i] == "--games" && has_value) {
+        options.games = std::stoul(args[++i]);
+      } else if (args[i] == "--concurrency" && has_value) {
+        options.concurrency = static_cast<unsigned>(std::stoul(args[++i]));
+      } else if (args[i] == "--tc" && has_value) {
+        const int margin_ms = options.time_control.margin_ms;
+        options.time_control = parse_time_control(args[++i]);
+        options.time_control.margin_ms = margin_ms;
+      } else if (args[i] == "--margin" && has_value) {
+        options.time_control.margin_ms = std::stoi(args[++i]);
+      } else if (args[i] == "--openings" && has_value) {
+        openings_path = args[++i];
+      } else if (args[i] == "--seed" && has_value) {
+        options.seed = std::stoull(args[++i]);
+      } else if (args[i] == "--sprt" && i + 2 < args.size()) {
+        options.sprt = options.sprt.value_or(Tools::SprtOptions{});
+        options.sprt->elo0 = std::stod(args[++i]);
+        options.sprt->elo1 = std::stod(args[++i]);
+      } else if (args[i] == "--alpha" && has_value) {
+        options.sprt = options.sprt.value_or(Tools::SprtOptions{});
+        options.sprt->alpha = std::stod(args[++i]);
+      } else if (args[i] == "--beta" && has_value) {
+        options.sprt = options.sprt.value_or(Tools::SprtOptions{});
+        options.sprt->beta = std::stod(args[++i]);
+      } else if (args[i] == "--max-plies" && has_value) {
+        options.max_plies = std::stoi(args[++i]);
+      } else if (args[i] == "--option1" && has_value) {
+        options.first.options.push_back(args[++i]);
+      } else if (args[i] == "--option2" && has_value) {
+        options.second.options.push_back(args[++i]);
+      } else {
+        engines.push_back(args[i]);
+      }
+    }
+  } catch (const std::exception&) {
+    print_usage();
+    return 1;
+  }
+  if (engines.size() != 2) {
+    print_usage();
+    return 1;
+  }
+  options.first.path = engines[0];
+  options.second.path = engines[1];
+
+  try {
+    if (!openings_path.empty()) {
+      std::size_t invalid_lines = 0;
+      options.openings = Tools::load_openings(openings_path, invalid_lines);
+      if (invalid_lines > 0) {
+        std::cerr << "skipped " << invalid_lines << " invalid lines\n";
+      }
+    }
+
+    const Tools::MatchResult result = Tools::run_match(options, [&](const Tools::GameRecord& record,
+                                                                    const Tools::MatchScore& score) {
+      // clang-format off
+      std::string_view result_text = "1/2-1/2";
+      switch (record.result) {
+        case Tools::GameResult::WhiteWin: result_text = "1-0"; break;
+        case Tools::GameResult::BlackWin: result_text = "0-1"; break;
+        default:                                               break;
+      }
+      // clang-format on
+      std::cout << "game " << score.games() << "/" << options.games << ": "
+                << (record.first_is_white ? "ENGINE1-ENGINE2 " : "ENGINE2-ENGINE1 ") << result_text << " ("
+                << Tools::game_end_name(record.end) << ", " << record.plies << " plies), ";
+      print_score(score);
+      if (options.sprt) {
+        std::cout << ", llr " << std::setprecision(2) << Tools::sprt_llr(score, *options.sprt);
+      }
+      std::cout << "\n";
+    });
+
+    std::cout << "score ";
+    print_score(result.score);
+    std::cout << ", " << result.time_forfeits << " time forfeits, " << std::setprecision(1) << result.seconds
+              << "s\n";
+    if (options.sprt) {
+      const Tools::SprtOptions& sprt = *options.sprt;
+      std::cout << "sprt elo0 " << sprt.elo0 << " elo1 " << sprt.elo1 << ": llr " << std::setprecision(2)
+                << result.llr << " [" << std::log(sprt.beta / (1.0 - sprt.alpha)) << ", "
+                << std::log((1.0 - sprt.beta) / sprt.alpha) << "], " << sprt_decision_name(result.decision) << "\n";
+    }
+  } catch (const std::exception& error) {
+    std::cerr << "error: " << error.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,137 @@
+#include <bitbishop/tools/packed_position.hpp>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+void print_usage() {
+  std::cerr << "usage: bitbishop-pack [--dedupe] --output FILE.bin TEXT...\n"
+               "       bitbishop-pack --decode --output FILE.epd BINARY...\n";
+}
+
+struct Counts {
+  std::size_t positions = 0;
+  std::size_t duplicates = 0;
+  std::size_t rejected = 0;
+};
+
+/**
+ * Packs the FEN or EPD lines of text files.
+ */
+Counts encode(const std::vector<std::string>& inputs, const std::string& output, bool deduplicate) {
+  Tools::PackedWriter writer(output, deduplicate);
+  Tools::TrainingPosition position;
+  std::size_t invalid_lines = 0;
+  for (const std::string& input : inputs) {
+    std::ifstream in(input);
+    if (!in) {
+      throw std::runtime_error("cannot read " + input);
+    }
+    for (std::string line; std::getline(in, line);) {
+      if (line.find_first_not_of(" \t\r") == std::string::npos) {
+        continue;
+      }
+      if (!Tools::parse_training_line(line, position)) {
+        ++invalid_lines;
+        continue;
+      }
+      writer.write(position);
+    }
+  }
+  writer.close();
+  return {.positions = writer.written(),
+          .duplicates = writer.duplicates(),
+          .rejected = writer.rejected() + invalid_lines};
+}
+
+/**
+ * Writes packed positions back as EPD lines.
+ */
+Counts decode(const std::vector<std::string>& inputs, const std::string& output) {
+  std::ofstream out(output);
+  if (!out) {
+    throw std::runtime_error("cannot create " + output);
+  }
+  Counts counts;
+  Tools::PackedReader reader;
+  for (const std::string& input : inputs) {
+    if (!reader.open(input)) {
+      throw std::runtime_error("cannot read " + input);
+    }
+    for (std::size_t index = 0; index < reader.size(); ++index) {
+      if (const std::optional<Tools::TrainingPosition> position = reader.position(index)) {
+        out << Tools::format_training_line(*position) << "\n";
+        ++counts.positions;
+      } else {
+        ++counts.rejected;
+      }
+    }
+  }
+  out.close();
+  if (!out) {
+    throw std::runtime_error("cannot write " + output);
+  }
+  return counts;
+}
+
+}  // namespace
+
+/**
+ * @brief Converts training positions between text (FEN or EPD lines) and packed 32-byte records.
+ *
+ * Usage:
+ * - bitbishop-pack [--dedupe] --output FILE.bin TEXT...
+ * - bitbishop-pack --decode --output FILE.epd BINARY...
+ *
+ * Text lines are FENs or EPD records with optional `ce` (score), `bm` (best move) and `c9` (result) operations, see
+ * Tools::parse_training_line. With `--dedupe`, positions seen before are skipped. Decoding writes EPD records.
+ *
+ * @return Exit code (0 on success, 1 on invalid arguments or I/O failure).
+ */
+int main(int argc, char* argv[]) {
+  bool decoding = false;
+  bool deduplicate = false;
+  std::string output;
+  std::vector<std::string> inputs;
+
+  const std::vector<std::string> args(argv + 1, argv + argc);
+  for (std::size_t i = 0; i < args.size(); ++i) {
+    if (args[i] == "--decode") {
+      decoding = true;
+    } else if (args[i] == "--dedupe") {
+      deduplicate = true;
+    } else if (args[i] == "--output" && i + 1 < args.size()) {
+      output = args[++i];
+    } else {
+      inputs.push_back(args[i]);
+    }
+  }
+  if (output.empty() || inputs.empty() || (decoding && deduplicate)) {
+    print_usage();
+    return 1;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  Counts counts;
+  try {
+    counts = decoding ? decode(inputs, output) : encode(inputs, output, deduplicate);
+  } catch (const std::exception& error) {
+    std::cerr << "error: " << error.what() << "\n";
+    return 1;
+  }
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  const std::size_t read = counts.positions + counts.duplicates + counts.rejected;
+  std::cout << "positions " << counts.positions << " (" << counts.duplicates << " duplicates, " << counts.rejected
+            << " rejected)\n"
+            << "time " << std::fixed << std::setprecision(2) << seconds << "s, " << std::setprecision(0)
+            << (seconds > 0.0 ? static_cast<double>(read) / seconds : 0.0) << " positions/s read\n";
+  return 0;
+}
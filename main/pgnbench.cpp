@@ -0,0 +1,137 @@
+#include <bitbishop/moves/position.hpp>
+#include <bitbishop/moves/san.hpp>
+#include <bitbishop/tools/pgn.hpp>
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+CX_CONST std::size_t CHUNKS_PER_THREAD = 8;
+
+void print_usage() { std::cerr << "usage: bitbishop-pgnbench [--threads N] [--replay] PGN...\n"; }
+
+double megabytes(std::size_t bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); }
+
+/**
+ * Per-thread counters, padded so threads do not share cache lines.
+ */
+struct alignas(64) Counters {
+  std::size_t games = 0;
+  std::size_t moves = 0;
+  std::size_t invalid_games = 0;
+};
+
+/**
+ * Parses every move of a game with San::parse and checks that San::write gives it back.
+ * @return false at the first invalid move, or FEN
+ */
+bool replay(const Tools::PgnGame& game) {
+  Board board = Board::StartingPosition();
+  if (!game.fen.empty()) {
+    try {
+      board = Board(std::string(game.fen));
+    } catch (const std::exception&) {
+      return false;
+    }
+  }
+  Position position(board);
+  for (const std::string_view san : game.moves) {
+    const std::optional<Move> move = San::parse(board, san);
+    if (!move) {
+      return false;
+    }
+    const std::optional<Move> written = San::parse(board, San::write(board, *move).view());
+    if (!written || written->from != move->from || written->to != move->to || written->promotion != move->promotion) {
+      return false;
+    }
+    position.apply_move(*move);
+  }
+  return true;
+}
+
+}  // namespace
+
+/**
+ * @brief Measures PGN reading throughput.
+ *
+ * Usage: bitbishop-pgnbench [--threads N] [--replay] PGN...
+ *
+ * The files are memory-mapped, cut into chunks of whole games and tokenized on N threads (default: hardware
+ * concurrency). With `--replay`, every move is also parsed from SAN, written back and played, as data pipelines do.
+ * Games, moves, MiB/s and games/s are reported.
+ *
+ * @return Exit code (0 on success, 1 on invalid arguments or unreadable file).
+ */
+int main(int argc, char* argv[]) {
+  unsigned threads = 0;
+  bool with_replay = false;
+  std::vector<std::string> paths;
+
+  const std::vector<std::string> args(argv + 1, argv + argc);
+  for (std::size_t i = 0; i < args.size(); ++i) {
+    if (args[i] == "--threads" && i + 1 < args.size()) {
+      threads = static_cast<unsigned>(std::stoul(args[++i]));
+    } else if (args[i] == "--replay") {
+      with_replay = true;
+    } else {
+      paths.push_back(args[i]);
+    }
+  }
+  if (paths.empty()) {
+    print_usage();
+    return 1;
+  }
+  if (threads == 0) {
+    threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::unique_ptr<Tools::PgnFile>> files;
+  std::vector<std::string_view> chunks;
+  std::size_t bytes = 0;
+  for (const std::string& path : paths) {
+    files.push_back(std::make_unique<Tools::PgnFile>());
+    if (!files.back()->open(path)) {
+      std::cerr << "error: cannot read " << path << "\n";
+      return 1;
+    }
+    bytes += files.back()->text().size();
+    for (const std::string_view chunk : Tools::split_games(files.back()->text(), CHUNKS_PER_THREAD * threads)) {
+      chunks.push_back(chunk);
+    }
+  }
+
+  std::vector<Counters> counters(threads);
+  Tools::for_each_game(chunks, threads, [&](unsigned thread, const Tools::PgnGame& game) {
+    Counters& counted = counters[thread];
+    ++counted.games;
+    counted.moves += game.moves.size();
+    if (with_replay && !replay(game)) {
+      ++counted.invalid_games;
+    }
+  });
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  Counters total;
+  for (const Counters& counted : counters) {
+    total.games += counted.games;
+    total.moves += counted.moves;
+    total.invalid_games += counted.invalid_games;
+  }
+  std::cout << "files " << paths.size() << ", " << std::fixed << std::setprecision(1) << megabytes(bytes)
+            << " MiB, games " << total.games << ", moves " << total.moves;
+  if (with_replay) {
+    std::cout << ", invalid games " << total.invalid_games;
+  }
+  std::cout << "\n"
+            << "threads " << threads << ", time " << std::setprecision(2) << seconds << "s, " << std::setprecision(1)
+            << (seconds > 0.0 ? megabytes(bytes) / seconds : 0.0) << " MiB/s, " << std::setprecision(0)
+            << (seconds > 0.0 ? static_cast<double>(total.games) / seconds : 0.0) << " games/s\n";
+  return 0;
+}
@@ -0,0 +1,101 @@
+#include <bitbishop/tools/tablebase_generator.hpp>
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if __has_include(<sys/resource.h>)
+#define BITBISHOP_TBGEN_RUSAGE 1
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+void print_usage() {
+  std::cerr << "usage: bitbishop-tbgen [--threads N] [--output DIR] CODE...\n"
+            << "  CODE  material signature, e.g. KQvK, KRvKB, KPvKP (at most " << Tablebase::MAX_PIECES
+            << " pieces)\n";
+}
+
+double megabytes(std::size_t bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); }
+
+/**
+ * Peak resident memory of the process, 0 when unknown.
+ */
+std::size_t peak_resident_bytes() {
+#ifdef BITBISHOP_TBGEN_RUSAGE
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;  // Kilobytes on Linux
+  }
+#endif
+  return 0;
+}
+
+}  // namespace
+
+/**
+ * @brief Generates endgame tablebases by retrograde analysis.
+ *
+ * Usage: bitbishop-tbgen [--threads N] [--output DIR] CODE...
+ *
+ * The tablebases of every listed material signature, and of those their captures and promotions lead to, are
+ * written to the output directory (default: current directory) as `<code>.bbw` (WDL) and `<code>.bbm` (DTM) files,
+ * ready for the engine `TablebasePath` option. Generation time and peak memory are reported per tablebase and in
+ * total, to plan which signatures to cover.
+ *
+ * @return Exit code (0 on success, 1 on invalid arguments or write failure).
+ */
+int main(int argc, char* argv[]) {
+  unsigned threads = 0;
+  std::string output = ".";
+  std::vector<std::string> codes;
+
+  const std::vector<std::string> args(argv + 1, argv + argc);
+  for (std::size_t i = 0; i < args.size(); ++i) {
+    if (args[i] == "--threads" && i + 1 < args.size()) {
+      threads = static_cast<unsigned>(std::stoul(args[++i]));
+    } else if (args[i] == "--output" && i + 1 < args.size()) {
+      output = args[++i];
+    } else {
+      codes.push_back(args[i]);
+    }
+  }
+  if (codes.empty()) {
+    print_usage();
+    return 1;
+  }
+
+  Tools::TablebaseGenerator generator(threads);
+  const auto start = std::chrono::steady_clock::now();
+  try {
+    for (const std::string& code : codes) {
+      generator.generate(code);
+    }
+  } catch (const std::exception& error) {
+    std::cerr << "error: " << error.what() << "\n";
+    return 1;
+  }
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::cout << std::left << std::setw(10) << "table" << std::right << std::setw(12) << "positions" << std::setw(11)
+            << "wins" << std::setw(11) << "draws" << std::setw(11) << "losses" << std::setw(11) << "illegal"
+            << std::setw(10) << "max dtm" << std::setw(8) << "passes" << std::setw(10) << "time(s)" << "\n";
+  for (const Tools::TablebaseStats& stats : generator.stats()) {
+    std::cout << std::left << std::setw(10) << stats.code << std::right << std::setw(12) << stats.positions
+              << std::setw(11) << stats.wins << std::setw(11) << stats.draws << std::setw(11) << stats.losses
+              << std::setw(11) << stats.illegal << std::setw(10) << stats.longest_mate << std::setw(8) << stats.passes
+              << std::setw(10) << std::fixed << std::setprecision(2) << stats.seconds << "\n";
+  }
+  std::cout << "total " << std::fixed << std::setprecision(2) << seconds << "s, peak table memory "
+            << megabytes(generator.peak_memory_bytes()) << " MiB, peak resident memory "
+            << megabytes(peak_resident_bytes()) << " MiB\n";
+
+  if (!generator.write(output)) {
+    std::cerr << "error: cannot write tablebases to " << output << "\n";
+    return 1;
+  }
+  return 0;
+}
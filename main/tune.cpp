@@ -0,0 +1,108 @@
+#include <bitbishop/tools/tuner.hpp>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+void print_usage() {
+  std::cerr << "usage: bitbishop-tune [--threads N] [--epochs N] [--batch N] [--rate R] [--k K] --output FILE.hpp "
+               "DATA...\n";
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+/**
+ * @brief Tunes the hand-crafted evaluation weights on labelled positions and writes them as a header.
+ *
+ * Usage: bitbishop-tune [--threads N] [--epochs N] [--batch N] [--rate R] [--k K] --output FILE.hpp DATA...
+ *
+ * DATA files are packed records (`.bin`, e.g. from bitbishop-datagen) or FEN/EPD lines with a `c9` result. Positions
+ * without a result, in check or in recognised endgames are skipped. Prints the error and the gradient throughput of
+ * each epoch; the output header holds the tuned tables (see Tools::write_tuned_header).
+ *
+ * @return Exit code (0 on success, 1 on invalid arguments or I/O failure).
+ */
+int main(int argc, char* argv[]) {
+  Tools::TunerOptions options;
+  std::size_t epochs = 100;  // NOLINT(readability-magic-numbers)
+  std::string output;
+  std::vector<std::string> inputs;
+
+  const std::vector<std::string> args(argv + 1, argv + argc);
+  try {
+    for (std::size_t i = 0; i < args.size(); ++i) {
+      const bool has_value = i + 1 < args.size();
+      if (args[i] == "--threads" && has_value) {
+        options.threads = static_cast<unsigned>(std::stoul(args[++i]));
+      } else if (args[i] == "--epochs" && has_value) {
+        epochs = std::stoul(args[++i]);
+      } else if (args[i] == "--batch" && has_value) {
+        options.batch_size = std::stoul(args[++i]);
+      } else if (args[i] == "--rate" && has_value) {
+        options.learning_rate = std::stod(args[++i]);
+      } else if (args[i] == "--k" && has_value) {
+        options.k = std::stod(args[++i]);
+      } else if (args[i] == "--output" && has_value) {
+        output = args[++i];
+      } else {
+        inputs.push_back(args[i]);
+      }
+    }
+  } catch (const std::exception&) {
+    print_usage();
+    return 1;
+  }
+  if (output.empty() || inputs.empty()) {
+    print_usage();
+    return 1;
+  }
+
+  try {
+    auto start = std::chrono::steady_clock::now();
+    Tools::TuningSet set;
+    for (const std::string& input : inputs) {
+      set.load(input);
+    }
+    std::cout << "positions " << set.size() << " (" << set.skipped() << " skipped), " << std::fixed
+              << std::setprecision(1) << static_cast<double>(set.memory_bytes()) / (1024.0 * 1024.0) << " MiB, "
+              << std::setprecision(2) << seconds_since(start) << "s\n";
+    if (set.size() == 0) {
+      throw std::runtime_error("no position to tune on");
+    }
+
+    Tools::Tuner tuner(set, options);
+    std::cout << "k " << std::setprecision(4) << tuner.k() << ", error " << std::setprecision(6) << tuner.error()
+              << "\n";
+
+    for (std::size_t epoch = 1; epoch <= epochs; ++epoch) {
+      start = std::chrono::steady_clock::now();
+      tuner.epoch();
+      const double seconds = seconds_since(start);
+      std::cout << "epoch " << epoch << " error " << std::setprecision(6) << tuner.error() << ", "
+                << std::setprecision(0) << (seconds > 0.0 ? static_cast<double>(set.size()) / seconds : 0.0)
+                << " positions/s\n";
+    }
+
+    std::ofstream out(output);
+    Tools::write_tuned_header(out, tuner.weights(),
+                              "Generated by bitbishop-tune from " + std::to_string(set.size()) + " positions");
+    out.close();
+    if (!out) {
+      throw std::runtime_error("cannot write " + output);
+    }
+  } catch (const std::exception& error) {
+    std::cerr << "error: " << error.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
@@ -1,76 +1,27 @@
+#include <array>
 #include <bitbishop/board.hpp>
 #include <bitbishop/constants.hpp>
 #include <cassert>
 #include <format>
-#include <sstream>
+#include <stdexcept>
 
 Board::Board() : Board("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1") {}
 
 Board::Board(const std::string& fen) {
-  /*
-   * https://en.wikipedia.org/wiki/Forsyth%E2%80%93Edwards_Notation
-   * https://www.chess.com/terms/fen-chess
-   *
-   * FEN (Forsyth-Edwards Notation) has 6 fields separated by slashes and spaces:
-   *
-   * 1. Piece placement (ranks 8 → 1, separated by /).
-   * 2. Side to move (w or b).
-   * 3. Castling availability (KQkq or -).
-   * 4. En passant target square (like e3 or -).
-   * 5. Halfmove clock (for 50-move rule).
-   * 6. Fullmove number (starts at 1).
-   *
-   * Example FEN for starting position: "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
-   */
-  using namespace Const;
-
-  std::istringstream iss(fen);
-  std::string token;
-  iss >> token;
-
-  int index = BOARD_SIZE - BOARD_WIDTH;
-  for (unsigned char character : token) {
-    if (character == '/') {
-      index -= 2 * BOARD_WIDTH;
-      continue;
-    }
-    if (std::isdigit(character) != 0) {
-      const int skip = character - '0';
-      index += skip;
-      continue;
-    }
-    const Square square(index);
-    Piece piece(character);
-    set_piece(square, piece);
-    index++;
-  }
-
-  // Second token: side to move
-  iss >> token;
-  m_state.m_is_white_turn = (token == "w");
-
-  // Third token: Castling Rights
-  iss >> token;
-  m_state.m_white_castle_kingside = token.find('K') != std::string::npos;
-  m_state.m_white_castle_queenside = token.find('Q') != std::string::npos;
-  m_state.m_black_castle_kingside = token.find('k') != std::string::npos;
-  m_state.m_black_castle_queenside = token.find('q') != std::string::npos;
-
-  // Fourth token: en passant
-  iss >> token;
-  if (token == "-") {
-    m_state.m_en_passant_sq = std::nullopt;
-  } else {
-    m_state.m_en_passant_sq = Square(token);
+  if (const Fen::Error error = Fen::parse(fen, *this); error != Fen::Error::None) {
+    throw std::invalid_argument(std::format("Invalid FEN \"{}\": {}", fen, Fen::error_message(error)));
   }
+}
 
-  // Fifth token: Halfmove clock
-  iss >> m_state.m_halfmove_clock;
-
-  // Sixth token: Fullmove number
-  iss >> m_state.m_fullmove_number;
-
-  m_zobrist_hash = Zobrist::compute_hash(*this);
+void Board::reset(BoardState state) noexcept {
+  m_w_pawns = m_w_rooks = m_w_bishops = m_w_knights = m_w_king = m_w_queens = Bitboard();
+  m_b_pawns = m_b_rooks = m_b_bishops = m_b_knights = m_b_king = m_b_queens = Bitboard();
+  m_state = state;
+  m_pawn_hash = Zobrist::NULL_HASH;
+  m_psqt_score = 0;
+  m_phase = 0;
+  m_material_key = 0;
+  m_zobrist_hash = Zobrist::compute_hash(*this);  // Game state only, set_piece() then adds the pieces
 }
 
 std::ostream& operator<<(std::ostream& out, const Board& board) {
@@ -209,11 +160,23 @@ void Board::set_piece(Square square, Piece piece) {
   }
 
   Zobrist::mutate_piece(square, piece, m_zobrist_hash);
+  if (piece.type() == Piece::PAWN) {
+    Zobrist::mutate_piece(square, piece, m_pawn_hash);
+  }
+  m_psqt_score += Eval::PIECE_SQUARE_SCORES[Zobrist::piece_index(piece)][square.flat_index()];
+  m_phase += Eval::PHASE_WEIGHTS[piece.type()];
+  m_material_key += Material::unit(piece);
 }
 
 void Board::remove_piece(Square square) {
   if (const std::optional<Piece> existing_piece = get_piece(square)) {
     Zobrist::mutate_piece(square, *existing_piece, m_zobrist_hash);
+    if (existing_piece->type() == Piece::PAWN) {
+      Zobrist::mutate_piece(square, *existing_piece, m_pawn_hash);
+    }
+    m_psqt_score -= Eval::PIECE_SQUARE_SCORES[Zobrist::piece_index(*existing_piece)][square.flat_index()];
+    m_phase -= Eval::PHASE_WEIGHTS[existing_piece->type()];
+    m_material_key -= Material::unit(*existing_piece);
   }
 
   // clear the square from ALL bitboards (only one will match)
@@ -324,63 +287,8 @@ bool Board::has_insufficient_material() const noexcept {
 }
 
 std::string Board::get_fen() const noexcept {
-  using namespace Const;
-
-  std::string fen;
-  fen.reserve(FEN_NOTATION_MAX_CHAR_COUNT);
-
-  // Board position
-  for (int rank = RANK_8_IND; rank >= RANK_1_IND; --rank) {
-    std::size_t empty = 0;
-
-    for (int file = FILE_A_IND; file <= FILE_H_IND; ++file) {
-      const auto opt_p = get_piece(Square(file, rank));
-      if (opt_p) {
-        if (empty > 0) {
-          fen += std::to_string(empty);
-          empty = 0;
-        }
-        fen += opt_p->to_char();
-      } else {
-        ++empty;
-      }
-    }
-    if (empty > 0) {
-      fen += std::to_string(empty);
-    }
-    if (rank != RANK_1_IND) {
-      fen += "/";
-    }
-  }
-  fen += " ";
-
-  // Side to move
-  fen += (m_state.m_is_white_turn ? "w" : "b");
-  fen += " ";
-
-  // Castling availability
-  bool has_castling = false;
-  // clang-format off
-  if (m_state.m_white_castle_kingside)  { fen += 'K'; has_castling = true; }
-  if (m_state.m_white_castle_queenside) { fen += 'Q'; has_castling = true; }
-  if (m_state.m_black_castle_kingside)  { fen += 'k'; has_castling = true; }
-  if (m_state.m_black_castle_queenside) { fen += 'q'; has_castling = true; }
-  if (!has_castling) { fen += '-'; }
-  // clang-format on
-  fen += " ";
-
-  // En passant target
-  fen += (m_state.m_en_passant_sq ? m_state.m_en_passant_sq->to_string() : "-");
-  fen += " ";
-
-  // Halfmove clock
-  fen += std::to_string(m_state.m_halfmove_clock);
-  fen += " ";
-
-  // Fullmove number
-  fen += std::to_string(m_state.m_fullmove_number);
-
-  return fen;
+  std::array<char, Fen::MAX_LENGTH> buffer;
+  return {buffer.data(), Fen::format_to(buffer.data(), *this)};
 }
 
 bool Board::operator==(const Board& other) const {
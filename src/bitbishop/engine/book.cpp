@@ -0,0 +1,143 @@
+#include <bitbishop/engine/book.hpp>
+#include <bitbishop/movegen/legal_moves.hpp>
+#include <utility>
+
+namespace {
+
+CX_CONST unsigned SQUARE_BITS = 6;
+CX_CONST int KINGSIDE_CASTLE_FILE = 6;
+CX_CONST int KINGSIDE_ROOK_FILE = 7;
+CX_CONST int QUEENSIDE_ROOK_FILE = 0;
+
+template <typename Integer>
+Integer read_big_endian(const std::byte* data) noexcept {
+  Integer value = 0;
+  for (std::size_t i = 0; i < sizeof(Integer); ++i) {
+    value = static_cast<Integer>((value << 8) | std::to_integer<Integer>(data[i]));  // NOLINT
+  }
+  return value;
+}
+
+template <typename Integer>
+void write_big_endian(std::ostream& out, Integer value) {
+  for (std::size_t i = sizeof(Integer); i-- > 0;) {
+    out.put(static_cast<char>((value >> (8 * i)) & 0xFF));  // NOLINT(readability-magic-numbers)
+  }
+}
+
+}  // namespace
+
+std::uint16_t Book::encode_move(const Move& move) noexcept {
+  int to = move.to.flat_index();
+  if (move.is_castling) {
+    // The king "captures" its rook
+    const int rook_file = move.to.file() == KINGSIDE_CASTLE_FILE ? KINGSIDE_ROOK_FILE : QUEENSIDE_ROOK_FILE;
+    to = (move.to.rank() * Const::BOARD_WIDTH) + rook_file;
+  }
+  const unsigned promotion = move.promotion ? static_cast<unsigned>(move.promotion->type()) : 0;
+  return static_cast<std::uint16_t>(static_cast<unsigned>(to) | (move.from.flat_index() << SQUARE_BITS) |
+                                    (promotion << (2 * SQUARE_BITS)));
+}
+
+std::optional<Move> Book::decode_move(const Board& board, std::uint16_t move) {
+  std::vector<Move> moves;
+  generate_legal_moves(moves, board);
+  for (const Move& legal : moves) {
+    if (encode_move(legal) == move) {
+      return legal;
+    }
+  }
+  return std::nullopt;
+}
+
+Book::Entry Book::read_entry(const std::byte* data) noexcept {
+  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  return Entry{.key = read_big_endian<std::uint64_t>(data),
+               .move = read_big_endian<std::uint16_t>(data + 8),
+               .weight = read_big_endian<std::uint16_t>(data + 10),
+               .learn = read_big_endian<std::uint32_t>(data + 12)};
+  // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
+
+void Book::write_entry(std::ostream& out, const Entry& entry) {
+  write_big_endian(out, entry.key);
+  write_big_endian(out, entry.move);
+  write_big_endian(out, entry.weight);
+  write_big_endian(out, entry.learn);
+}
+
+bool Book::PolyglotBook::open(const std::string& path) {
+  close();
+  auto file = std::make_unique<Nnue::MappedFile>();
+  if (!file->open(path) || file->size() % ENTRY_SIZE != 0) {
+    return false;
+  }
+  m_file = std::move(file);
+  m_path = path;
+  return true;
+}
+
+void Book::PolyglotBook::close() noexcept {
+  m_file.reset();
+  m_path.clear();
+}
+
+std::size_t Book::PolyglotBook::size() const noexcept { return m_file ? m_file->size() / ENTRY_SIZE : 0; }
+
+Book::Entry Book::PolyglotBook::entry(std::size_t index) const noexcept {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  return read_entry(m_file->data() + (index * ENTRY_SIZE));
+}
+
+std::vector<Book::Entry> Book::PolyglotBook::find(Zobrist::Key key) const {
+  // Lower bound of the key, entries being sorted by key
+  std::size_t low = 0;
+  std::size_t high = size();
+  while (low < high) {
+    const std::size_t middle = low + ((high - low) / 2);
+    if (entry(middle).key < key) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+
+  std::vector<Entry> entries;
+  for (std::size_t index = low; index < size(); ++index) {
+    const Entry found = entry(index);
+    if (found.key != key) {
+      break;
+    }
+    entries.push_back(found);
+  }
+  return entries;
+}
+
+std::optional<Move> Book::PolyglotBook::pick(const Board& board, std::uint64_t random) const {
+  if (!is_open()) {
+    return std::nullopt;
+  }
+
+  std::vector<std::pair<Move, std::uint64_t>> candidates;
+  std::uint64_t total_weight = 0;
+  for (const Entry& found : find(Zobrist::compute_polyglot_key(board))) {
+    if (found.weight == 0) {
+      continue;
+    }
+    if (const std::optional<Move> move = decode_move(board, found.move)) {
+      total_weight += found.weight;
+      candidates.emplace_back(*move, total_weight);
+    }
+  }
+  if (candidates.empty()) {
+    return std::nullopt;
+  }
+
+  const std::uint64_t target = random % total_weight;
+  for (const auto& [move, cumulative_weight] : candidates) {
+    if (target < cumulative_weight) {
+      return move;
+    }
+  }
+  return candidates.back().first;
+}
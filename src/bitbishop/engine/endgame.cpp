@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <array>
+#include <bitbishop/engine/endgame.hpp>
+#include <bitbishop/lookups/kpk_bitbase.hpp>
+#include <bitbishop/psqt.hpp>
+#include <cstdlib>
+#include <string_view>
+
+namespace {
+
+using namespace Eval;
+
+CX_CONST int DRIVE_WEIGHT = 20;         // Per square of king distance, see push_to_edge() and push_close()
+CX_CONST int CORNER_WEIGHT = 40;        // Per square of distance to the mating corner in KBNK
+CX_CONST int PAWN_PROGRESS_WEIGHT = 10;  // Per rank of pawn advance in won KPK
+
+int distance(Square a, Square b) { return std::max(std::abs(a.file() - b.file()), std::abs(a.rank() - b.rank())); }
+
+int manhattan_distance(Square a, Square b) { return std::abs(a.file() - b.file()) + std::abs(a.rank() - b.rank()); }
+
+/**
+ * Bonus for a king far from the center: mates only happen on the edge.
+ */
+int push_to_edge(Square square) {
+  const int file_distance = std::max(3 - square.file(), square.file() - 4);
+  const int rank_distance = std::max(3 - square.rank(), square.rank() - 4);
+  return DRIVE_WEIGHT * (file_distance + rank_distance);
+}
+
+/**
+ * Bonus for kings close to each other: the strong king must help mating.
+ */
+int push_close(Square a, Square b) { return DRIVE_WEIGHT * (Const::BOARD_WIDTH - 1 - distance(a, b)); }
+
+int relative_rank(Color color, Square square) {
+  return color == Color::WHITE ? square.rank() : Const::BOARD_WIDTH - 1 - square.rank();
+}
+
+Square promotion_square(Color color, Square pawn) {
+  return {(color == Color::WHITE ? Const::BOARD_WIDTH * (Const::BOARD_WIDTH - 1) : 0) + pawn.file(), std::in_place};
+}
+
+bool is_rook_file(Square square) { return square.file() == 0 || square.file() == Const::BOARD_WIDTH - 1; }
+
+Square only_square(Bitboard bitboard) { return *bitboard.lsb(); }
+
+/**
+ * Hash table of the registered endgames, single probe for material keys without entry.
+ */
+struct EndgameTable {
+  static CX_VALUE int SLOT_BITS = 6;
+  static CX_VALUE std::uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+
+  std::array<Endgame, std::size_t{1} << SLOT_BITS> slots{};
+
+  static std::size_t slot_of(Material::Key key) { return static_cast<std::size_t>((key * MULTIPLIER) >> (64 - SLOT_BITS)); }
+
+  void add(const Endgame& endgame) {
+    std::size_t slot = slot_of(endgame.key);
+    while (slots[slot].key != 0) {
+      slot = (slot + 1) % slots.size();
+    }
+    slots[slot] = endgame;
+  }
+
+  /**
+   * Registers an endgame code ("KRvK", white strong) for both colors.
+   */
+  void add(std::string_view code, EndgameValueFunction value, EndgameScaleFunction scale, bool exact = false) {
+    const Material::Key key = Material::from_code(code);
+    add({.key = key, .strong = Color::WHITE, .value = value, .scale = scale, .exact = exact});
+    add({.key = Material::mirror(key), .strong = Color::BLACK, .value = value, .scale = scale, .exact = exact});
+  }
+
+  [[nodiscard]] const Endgame* find(Material::Key key) const {
+    for (std::size_t slot = slot_of(key); slots[slot].key != 0; slot = (slot + 1) % slots.size()) {
+      if (slots[slot].key == key) {
+        return &slots[slot];
+      }
+    }
+    return nullptr;
+  }
+};
+
+const EndgameTable ENDGAMES = [] {
+  EndgameTable table;
+  table.add("KQvK", evaluate_kxk, nullptr);
+  table.add("KRvK", evaluate_kxk, nullptr);
+  table.add("KBNvK", evaluate_kbnk, nullptr);
+  table.add("KQvKR", evaluate_kqkr, nullptr);
+  table.add("KPvK", evaluate_kpk, nullptr, true);
+  table.add("KNNvK", evaluate_knnk, nullptr);
+  table.add("KBPvK", nullptr, scale_kbpk);
+  return table;
+}();
+
+}  // namespace
+
+const Eval::Endgame* Eval::find_endgame(Material::Key key) noexcept { return ENDGAMES.find(key); }
+
+int Eval::evaluate_kxk(const Board& board, Color strong) noexcept {
+  const Color weak = ColorUtil::opposite(strong);
+  const Square strong_king = only_square(board.king(strong));
+  const Square weak_king = only_square(board.king(weak));
+
+  const int material = (board.queens(strong).count() * QUEEN_ENDGAME) + (board.rooks(strong).count() * ROOK_ENDGAME);
+  return KNOWN_WIN + material + push_to_edge(weak_king) + push_close(strong_king, weak_king);
+}
+
+int Eval::evaluate_kbnk(const Board& board, Color strong) noexcept {
+  using namespace Squares;
+  const Color weak = ColorUtil::opposite(strong);
+  const Square strong_king = only_square(board.king(strong));
+  const Square weak_king = only_square(board.king(weak));
+  const Square bishop = only_square(board.bishops(strong));
+
+  // Mate is only forced in a corner the bishop can attack
+  const bool a1_h8 = bishop.same_color(A1);
+  const int corner_distance = std::min(manhattan_distance(weak_king, a1_h8 ? A1 : A8),
+                                       manhattan_distance(weak_king, a1_h8 ? H8 : H1));
+  const int max_corner_distance = 2 * (Const::BOARD_WIDTH - 1);
+
+  return KNOWN_WIN + KNIGHT_ENDGAME + BISHOP_ENDGAME + (CORNER_WEIGHT * (max_corner_distance - corner_distance)) +
+         push_close(strong_king, weak_king);
+}
+
+int Eval::evaluate_kqkr(const Board& board, Color strong) noexcept {
+  const Color weak = ColorUtil::opposite(strong);
+  const Square strong_king = only_square(board.king(strong));
+  const Square weak_king = only_square(board.king(weak));
+
+  return QUEEN_ENDGAME - ROOK_ENDGAME + push_to_edge(weak_king) + push_close(strong_king, weak_king);
+}
+
+int Eval::evaluate_kpk(const Board& board, Color strong) noexcept {
+  const Color weak = ColorUtil::opposite(strong);
+  const Square strong_king = only_square(board.king(strong));
+  const Square weak_king = only_square(board.king(weak));
+  const Square pawn = only_square(board.pawns(strong));
+
+  if (!Lookups::kpk_is_win(strong, strong_king, pawn, weak_king, board.get_side_to_move())) {
+    return 0;
+  }
+  // Prefer advancing the pawn, so the search makes progress towards promotion
+  return KNOWN_WIN + PAWN_ENDGAME + (PAWN_PROGRESS_WEIGHT * relative_rank(strong, pawn));
+}
+
+int Eval::evaluate_knnk([[maybe_unused]] const Board& board, [[maybe_unused]] Color strong) noexcept { return 0; }
+
+int Eval::scale_kbpk(const Board& board, Color strong) noexcept {
+  const Color weak = ColorUtil::opposite(strong);
+  const Square pawn = only_square(board.pawns(strong));
+  if (!is_rook_file(pawn)) {
+    return SCALE_FACTOR_NORMAL;
+  }
+
+  const Square promotion = promotion_square(strong, pawn);
+  const Square bishop = only_square(board.bishops(strong));
+  const Square weak_king = only_square(board.king(weak));
+  const bool wrong_bishop = !bishop.same_color(promotion);
+  return (wrong_bishop && distance(weak_king, promotion) <= 1) ? SCALE_FACTOR_DRAW : SCALE_FACTOR_NORMAL;
+}
@@ -0,0 +1,54 @@
+#include <algorithm>
+#include <bit>
+#include <bitbishop/engine/eval_cache.hpp>
+#include <bitbishop/engine/eval_tables.hpp>
+#include <bitbishop/engine/evaluation.hpp>
+#include <cassert>
+
+Eval::EvalCache::EvalCache(std::size_t size) : entries(size), mask(size - 1) { assert(std::has_single_bit(size)); }
+
+namespace {
+
+/**
+ * Shared probe logic: `compute` evaluates the position on a miss.
+ */
+template <typename Entry, typename Compute>
+int probe_entry(Entry& entry, Zobrist::Key key, std::uint32_t generation, std::uint64_t& hits_count,
+                Compute&& compute) {
+  if (entry.generation == generation && entry.key == key) {
+    hits_count++;
+    return entry.score;
+  }
+
+  entry.key = key;
+  entry.score = compute();
+  entry.generation = generation;
+  return entry.score;
+}
+
+}  // namespace
+
+int Eval::EvalCache::probe(const Board& board) noexcept {
+  const Zobrist::Key key = board.get_zobrist_hash();
+  probes_count++;
+  return probe_entry(entries[key & mask], key, generation, hits_count, [&board] { return evaluate(board); });
+}
+
+int Eval::EvalCache::probe(const Position& position) noexcept {
+  const Zobrist::Key key = position.get_board().get_zobrist_hash();
+  probes_count++;
+  return probe_entry(entries[key & mask], key, generation, hits_count, [&position] { return evaluate(position); });
+}
+
+void Eval::EvalCache::clear() noexcept {
+  generation++;
+  if (generation == 0) {
+    // Wrapped around: entries of an old generation could match again
+    std::fill(entries.begin(), entries.end(), Entry{});
+    generation = 1;
+  }
+  probes_count = 0;
+  hits_count = 0;
+}
+
+Eval::EvalCache& Eval::thread_eval_cache() noexcept { return thread_tables().eval_cache; }
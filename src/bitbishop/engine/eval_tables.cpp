@@ -0,0 +1,26 @@
+#include <bitbishop/engine/eval_tables.hpp>
+
+namespace {
+
+thread_local Eval::ThreadTables* bound_tables = nullptr;
+
+}  // namespace
+
+void Eval::ThreadTables::clear() noexcept {
+  pawn_table.clear();
+  eval_cache.clear();
+}
+
+Eval::ThreadTablesScope::ThreadTablesScope(ThreadTables& tables) noexcept : previous(bound_tables) {
+  bound_tables = &tables;
+}
+
+Eval::ThreadTablesScope::~ThreadTablesScope() { bound_tables = previous; }
+
+Eval::ThreadTables& Eval::thread_tables() noexcept {
+  if (bound_tables != nullptr) {
+    return *bound_tables;
+  }
+  thread_local ThreadTables default_tables;
+  return default_tables;
+}
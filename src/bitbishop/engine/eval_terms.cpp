@@ -0,0 +1,86 @@
+#include <bitbishop/engine/eval_terms.hpp>
+#include <bitbishop/engine/pawn_structure.hpp>
+
+namespace {
+
+using namespace Eval;
+
+CX_CONST std::array<const PieceSquareTable*, Piece::TYPE_COUNT> MIDGAME_PSQTS = {
+    &PAWN_PSQT_WHITE, &KNIGHT_PSQT_WHITE, &BISHOP_PSQT_WHITE,
+    &ROOK_PSQT_WHITE, &QUEEN_PSQT_WHITE,  &KING_MIDGAME_PSQT_WHITE,
+};
+
+CX_CONST std::array<const PieceSquareTable*, Piece::TYPE_COUNT> ENDGAME_PSQTS = {
+    &PAWN_ENDGAME_PSQT_WHITE, &KNIGHT_ENDGAME_PSQT_WHITE, &BISHOP_ENDGAME_PSQT_WHITE,
+    &ROOK_ENDGAME_PSQT_WHITE, &QUEEN_ENDGAME_PSQT_WHITE,  &KING_ENDGAME_PSQT_WHITE,
+};
+
+CX_CONST std::array<int, Piece::KING> MIDGAME_MATERIAL = {PAWN, KNIGHT, BISHOP, ROOK, QUEEN};
+
+CX_CONST std::array<int, Piece::KING> ENDGAME_MATERIAL = {PAWN_ENDGAME, KNIGHT_ENDGAME, BISHOP_ENDGAME, ROOK_ENDGAME,
+                                                           QUEEN_ENDGAME};
+
+}  // namespace
+
+Eval::TermWeights Eval::current_term_weights() noexcept {
+  TermWeights weights{};
+  for (std::size_t type = 0; type < MIDGAME_MATERIAL.size(); ++type) {
+    weights[MATERIAL_TERMS + type] = make_score(MIDGAME_MATERIAL[type], ENDGAME_MATERIAL[type]);
+  }
+  for (std::size_t type = 0; type < Piece::TYPE_COUNT; ++type) {
+    for (std::size_t index = 0; index < Const::BOARD_SIZE; ++index) {
+      weights[PSQT_TERMS + (type * Const::BOARD_SIZE) + index] =
+          make_score((*MIDGAME_PSQTS[type])[index], (*ENDGAME_PSQTS[type])[index]);
+    }
+  }
+  weights[DOUBLED_PAWN_TERM] = DOUBLED_PAWN_PENALTY;
+  weights[ISOLATED_PAWN_TERM] = ISOLATED_PAWN_PENALTY;
+  weights[BACKWARD_PAWN_TERM] = BACKWARD_PAWN_PENALTY;
+  for (std::size_t rank = 0; rank < Const::BOARD_WIDTH; ++rank) {
+    weights[PASSED_PAWN_TERMS + rank] = PASSED_PAWN_BONUS[rank];
+  }
+  return weights;
+}
+
+void Eval::extract_terms(const Board& board, std::vector<TermCoefficient>& coefficients) {
+  // White and black pieces on mirrored squares share a piece-square term and cancel out, so counts are summed first
+  std::array<int, TERM_COUNT> counts{};
+
+  for (const Color color : {Color::WHITE, Color::BLACK}) {
+    const bool white = color == Color::WHITE;
+    const int sign = white ? 1 : -1;
+    for (const Piece::Type type : Piece::ALL_TYPES) {
+      const Bitboard pieces = board.pieces(Piece(type, color));
+      if (type != Piece::KING) {
+        counts[MATERIAL_TERMS + type] += sign * pieces.count();
+      }
+      for (const Square square : pieces) {
+        const std::size_t index = white ? flip_index_vertically(square.flat_index()) : square.flat_index();
+        counts[PSQT_TERMS + (type * Const::BOARD_SIZE) + index] += sign;
+      }
+    }
+
+    const PawnTerms terms = find_pawn_terms(board, color);
+    counts[DOUBLED_PAWN_TERM] += sign * terms.doubled.count();
+    counts[ISOLATED_PAWN_TERM] += sign * terms.isolated.count();
+    counts[BACKWARD_PAWN_TERM] += sign * terms.backward.count();
+    for (const Square square : terms.passed) {
+      counts[PASSED_PAWN_TERMS + relative_rank(square, color)] += sign;
+    }
+  }
+
+  for (std::size_t term = 0; term < TERM_COUNT; ++term) {
+    if (counts[term] != 0) {
+      coefficients.push_back(
+          {.term = static_cast<std::uint16_t>(term), .coefficient = static_cast<std::int8_t>(counts[term])});
+    }
+  }
+}
+
+Eval::Score Eval::score_terms(const TermWeights& weights, std::span<const TermCoefficient> coefficients) noexcept {
+  Score score = 0;
+  for (const TermCoefficient& coefficient : coefficients) {
+    score += weights[coefficient.term] * coefficient.coefficient;
+  }
+  return score;
+}
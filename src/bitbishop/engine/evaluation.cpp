@@ -1,4 +1,9 @@
+#include <bitbishop/engine/endgame.hpp>
+#include <bitbishop/engine/eval_tables.hpp>
 #include <bitbishop/engine/evaluation.hpp>
+#include <bitbishop/engine/nnue.hpp>
+#include <bitbishop/engine/pawn_structure.hpp>
+#include <cassert>
 
 int Eval::evaluate_material(const Board& board, Color side) noexcept {
   int score = 0;
@@ -39,11 +44,78 @@ int Eval::evaluate_psqt(const Board& board, Color side) noexcept {
   return score;
 }
 
-int Eval::evaluate(const Board& board) noexcept {
+namespace {
+
+bool use_network(const Board& board) {
+  return Nnue::network() != nullptr && board.king(Color::WHITE).any() && board.king(Color::BLACK).any();
+}
+
+/**
+ * Hand-crafted evaluation from the board's incremental scores.
+ */
+int evaluate_hand_crafted(const Board& board) {
   using namespace Eval;
 
-  const int white_score = evaluate_material(board, Color::WHITE) + evaluate_psqt(board, Color::WHITE);
-  const int black_score = evaluate_material(board, Color::BLACK) + evaluate_psqt(board, Color::BLACK);
+  // The incremental material + piece-square score must match a full recomputation
+  assert(board.get_psqt_score() == compute_psqt_score(board));
+
+  const Score score = board.get_psqt_score() + thread_pawn_hash_table().probe(board).score;
+  return taper(score, board.get_phase());
+}
+
+/**
+ * Replaces or scales the generic evaluation of recognised endgames (see Eval::find_endgame).
+ */
+template <typename Generic>
+int with_endgames(const Board& board, Material::Key key, Generic&& generic) {
+  using namespace Eval;
+
+  const Endgame* endgame = find_endgame(key);
+  if (endgame == nullptr) {
+    return generic();
+  }
+
+  if (endgame->value != nullptr) {
+    const int value = endgame->value(board, endgame->strong);
+    return endgame->strong == Color::WHITE ? value : -value;
+  }
+  return generic() * endgame->scale(board, endgame->strong) / SCALE_FACTOR_NORMAL;
+}
+
+}  // namespace
+
+int Eval::evaluate(const Board& board) noexcept {
+  return with_endgames(board, board.get_material_key(), [&board] {
+    return use_network(board) ? Nnue::evaluate(board, thread_tables().nnue_refresh_cache)
+                              : evaluate_hand_crafted(board);
+  });
+}
+
+int Eval::evaluate(const Position& position) noexcept {
+  const Board& board = position.get_board();
+  return with_endgames(board, board.get_material_key(), [&position, &board] {
+    if (!use_network(board)) {
+      return evaluate_hand_crafted(board);
+    }
+    ThreadTables& tables = thread_tables();
+    return Nnue::evaluate(position, tables.nnue_accumulators, tables.nnue_refresh_cache);
+  });
+}
+
+int Eval::evaluate_from_scratch(const Board& board) noexcept {
+  int phase = 0;
+  Material::Key material_key = 0;
+  for (const Color color : {Color::WHITE, Color::BLACK}) {
+    for (const Piece::Type type : Piece::ALL_TYPES) {
+      const Piece piece(type, color);
+      const int count = board.pieces(piece).count();
+      phase += count * PHASE_WEIGHTS[type];
+      material_key += static_cast<Material::Key>(count) * Material::unit(piece);
+    }
+  }
 
-  return white_score - black_score;
+  return with_endgames(board, material_key, [&board, phase] {
+    const Score score = compute_psqt_score(board) + evaluate_pawn_structure(board).score;
+    return taper(score, phase);
+  });
 }
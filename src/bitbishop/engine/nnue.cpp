@@ -0,0 +1,341 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <bitbishop/engine/nnue.hpp>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+
+#if __has_include(<sys/mman.h>)
+#define BITBISHOP_NNUE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static_assert(std::endian::native == std::endian::little, "network files are read in place as little-endian data");
+
+namespace {
+
+using Nnue::Accumulator;
+
+// Owner of the loaded network, only touched by load/unload
+std::unique_ptr<Nnue::Network> owned_network;
+
+// Network read by evaluations
+std::atomic<const Nnue::Network*> published_network{nullptr};
+
+// Incremented each time the network changes, so thread caches can detect stale accumulators.
+std::atomic<std::uint64_t> network_generation{0};
+
+// Number of live SearchGuard instances
+std::atomic<int> active_searches{0};
+
+const std::int16_t* feature_column(const Nnue::Network& net, std::size_t feature) {
+  return net.feature_weights + (feature * Nnue::L1_SIZE);
+}
+
+/**
+ * Brings the refresh cache entry of the perspective's king bucket up to date with the board, touching only the
+ * pieces that changed since the entry was last used.
+ */
+const Accumulator& refresh_accumulator(const Nnue::Network& net, Nnue::RefreshCache& cache, const Board& board,
+                                       Color perspective, std::uint64_t generation) {
+  const Square king_square = *board.king(perspective).lsb();
+  const std::size_t bucket = Nnue::king_bucket(king_square, perspective);
+  Nnue::RefreshCache::Entry& entry = cache.entries[ColorUtil::to_index(perspective)][bucket];
+
+  if (entry.generation != generation) {
+    std::copy_n(net.feature_biases, Nnue::L1_SIZE, entry.accumulator.begin());
+    entry.pieces.fill(Bitboard::Zeros());
+    entry.generation = generation;
+  }
+
+  for (const Color color : {Color::WHITE, Color::BLACK}) {
+    for (const Piece::Type type : Piece::ALL_TYPES) {
+      const Piece piece(type, color);
+      const int p_ind = Zobrist::piece_index(piece);
+      const Bitboard current = board.pieces(piece);
+      const Bitboard cached = entry.pieces[p_ind];
+
+      for (const Square square : cached & ~current) {
+        Nnue::sub_column(net.simd, entry.accumulator.data(),
+                         feature_column(net, Nnue::feature_index(bucket, piece, square, perspective)), Nnue::L1_SIZE);
+      }
+      for (const Square square : current & ~cached) {
+        Nnue::add_column(net.simd, entry.accumulator.data(),
+                         feature_column(net, Nnue::feature_index(bucket, piece, square, perspective)), Nnue::L1_SIZE);
+      }
+      entry.pieces[p_ind] = current;
+    }
+  }
+
+  return entry.accumulator;
+}
+
+/**
+ * Tells if a move changes the king bucket of a perspective, which invalidates all the accumulators before it.
+ */
+bool moves_king_bucket(const MoveExecution& exec, Color perspective) {
+  const Piece king(Piece::KING, perspective);
+  std::size_t from_bucket = Nnue::KING_BUCKETS;
+  std::size_t to_bucket = Nnue::KING_BUCKETS;
+  for (int i = 0; i < exec.count; ++i) {
+    const MoveEffect& effect = exec.effects[i];
+    if (effect.type == MoveEffect::Type::BoardState || effect.piece != king) {
+      continue;
+    }
+    const std::size_t bucket = Nnue::king_bucket(effect.square, perspective);
+    (effect.type == MoveEffect::Type::Remove ? from_bucket : to_bucket) = bucket;
+  }
+  return from_bucket != to_bucket;
+}
+
+/**
+ * Replays (or undoes) the pieces changed by a move on an accumulator of a perspective whose king stays in `bucket`.
+ */
+void apply_execution(const Nnue::Network& net, Accumulator& accumulator, const MoveExecution& exec,
+                     std::size_t bucket, Color perspective, bool undo) {
+  for (int i = 0; i < exec.count; ++i) {
+    const MoveEffect& effect = exec.effects[i];
+    if (effect.type == MoveEffect::Type::BoardState) {
+      continue;
+    }
+    const std::int16_t* column =
+        feature_column(net, Nnue::feature_index(bucket, effect.piece, effect.square, perspective));
+    if ((effect.type == MoveEffect::Type::Place) != undo) {
+      Nnue::add_column(net.simd, accumulator.data(), column, Nnue::L1_SIZE);
+    } else {
+      Nnue::sub_column(net.simd, accumulator.data(), column, Nnue::L1_SIZE);
+    }
+  }
+}
+
+/**
+ * Brings the accumulator stack frame of the current ply up to date for one perspective (see Nnue::evaluate).
+ */
+const Accumulator& update_frame(const Nnue::Network& net, Nnue::AccumulatorStack& stack, Nnue::RefreshCache& cache,
+                                const Position& position, Color perspective, std::uint64_t generation) {
+  const std::vector<MoveExecution>& moves = position.get_move_history();
+  const std::vector<Zobrist::Key>& keys = position.get_zobrist_history();
+  const std::size_t ply = moves.size();
+  const std::size_t key_offset = keys.size() - 1 - ply;
+  std::vector<Nnue::AccumulatorStack::Frame>& frames = stack.frames[ColorUtil::to_index(perspective)];
+
+  const auto is_current = [&](std::size_t index) {
+    return frames[index].generation == generation && frames[index].key == keys[key_offset + index];
+  };
+  const auto stamp = [&](std::size_t index) {
+    frames[index].key = keys[key_offset + index];
+    frames[index].generation = generation;
+  };
+
+  if (is_current(ply)) {
+    return frames[ply].accumulator;
+  }
+
+  const Board& board = position.get_board();
+  const std::size_t bucket = Nnue::king_bucket(*board.king(perspective).lsb(), perspective);
+
+  // Nearest earlier up-to-date frame with the king in the same bucket since
+  std::size_t start = ply;
+  bool found = false;
+  while (start > 0 && !moves_king_bucket(moves[start - 1], perspective)) {
+    --start;
+    if (is_current(start)) {
+      found = true;
+      break;
+    }
+  }
+
+  if (found) {
+    for (std::size_t index = start + 1; index <= ply; ++index) {
+      frames[index].accumulator = frames[index - 1].accumulator;
+      apply_execution(net, frames[index].accumulator, moves[index - 1], bucket, perspective, false);
+      stamp(index);
+    }
+    return frames[ply].accumulator;
+  }
+
+  // Refresh, then rebuild the frames back to the last king bucket change by undoing the moves
+  frames[ply].accumulator = refresh_accumulator(net, cache, board, perspective, generation);
+  stamp(ply);
+  for (std::size_t index = ply; index > start; --index) {
+    frames[index - 1].accumulator = frames[index].accumulator;
+    apply_execution(net, frames[index - 1].accumulator, moves[index - 1], bucket, perspective, true);
+    stamp(index - 1);
+  }
+  return frames[ply].accumulator;
+}
+
+Accumulator compute_accumulator(const Nnue::Network& net, const Board& board, Color perspective) {
+  Accumulator accumulator{};
+  std::copy_n(net.feature_biases, Nnue::L1_SIZE, accumulator.begin());
+
+  const std::size_t bucket = Nnue::king_bucket(*board.king(perspective).lsb(), perspective);
+  for (const Color color : {Color::WHITE, Color::BLACK}) {
+    for (const Piece::Type type : Piece::ALL_TYPES) {
+      const Piece piece(type, color);
+      for (const Square square : board.pieces(piece)) {
+        Nnue::add_column(Simd::Level::Scalar, accumulator.data(),
+                         feature_column(net, Nnue::feature_index(bucket, piece, square, perspective)), Nnue::L1_SIZE);
+      }
+    }
+  }
+  return accumulator;
+}
+
+int output(const Nnue::Network& net, Simd::Level simd, const Board& board, const Accumulator& white,
+           const Accumulator& black) {
+  const Color side = board.get_side_to_move();
+  const Accumulator& us = side == Color::WHITE ? white : black;
+  const Accumulator& them = side == Color::WHITE ? black : white;
+
+  const std::int32_t raw = net.output_bias + Nnue::clipped_dot(simd, us.data(), net.output_weights, Nnue::L1_SIZE) +
+                           Nnue::clipped_dot(simd, them.data(), net.output_weights + Nnue::L1_SIZE, Nnue::L1_SIZE);
+  const int score = raw / Nnue::OUTPUT_DIVISOR;
+
+  // The network scores the side to move
+  return side == Color::WHITE ? score : -score;
+}
+
+}  // namespace
+
+Nnue::MappedFile::~MappedFile() {
+#ifdef BITBISHOP_NNUE_MMAP
+  if (mapped != nullptr) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    munmap(const_cast<std::byte*>(mapped), mapped_size);
+  }
+#endif
+}
+
+bool Nnue::MappedFile::open(const std::string& path) {
+#ifdef BITBISHOP_NNUE_MMAP
+  const int descriptor = ::open(path.c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    return false;
+  }
+
+  struct stat info {};
+  if (fstat(descriptor, &info) != 0 || info.st_size <= 0) {
+    close(descriptor);
+    return false;
+  }
+
+  void* address = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+  close(descriptor);
+  if (address == MAP_FAILED) {
+    return false;
+  }
+
+  mapped = static_cast<const std::byte*>(address);
+  mapped_size = static_cast<std::size_t>(info.st_size);
+  return true;
+#else
+  std::ifstream stream(path, std::ios::binary | std::ios::ate);
+  if (!stream) {
+    return false;
+  }
+  fallback.resize(static_cast<std::size_t>(stream.tellg()));
+  stream.seekg(0);
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  stream.read(reinterpret_cast<char*>(fallback.data()), static_cast<std::streamsize>(fallback.size()));
+  return static_cast<bool>(stream);
+#endif
+}
+
+Nnue::SearchGuard::SearchGuard() noexcept { active_searches.fetch_add(1); }
+
+Nnue::SearchGuard::~SearchGuard() { active_searches.fetch_sub(1); }
+
+bool Nnue::load_network(const std::string& path) {
+  assert(active_searches.load() == 0 && "the network cannot change during a search");
+  if (active_searches.load() != 0) {
+    return false;
+  }
+
+  auto net = std::make_unique<Network>();
+  if (!net->file.open(path) || net->file.size() != FILE_SIZE) {
+    return false;
+  }
+
+  const std::byte* data = net->file.data();
+  if (std::memcmp(data, FILE_MAGIC.data(), FILE_MAGIC.size()) != 0) {
+    return false;
+  }
+
+  std::array<std::uint32_t, 3> header{};  // version, features, l1 size
+  std::memcpy(header.data(), data + FILE_MAGIC.size(), sizeof(header));
+  if (header[0] != FILE_VERSION || header[1] != FEATURES || header[2] != L1_SIZE) {
+    return false;
+  }
+
+  // Parameters are used in place, inside the mapped file
+  // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+  const std::byte* cursor = data + FILE_MAGIC.size() + sizeof(header);
+  net->feature_biases = reinterpret_cast<const std::int16_t*>(cursor);
+  cursor += L1_SIZE * sizeof(std::int16_t);
+  net->feature_weights = reinterpret_cast<const std::int16_t*>(cursor);
+  cursor += FEATURES * L1_SIZE * sizeof(std::int16_t);
+  net->output_weights = reinterpret_cast<const std::int8_t*>(cursor);
+  cursor += 2 * L1_SIZE * sizeof(std::int8_t);
+  // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+  std::memcpy(&net->output_bias, cursor, sizeof(net->output_bias));
+
+  net->path = path;
+  net->simd = Simd::detect_level();
+
+  published_network.store(net.get());
+  owned_network = std::move(net);
+  network_generation.fetch_add(1);
+  return true;
+}
+
+void Nnue::unload_network() noexcept {
+  assert(active_searches.load() == 0 && "the network cannot change during a search");
+  if (active_searches.load() != 0) {
+    return;
+  }
+
+  published_network.store(nullptr);
+  owned_network.reset();
+  network_generation.fetch_add(1);
+}
+
+const Nnue::Network* Nnue::network() noexcept { return published_network.load(); }
+
+int Nnue::evaluate(const Board& board, RefreshCache& cache) noexcept {
+  const Network* net = published_network.load();
+  assert(net != nullptr);
+
+  const std::uint64_t generation = network_generation.load();
+  const Accumulator& white = refresh_accumulator(*net, cache, board, Color::WHITE, generation);
+  const Accumulator& black = refresh_accumulator(*net, cache, board, Color::BLACK, generation);
+  return output(*net, net->simd, board, white, black);
+}
+
+int Nnue::evaluate(const Position& position, AccumulatorStack& stack, RefreshCache& cache) noexcept {
+  const Network* net = published_network.load();
+  assert(net != nullptr);
+
+  const Board& board = position.get_board();
+  if (position.get_move_history().size() >= AccumulatorStack::MAX_PLY) {
+    return evaluate(board, cache);
+  }
+
+  const std::uint64_t generation = network_generation.load();
+  const Accumulator& white = update_frame(*net, stack, cache, position, Color::WHITE, generation);
+  const Accumulator& black = update_frame(*net, stack, cache, position, Color::BLACK, generation);
+  return output(*net, net->simd, board, white, black);
+}
+
+int Nnue::evaluate_from_scratch(const Board& board) noexcept {
+  const Network* net = published_network.load();
+  assert(net != nullptr);
+
+  const Accumulator white = compute_accumulator(*net, board, Color::WHITE);
+  const Accumulator black = compute_accumulator(*net, board, Color::BLACK);
+  return output(*net, Simd::Level::Scalar, board, white, black);
+}
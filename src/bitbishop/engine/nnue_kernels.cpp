@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <bitbishop/engine/nnue.hpp>
+
+#ifdef BITBISHOP_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+std::int32_t clipped_dot_scalar(const std::int16_t* values, const std::int8_t* weights, std::size_t size) noexcept {
+  std::int32_t sum = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    const int activated = std::clamp<int>(values[i], 0, Nnue::ACTIVATION_MAX);
+    sum += activated * weights[i];
+  }
+  return sum;
+}
+
+void add_column_scalar(std::int16_t* values, const std::int16_t* column, std::size_t size) noexcept {
+  for (std::size_t i = 0; i < size; ++i) {
+    values[i] = static_cast<std::int16_t>(values[i] + column[i]);
+  }
+}
+
+void sub_column_scalar(std::int16_t* values, const std::int16_t* column, std::size_t size) noexcept {
+  for (std::size_t i = 0; i < size; ++i) {
+    values[i] = static_cast<std::int16_t>(values[i] - column[i]);
+  }
+}
+
+#ifdef BITBISHOP_SIMD_X86
+
+__attribute__((target("sse2"))) std::int32_t clipped_dot_sse2(const std::int16_t* values, const std::int8_t* weights,
+                                                                std::size_t size) noexcept {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i max = _mm_set1_epi16(static_cast<std::int16_t>(Nnue::ACTIVATION_MAX));
+  __m128i sum = _mm_setzero_si128();
+
+  for (std::size_t i = 0; i < size; i += 8) {
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    const __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+    const __m128i packed_weights = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(weights + i));
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+    const __m128i activated = _mm_min_epi16(_mm_max_epi16(raw, zero), max);
+    // Sign-extends the 8 int8 weights to int16
+    const __m128i wide_weights = _mm_unpacklo_epi8(packed_weights, _mm_cmpgt_epi8(zero, packed_weights));
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(activated, wide_weights));
+  }
+
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));  // NOLINT(readability-magic-numbers)
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));  // NOLINT(readability-magic-numbers)
+  return _mm_cvtsi128_si32(sum);
+}
+
+__attribute__((target("avx2"))) std::int32_t clipped_dot_avx2(const std::int16_t* values, const std::int8_t* weights,
+                                                                std::size_t size) noexcept {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i max = _mm256_set1_epi16(static_cast<std::int16_t>(Nnue::ACTIVATION_MAX));
+  __m256i sum = _mm256_setzero_si256();
+
+  for (std::size_t i = 0; i < size; i += 16) {
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    const __m256i raw = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+    const __m256i wide_weights = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i)));
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+    const __m256i activated = _mm256_min_epi16(_mm256_max_epi16(raw, zero), max);
+    sum = _mm256_add_epi32(sum, _mm256_madd_epi16(activated, wide_weights));
+  }
+
+  __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+  half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));  // NOLINT(readability-magic-numbers)
+  half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xB1));  // NOLINT(readability-magic-numbers)
+  return _mm_cvtsi128_si32(half);
+}
+
+// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+
+__attribute__((target("sse2"))) void add_column_sse2(std::int16_t* values, const std::int16_t* column,
+                                                     std::size_t size) noexcept {
+  for (std::size_t i = 0; i < size; i += 8) {
+    auto* target = reinterpret_cast<__m128i*>(values + i);
+    const __m128i weights = _mm_loadu_si128(reinterpret_cast<const __m128i*>(column + i));
+    _mm_storeu_si128(target, _mm_add_epi16(_mm_loadu_si128(target), weights));
+  }
+}
+
+__attribute__((target("sse2"))) void sub_column_sse2(std::int16_t* values, const std::int16_t* column,
+                                                     std::size_t size) noexcept {
+  for (std::size_t i = 0; i < size; i += 8) {
+    auto* target = reinterpret_cast<__m128i*>(values + i);
+    const __m128i weights = _mm_loadu_si128(reinterpret_cast<const __m128i*>(column + i));
+    _mm_storeu_si128(target, _mm_sub_epi16(_mm_loadu_si128(target), weights));
+  }
+}
+
+__attribute__((target("avx2"))) void add_column_avx2(std::int16_t* values, const std::int16_t* column,
+                                                     std::size_t size) noexcept {
+  for (std::size_t i = 0; i < size; i += 16) {
+    auto* target = reinterpret_cast<__m256i*>(values + i);
+    const __m256i weights = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(column + i));
+    _mm256_storeu_si256(target, _mm256_add_epi16(_mm256_loadu_si256(target), weights));
+  }
+}
+
+__attribute__((target("avx2"))) void sub_column_avx2(std::int16_t* values, const std::int16_t* column,
+                                                     std::size_t size) noexcept {
+  for (std::size_t i = 0; i < size; i += 16) {
+    auto* target = reinterpret_cast<__m256i*>(values + i);
+    const __m256i weights = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(column + i));
+    _mm256_storeu_si256(target, _mm256_sub_epi16(_mm256_loadu_si256(target), weights));
+  }
+}
+
+// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+
+#endif
+
+}  // namespace
+
+std::int32_t Nnue::clipped_dot(Simd::Level level, const std::int16_t* values, const std::int8_t* weights,
+                               std::size_t size) noexcept {
+  switch (level) {
+#ifdef BITBISHOP_SIMD_X86
+    case Simd::Level::Avx2:
+      return clipped_dot_avx2(values, weights, size);
+    case Simd::Level::Sse2:
+      return clipped_dot_sse2(values, weights, size);
+#endif
+    default:
+      return clipped_dot_scalar(values, weights, size);
+  }
+}
+
+void Nnue::add_column(Simd::Level level, std::int16_t* values, const std::int16_t* column, std::size_t size) noexcept {
+  switch (level) {
+#ifdef BITBISHOP_SIMD_X86
+    case Simd::Level::Avx2:
+      add_column_avx2(values, column, size);
+      break;
+    case Simd::Level::Sse2:
+      add_column_sse2(values, column, size);
+      break;
+#endif
+    default:
+      add_column_scalar(values, column, size);
+  }
+}
+
+void Nnue::sub_column(Simd::Level level, std::int16_t* values, const std::int16_t* column, std::size_t size) noexcept {
+  switch (level) {
+#ifdef BITBISHOP_SIMD_X86
+    case Simd::Level::Avx2:
+      sub_column_avx2(values, column, size);
+      break;
+    case Simd::Level::Sse2:
+      sub_column_sse2(values, column, size);
+      break;
+#endif
+    default:
+      sub_column_scalar(values, column, size);
+  }
+}
@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <bit>
+#include <bitbishop/bitmasks.hpp>
+#include <bitbishop/engine/eval_tables.hpp>
+#include <bitbishop/engine/pawn_structure.hpp>
+#include <cassert>
+
+namespace {
+
+// https://www.chessprogramming.org/Pawn_Fills
+
+Bitboard north_fill(Bitboard bb) {
+  bb |= bb << 8;   // NOLINT(readability-magic-numbers)
+  bb |= bb << 16;  // NOLINT(readability-magic-numbers)
+  bb |= bb << 32;  // NOLINT(readability-magic-numbers)
+  return bb;
+}
+
+Bitboard south_fill(Bitboard bb) {
+  bb |= bb >> 8;   // NOLINT(readability-magic-numbers)
+  bb |= bb >> 16;  // NOLINT(readability-magic-numbers)
+  bb |= bb >> 32;  // NOLINT(readability-magic-numbers)
+  return bb;
+}
+
+Bitboard east_one(Bitboard bb) { return (bb & ~Bitboard(Bitmasks::FILE_H)) << 1; }
+
+Bitboard west_one(Bitboard bb) { return (bb & ~Bitboard(Bitmasks::FILE_A)) >> 1; }
+
+Bitboard forward_fill(Bitboard bb, Color side) { return side == Color::WHITE ? north_fill(bb) : south_fill(bb); }
+
+Bitboard forward_one(Bitboard bb, Color side) {
+  return side == Color::WHITE ? bb << Const::BOARD_WIDTH : bb >> Const::BOARD_WIDTH;
+}
+
+Bitboard pawn_attacks(Bitboard pawns, Color side) {
+  const Bitboard pushed = forward_one(pawns, side);
+  return east_one(pushed) | west_one(pushed);
+}
+
+/**
+ * Squares strictly in front of the pawns, on their own file.
+ */
+Bitboard front_span(Bitboard pawns, Color side) { return forward_fill(forward_one(pawns, side), side); }
+
+/**
+ * Evaluates the pawns of `side`, filling its passed pawns mask.
+ */
+Eval::Score evaluate_side(const Board& board, Color side, Bitboard& passed) {
+  using namespace Eval;
+
+  const PawnTerms terms = find_pawn_terms(board, side);
+
+  Score score = 0;
+  score += DOUBLED_PAWN_PENALTY * terms.doubled.count();
+  score += ISOLATED_PAWN_PENALTY * terms.isolated.count();
+  score += BACKWARD_PAWN_PENALTY * terms.backward.count();
+  for (const Square square : terms.passed) {
+    score += PASSED_PAWN_BONUS[relative_rank(square, side)];
+  }
+
+  passed = terms.passed;
+  return score;
+}
+
+}  // namespace
+
+Eval::PawnTerms Eval::find_pawn_terms(const Board& board, Color side) noexcept {
+  const Color enemy = ColorUtil::opposite(side);
+  const Bitboard pawns = board.pawns(side);
+  const Bitboard enemy_pawns = board.pawns(enemy);
+
+  PawnTerms terms;
+
+  // Pawns with a friendly pawn in front of them
+  const Bitboard own_front_span = front_span(pawns, side);
+  terms.doubled = pawns & own_front_span;
+
+  // Pawns without friendly pawns on adjacent files
+  const Bitboard adjacent = east_one(pawns) | west_one(pawns);
+  const Bitboard adjacent_files = north_fill(adjacent) | south_fill(adjacent);
+  terms.isolated = pawns & ~adjacent_files;
+
+  // Pawns whose stop square is attacked by an enemy pawn and out of reach of every friendly pawn attack
+  const Bitboard support_span = forward_fill(pawn_attacks(pawns, side), side);
+  const Bitboard enemy_attacks = pawn_attacks(enemy_pawns, enemy);
+  terms.backward = forward_one(pawns, side) & enemy_attacks & ~support_span;
+
+  // Front-most pawns with no enemy pawn in front of them, on the same or adjacent files
+  const Bitboard enemy_front = front_span(enemy_pawns, enemy);
+  const Bitboard blocked = enemy_front | east_one(enemy_front) | west_one(enemy_front);
+  terms.passed = pawns & ~blocked & ~terms.doubled;
+
+  return terms;
+}
+
+Eval::PawnEntry Eval::evaluate_pawn_structure(const Board& board) noexcept {
+  PawnEntry entry;
+  entry.key = board.get_pawn_hash();
+
+  const Score white = evaluate_side(board, Color::WHITE, entry.passed[ColorUtil::to_index(Color::WHITE)]);
+  const Score black = evaluate_side(board, Color::BLACK, entry.passed[ColorUtil::to_index(Color::BLACK)]);
+  entry.score = white - black;
+
+  return entry;
+}
+
+Eval::PawnHashTable::PawnHashTable(std::size_t size) : entries(size), mask(size - 1) {
+  assert(std::has_single_bit(size));
+}
+
+const Eval::PawnEntry& Eval::PawnHashTable::probe(const Board& board) noexcept {
+  const Zobrist::Key key = board.get_pawn_hash();
+  PawnEntry& entry = entries[key & mask];
+
+  probes_count++;
+  // A null key (no pawns at all) is also the key of empty slots: the empty evaluation stored there is correct.
+  if (entry.key == key) {
+    hits_count++;
+    return entry;
+  }
+
+  entry = evaluate_pawn_structure(board);
+  return entry;
+}
+
+void Eval::PawnHashTable::clear() noexcept {
+  std::fill(entries.begin(), entries.end(), PawnEntry{});
+  probes_count = 0;
+  hits_count = 0;
+}
+
+Eval::PawnHashTable& Eval::thread_pawn_hash_table() noexcept { return thread_tables().pawn_table; }
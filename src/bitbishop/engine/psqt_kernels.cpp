@@ -0,0 +1,111 @@
+#include <array>
+#include <bitbishop/engine/evaluation.hpp>
+
+#ifdef BITBISHOP_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using namespace Eval;
+
+using PieceBitboards = std::array<std::uint64_t, Piece::DISTINCT_PIECES_COUNT>;
+
+/**
+ * The 12 piece bitboards of a board, in Zobrist::piece_index() order (the order of PIECE_SQUARE_SCORES).
+ */
+PieceBitboards piece_bitboards(const Board& board) noexcept {
+  const Color W = Color::WHITE;
+  const Color B = Color::BLACK;
+  return {
+      board.pawns(W).value(), board.knights(W).value(), board.bishops(W).value(),
+      board.rooks(W).value(), board.queens(W).value(),  board.king(W).value(),
+      board.pawns(B).value(), board.knights(B).value(), board.bishops(B).value(),
+      board.rooks(B).value(), board.queens(B).value(),  board.king(B).value(),
+  };
+}
+
+/**
+ * Portable kernel: one lookup per piece on board in the combined material + piece-square table.
+ */
+Score compute_psqt_score_scalar(const Board& board) noexcept {
+  const PieceBitboards bitboards = piece_bitboards(board);
+  Score score = 0;
+  for (std::size_t p_ind = 0; p_ind < Piece::DISTINCT_PIECES_COUNT; ++p_ind) {
+    const auto& scores = PIECE_SQUARE_SCORES[p_ind];
+    for (const Square square : Bitboard(bitboards[p_ind])) {
+      score += scores[square.flat_index()];
+    }
+  }
+  return score;
+}
+
+#ifdef BITBISHOP_SIMD_X86
+
+/**
+ * Adds the 8 scores of a rank whose square bits are set in `half_bits` to `sum`.
+ */
+__attribute__((target("avx2"), always_inline)) inline __m256i add_rank_scores(__m256i sum, __m256i half_bits,
+                                                                               __m256i rank_bits,
+                                                                               const Score* scores) noexcept {
+  const __m256i mask = _mm256_cmpeq_epi32(_mm256_and_si256(half_bits, rank_bits), rank_bits);
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(scores));
+  return _mm256_add_epi32(sum, _mm256_and_si256(values, mask));
+}
+
+/**
+ * AVX2 kernel: each rank of a piece bitboard is expanded into an 8-lane mask selecting the packed scores of the
+ * occupied squares, summed without data-dependent branches. Empty halves of a bitboard (4 ranks) are skipped.
+ */
+__attribute__((target("avx2"))) Score compute_psqt_score_avx2(const Board& board) noexcept {
+  const std::size_t RANKS_PER_HALF = Const::BOARD_WIDTH / 2;
+  const Score* table = PIECE_SQUARE_SCORES[0].data();
+
+  // Bit of each square of a rank, inside the 32-bit half of the bitboard holding that rank
+  const __m256i rank0 = _mm256_setr_epi32(1 << 0, 1 << 1, 1 << 2, 1 << 3, 1 << 4, 1 << 5, 1 << 6, 1 << 7);
+  const __m256i rank1 = _mm256_slli_epi32(rank0, 8);   // NOLINT(readability-magic-numbers)
+  const __m256i rank2 = _mm256_slli_epi32(rank0, 16);  // NOLINT(readability-magic-numbers)
+  const __m256i rank3 = _mm256_slli_epi32(rank0, 24);  // NOLINT(readability-magic-numbers)
+
+  __m256i sum = _mm256_setzero_si256();
+
+  const PieceBitboards bitboards = piece_bitboards(board);
+  for (std::size_t p_ind = 0; p_ind < Piece::DISTINCT_PIECES_COUNT; ++p_ind) {
+    const std::uint64_t bb = bitboards[p_ind];
+    const Score* scores = table + (p_ind * Const::BOARD_SIZE);
+
+    for (std::size_t half = 0; half < 2; ++half) {
+      const auto half_value = static_cast<std::uint32_t>(bb >> (half * 32));  // NOLINT(readability-magic-numbers)
+      if (half_value == 0) {
+        continue;
+      }
+      const __m256i half_bits = _mm256_set1_epi32(static_cast<int>(half_value));
+      const Score* half_scores = scores + (half * RANKS_PER_HALF * Const::BOARD_WIDTH);
+      sum = add_rank_scores(sum, half_bits, rank0, half_scores);
+      sum = add_rank_scores(sum, half_bits, rank1, half_scores + Const::BOARD_WIDTH);
+      sum = add_rank_scores(sum, half_bits, rank2, half_scores + (2 * Const::BOARD_WIDTH));
+      sum = add_rank_scores(sum, half_bits, rank3, half_scores + (3 * Const::BOARD_WIDTH));
+    }
+  }
+
+  __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+  half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));  // NOLINT(readability-magic-numbers)
+  half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xB1));  // NOLINT(readability-magic-numbers)
+  return _mm_cvtsi128_si32(half);
+}
+
+#endif
+
+}  // namespace
+
+Eval::Score Eval::compute_psqt_score(const Board& board, [[maybe_unused]] Simd::Level level) noexcept {
+#ifdef BITBISHOP_SIMD_X86
+  if (level == Simd::Level::Avx2) {
+    return compute_psqt_score_avx2(board);
+  }
+#endif
+  return compute_psqt_score_scalar(board);
+}
+
+Eval::Score Eval::compute_psqt_score(const Board& board) noexcept { return compute_psqt_score_scalar(board); }
@@ -1,13 +1,35 @@
+#include <algorithm>
+#include <bitbishop/engine/endgame.hpp>
+#include <bitbishop/engine/eval_cache.hpp>
 #include <bitbishop/engine/evaluation.hpp>
+#include <bitbishop/engine/tablebase.hpp>
 #include <bitbishop/engine/search.hpp>
 #include <bitbishop/movegen/legal_moves.hpp>
 #include <bitbishop/moves/position.hpp>
+#include <functional>
+
+namespace {
+
+/**
+ * Whether a node must stop searching, raising the stop flag once the node limit is reached.
+ */
+bool should_stop(const Search::SearchStats& stats, std::atomic<bool>* stop_flag) {
+  if (stop_flag == nullptr) {
+    return false;
+  }
+  if (stats.node_limit != 0 && stats.negamax_nodes + stats.quiescence_nodes >= stats.node_limit) {
+    stop_flag->store(true);
+  }
+  return stop_flag->load();
+}
+
+}  // namespace
 
 // https://www.chessprogramming.org/Quiescence_Search
 int Search::quiesce(Position& position, int alpha, int beta, SearchStats& stats, std::atomic<bool>* stop_flag) {
   stats.quiescence_nodes++;
 
-  if (stop_flag != nullptr && stop_flag->load()) {
+  if (should_stop(stats, stop_flag)) {
     return alpha;
   }
 
@@ -26,7 +48,9 @@ int Search::quiesce(Position& position, int alpha, int beta, SearchStats& stats,
   }
 
   if (!position.is_in_check()) {
-    int stand_pat = Eval::evaluate(board);
+    // Evaluations favour white, negamax scores favour the side to move
+    const int evaluation = Eval::thread_eval_cache().probe(position);
+    const int stand_pat = (board.get_side_to_move() == Color::WHITE) ? evaluation : -evaluation;
     if (stand_pat >= beta) {
       return beta;
     }
@@ -69,7 +93,7 @@ Search::BestMove Search::negamax(Position& position, std::size_t depth, int alph
   BestMove best;
   std::vector<Move> moves;
 
-  if (stop_flag != nullptr && stop_flag->load()) {
+  if (should_stop(stats, stop_flag)) {
     best.score = 0;
     return best;
   }
@@ -79,11 +103,41 @@ Search::BestMove Search::negamax(Position& position, std::size_t depth, int alph
     return best;
   }
 
+  // The side to move can force a repetition with a single reversible move: a draw is a lower bound of the score.
+  // https://www.chessprogramming.org/Repetitions
+  const bool draw_available = ply > 0 && alpha < 0 && position.has_upcoming_repetition(ply);
+  if (draw_available) {
+    alpha = 0;
+    if (alpha >= beta) {
+      best.score = alpha;
+      return best;
+    }
+  }
+
   if (depth == 0) {
     best.score = quiesce(position, alpha, beta, stats, stop_flag);
     return best;
   }
 
+  // Tablebase positions are solved, whatever the remaining depth
+  if (ply > 0 && board.occupied().count() <= Tablebase::max_pieces()) {
+    if (const std::optional<int> score = Tablebase::probe_score(board, ply)) {
+      stats.tablebase_hits++;
+      best.score = *score;
+      return best;
+    }
+  }
+
+  // Exact endgame knowledge is the result of the line, searching deeper cannot change it
+  if (ply > 0) {
+    const Eval::Endgame* endgame = Eval::find_endgame(board.get_material_key());
+    if (endgame != nullptr && endgame->exact) {
+      const int score = endgame->value(board, endgame->strong);
+      best.score = (board.get_side_to_move() == endgame->strong) ? score : -score;
+      return best;
+    }
+  }
+
   generate_legal_moves(moves, board);
 
   if (board.has_insufficient_material()) {
@@ -105,7 +159,7 @@ Search::BestMove Search::negamax(Position& position, std::size_t depth, int alph
     return best;
   }
 
-  int bestScore = ALPHA_INIT;
+  int bestScore = draw_available ? 0 : ALPHA_INIT;
   for (const Move& move : moves) {
     if (stop_flag != nullptr && stop_flag->load()) {
       best.score = bestScore;
@@ -114,7 +168,8 @@ Search::BestMove Search::negamax(Position& position, std::size_t depth, int alph
     position.apply_move(move);
     // Negamax window flip: child is searched with (-beta, -alpha) and the returned score is negated.
     // This relies on `ALPHA_INIT` not being `INT_MIN` (see `include/bitbishop/engine/search.hpp`).
-    int score = -negamax(position, depth - 1, -beta, -alpha, ply + 1, stats, stop_flag).score;
+    BestMove child = negamax(position, depth - 1, -beta, -alpha, ply + 1, stats, stop_flag);
+    int score = -child.score;
     position.revert_move();
 
     if (stop_flag != nullptr && stop_flag->load()) {
@@ -125,6 +180,9 @@ Search::BestMove Search::negamax(Position& position, std::size_t depth, int alph
     if (score > bestScore) {
       bestScore = score;
       best.move = move;
+      best.pv.clear();
+      best.pv.push_back(move);
+      best.pv.insert(best.pv.end(), child.pv.begin(), child.pv.end());
     }
 
     alpha = std::max(score, alpha);
@@ -138,3 +196,76 @@ Search::BestMove Search::negamax(Position& position, std::size_t depth, int alph
   best.score = bestScore;
   return best;
 }
+
+std::vector<Search::BestMove> Search::search_root(Position& position, std::size_t depth, std::size_t multipv,
+                                                  std::vector<Move>& root_moves, SearchStats& stats,
+                                                  std::atomic<bool>* stop_flag) {
+  if (root_moves.empty() || depth == 0) {
+    return {negamax(position, depth, ALPHA_INIT, BETA_INIT, 0, stats, stop_flag)};
+  }
+
+  stats.negamax_nodes++;
+
+  multipv = std::clamp<std::size_t>(multipv, 1, root_moves.size());
+
+  // Kept lines, sorted by decreasing score, along with the index of their root move.
+  std::vector<BestMove> lines;
+  std::vector<std::size_t> line_indexes;
+  lines.reserve(multipv + 1);
+  line_indexes.reserve(multipv + 1);
+
+  for (std::size_t i = 0; i < root_moves.size(); ++i) {
+    if (stop_flag != nullptr && stop_flag->load()) {
+      break;
+    }
+
+    // Only the worst kept line needs to be beaten once the list is full.
+    const int alpha = (lines.size() < multipv) ? ALPHA_INIT : lines.back().score;
+
+    const Move& move = root_moves[i];
+    position.apply_move(move);
+    BestMove child = negamax(position, depth - 1, -BETA_INIT, -alpha, 1, stats, stop_flag);
+    position.revert_move();
+
+    if (stop_flag != nullptr && stop_flag->load()) {
+      break;
+    }
+
+    const int score = -child.score;
+    if (score <= alpha) {
+      continue;
+    }
+
+    BestMove line{.move = move, .score = score};
+    line.pv.reserve(child.pv.size() + 1);
+    line.pv.push_back(move);
+    line.pv.insert(line.pv.end(), child.pv.begin(), child.pv.end());
+
+    const auto rank = static_cast<std::size_t>(
+        std::ranges::upper_bound(lines, score, std::greater<>{}, &BestMove::score) - lines.begin());
+    lines.insert(lines.begin() + static_cast<std::ptrdiff_t>(rank), std::move(line));
+    line_indexes.insert(line_indexes.begin() + static_cast<std::ptrdiff_t>(rank), i);
+
+    if (lines.size() > multipv) {
+      lines.pop_back();
+      line_indexes.pop_back();
+    }
+  }
+
+  // Move the kept lines to the front, best first, keeping the relative order of the other moves.
+  std::vector<Move> reordered;
+  reordered.reserve(root_moves.size());
+  std::vector<bool> is_line(root_moves.size(), false);
+  for (const std::size_t index : line_indexes) {
+    reordered.push_back(root_moves[index]);
+    is_line[index] = true;
+  }
+  for (std::size_t i = 0; i < root_moves.size(); ++i) {
+    if (!is_line[i]) {
+      reordered.push_back(root_moves[i]);
+    }
+  }
+  root_moves.swap(reordered);
+
+  return lines;
+}
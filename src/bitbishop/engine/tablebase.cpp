@@ -0,0 +1,368 @@
+#include <algorithm>
+#include <atomic>
+#include <bitbishop/engine/nnue.hpp>
+#include <bitbishop/engine/tablebase.hpp>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+using namespace Tablebase;
+
+CX_CONST int FILE_MASK = 7;
+CX_CONST int RANK_MASK = 56;
+CX_CONST int KING_PAIRS_PER_SQUARE = 64;
+CX_CONST int PAWN_SQUARES = 48;  // Ranks 2 to 7
+CX_CONST int HALF_BOARD = 4;
+
+// White king squares of the a1-d1-d4 triangle, and their index
+CX_CONST std::array<int, 10> TRIANGLE_SQUARES = {0, 1, 2, 3, 9, 10, 11, 18, 19, 27};
+const std::array<int, Const::BOARD_SIZE> TRIANGLE_INDEX = [] {
+  std::array<int, Const::BOARD_SIZE> table{};
+  table.fill(-1);
+  for (std::size_t i = 0; i < TRIANGLE_SQUARES.size(); ++i) {
+    table[TRIANGLE_SQUARES[i]] = static_cast<int>(i);
+  }
+  return table;
+}();
+
+// Order of the non-king pieces of one side in layouts and codes
+CX_CONST std::array<Piece::Type, 5> PIECE_ORDER = {Piece::QUEEN, Piece::ROOK, Piece::BISHOP, Piece::KNIGHT,
+                                                   Piece::PAWN};
+
+enum Symmetry : unsigned { MIRROR_FILES = 1, FLIP_RANKS = 2, TRANSPOSE = 4 };
+
+int transform(int square, unsigned symmetry) {
+  if ((symmetry & MIRROR_FILES) != 0) {
+    square ^= FILE_MASK;
+  }
+  if ((symmetry & FLIP_RANKS) != 0) {
+    square ^= RANK_MASK;
+  }
+  if ((symmetry & TRANSPOSE) != 0) {
+    square = ((square & FILE_MASK) << 3) | (square >> 3);
+  }
+  return square;
+}
+
+/**
+ * Symmetry bringing the white king to files a-d, and to the a1-d1-d4 triangle without pawns.
+ */
+unsigned symmetry_of(int white_king, bool has_pawns) {
+  unsigned symmetry = 0;
+  if ((white_king & FILE_MASK) >= HALF_BOARD) {
+    symmetry |= MIRROR_FILES;
+    white_king ^= FILE_MASK;
+  }
+  if (has_pawns) {
+    return symmetry;
+  }
+  if ((white_king >> 3) >= HALF_BOARD) {
+    symmetry |= FLIP_RANKS;
+    white_king ^= RANK_MASK;
+  }
+  if ((white_king >> 3) > (white_king & FILE_MASK)) {
+    symmetry |= TRANSPOSE;
+  }
+  return symmetry;
+}
+
+std::size_t radix_of(Piece piece) { return piece.is_pawn() ? PAWN_SQUARES : Const::BOARD_SIZE; }
+
+/**
+ * Tablebase files of one material signature.
+ */
+struct Table {
+  explicit Table(std::string_view code) : layout(code) {}
+
+  Layout layout;
+  Nnue::MappedFile wdl;
+  Nnue::MappedFile dtm;
+  bool has_dtm = false;
+};
+
+struct Registry {
+  std::vector<std::unique_ptr<Table>> tables;
+  std::unordered_map<Material::Key, std::pair<const Table*, bool>> by_key;  ///< Table and colors flipped
+  std::size_t max_pieces = 0;
+};
+
+// Owner of the loaded tablebases, only touched by load/unload
+std::unique_ptr<Registry> owned_registry;
+
+// Tablebases read by probes
+std::atomic<const Registry*> published_registry{nullptr};
+std::atomic<std::size_t> published_max_pieces{0};
+
+bool open_table_file(Nnue::MappedFile& file, const std::string& path, const std::array<char, 4>& magic,
+                     const Layout& layout, std::size_t data_size) {
+  if (!file.open(path) || file.size() != sizeof(FileHeader) + data_size) {
+    return false;
+  }
+
+  FileHeader header;
+  std::memcpy(&header, file.data(), sizeof(header));
+  return header.magic == magic && header.version == FILE_VERSION && header.positions == layout.size() &&
+         std::string_view(header.code.data()) == layout.code();
+}
+
+struct Lookup {
+  const Table* table = nullptr;
+  std::size_t index = 0;
+};
+
+std::optional<Lookup> find(const Board& board) {
+  const Registry* registry = published_registry.load(std::memory_order_acquire);
+  if (registry == nullptr || board.occupied().count() > registry->max_pieces) {
+    return std::nullopt;
+  }
+
+  // Tablebases know neither castling nor en passant
+  const BoardState state = board.get_state();
+  if (state.m_en_passant_sq.has_value() || state.m_white_castle_kingside || state.m_white_castle_queenside ||
+      state.m_black_castle_kingside || state.m_black_castle_queenside) {
+    return std::nullopt;
+  }
+
+  const auto entry = registry->by_key.find(board.get_material_key());
+  if (entry == registry->by_key.end()) {
+    return std::nullopt;
+  }
+  const auto [table, flipped] = entry->second;
+  return Lookup{.table = table, .index = table->layout.index(board, flipped)};
+}
+
+}  // namespace
+
+Tablebase::Layout::Layout(std::string_view code) {
+  const std::size_t separator = code.find('v');
+  if (separator == std::string_view::npos || std::ranges::count(code, 'K') != 2 ||
+      code.substr(0, separator).find('K') == std::string_view::npos) {
+    throw std::invalid_argument("tablebase code needs one king per side");
+  }
+  if (code.size() - 1 > MAX_PIECES) {
+    throw std::invalid_argument("tablebase code with too many pieces");
+  }
+
+  m_key = Material::from_code(code);
+  m_code = code_of(m_key);
+
+  m_pieces = {Piece(Piece::KING, Color::WHITE), Piece(Piece::KING, Color::BLACK)};
+  for (const Color color : {Color::WHITE, Color::BLACK}) {
+    for (const Piece::Type type : PIECE_ORDER) {
+      const Piece piece(type, color);
+      for (int i = 0; i < Material::count(m_key, piece); ++i) {
+        m_pieces.push_back(piece);
+        m_has_pawns |= piece.is_pawn();
+      }
+    }
+  }
+
+  m_size = (m_has_pawns ? HALF_BOARD * Const::BOARD_WIDTH : TRIANGLE_SQUARES.size()) * KING_PAIRS_PER_SQUARE *
+           ColorUtil::SIZE;
+  for (std::size_t slot = 2; slot < m_pieces.size(); ++slot) {
+    m_size *= radix_of(m_pieces[slot]);
+  }
+}
+
+std::string Tablebase::Layout::code_of(Material::Key key) {
+  std::string code;
+  for (const Color color : {Color::WHITE, Color::BLACK}) {
+    code += color == Color::WHITE ? "K" : "vK";
+    for (const Piece::Type type : PIECE_ORDER) {
+      const auto count = static_cast<std::size_t>(Material::count(key, Piece(type, color)));
+      code.append(count, Piece::to_char(type, Color::WHITE));
+    }
+  }
+  return code;
+}
+
+std::size_t Tablebase::Layout::index(const Board& board, bool flipped) const {
+  const auto square_of = [flipped](Square square) { return square.flat_index() ^ (flipped ? RANK_MASK : 0); };
+  const auto board_piece = [flipped](Piece piece) {
+    return flipped ? Piece(piece.type(), ColorUtil::opposite(piece.color())) : piece;
+  };
+
+  const unsigned symmetry = symmetry_of(square_of(*board.pieces(board_piece(m_pieces[0])).lsb()), m_has_pawns);
+
+  std::array<int, MAX_PIECES> squares{};
+  for (std::size_t slot = 0; slot < m_pieces.size();) {
+    const std::size_t first = slot;
+    for (const Square square : board.pieces(board_piece(m_pieces[first]))) {
+      squares[slot++] = transform(square_of(square), symmetry);
+    }
+    std::sort(squares.begin() + static_cast<std::ptrdiff_t>(first),
+              squares.begin() + static_cast<std::ptrdiff_t>(slot));
+  }
+
+  const Color side_to_move = flipped ? ColorUtil::opposite(board.get_side_to_move()) : board.get_side_to_move();
+  const int white_king = squares[0];
+  const int king_square_index = m_has_pawns ? ((white_king >> 3) * HALF_BOARD) + (white_king & FILE_MASK)
+                                            : TRIANGLE_INDEX[white_king];
+
+  std::size_t index = (static_cast<std::size_t>(king_square_index) * KING_PAIRS_PER_SQUARE) + squares[1];
+  index = (index * ColorUtil::SIZE) + (side_to_move == Color::WHITE ? 0 : 1);
+  for (std::size_t slot = 2; slot < m_pieces.size(); ++slot) {
+    const int digit = m_pieces[slot].is_pawn() ? squares[slot] - Const::BOARD_WIDTH : squares[slot];
+    index = (index * radix_of(m_pieces[slot])) + static_cast<std::size_t>(digit);
+  }
+  return index;
+}
+
+bool Tablebase::Layout::decode(std::size_t index, std::array<int, MAX_PIECES>& flat, Color& side_to_move) const {
+  for (std::size_t slot = m_pieces.size() - 1; slot >= 2; --slot) {
+    const std::size_t radix = radix_of(m_pieces[slot]);
+    const auto digit = static_cast<int>(index % radix);
+    flat[slot] = m_pieces[slot].is_pawn() ? digit + Const::BOARD_WIDTH : digit;
+    index /= radix;
+  }
+
+  side_to_move = (index % ColorUtil::SIZE == 0) ? Color::WHITE : Color::BLACK;
+  index /= ColorUtil::SIZE;
+  flat[1] = static_cast<int>(index % KING_PAIRS_PER_SQUARE);
+  const auto king_square_index = static_cast<int>(index / KING_PAIRS_PER_SQUARE);
+  flat[0] = m_has_pawns ? ((king_square_index / HALF_BOARD) * Const::BOARD_WIDTH) + (king_square_index % HALF_BOARD)
+                        : TRIANGLE_SQUARES[static_cast<std::size_t>(king_square_index)];
+
+  for (std::size_t slot = 0; slot < m_pieces.size(); ++slot) {
+    for (std::size_t other = 0; other < slot; ++other) {
+      if (flat[slot] == flat[other]) {
+        return false;
+      }
+    }
+    if (slot > 0 && m_pieces[slot] == m_pieces[slot - 1] && flat[slot] < flat[slot - 1]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::size_t Tablebase::load(const std::string& directory) {
+  auto registry = std::make_unique<Registry>();
+
+  std::error_code error;
+  for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+    if (entry.path().extension() != WDL_EXTENSION) {
+      continue;
+    }
+
+    std::unique_ptr<Table> table;
+    try {
+      table = std::make_unique<Table>(entry.path().stem().string());
+    } catch (const std::invalid_argument&) {
+      continue;
+    }
+    const std::size_t positions = table->layout.size();
+    if (!open_table_file(table->wdl, entry.path().string(), WDL_MAGIC, table->layout, (positions + 3) / 4)) {
+      continue;
+    }
+    std::filesystem::path dtm_path = entry.path();
+    dtm_path.replace_extension(DTM_EXTENSION);
+    table->has_dtm = open_table_file(table->dtm, dtm_path.string(), DTM_MAGIC, table->layout, positions);
+
+    const Material::Key key = table->layout.key();
+    registry->by_key[key] = {table.get(), false};
+    if (Material::mirror(key) != key) {
+      registry->by_key[Material::mirror(key)] = {table.get(), true};
+    }
+    registry->max_pieces = std::max(registry->max_pieces, table->layout.pieces().size());
+    registry->tables.push_back(std::move(table));
+  }
+
+  const std::size_t count = registry->tables.size();
+  unload();
+  if (count > 0) {
+    published_max_pieces.store(registry->max_pieces);
+    published_registry.store(registry.get(), std::memory_order_release);
+    owned_registry = std::move(registry);
+  }
+  return count;
+}
+
+void Tablebase::unload() {
+  published_max_pieces.store(0);
+  published_registry.store(nullptr, std::memory_order_release);
+  owned_registry.reset();
+}
+
+std::size_t Tablebase::max_pieces() noexcept { return published_max_pieces.load(std::memory_order_relaxed); }
+
+std::optional<Tablebase::Wdl> Tablebase::probe_wdl(const Board& board) noexcept {
+  const std::optional<Lookup> lookup = find(board);
+  if (!lookup) {
+    return std::nullopt;
+  }
+
+  const auto byte = static_cast<unsigned>(lookup->table->wdl.data()[sizeof(FileHeader) + (lookup->index / 4)]);
+  const auto wdl = static_cast<Wdl>((byte >> (2 * (lookup->index % 4))) & 3U);
+  return wdl == Wdl::Illegal ? std::nullopt : std::optional<Wdl>(wdl);
+}
+
+std::optional<int> Tablebase::probe_dtm(const Board& board) noexcept {
+  const std::optional<Lookup> lookup = find(board);
+  if (!lookup || !lookup->table->has_dtm) {
+    return std::nullopt;
+  }
+
+  const auto code = static_cast<std::uint8_t>(lookup->table->dtm.data()[sizeof(FileHeader) + lookup->index]);
+  if (code == DTM_DRAW) {
+    return -1;
+  }
+  return is_mate_distance(code) ? std::optional<int>(dtm_plies(code)) : std::nullopt;
+}
+
+std::optional<int> Tablebase::probe_score(const Board& board, int ply) noexcept {
+  if (const std::optional<int> plies = probe_dtm(board)) {
+    if (*plies < 0) {
+      return 0;
+    }
+    const int score = Eval::MATE_SCORE - ply - *plies;
+    return (*plies % 2 == 1) ? score : -score;
+  }
+
+  const std::optional<Wdl> wdl = probe_wdl(board);
+  if (!wdl) {
+    return std::nullopt;
+  }
+  switch (*wdl) {
+    case Wdl::Win:
+      return WIN_SCORE - ply;
+    case Wdl::Loss:
+      return -(WIN_SCORE - ply);
+    default:
+      return 0;
+  }
+}
+
+bool Tablebase::filter_root_moves(Position& position, std::vector<Move>& moves) {
+  const Board& board = position.get_board();
+  if (moves.empty() || !probe_wdl(board)) {
+    return false;
+  }
+
+  std::vector<int> scores;
+  scores.reserve(moves.size());
+  for (const Move& move : moves) {
+    position.apply_move(move);
+    const std::optional<int> child = board.has_insufficient_material() ? 0 : probe_score(board, 1);
+    position.revert_move();
+    if (!child) {
+      return false;
+    }
+    scores.push_back(-*child);
+  }
+
+  const int best = *std::ranges::max_element(scores);
+  std::vector<Move> kept;
+  for (std::size_t i = 0; i < moves.size(); ++i) {
+    if (scores[i] == best) {
+      kept.push_back(moves[i]);
+    }
+  }
+  moves = std::move(kept);
+  return true;
+}
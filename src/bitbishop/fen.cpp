@@ -0,0 +1,284 @@
+#include <array>
+#include <bitbishop/board.hpp>
+#include <bitbishop/constants.hpp>
+#include <bitbishop/fen.hpp>
+#include <charconv>
+#include <climits>
+
+namespace {
+
+/** Pieces of each square, indexed like Square, '\0' when empty. */
+using Placement = std::array<char, Const::BOARD_SIZE>;
+
+CX_CONST std::string_view PIECE_CHARACTERS = "PNBRQKpnbrqk";
+
+bool is_space(char character) {
+  return character == ' ' || character == '\t' || character == '\r' || character == '\n';
+}
+
+/**
+ * Cuts the next space-separated field off the front of a text.
+ */
+std::string_view next_field(std::string_view& text) {
+  std::size_t begin = 0;
+  while (begin < text.size() && is_space(text[begin])) {
+    ++begin;
+  }
+  std::size_t end = begin;
+  while (end < text.size() && !is_space(text[end])) {
+    ++end;
+  }
+  const std::string_view field = text.substr(begin, end - begin);
+  text.remove_prefix(end);
+  return field;
+}
+
+std::string_view trim(std::string_view text) {
+  while (!text.empty() && is_space(text.front())) {
+    text.remove_prefix(1);
+  }
+  while (!text.empty() && is_space(text.back())) {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+bool parse_placement(std::string_view field, Placement& placement) {
+  using namespace Const;
+
+  placement.fill('\0');
+  int rank = RANK_8_IND;
+  int file = FILE_A_IND;
+  for (const char character : field) {
+    if (character == '/') {
+      if (file != BOARD_WIDTH || rank == RANK_1_IND) {
+        return false;
+      }
+      --rank;
+      file = FILE_A_IND;
+    } else if (character >= '1' && character <= '8') {
+      file += character - '0';
+      if (file > BOARD_WIDTH) {
+        return false;
+      }
+    } else if (PIECE_CHARACTERS.find(character) != std::string_view::npos && file < BOARD_WIDTH) {
+      placement[(rank * BOARD_WIDTH) + file] = character;
+      ++file;
+    } else {
+      return false;
+    }
+  }
+  return rank == RANK_1_IND && file == BOARD_WIDTH;
+}
+
+bool parse_castling(std::string_view field, BoardState& state) {
+  state.m_white_castle_kingside = false;
+  state.m_white_castle_queenside = false;
+  state.m_black_castle_kingside = false;
+  state.m_black_castle_queenside = false;
+  if (field == "-") {
+    return true;
+  }
+  if (field.empty()) {
+    return false;
+  }
+  for (const char character : field) {
+    bool* right = nullptr;
+    switch (character) {
+      // clang-format off
+      case 'K': right = &state.m_white_castle_kingside;  break;
+      case 'Q': right = &state.m_white_castle_queenside; break;
+      case 'k': right = &state.m_black_castle_kingside;  break;
+      case 'q': right = &state.m_black_castle_queenside; break;
+      default:  return false;
+      // clang-format on
+    }
+    if (*right) {
+      return false;  // Repeated letter
+    }
+    *right = true;
+  }
+  return true;
+}
+
+bool parse_en_passant(std::string_view field, BoardState& state) {
+  using namespace Const;
+
+  if (field == "-") {
+    state.m_en_passant_sq = std::nullopt;
+    return true;
+  }
+  if (field.size() != 2 || field[0] < 'a' || field[0] > 'h' || (field[1] != '3' && field[1] != '6')) {
+    return false;
+  }
+  state.m_en_passant_sq = Square(((field[1] - '1') * BOARD_WIDTH) + (field[0] - 'a'), std::in_place);
+  return true;
+}
+
+bool parse_counter(std::string_view field, int& value) {
+  unsigned parsed = 0;
+  const char* end = field.data() + field.size();
+  const auto [last, error] = std::from_chars(field.data(), end, parsed);
+  if (field.empty() || error != std::errc{} || last != end || parsed > INT_MAX) {
+    return false;
+  }
+  value = static_cast<int>(parsed);
+  return true;
+}
+
+/**
+ * Parses the 4 position fields shared by FEN and EPD, and cuts them off the front of the text.
+ */
+Fen::Error parse_position(std::string_view& text, Placement& placement, BoardState& state) {
+  using Fen::Error;
+
+  if (!parse_placement(next_field(text), placement)) {
+    return Error::Placement;
+  }
+  const std::string_view side = next_field(text);
+  if (side != "w" && side != "b") {
+    return Error::SideToMove;
+  }
+  state.m_is_white_turn = side == "w";
+  if (!parse_castling(next_field(text), state)) {
+    return Error::Castling;
+  }
+  if (!parse_en_passant(next_field(text), state)) {
+    return Error::EnPassant;
+  }
+  state.m_halfmove_clock = 0;
+  state.m_fullmove_number = 1;
+  return Error::None;
+}
+
+void place(const Placement& placement, Board& board) {
+  for (int index = 0; index < Const::BOARD_SIZE; ++index) {
+    if (placement[index] != '\0') {
+      board.set_piece(Square(index, std::in_place), Piece(placement[index]));
+    }
+  }
+}
+
+char* write_counter(char* out, int value) {
+  return std::to_chars(out, out + Fen::COUNTER_MAX_LENGTH, value).ptr;
+}
+
+}  // namespace
+
+std::string_view Fen::error_message(Error error) noexcept {
+  switch (error) {
+    // clang-format off
+    case Error::None:           return "no error";
+    case Error::Placement:      return "invalid piece placement";
+    case Error::SideToMove:     return "invalid side to move";
+    case Error::Castling:       return "invalid castling rights";
+    case Error::EnPassant:      return "invalid en passant square";
+    case Error::HalfmoveClock:  return "invalid halfmove clock";
+    case Error::FullmoveNumber: return "invalid fullmove number";
+    case Error::TrailingText:   return "unexpected text after the fullmove number";
+    // clang-format on
+  }
+  return "unknown error";
+}
+
+Fen::Error Fen::parse(std::string_view fen, Board& board) noexcept {
+  Placement placement;
+  BoardState state{};
+  if (const Error error = parse_position(fen, placement, state); error != Error::None) {
+    return error;
+  }
+  if (const std::string_view halfmove = next_field(fen); !halfmove.empty()) {
+    if (!parse_counter(halfmove, state.m_halfmove_clock)) {
+      return Error::HalfmoveClock;
+    }
+    if (!parse_counter(next_field(fen), state.m_fullmove_number)) {
+      return Error::FullmoveNumber;
+    }
+  }
+  if (!next_field(fen).empty()) {
+    return Error::TrailingText;
+  }
+
+  board.reset(state);
+  place(placement, board);
+  return Error::None;
+}
+
+Fen::Error Fen::parse_epd(std::string_view epd, Board& board, std::string_view& operations) noexcept {
+  Placement placement;
+  BoardState state{};
+  if (const Error error = parse_position(epd, placement, state); error != Error::None) {
+    return error;
+  }
+
+  board.reset(state);
+  place(placement, board);
+  operations = trim(epd);
+  return Error::None;
+}
+
+char* Fen::format_to(char* out, const Board& board) noexcept {
+  using namespace Const;
+
+  // Mailbox from the bitboards, instead of 64 lookups through all of them
+  Placement placement{};
+  for (const Color color : {Color::WHITE, Color::BLACK}) {
+    for (int type = Piece::PAWN; type <= Piece::KING; ++type) {
+      const Piece piece(static_cast<Piece::Type>(type), color);
+      for (const Square square : board.pieces(piece)) {
+        placement[square.flat_index()] = piece.to_char();
+      }
+    }
+  }
+
+  for (int rank = RANK_8_IND; rank >= RANK_1_IND; --rank) {
+    char empty = '0';
+    for (int file = FILE_A_IND; file <= FILE_H_IND; ++file) {
+      const char piece = placement[(rank * BOARD_WIDTH) + file];
+      if (piece == '\0') {
+        ++empty;
+        continue;
+      }
+      if (empty != '0') {
+        *out++ = empty;
+        empty = '0';
+      }
+      *out++ = piece;
+    }
+    if (empty != '0') {
+      *out++ = empty;
+    }
+    if (rank != RANK_1_IND) {
+      *out++ = '/';
+    }
+  }
+
+  const BoardState state = board.get_state();
+  *out++ = ' ';
+  *out++ = state.m_is_white_turn ? 'w' : 'b';
+  *out++ = ' ';
+
+  char* const castling = out;
+  // clang-format off
+  if (state.m_white_castle_kingside)  { *out++ = 'K'; }
+  if (state.m_white_castle_queenside) { *out++ = 'Q'; }
+  if (state.m_black_castle_kingside)  { *out++ = 'k'; }
+  if (state.m_black_castle_queenside) { *out++ = 'q'; }
+  // clang-format on
+  if (out == castling) {
+    *out++ = '-';
+  }
+  *out++ = ' ';
+
+  if (state.m_en_passant_sq) {
+    *out++ = static_cast<char>('a' + state.m_en_passant_sq->file());
+    *out++ = static_cast<char>('1' + state.m_en_passant_sq->rank());
+  } else {
+    *out++ = '-';
+  }
+  *out++ = ' ';
+
+  out = write_counter(out, state.m_halfmove_clock);
+  *out++ = ' ';
+  return write_counter(out, state.m_fullmove_number);
+}
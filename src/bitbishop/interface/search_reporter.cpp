@@ -1,7 +1,46 @@
+#include <bitbishop/engine/evaluation.hpp>
 #include <bitbishop/interface/search_reporter.hpp>
+#include <cstdlib>
 #include <utility>
 
-UciReporter::UciReporter(std::ostream& out) : out_stream(out) {}
+UciReporter::UciReporter(std::ostream& out) : UciReporter(out, Clock::now) {}
+
+UciReporter::UciReporter(std::ostream& out, std::function<Clock::time_point()> now_fn)
+    : now(std::move(now_fn)), out_stream(out), start(now()) {}
+
+void UciReporter::on_iteration(const std::vector<Search::BestMove>& lines, int depth,
+                               const Search::SearchStats& stats) {
+  const uint64_t nodes = stats.negamax_nodes + stats.quiescence_nodes;
+  const auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now() - start).count();
+  const uint64_t nps = (elapsed_ms > 0) ? (nodes * 1000 / static_cast<uint64_t>(elapsed_ms)) : 0;
+
+  for (std::size_t i = 0; i < lines.size(); ++i) {
+    const Search::BestMove& line = lines[i];
+
+    out_stream << "info depth " << depth << " multipv " << (i + 1) << " score ";
+    if (std::abs(line.score) > Eval::MATE_THRESHOLD) {
+      // Mate scores encode the distance in plies, UCI expects it in moves (negative when we are mated).
+      const int plies = Eval::MATE_SCORE - std::abs(line.score);
+      const int moves = (plies + 1) / 2;
+      out_stream << "mate " << ((line.score > 0) ? moves : -moves);
+    } else {
+      out_stream << "cp " << line.score;
+    }
+    out_stream << " nodes " << nodes << " nps " << nps << " time " << elapsed_ms;
+    if (stats.tablebase_hits > 0) {
+      out_stream << " tbhits " << stats.tablebase_hits;
+    }
+
+    if (!line.pv.empty()) {
+      out_stream << " pv";
+      for (const Move& move : line.pv) {
+        out_stream << " " << move.to_uci();
+      }
+    }
+    out_stream << "\n";
+  }
+  out_stream << std::flush;
+}
 
 void UciReporter::on_finish(const Search::BestMove& best, const Search::SearchStats& stats) {
   const std::string best_move_str = (best.move) ? (*best.move).to_uci() : "0000";
@@ -23,7 +62,19 @@ void BenchReporter::on_finish(const Search::BestMove& best, const Search::Search
   uint64_t total = stats.negamax_nodes + stats.quiescence_nodes;
   uint64_t nps = (seconds > 0.0) ? static_cast<uint64_t>(static_cast<double>(total) / seconds) : 0;
 
+  const double pawn_hash_hit_rate =
+      (stats.pawn_hash_probes > 0)
+          ? 100.0 * static_cast<double>(stats.pawn_hash_hits) / static_cast<double>(stats.pawn_hash_probes)
+          : 0.0;
+  const double eval_cache_hit_rate =
+      (stats.eval_cache_probes > 0)
+          ? 100.0 * static_cast<double>(stats.eval_cache_hits) / static_cast<double>(stats.eval_cache_probes)
+          : 0.0;
+
   out_stream << "bench nodes " << total << " negamax_nodes " << stats.negamax_nodes << " quiescence_nodes "
-             << stats.quiescence_nodes << " time(s) " << seconds << "s" << " nps " << nps << "\n"
+             << stats.quiescence_nodes << " time(s) " << seconds << "s" << " nps " << nps << " pawn_hash_probes "
+             << stats.pawn_hash_probes << " pawn_hash_hit_rate " << pawn_hash_hit_rate << "%"
+             << " eval_cache_probes " << stats.eval_cache_probes << " eval_cache_hit_rate " << eval_cache_hit_rate
+             << "%\n"
              << std::flush;
 }
@@ -1,39 +1,96 @@
 #include <bitbishop/interface/search_session.hpp>
 
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <exception>
+#include <thread>
+#include <utility>
+
+struct Uci::SearchSession::BenchRun {
+  Tools::BenchOptions options;
+  BenchReporter reporter;
+  std::atomic<bool> stop_flag{false};
+  std::atomic<bool> finished{false};
+  Tools::BenchResult result;
+  std::exception_ptr error;
+  std::thread thread;
+
+  BenchRun(const Tools::BenchOptions& options, std::ostream& out) : options(options), reporter(out) {}
+};
 
 Uci::SearchSession::SearchSession(std::ostream& out_stream)
-    : out_stream(out_stream), worker(nullptr), reporter(nullptr) {}
+    : out_stream(out_stream),
+      worker(nullptr),
+      reporter(nullptr),
+      tables(std::make_unique<Eval::ThreadTables>()),
+      book_seed(static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count())) {}
 
 Uci::SearchSession::~SearchSession() { stop_and_join(); }
 
-void Uci::SearchSession::start_go(Board board, SearchLimits limits) {
+void Uci::SearchSession::start_go(Board board, SearchLimits limits, SearchOptions options,
+                                  std::vector<Zobrist::Key> zobrist_history) {
   stop_and_join();
 
+  if (options.own_book && !limits.infinite) {
+    if (const std::optional<Move> move = book.pick(board, Random::splitmix64(book_seed))) {
+      out_stream << "info string book move " << move->to_uci() << "\n";
+      UciReporter(out_stream).on_finish(Search::BestMove{.move = move}, Search::SearchStats{});
+      return;
+    }
+  }
+
   reporter = std::make_unique<UciReporter>(out_stream);
-  worker = std::make_unique<SearchWorker>(board, limits);
+  worker = std::make_unique<SearchWorker>(board, limits, options, std::move(zobrist_history), tables.get());
   assert(worker != nullptr);
   worker->start();
 }
 
-void Uci::SearchSession::start_bench(Board board, SearchLimits limits) {
+void Uci::SearchSession::start_bench(const Tools::BenchOptions& options) {
   stop_and_join();
 
-  if (limits.infinite) {
-    limits.depth = 10;  // NOLINT(readability-magic-numbers)
-    limits.infinite = false;
+  bench = std::make_unique<BenchRun>(options, out_stream);
+  bench->thread = std::thread([run = bench.get()]() {
+    try {
+      run->result = Tools::run_bench(run->options, &run->stop_flag);
+    } catch (...) {
+      run->error = std::current_exception();
+    }
+    run->finished = true;
+  });
+}
+
+void Uci::SearchSession::finish_bench() {
+  if (!bench) {
+    return;
   }
+  bench->thread.join();
 
-  reporter = std::make_unique<BenchReporter>(out_stream);
-  worker = std::make_unique<SearchWorker>(board, limits);
-  assert(worker != nullptr);
-  worker->start();
+  if (bench->error) {
+    try {
+      std::rethrow_exception(bench->error);
+    } catch (const std::exception& error) {
+      out_stream << "info string bench failed: " << error.what() << "\n";
+    }
+  }
+  const std::vector<std::uint64_t>& nodes = bench->result.position_nodes;
+  for (std::size_t index = 0; index < nodes.size(); ++index) {
+    out_stream << "info string bench position " << index + 1 << "/" << nodes.size() << " nodes " << nodes[index]
+               << "\n";
+  }
+  out_stream << "info string bench depth " << bench->options.depth << " threads " << bench->options.threads
+             << (bench->result.complete ? "" : " interrupted") << "\n";
+  bench->reporter.on_finish(Search::BestMove{}, bench->result.stats);
+  bench.reset();
 }
 
 void Uci::SearchSession::request_stop() {
   if (worker) {
     worker->request_stop();
   }
+  if (bench) {
+    bench->stop_flag = true;
+  }
 }
 
 void Uci::SearchSession::emit_reports() {
@@ -44,7 +101,7 @@ void Uci::SearchSession::emit_reports() {
   const auto reports = worker->drain_reports();
   for (const SearchReport& report : reports) {
     if (report.kind == SearchReportKind::Iteration) {
-      reporter->on_iteration(report.best, report.depth, report.stats);
+      reporter->on_iteration(report.lines, report.depth, report.stats);
     } else if (report.kind == SearchReportKind::Finish) {
       reporter->on_finish(report.best, report.stats);
     }
@@ -52,6 +109,9 @@ void Uci::SearchSession::emit_reports() {
 }
 
 void Uci::SearchSession::finalize_if_done() {
+  if (bench && bench->finished) {
+    finish_bench();
+  }
   if (!worker || !worker->is_finished()) {
     return;
   }
@@ -68,6 +128,10 @@ void Uci::SearchSession::poll() {
 }
 
 void Uci::SearchSession::stop_and_join() {
+  if (bench) {
+    bench->stop_flag = true;
+    finish_bench();
+  }
   if (worker) {
     worker->stop();
     emit_reports();
@@ -75,3 +139,8 @@ void Uci::SearchSession::stop_and_join() {
   }
   reporter.reset();
 }
+
+void Uci::SearchSession::clear_tables() {
+  stop_and_join();
+  tables->clear();
+}
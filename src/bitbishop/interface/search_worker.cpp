@@ -1,7 +1,11 @@
 #include <algorithm>
+#include <bitbishop/engine/pawn_structure.hpp>
+#include <bitbishop/engine/tablebase.hpp>
 #include <bitbishop/interface/search_worker.hpp>
+#include <bitbishop/movegen/legal_moves.hpp>
 #include <bitbishop/tools/time_guard.hpp>
 #include <limits>
+#include <utility>
 
 namespace {
 
@@ -52,12 +56,16 @@ Uci::SearchLimits Uci::SearchLimits::from_uci_cmd(const std::vector<std::string>
       read(limits.winc);
     } else if (tok == "binc") {
       read(limits.binc);
+    } else if (tok == "nodes") {
+      if (i + 1 < line.size()) {
+        limits.nodes = std::stoull(line[++i]);
+      }
     } else if (tok == "infinite") {
       limits.infinite = true;
     }
   }
 
-  if (!limits.depth && !limits.has_time_limit() && !limits.infinite) {
+  if (!limits.depth && !limits.nodes && !limits.has_time_limit() && !limits.infinite) {
     limits.infinite = true;
   }
 
@@ -82,8 +90,13 @@ std::optional<int> Uci::SearchLimits::think_time_ms(Color side_to_move) const {
   return estimate_clock_think_time_ms(*remaining_opt, increment_opt.value_or(0));
 }
 
-Uci::SearchWorker::SearchWorker(Board board, SearchLimits limits)
-    : board(board), position(Position(this->board)), limits(limits) {}
+Uci::SearchWorker::SearchWorker(Board board, SearchLimits limits, SearchOptions options,
+                                std::vector<Zobrist::Key> zobrist_history, Eval::ThreadTables* tables)
+    : board(board),
+      position(Position(this->board, std::move(zobrist_history))),
+      limits(limits),
+      options(options),
+      tables(tables) {}
 
 Uci::SearchWorker::~SearchWorker() { stop(); }
 
@@ -103,7 +116,16 @@ void Uci::SearchWorker::run() {
     ~FinishGuard() { finished_ref.store(true); }
   } guard{finished};
 
+  const Nnue::SearchGuard network_guard;
+  std::optional<Eval::ThreadTablesScope> tables_scope;
+  if (tables != nullptr) {
+    tables_scope.emplace(*tables);
+  }
+
   SearchStats stats{};
+  if (limits.nodes && !limits.infinite) {
+    stats.node_limit = std::max<std::uint64_t>(*limits.nodes, 1);
+  }
   SearchReport current_best_report{.kind = SearchReportKind::Iteration};
 
   const auto side = board.get_side_to_move();
@@ -113,11 +135,29 @@ void Uci::SearchWorker::run() {
     timeguard.emplace(stop_flag, std::chrono::milliseconds(*think_time));
   }
 
-  auto perform_search_at_depth = [&](int depth) {
-    auto result = negamax(position, depth, ALPHA_INIT, BETA_INIT, 0, stats, &stop_flag);
+  // Tables owned by the caller are kept warm between searches: only count this search's probes.
+  const Eval::PawnHashTable& pawn_table = Eval::thread_pawn_hash_table();
+  const uint64_t pawn_probes_at_start = pawn_table.probes();
+  const uint64_t pawn_hits_at_start = pawn_table.hits();
+  const Eval::EvalCache& eval_cache = Eval::thread_eval_cache();
+  const uint64_t eval_probes_at_start = eval_cache.probes();
+  const uint64_t eval_hits_at_start = eval_cache.hits();
+
+  // Root moves are generated once and reordered by every iteration, best lines first.
+  std::vector<Move> root_moves;
+  generate_legal_moves(root_moves, board);
+  Tablebase::filter_root_moves(position, root_moves);
 
-    if (!stop_flag.load()) {
-      current_best_report.best = result;
+  auto perform_search_at_depth = [&](int depth) {
+    auto lines = search_root(position, depth, options.multipv, root_moves, stats, &stop_flag);
+    stats.pawn_hash_probes = pawn_table.probes() - pawn_probes_at_start;
+    stats.pawn_hash_hits = pawn_table.hits() - pawn_hits_at_start;
+    stats.eval_cache_probes = eval_cache.probes() - eval_probes_at_start;
+    stats.eval_cache_hits = eval_cache.hits() - eval_hits_at_start;
+
+    if (!stop_flag.load() && !lines.empty()) {
+      current_best_report.best = lines.front();
+      current_best_report.lines = std::move(lines);
       current_best_report.depth = depth;
       current_best_report.stats = stats;
       push_report(current_best_report);
@@ -126,18 +166,24 @@ void Uci::SearchWorker::run() {
     return false;
   };
 
-  if (limits.depth && !limits.infinite && !think_time) {
+  if (limits.depth && !limits.infinite && !think_time && stats.node_limit == 0) {
     // Case: Fixed depth search (e.g., "go depth 10")
     perform_search_at_depth(*limits.depth);
   } else {
-    // Case: Iterative deepening (Infinite or Time-limited)
-    for (int depth = 1; depth <= MAX_DEPTH && !stop_flag.load(); ++depth) {
+    // Case: Iterative deepening (Infinite, Time-limited or Node-limited)
+    const int max_depth = stats.node_limit != 0 && !think_time ? limits.depth.value_or(MAX_DEPTH) : MAX_DEPTH;
+    for (int depth = 1; depth <= max_depth && !stop_flag.load(); ++depth) {
       if (!perform_search_at_depth(depth)) {
         break;
       }
     }
   }
 
+  // A search stopped before its first iteration completed still has to play a legal move
+  if (!current_best_report.best.move && !root_moves.empty()) {
+    current_best_report.best.move = root_moves.front();
+  }
+
   current_best_report.kind = SearchReportKind::Finish;
   push_report(current_best_report);
 }
@@ -1,6 +1,28 @@
 #include <BitBishop.h>
 
+#include <algorithm>
+#include <bitbishop/engine/nnue.hpp>
+#include <bitbishop/engine/tablebase.hpp>
 #include <bitbishop/interface/uci_engine.hpp>
+#include <cctype>
+
+namespace {
+
+/**
+ * Parses a UCI move, deriving from the board what the notation leaves implicit: a castling is a king move, an en
+ * passant capture is a pawn move onto the en passant square.
+ */
+Move parse_move(const Board& board, const std::string& text) {
+  Move move = Move::from_uci(text);
+  const std::optional<Piece> piece = board.get_piece(move.from);
+  move.is_castling = move.is_castling && piece && piece->is_king();
+  move.is_en_passant =
+      piece && piece->is_pawn() && move.from.file() != move.to.file() && board.en_passant_square() == move.to;
+  move.is_capture = board.get_piece(move.to).has_value() || move.is_en_passant;
+  return move;
+}
+
+}  // namespace
 
 [[nodiscard]] std::vector<std::string> Uci::split(const std::string &str) {
   std::vector<std::string> tokens;
@@ -71,6 +93,8 @@ void Uci::UciEngine::register_handlers() {
     (void)line;
     handle_new_game();
   });
+  command_registry.register_handler("setoption",
+                                    [this](const std::vector<std::string>& line) { handle_setoption(line); });
   command_registry.register_handler("position",
                                     [this](const std::vector<std::string>& line) { handle_position(line); });
   command_registry.register_handler("go", [this](const std::vector<std::string>& line) { handle_go(line); });
@@ -96,18 +120,93 @@ void Uci::UciEngine::register_handlers() {
 void Uci::UciEngine::handle_uci() {
   out_stream << "id name " << BITBISHOP_PROJECT_NAME << "\n"
              << "id author Hardcode (Baptiste Penot)\n"
+             << "option name MultiPV type spin default " << SearchOptions::MIN_MULTIPV << " min "
+             << SearchOptions::MIN_MULTIPV << " max " << SearchOptions::MAX_MULTIPV << "\n"
+             << "option name EvalFile type string default <empty>\n"
+             << "option name TablebasePath type string default <empty>\n"
+             << "option name OwnBook type check default false\n"
+             << "option name BookFile type string default <empty>\n"
              << "uciok\n"
              << std::flush;
 }
 
+void Uci::UciEngine::handle_setoption(const std::vector<std::string>& line) {
+  // "setoption name <id> [value <x>]", where <id> and <x> may contain spaces
+  std::string name;
+  std::string value;
+  std::string* target = nullptr;
+  for (std::size_t i = 1; i < line.size(); ++i) {
+    if (line[i] == "name") {
+      target = &name;
+    } else if (line[i] == "value") {
+      target = &value;
+    } else if (target != nullptr) {
+      if (!target->empty()) {
+        *target += " ";
+      }
+      *target += line[i];
+    }
+  }
+
+  std::ranges::transform(name, name.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+  if (name == "multipv") {
+    try {
+      const auto multipv = static_cast<std::size_t>(std::max(std::stoi(value), 0));
+      search_options.multipv = std::clamp(multipv, SearchOptions::MIN_MULTIPV, SearchOptions::MAX_MULTIPV);
+    } catch (const std::exception &) {
+      // invalid values are discarded silently following uci rules
+    }
+  } else if (name == "evalfile") {
+    // the network must not change under a running search, nor leave stale scores in the evaluation cache
+    search_session.clear_tables();
+    if (value.empty() || value == "<empty>") {
+      Nnue::unload_network();
+      out_stream << "info string using hand-crafted evaluation\n" << std::flush;
+    } else if (Nnue::load_network(value)) {
+      out_stream << "info string loaded network " << value << " ("
+                 << Simd::level_name(Nnue::network()->simd) << ")\n"
+                 << std::flush;
+    } else {
+      out_stream << "info string failed to load network " << value << "\n" << std::flush;
+    }
+  } else if (name == "tablebasepath") {
+    // searches read the mapped tablebases without synchronization
+    search_session.stop_and_join();
+    if (value.empty() || value == "<empty>") {
+      Tablebase::unload();
+      out_stream << "info string tablebases disabled\n" << std::flush;
+    } else {
+      const std::size_t count = Tablebase::load(value);
+      out_stream << "info string loaded " << count << " tablebases (up to " << Tablebase::max_pieces()
+                 << " pieces) from " << value << "\n"
+                 << std::flush;
+    }
+  } else if (name == "ownbook") {
+    std::ranges::transform(value, value.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (value == "true" || value == "false") {
+      search_options.own_book = value == "true";
+    }
+  } else if (name == "bookfile") {
+    if (value.empty() || value == "<empty>") {
+      search_session.close_book();
+      out_stream << "info string book disabled\n" << std::flush;
+    } else if (search_session.open_book(value)) {
+      out_stream << "info string loaded book " << value << " (" << search_session.opening_book().size()
+                 << " entries)\n"
+                 << std::flush;
+    } else {
+      out_stream << "info string failed to load book " << value << "\n" << std::flush;
+    }
+  }
+}
+
 void Uci::UciEngine::handle_new_game() {
   board = Board::StartingPosition();
   position.reset();
 }
 
 void Uci::UciEngine::handle_position(const std::vector<std::string>& line) {
-  using namespace Const;
-
   if (line.size() < 2) {
     return;
   }
@@ -118,18 +217,14 @@ void Uci::UciEngine::handle_position(const std::vector<std::string>& line) {
     ++offset;
   } else if (line[offset] == "fen") {  // "position fen ..."
     ++offset;
-    if (line.size() < offset + FEN_NOTATION_COMPONENT_COUNT) {
-      return;
-    }
     std::string fen;
-    fen.reserve(FEN_NOTATION_MAX_CHAR_COUNT);
-    fen += line[offset];
-    for (int i = 1; i < FEN_NOTATION_COMPONENT_COUNT; ++i) {
-      fen += " ";
-      fen += line[offset + i];
+    for (; offset < line.size() && line[offset] != "moves"; ++offset) {
+      fen += line[offset];
+      fen += ' ';
+    }
+    if (Fen::parse(fen, board) != Fen::Error::None) {
+      return;  // Invalid FEN: the position is left as it was
     }
-    offset += FEN_NOTATION_COMPONENT_COUNT;
-    board = Board(fen);
   } else {
     return;
   }
@@ -140,7 +235,7 @@ void Uci::UciEngine::handle_position(const std::vector<std::string>& line) {
     ++offset;
     while (offset < line.size()) {
       try {
-        position.apply_move(Move::from_uci(line[offset]));
+        position.apply_move(parse_move(board, line[offset]));
       } catch (const std::exception &) {
         break;
       }
@@ -151,7 +246,7 @@ void Uci::UciEngine::handle_position(const std::vector<std::string>& line) {
 
 void Uci::UciEngine::handle_go(const std::vector<std::string>& line) {
   SearchLimits limits = SearchLimits::from_uci_cmd(line);
-  search_session.start_go(board, limits);
+  search_session.start_go(board, limits, search_options, position.get_zobrist_history());
 }
 
 void Uci::UciEngine::handle_stop() { search_session.request_stop(); }
@@ -187,6 +282,5 @@ void Uci::UciEngine::send_startup_msg() {
 }
 
 void Uci::UciEngine::handle_bench(const std::vector<std::string>& line) {
-  SearchLimits limits = SearchLimits::from_uci_cmd(line);
-  search_session.start_bench(board, limits);
+  search_session.start_bench(Tools::BenchOptions::from_uci_cmd(line));
 }
@@ -0,0 +1,166 @@
+#include <array>
+#include <bitbishop/constants.hpp>
+#include <bitbishop/lookups/king_attacks.hpp>
+#include <bitbishop/lookups/kpk_bitbase.hpp>
+#include <bitbishop/lookups/pawn_attacks.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using namespace Lookups;
+
+CX_CONST int NORTH = 8;
+CX_CONST int PAWN_RANKS = 6;  // Ranks 2 to 7
+CX_CONST int LAST_PAWN_RANK = 6;
+
+/**
+ * Results of the analysis, as bit flags so the results of all successors can be merged with a single OR.
+ */
+enum Result : std::uint8_t { INVALID = 0, UNKNOWN = 1, DRAW = 2, WIN = 4 };
+
+/**
+ * Position of the bitbase, white has the pawn (files a-d).
+ */
+struct KpkPosition {
+  bool white_to_move;
+  int white_king;
+  int black_king;
+  int pawn;
+};
+
+// Index layout: white king (6 bits), black king (6 bits), side to move (1 bit), pawn file (2 bits), pawn rank (rest)
+std::size_t kpk_index(bool white_to_move, int white_king, int black_king, int pawn) {
+  const auto file = static_cast<std::size_t>(pawn % Const::BOARD_WIDTH);
+  const auto rank_from_top = static_cast<std::size_t>(LAST_PAWN_RANK - (pawn / Const::BOARD_WIDTH));
+  return static_cast<std::size_t>(white_king) | (static_cast<std::size_t>(black_king) << 6) |
+         (static_cast<std::size_t>(white_to_move ? 0 : 1) << 12) | (file << 13) | (rank_from_top << 15);
+}
+
+KpkPosition decode(std::size_t index) {
+  const int file = static_cast<int>((index >> 13) & 3);
+  const int rank = LAST_PAWN_RANK - static_cast<int>(index >> 15);
+  return {.white_to_move = ((index >> 12) & 1) == 0,
+          .white_king = static_cast<int>(index & 63),
+          .black_king = static_cast<int>((index >> 6) & 63),
+          .pawn = (rank * Const::BOARD_WIDTH) + file};
+}
+
+bool king_touches(int from, int square) { return KING_ATTACKS[from].test(static_cast<std::uint8_t>(square)); }
+
+bool pawn_attacks(int pawn, int square) {
+  return WHITE_PAWN_ATTACKS[pawn].test(static_cast<std::uint8_t>(square));
+}
+
+/**
+ * Result of a position that needs no search.
+ */
+Result initial_result(const KpkPosition& pos) {
+  if (pos.white_king == pos.black_king || king_touches(pos.white_king, pos.black_king) ||
+      pos.white_king == pos.pawn || pos.black_king == pos.pawn ||
+      (pos.white_to_move && pawn_attacks(pos.pawn, pos.black_king))) {
+    return INVALID;
+  }
+
+  const int push = pos.pawn + NORTH;
+  if (pos.white_to_move && pos.pawn / Const::BOARD_WIDTH == LAST_PAWN_RANK && pos.white_king != push &&
+      (!king_touches(pos.black_king, push) || king_touches(pos.white_king, push)) && pos.black_king != push) {
+    return WIN;  // Promotes safely
+  }
+
+  if (!pos.white_to_move) {
+    const Bitboard guarded = KING_ATTACKS[pos.white_king] | WHITE_PAWN_ATTACKS[pos.pawn];
+    if ((KING_ATTACKS[pos.black_king] & ~guarded).empty()) {
+      return DRAW;  // Stalemate
+    }
+    if (king_touches(pos.black_king, pos.pawn) && !king_touches(pos.white_king, pos.pawn)) {
+      return DRAW;  // The pawn falls
+    }
+  }
+
+  return UNKNOWN;
+}
+
+/**
+ * Result of a position from the current results of its successors.
+ */
+Result resolve(const std::vector<Result>& results, const KpkPosition& pos) {
+  std::uint8_t merged = INVALID;
+
+  if (pos.white_to_move) {
+    for (const Square to : KING_ATTACKS[pos.white_king]) {
+      merged |= results[kpk_index(false, to.flat_index(), pos.black_king, pos.pawn)];
+    }
+    const int push = pos.pawn + NORTH;
+    if (pos.pawn / Const::BOARD_WIDTH < LAST_PAWN_RANK && push != pos.white_king && push != pos.black_king) {
+      merged |= results[kpk_index(false, pos.white_king, pos.black_king, push)];
+      const int double_push = push + NORTH;
+      if (pos.pawn / Const::BOARD_WIDTH == 1 && double_push != pos.white_king && double_push != pos.black_king) {
+        merged |= results[kpk_index(false, pos.white_king, pos.black_king, double_push)];
+      }
+    }
+    if ((merged & WIN) != 0) {
+      return WIN;
+    }
+    return (merged & UNKNOWN) != 0 ? UNKNOWN : DRAW;
+  }
+
+  for (const Square to : KING_ATTACKS[pos.black_king]) {
+    merged |= results[kpk_index(true, pos.white_king, to.flat_index(), pos.pawn)];
+  }
+  if ((merged & DRAW) != 0) {
+    return DRAW;
+  }
+  return (merged & UNKNOWN) != 0 ? UNKNOWN : WIN;
+}
+
+/**
+ * Bitbase of the positions won by white.
+ */
+struct KpkBitbase {
+  std::array<std::uint64_t, KPK_POSITIONS_COUNT / 64> wins{};
+
+  KpkBitbase() {
+    std::vector<Result> results(KPK_POSITIONS_COUNT);
+    for (std::size_t index = 0; index < KPK_POSITIONS_COUNT; ++index) {
+      results[index] = initial_result(decode(index));
+    }
+
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (std::size_t index = 0; index < KPK_POSITIONS_COUNT; ++index) {
+        if (results[index] == UNKNOWN) {
+          results[index] = resolve(results, decode(index));
+          changed |= results[index] != UNKNOWN;
+        }
+      }
+    }
+
+    for (std::size_t index = 0; index < KPK_POSITIONS_COUNT; ++index) {
+      if (results[index] == WIN) {
+        wins[index / 64] |= std::uint64_t{1} << (index % 64);
+      }
+    }
+  }
+
+  [[nodiscard]] bool is_win(std::size_t index) const { return ((wins[index / 64] >> (index % 64)) & 1) != 0; }
+};
+
+const KpkBitbase& kpk_bitbase() {
+  static const KpkBitbase bitbase;
+  return bitbase;
+}
+
+}  // namespace
+
+bool Lookups::kpk_is_win(Color strong, Square strong_king, Square pawn, Square weak_king,
+                         Color side_to_move) noexcept {
+  // Seen from white, pawn on files a-d
+  const int flip_ranks = strong == Color::WHITE ? 0 : 56;  // NOLINT(readability-magic-numbers)
+  const int mirror_files = pawn.file() < Const::BOARD_WIDTH / 2 ? 0 : 7;
+  const auto normalize = [&](Square square) { return square.flat_index() ^ flip_ranks ^ mirror_files; };
+
+  return kpk_bitbase().is_win(
+      kpk_index(side_to_move == strong, normalize(strong_king), normalize(weak_king), normalize(pawn)));
+}
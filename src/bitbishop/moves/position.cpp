@@ -1,8 +1,25 @@
 #include <algorithm>
 #include <bitbishop/attacks/checkers.hpp>
+#include <bitbishop/lookups/between_squares.hpp>
+#include <bitbishop/lookups/cuckoo.hpp>
 #include <bitbishop/moves/move_builder.hpp>
 #include <bitbishop/moves/position.hpp>
 #include <cassert>
+#include <utility>
+
+Position::Position(Board& board, std::vector<Zobrist::Key> zobrist_history)
+    : board(board), zobrist_hashes_history(std::move(zobrist_history)) {
+  if (zobrist_hashes_history.empty()) {
+    zobrist_hashes_history.push_back(board.get_zobrist_hash());
+  }
+  assert(zobrist_hashes_history.back() == board.get_zobrist_hash());
+
+  // Halfmove clocks of earlier positions are unknown, look back through the whole history.
+  repetition_counts.reserve(zobrist_hashes_history.size());
+  for (std::size_t i = 0; i < zobrist_hashes_history.size(); ++i) {
+    repetition_counts.push_back(count_repetitions_at(i, static_cast<int>(i)));
+  }
+}
 
 void Position::apply_move(const Move& move) {
   MoveBuilder builder(board, move);
@@ -10,6 +27,8 @@ void Position::apply_move(const Move& move) {
   move_execution_history.push_back(exec);
   exec.apply(board);
   zobrist_hashes_history.push_back(board.get_zobrist_hash());
+  repetition_counts.push_back(
+      count_repetitions_at(zobrist_hashes_history.size() - 1, board.get_state().m_halfmove_clock));
 }
 
 void Position::revert_move() {
@@ -21,6 +40,7 @@ void Position::revert_move() {
     last_exec.revert(board);
     move_execution_history.pop_back();
     zobrist_hashes_history.pop_back();
+    repetition_counts.pop_back();
 
     assert(!zobrist_hashes_history.empty());
     assert(board.get_zobrist_hash() == zobrist_hashes_history.back());
@@ -31,46 +51,105 @@ void Position::reset() {
   move_execution_history.clear();
   zobrist_hashes_history.clear();
   zobrist_hashes_history.push_back(board.get_zobrist_hash());
+  repetition_counts.clear();
+  repetition_counts.push_back(1);
 }
 
-[[nodiscard]] int Position::repetition_count() const noexcept {
-  assert(!zobrist_hashes_history.empty());
-
-  const Zobrist::Key key = zobrist_hashes_history.back();
-
-  int count = 1;
-
-  const int halfmove_clock = board.get_state().m_halfmove_clock;
+int Position::count_repetitions_at(std::size_t index, int max_back_plies) const noexcept {
+  const Zobrist::Key key = zobrist_hashes_history[index];
 
   // If a pawn moved 2 turns ago, it is mathematically impossible for the current position to have occurred 4 turns ago
   // (a pawn move is irreversible).
   // Therefore, we only need to look back as far as the halfmove_clock allows.
   // We also ensure we don't look back further than the actual history size (to avoid index out-of-bounds).
-  const int max_back_plies = std::min<int>(halfmove_clock, static_cast<int>(zobrist_hashes_history.size()) - 1);
+  max_back_plies = std::min<int>(max_back_plies, static_cast<int>(index));
 
   // An irreversible move just happened or the game just started.
   if (max_back_plies < 2) {
-    return count;
+    return 1;
   }
 
-  const int stop_index = static_cast<int>(zobrist_hashes_history.size()) - 1 - max_back_plies;
+  const int stop_index = static_cast<int>(index) - max_back_plies;
 
   // For a position to be a "repetition" in chess, it’s not enough for the pieces to be on the same squares.
   // The same player must also be on move.
   // If it is White's turn now (Index N), it must have been White's turn in the repeating position:
-  // - Index N: Current (White) -> size() - 1 is the current turn (cannot be the same position).
-  // - Index N-1: Previous (Black) -> size() - 2 was the opponent's turn (impossible to be the same position).
-  // - Index N-2: Previous (White) -> size() - 3 was the last time it was our turn.
-  for (int i = static_cast<int>(zobrist_hashes_history.size()) - 3; i >= stop_index; i -= 2) {
+  // - Index N: Current (White) -> cannot be the same position.
+  // - Index N-1: Previous (Black) -> was the opponent's turn (impossible to be the same position).
+  // - Index N-2: Previous (White) -> was the last time it was our turn.
+  // The most recent occurrence already knows how many times it occurred before, stop there.
+  for (int i = static_cast<int>(index) - 2; i >= stop_index; i -= 2) {
     if (zobrist_hashes_history[static_cast<std::size_t>(i)] == key) {
-      ++count;
-      if (count >= Const::FIVEFOLD_REPETITION_COUNT) {
-        break;
+      return std::min(repetition_counts[static_cast<std::size_t>(i)] + 1, Const::FIVEFOLD_REPETITION_COUNT);
+    }
+  }
+
+  return 1;
+}
+
+[[nodiscard]] int Position::repetition_count() const noexcept {
+  assert(!repetition_counts.empty());
+  return repetition_counts.back();
+}
+
+[[nodiscard]] bool Position::has_upcoming_repetition(int ply) const noexcept {
+  using namespace Lookups;
+
+  const int size = static_cast<int>(zobrist_hashes_history.size());
+  const int end = std::min(board.get_state().m_halfmove_clock, size - 1);
+
+  // A cycle needs at least 3 plies before the reversible move that closes it.
+  if (end < 3) {
+    return false;
+  }
+
+  // key(d) is the hash of the position d plies ago.
+  auto key = [&](int plies_ago) { return zobrist_hashes_history[static_cast<std::size_t>(size - 1 - plies_ago)]; };
+
+  const Zobrist::Key original_key = key(0);
+
+  // `other` accumulates the moves played by the opponent in between: it only cancels out when the opponent went back
+  // to its earlier piece placement, in which case only our own single move can separate both positions.
+  Zobrist::Key other = original_key ^ key(1) ^ Zobrist::tables.side;
+
+  for (int i = 3; i <= end; i += 2) {
+    other ^= key(i - 1) ^ key(i) ^ Zobrist::tables.side;
+    if (other != Zobrist::NULL_HASH) {
+      continue;
+    }
+
+    const Zobrist::Key move_key = original_key ^ key(i);
+    std::size_t slot = cuckoo_h1(move_key);
+    if (CUCKOO.keys[slot] != move_key) {
+      slot = cuckoo_h2(move_key);
+      if (CUCKOO.keys[slot] != move_key) {
+        continue;
       }
     }
+
+    // The reversible move must not be blocked on the current board.
+    if ((BETWEEN[CUCKOO.from[slot]][CUCKOO.to[slot]] & board.occupied()).any()) {
+      continue;
+    }
+
+    if (ply > i) {
+      return true;
+    }
+
+    // The cycle goes back before the root: the piece must be ours and the reached position must already have been
+    // repeated, otherwise going back to it is not a draw yet.
+    const Square from(CUCKOO.from[slot], std::in_place);
+    const Square to(CUCKOO.to[slot], std::in_place);
+    const std::optional<Piece> piece = board.get_piece(from).has_value() ? board.get_piece(from) : board.get_piece(to);
+    if (!piece || piece->is_white() != board.get_state().m_is_white_turn) {
+      continue;
+    }
+    if (repetition_counts[static_cast<std::size_t>(size - 1 - i)] > 1) {
+      return true;
+    }
   }
 
-  return count;
+  return false;
 }
 
 [[nodiscard]] bool Position::is_in_check() const {
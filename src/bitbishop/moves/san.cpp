@@ -0,0 +1,186 @@
+#include <bitbishop/attacks/checkers.hpp>
+#include <bitbishop/movegen/legal_moves.hpp>
+#include <bitbishop/moves/position.hpp>
+#include <bitbishop/moves/san.hpp>
+#include <vector>
+
+namespace {
+
+CX_CONST int KINGSIDE_CASTLE_FILE = 6;
+CX_CONST int QUEENSIDE_CASTLE_FILE = 2;
+
+bool is_file(char character) { return character >= 'a' && character <= 'h'; }
+
+bool is_rank(char character) { return character >= '1' && character <= '8'; }
+
+std::optional<Piece::Type> piece_type_of(char character) {
+  switch (character) {
+    case 'N':
+      return Piece::KNIGHT;
+    case 'B':
+      return Piece::BISHOP;
+    case 'R':
+      return Piece::ROOK;
+    case 'Q':
+      return Piece::QUEEN;
+    case 'K':
+      return Piece::KING;
+    default:
+      return std::nullopt;
+  }
+}
+
+CX_CONST std::array<char, Piece::TYPE_COUNT> PIECE_LETTERS = {'P', 'N', 'B', 'R', 'Q', 'K'};
+
+void append(San::Notation& notation, char character) {
+  if (notation.size < notation.chars.size()) {
+    notation.chars[notation.size++] = character;
+  }
+}
+
+void append_square(San::Notation& notation, Square square) {
+  append(notation, static_cast<char>('a' + square.file()));
+  append(notation, static_cast<char>('1' + square.rank()));
+}
+
+}  // namespace
+
+std::optional<Move> San::parse(const Board& board, std::string_view san) {
+  while (!san.empty() && (san.back() == '+' || san.back() == '#' || san.back() == '!' || san.back() == '?')) {
+    san.remove_suffix(1);
+  }
+  if (san.empty()) {
+    return std::nullopt;
+  }
+
+  std::vector<Move> moves;
+  generate_legal_moves(moves, board);
+
+  if (san == "O-O" || san == "0-0" || san == "O-O-O" || san == "0-0-0") {
+    const int file = san.size() == 3 ? KINGSIDE_CASTLE_FILE : QUEENSIDE_CASTLE_FILE;
+    for (const Move& move : moves) {
+      if (move.is_castling && move.to.file() == file) {
+        return move;
+      }
+    }
+    return std::nullopt;
+  }
+
+  Piece::Type type = Piece::PAWN;
+  if (const std::optional<Piece::Type> piece_type = piece_type_of(san.front())) {
+    type = *piece_type;
+    san.remove_prefix(1);
+  }
+
+  // Promotion: "e8=Q" or "e8Q"
+  std::optional<Piece::Type> promotion;
+  if (!san.empty() && piece_type_of(san.back())) {
+    promotion = piece_type_of(san.back());
+    san.remove_suffix(1);
+    if (!san.empty() && san.back() == '=') {
+      san.remove_suffix(1);
+    }
+  }
+
+  if (san.size() < 2 || !is_file(san[san.size() - 2]) || !is_rank(san.back())) {
+    return std::nullopt;
+  }
+  const int to_file = san[san.size() - 2] - 'a';
+  const int to_rank = san.back() - '1';
+  san.remove_suffix(2);
+
+  // What is left is the disambiguation, and the capture mark
+  int from_file = -1;
+  int from_rank = -1;
+  for (const char character : san) {
+    if (is_file(character)) {
+      from_file = character - 'a';
+    } else if (is_rank(character)) {
+      from_rank = character - '1';
+    } else if (character != 'x' && character != ':') {
+      return std::nullopt;
+    }
+  }
+
+  std::optional<Move> found;
+  for (const Move& move : moves) {
+    const std::optional<Piece> piece = board.get_piece(move.from);
+    if (!piece || piece->type() != type || move.to.file() != to_file || move.to.rank() != to_rank ||
+        (from_file >= 0 && move.from.file() != from_file) || (from_rank >= 0 && move.from.rank() != from_rank)) {
+      continue;
+    }
+    const std::optional<Piece::Type> move_promotion =
+        move.promotion ? std::optional<Piece::Type>(move.promotion->type()) : std::nullopt;
+    if (move_promotion != promotion) {
+      continue;
+    }
+    if (found) {
+      return std::nullopt;  // Ambiguous
+    }
+    found = move;
+  }
+  return found;
+}
+
+San::Notation San::write(const Board& board, const Move& move) {
+  Notation notation;
+  std::vector<Move> moves;
+  generate_legal_moves(moves, board);
+
+  if (move.is_castling) {
+    for (const char character : move.to.file() == KINGSIDE_CASTLE_FILE ? std::string_view("O-O")
+                                                                        : std::string_view("O-O-O")) {
+      append(notation, character);
+    }
+  } else {
+    const Piece::Type type = board.get_piece(move.from)->type();
+    const bool is_capture = move.is_capture || move.is_en_passant;
+
+    if (type == Piece::PAWN) {
+      if (is_capture) {
+        append(notation, static_cast<char>('a' + move.from.file()));
+      }
+    } else {
+      append(notation, PIECE_LETTERS[type]);
+
+      bool ambiguous = false;
+      bool shares_file = false;
+      bool shares_rank = false;
+      for (const Move& other : moves) {
+        if (other.to != move.to || other.from == move.from || board.get_piece(other.from)->type() != type) {
+          continue;
+        }
+        ambiguous = true;
+        shares_file = shares_file || other.from.file() == move.from.file();
+        shares_rank = shares_rank || other.from.rank() == move.from.rank();
+      }
+      if (ambiguous && (!shares_file || shares_rank)) {
+        append(notation, static_cast<char>('a' + move.from.file()));
+      }
+      if (ambiguous && shares_file) {
+        append(notation, static_cast<char>('1' + move.from.rank()));
+      }
+    }
+
+    if (is_capture) {
+      append(notation, 'x');
+    }
+    append_square(notation, move.to);
+    if (move.promotion) {
+      append(notation, '=');
+      append(notation, PIECE_LETTERS[move.promotion->type()]);
+    }
+  }
+
+  // Check and mate, from the position after the move
+  Board after = board;
+  Position position(after);
+  position.apply_move(move);
+  const Color them = after.get_side_to_move();
+  if (compute_checkers(after, *after.king_square(them), ColorUtil::opposite(them)).any()) {
+    moves.clear();
+    generate_legal_moves(moves, after);
+    append(notation, moves.empty() ? '#' : '+');
+  }
+  return notation;
+}
@@ -0,0 +1,24 @@
+#include <bitbishop/simd.hpp>
+
+Simd::Level Simd::detect_level() noexcept {
+#ifdef BITBISHOP_SIMD_X86
+  if (__builtin_cpu_supports("avx2")) {
+    return Level::Avx2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return Level::Sse2;
+  }
+#endif
+  return Level::Scalar;
+}
+
+const char* Simd::level_name(Level level) noexcept {
+  switch (level) {
+    case Level::Avx2:
+      return "avx2";
+    case Level::Sse2:
+      return "sse2";
+    default:
+      return "scalar";
+  }
+}
@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <bitbishop/engine/eval_cache.hpp>
+#include <bitbishop/engine/eval_tables.hpp>
+#include <bitbishop/engine/nnue.hpp>
+#include <bitbishop/engine/tablebase.hpp>
+#include <bitbishop/movegen/legal_moves.hpp>
+#include <bitbishop/moves/position.hpp>
+#include <bitbishop/tools/bench.hpp>
+#include <charconv>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+using Tools::BenchOptions;
+using Tools::BenchResult;
+
+CX_CONST std::size_t BYTES_PER_MB = 1024 * 1024;
+CX_CONST std::size_t EVAL_CACHE_ENTRY_BYTES = 16;  // See Eval::EvalCache::DEFAULT_SIZE
+
+// Changing, adding or reordering positions changes the node signature
+CX_CONST std::array<std::string_view, 50> POSITIONS = {
+    // Perft positions: castling, en passant and promotion corner cases
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1",
+    "8/8/8/8/8/8/6k1/4K2R w K - 0 1",
+    // Openings
+    "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3",
+    "r1bqkbnr/pppp1ppp/2n5/1B2p3/4P3/5N2/PPPP1PPP/RNBQK2R b KQkq - 3 3",
+    "rnbqkbnr/pp1ppppp/8/2p5/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 2",
+    "r1bqkbnr/pp1ppppp/2n5/2p5/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3",
+    "rnbqkb1r/1p2pppp/p2p1n2/8/3NP3/2N5/PPP2PPP/R1BQKB1R w KQkq - 0 6",
+    "rnbqkbnr/pp2pppp/2p5/3p4/3PP3/8/PPP2PPP/RNBQKBNR w KQkq - 0 3",
+    "rnbqk1nr/ppp2ppp/4p3/3p4/1b1PP3/2N5/PPP2PPP/R1BQKBNR w KQkq - 2 4",
+    "rnbqkbnr/ppp1pppp/8/3p4/2PP4/8/PP2PPPP/RNBQKBNR b KQkq - 0 2",
+    "rnbqkb1r/ppp2ppp/4pn2/3p2B1/2PP4/2N5/PP2PPPP/R2QKBNR b KQkq - 3 4",
+    "rnbqk2r/pppp1ppp/4pn2/8/1bPP4/2N5/PP2PPPP/R1BQKBNR w KQkq - 2 4",
+    "rnbqk2r/ppp1ppbp/3p1np1/8/2PPP3/2N5/PP3PPP/R1BQKBNR w KQkq - 1 5",
+    "rnbqkb1r/pp1p1ppp/4pn2/2p5/2PP4/2N5/PP2PPPP/R1BQKBNR w KQkq - 0 4",
+    "rnbqkb1r/ppp1pppp/5n2/3p4/3P1B2/5N2/PPP1PPPP/RN1QKB1R b KQkq - 3 3",
+    "r1bqkb1r/pppppppp/2n2n2/8/2P5/2N2N2/PP1PPPPP/R1BQKB1R b KQkq - 4 3",
+    "r1bqk2r/pppp1ppp/2n2n2/2b1p3/2B1P3/3P1N2/PPP2PPP/RNBQK2R w KQkq - 1 5",
+    "r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 4 4",
+    "r2qkbnr/ppp2ppp/2np4/4p3/2B1P1b1/5N2/PPPP1PPP/RNBQ1RK1 w kq - 2 5",
+    // Middlegames
+    "r1bq1rk1/ppp1bppp/2n1pn2/3p4/2PP4/2N1PN2/PP3PPP/R1BQKB1R w KQ - 3 7",
+    "2rq1rk1/pp1bppbp/2np1np1/8/3NP3/1BN1BP2/PPPQ2PP/2KR3R w - - 3 11",
+    "r2q1rk1/pp2ppbp/2np1np1/2p5/4P3/2NP1NP1/PPP2PBP/R1BQ1RK1 w - - 0 9",
+    "r1bqkb1r/pp3ppp/2nppn2/8/3NP3/2N5/PPP2PPP/R1BQKB1R w KQkq - 0 6",
+    "r1b1k2r/ppppnppp/2n2q2/2b5/3NP3/2P1B3/PP3PPP/RN1QKB1R w KQkq - 0 7",
+    "r1bqr1k1/pp1nbppp/2p2n2/3p2B1/3P4/2NBP3/PPQ1NPPP/R3K2R w KQ - 5 10",
+    "r2q1rk1/1b1nbppp/p2ppn2/1p6/3NP3/1BN1BP2/PPPQ2PP/2KR3R w - - 2 12",
+    "r1bq1rk1/pp2ppbp/2np1np1/8/2PNP3/2N1B3/PP2BPPP/R2QK2R w KQ - 1 9",
+    "r1b2rk1/2q1bppp/p2p1n2/np2p3/3PP3/5N1P/PPBN1PP1/R1BQR1K1 w - - 0 13",
+    "2r2rk1/1bqnbppp/pp1ppn2/8/2PNP3/2N1B1P1/PP2QPBP/R2R2K1 w - - 0 13",
+    "r1bq1rk1/pp3ppp/2n1pn2/2pp4/2PP4/P1PBPN2/5PPP/R1BQK2R w KQ - 1 9",
+    "r2qk2r/ppp2ppp/2n1bn2/2bpp3/4P3/2PP1N2/PP1NBPPP/R1BQK2R w KQkq - 0 7",
+    "r3r1k1/pp3pbp/1qp3p1/2B5/2BP2b1/Q1n2N2/P4PPP/3R1K1R w - - 0 18",
+    "4rrk1/pp3ppp/2p5/3p4/3P4/2P5/PP3PPP/4RRK1 w - - 0 20",
+    // Endgames
+    "3r2k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 30",
+    "8/5pk1/6p1/8/8/6P1/5PK1/3r4 w - - 0 40",
+    "6k1/pp3ppp/8/8/8/8/PP3PPP/6K1 w - - 0 30",
+    "1k6/1pp5/8/8/8/8/5PP1/6K1 w - - 0 40",
+    "8/8/4kp2/8/5P2/4K3/8/8 w - - 0 45",
+    "8/8/8/4k3/4P3/4K3/8/8 w - - 0 50",
+    "8/8/8/2k5/2P5/2K5/8/8 b - - 0 50",
+    "8/8/8/8/2k5/8/1P6/1K6 w - - 0 40",
+    "8/1k6/8/8/8/8/6PP/6K1 w - - 0 40",
+    "2k5/8/1K6/8/8/8/8/7R w - - 0 60",
+    "8/8/3k4/8/8/2B5/1B6/4K3 w - - 0 60",
+};
+
+template <typename Integer>
+bool parse_integer(std::string_view text, Integer& value) {
+  const char* end = text.data() + text.size();
+  const auto [last, error] = std::from_chars(text.data(), end, value);
+  return !text.empty() && error == std::errc{} && last == end;
+}
+
+/**
+ * Searches one position by iterative deepening, counting nodes into `stats`; false if interrupted.
+ */
+bool search_position(std::string_view fen, int depth, Search::SearchStats& stats, std::atomic<bool>* stop_flag) {
+  Board board{std::string(fen)};
+  Position position(board);
+  std::vector<Move> root_moves;
+  generate_legal_moves(root_moves, board);
+  Tablebase::filter_root_moves(position, root_moves);
+
+  for (int iteration = 1; iteration <= depth && !root_moves.empty(); ++iteration) {
+    (void)Search::search_root(position, static_cast<std::size_t>(iteration), 1, root_moves, stats, stop_flag);
+    if (stop_flag != nullptr && stop_flag->load()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Searches positions taken from `next` with tables of its own, emptied before each position.
+ */
+void run_positions(const BenchOptions& options, std::atomic<std::size_t>& next, std::vector<std::uint64_t>& nodes,
+                   std::vector<Search::SearchStats>& stats, std::atomic<bool>* stop_flag) {
+  const Nnue::SearchGuard network_guard;
+  auto tables = std::make_unique<Eval::ThreadTables>();
+  if (options.hash_mb > 0) {
+    const std::size_t entries = options.hash_mb * BYTES_PER_MB / EVAL_CACHE_ENTRY_BYTES;
+    tables->eval_cache = Eval::EvalCache(std::bit_floor(entries));
+  }
+  const Eval::ThreadTablesScope tables_scope(*tables);
+
+  for (std::size_t index = next++; index < POSITIONS.size(); index = next++) {
+    tables->clear();
+    Search::SearchStats position_stats{};
+    if (!search_position(POSITIONS[index], options.depth, position_stats, stop_flag)) {
+      next = POSITIONS.size();
+      return;
+    }
+    position_stats.pawn_hash_probes = tables->pawn_table.probes();
+    position_stats.pawn_hash_hits = tables->pawn_table.hits();
+    position_stats.eval_cache_probes = tables->eval_cache.probes();
+    position_stats.eval_cache_hits = tables->eval_cache.hits();
+    nodes[index] = position_stats.negamax_nodes + position_stats.quiescence_nodes;
+    stats[index] = position_stats;
+  }
+}
+
+}  // namespace
+
+Tools::BenchOptions Tools::BenchOptions::from_uci_cmd(const std::vector<std::string>& line) {
+  BenchOptions options;
+  for (std::size_t i = 1; i + 1 < line.size(); ++i) {
+    const std::string& token = line[i];
+    if (token == "depth" && parse_integer(line[i + 1], options.depth)) {
+      options.depth = std::max(1, options.depth);
+      ++i;
+    } else if (token == "threads" && parse_integer(line[i + 1], options.threads)) {
+      options.threads = std::max(1U, options.threads);
+      ++i;
+    } else if (token == "hash" && parse_integer(line[i + 1], options.hash_mb)) {
+      ++i;
+    }
+  }
+  return options;
+}
+
+std::span<const std::string_view> Tools::bench_positions() noexcept { return POSITIONS; }
+
+Tools::BenchResult Tools::run_bench(const BenchOptions& options, std::atomic<bool>* stop_flag) {
+  BenchResult result;
+  result.position_nodes.assign(POSITIONS.size(), 0);
+  std::vector<Search::SearchStats> stats(POSITIONS.size());
+  std::atomic<std::size_t> next{0};
+
+  const auto threads = static_cast<unsigned>(std::clamp<std::size_t>(options.threads, 1, POSITIONS.size()));
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  const auto worker = [&]() {
+    try {
+      run_positions(options, next, result.position_nodes, stats, stop_flag);
+    } catch (...) {
+      const std::scoped_lock lock(error_mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+      next = POSITIONS.size();
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (unsigned thread = 1; thread < threads; ++thread) {
+    pool.emplace_back(worker);
+  }
+  worker();
+  for (std::thread& thread : pool) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  for (const Search::SearchStats& position_stats : stats) {
+    result.stats.negamax_nodes += position_stats.negamax_nodes;
+    result.stats.quiescence_nodes += position_stats.quiescence_nodes;
+    result.stats.pawn_hash_probes += position_stats.pawn_hash_probes;
+    result.stats.pawn_hash_hits += position_stats.pawn_hash_hits;
+    result.stats.eval_cache_probes += position_stats.eval_cache_probes;
+    result.stats.eval_cache_hits += position_stats.eval_cache_hits;
+    result.stats.tablebase_hits += position_stats.tablebase_hits;
+  }
+  result.complete = stop_flag == nullptr || !stop_flag->load();
+  return result;
+}
@@ -0,0 +1,321 @@
+#include <algorithm>
+#include <bitbishop/moves/position.hpp>
+#include <bitbishop/moves/san.hpp>
+#include <bitbishop/tools/book_builder.hpp>
+#include <bitbishop/tools/pgn.hpp>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+CX_CONST std::size_t BYTES_PER_COUNT = 64;  // Hash map node, bucket and allocation overhead, estimated
+CX_CONST std::uint32_t MAX_WEIGHT = 0xFFFF;
+CX_CONST std::size_t CHUNKS_PER_THREAD = 8;  // Keeps threads busy when games have uneven lengths
+
+/**
+ * Counts of one (position, move) pair, also the record of the run files.
+ */
+struct MoveCounts {
+  Zobrist::Key key = 0;
+  std::uint32_t games = 0;
+  std::uint32_t score = 0;  ///< 2 per win and 1 per draw of the moving side
+  std::uint16_t move = 0;
+};
+
+bool comes_before(const MoveCounts& lhs, const MoveCounts& rhs) {
+  return lhs.key != rhs.key ? lhs.key < rhs.key : lhs.move < rhs.move;
+}
+
+struct CountKey {
+  Zobrist::Key key;
+  std::uint16_t move;
+
+  bool operator==(const CountKey&) const = default;
+};
+
+struct CountKeyHash {
+  std::size_t operator()(const CountKey& count_key) const noexcept {
+    return static_cast<std::size_t>(count_key.key ^ (count_key.move * 0x9E3779B97F4A7C15ULL));  // NOLINT
+  }
+};
+
+/**
+ * Sorted run files of a build, removed with the set.
+ */
+class RunSet {
+ private:
+  std::filesystem::path m_directory;
+  std::string m_prefix;
+  std::mutex m_mutex;
+  std::vector<std::filesystem::path> m_paths;
+
+ public:
+  explicit RunSet(const std::string& directory)
+      : m_directory(directory.empty() ? std::filesystem::temp_directory_path() : std::filesystem::path(directory)),
+        m_prefix("bitbishop_book_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count())) {}
+
+  RunSet(const RunSet&) = delete;
+  RunSet& operator=(const RunSet&) = delete;
+
+  ~RunSet() {
+    std::error_code error;
+    for (const std::filesystem::path& path : m_paths) {
+      std::filesystem::remove(path, error);
+    }
+  }
+
+  void write(const std::vector<MoveCounts>& records) {
+    std::filesystem::path path;
+    {
+      const std::scoped_lock lock(m_mutex);
+      path = m_directory / (m_prefix + "_" + std::to_string(m_paths.size()) + ".run");
+      m_paths.push_back(path);
+    }
+    std::ofstream out(path, std::ios::binary);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    out.write(reinterpret_cast<const char*>(records.data()),
+              static_cast<std::streamsize>(records.size() * sizeof(MoveCounts)));
+    if (!out) {
+      throw std::runtime_error("cannot write book run " + path.string());
+    }
+  }
+
+  [[nodiscard]] const std::vector<std::filesystem::path>& paths() const noexcept { return m_paths; }
+};
+
+/**
+ * Counts of one worker, spilled as a sorted run when they reach the worker's memory share.
+ */
+class Aggregator {
+ private:
+  std::unordered_map<CountKey, MoveCounts, CountKeyHash> m_counts;
+  std::size_t m_limit;
+  RunSet& m_runs;
+
+ public:
+  Aggregator(std::size_t limit, RunSet& runs) : m_limit(limit), m_runs(runs) {}
+
+  void add(Zobrist::Key key, std::uint16_t move, std::uint32_t score) {
+    MoveCounts& counts = m_counts[CountKey{.key = key, .move = move}];
+    counts.key = key;
+    counts.move = move;
+    ++counts.games;
+    counts.score += score;
+    if (m_counts.size() >= m_limit) {
+      flush();
+    }
+  }
+
+  void flush() {
+    if (m_counts.empty()) {
+      return;
+    }
+    std::vector<MoveCounts> records;
+    records.reserve(m_counts.size());
+    for (const auto& [count_key, counts] : m_counts) {
+      records.push_back(counts);
+    }
+    m_counts.clear();
+    std::ranges::sort(records, comes_before);
+    m_runs.write(records);
+  }
+};
+
+/**
+ * Score of the side to move at the end of a game.
+ */
+std::uint32_t score_of(Tools::GameResult result, Color side_to_move) {
+  switch (result) {
+    case Tools::GameResult::WhiteWin:
+      return side_to_move == Color::WHITE ? 2 : 0;
+    case Tools::GameResult::BlackWin:
+      return side_to_move == Color::BLACK ? 2 : 0;
+    case Tools::GameResult::Draw:
+      return 1;
+    case Tools::GameResult::Unknown:
+      break;
+  }
+  return 0;
+}
+
+/**
+ * Replays the first plies of a game into the counts.
+ * @return false if the game has an invalid FEN or move
+ */
+bool add_game(const Tools::PgnGame& game, int max_ply, Aggregator& aggregator, std::size_t& moves) {
+  Board board = Board::StartingPosition();
+  if (!game.fen.empty()) {
+    try {
+      board = Board(std::string(game.fen));
+    } catch (const std::exception&) {
+      return false;
+    }
+  }
+  Position position(board);
+
+  const std::size_t plies = std::min(game.moves.size(), static_cast<std::size_t>(std::max(max_ply, 0)));
+  for (std::size_t ply = 0; ply < plies; ++ply) {
+    const std::optional<Move> move = San::parse(board, game.moves[ply]);
+    if (!move) {
+      return false;
+    }
+    aggregator.add(Zobrist::compute_polyglot_key(board), Book::encode_move(*move),
+                   score_of(game.result, board.get_side_to_move()));
+    ++moves;
+    position.apply_move(*move);
+  }
+  return true;
+}
+
+/**
+ * Run file read one record at a time during the merge.
+ */
+class RunReader {
+ private:
+  std::ifstream m_in;
+  MoveCounts m_current;
+
+ public:
+  explicit RunReader(const std::filesystem::path& path) : m_in(path, std::ios::binary) { advance(); }
+
+  bool advance() {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return static_cast<bool>(m_in.read(reinterpret_cast<char*>(&m_current), sizeof(MoveCounts)));
+  }
+
+  [[nodiscard]] bool valid() const { return static_cast<bool>(m_in); }
+  [[nodiscard]] const MoveCounts& current() const noexcept { return m_current; }
+};
+
+/**
+ * Writes the book entries of one position: cutoffs, 16-bit weights, heaviest move first.
+ */
+std::size_t write_position(std::vector<MoveCounts>& moves, std::uint32_t min_games, std::ostream& out) {
+  std::erase_if(moves, [&](const MoveCounts& counts) { return counts.games < min_games || counts.score == 0; });
+  if (moves.empty()) {
+    return 0;
+  }
+
+  const std::uint32_t max_score = std::ranges::max_element(moves, {}, &MoveCounts::score)->score;
+  std::ranges::stable_sort(moves, std::ranges::greater{}, &MoveCounts::score);
+  for (const MoveCounts& counts : moves) {
+    const std::uint64_t weight = max_score <= MAX_WEIGHT
+                                     ? counts.score
+                                     : std::max<std::uint64_t>(1, std::uint64_t{counts.score} * MAX_WEIGHT / max_score);
+    Book::write_entry(out, Book::Entry{.key = counts.key, .move = counts.move,
+                                       .weight = static_cast<std::uint16_t>(weight)});
+  }
+  return moves.size();
+}
+
+/**
+ * K-way merge of the sorted runs into the book, summing the counts of the same (position, move) pair.
+ */
+std::size_t merge_runs(const std::vector<std::filesystem::path>& paths, std::uint32_t min_games, std::ostream& out) {
+  std::vector<RunReader> readers;
+  readers.reserve(paths.size());
+  for (const std::filesystem::path& path : paths) {
+    readers.emplace_back(path);
+  }
+
+  const auto later = [&](std::size_t lhs, std::size_t rhs) {
+    return comes_before(readers[rhs].current(), readers[lhs].current());
+  };
+  std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(later)> heap(later);
+  for (std::size_t run = 0; run < readers.size(); ++run) {
+    if (readers[run].valid()) {
+      heap.push(run);
+    }
+  }
+
+  std::size_t entries = 0;
+  std::vector<MoveCounts> position_moves;
+  while (!heap.empty()) {
+    const std::size_t run = heap.top();
+    heap.pop();
+    const MoveCounts& counts = readers[run].current();
+
+    if (!position_moves.empty() && position_moves.back().key != counts.key) {
+      entries += write_position(position_moves, min_games, out);
+      position_moves.clear();
+    }
+    if (!position_moves.empty() && position_moves.back().move == counts.move) {
+      position_moves.back().games += counts.games;
+      position_moves.back().score += counts.score;
+    } else {
+      position_moves.push_back(counts);
+    }
+
+    if (readers[run].advance()) {
+      heap.push(run);
+    }
+  }
+  entries += write_position(position_moves, min_games, out);
+  return entries;
+}
+
+}  // namespace
+
+Tools::BookBuilder::BookBuilder(BookBuilderOptions options) : m_options(std::move(options)) {
+  if (m_options.threads == 0) {
+    m_options.threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+}
+
+Tools::BookBuilderStats Tools::BookBuilder::build(const std::vector<std::string>& pgn_paths,
+                                                  const std::string& book_path) const {
+  const auto start = std::chrono::steady_clock::now();
+
+  // Every file is mapped for the whole build: games are views into the mapped text
+  std::vector<std::unique_ptr<PgnFile>> files;
+  std::vector<std::string_view> chunks;
+  for (const std::string& path : pgn_paths) {
+    files.push_back(std::make_unique<PgnFile>());
+    if (!files.back()->open(path)) {
+      throw std::runtime_error("cannot read " + path);
+    }
+    for (const std::string_view chunk : split_games(files.back()->text(), CHUNKS_PER_THREAD * m_options.threads)) {
+      chunks.push_back(chunk);
+    }
+  }
+
+  const unsigned threads = std::max(1U, std::min(m_options.threads, static_cast<unsigned>(chunks.size())));
+  const std::size_t counts_per_worker = std::max<std::size_t>(1, m_options.memory_bytes / (threads * BYTES_PER_COUNT));
+
+  RunSet runs(m_options.temp_directory);
+  std::vector<Aggregator> aggregators(threads, Aggregator(counts_per_worker, runs));
+  std::vector<BookBuilderStats> thread_stats(threads);
+  for_each_game(chunks, threads, [&](unsigned thread, const PgnGame& game) {
+    BookBuilderStats& stats = thread_stats[thread];
+    ++stats.games;
+    if (!add_game(game, m_options.max_ply, aggregators[thread], stats.moves)) {
+      ++stats.rejected_games;
+    }
+  });
+  for (Aggregator& aggregator : aggregators) {
+    aggregator.flush();
+  }
+
+  std::ofstream out(book_path, std::ios::binary);
+  BookBuilderStats stats{.runs = runs.paths().size(),
+                         .entries = merge_runs(runs.paths(), m_options.min_games, out)};
+  if (!out) {
+    throw std::runtime_error("cannot write book " + book_path);
+  }
+  for (const BookBuilderStats& counted : thread_stats) {
+    stats.games += counted.games;
+    stats.rejected_games += counted.rejected_games;
+    stats.moves += counted.moves;
+  }
+  stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return stats;
+}
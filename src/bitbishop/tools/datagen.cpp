@@ -0,0 +1,280 @@
+#include <algorithm>
+#include <atomic>
+#include <bitbishop/engine/book.hpp>
+#include <bitbishop/engine/eval_tables.hpp>
+#include <bitbishop/engine/evaluation.hpp>
+#include <bitbishop/engine/nnue.hpp>
+#include <bitbishop/engine/search.hpp>
+#include <bitbishop/movegen/legal_moves.hpp>
+#include <bitbishop/moves/position.hpp>
+#include <bitbishop/random.hpp>
+#include <bitbishop/tools/datagen.hpp>
+#include <bitbishop/tools/packed_position.hpp>
+#include <chrono>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Tools::DataGenOptions;
+using Tools::DataGenStats;
+using Tools::GameResult;
+using Tools::TrainingPosition;
+
+CX_CONST int MAX_OPENING_ATTEMPTS = 16;
+
+/**
+ * State shared by the threads of a run.
+ */
+struct SharedRun {
+  const DataGenOptions& options;
+  const Book::PolyglotBook& book;
+  Tools::PackedWriter& writer;
+  std::mutex writer_mutex;
+  std::atomic<std::size_t> next_game{0};
+};
+
+GameResult loss_of(Color side) { return side == Color::WHITE ? GameResult::BlackWin : GameResult::WhiteWin; }
+
+/**
+ * Result of a game whose side to move has no legal move, or is drawn by rule; std::nullopt if it goes on.
+ */
+std::optional<GameResult> rule_result(const Position& position, const std::vector<Move>& moves) {
+  const Board& board = position.get_board();
+  if (moves.empty()) {
+    return position.is_in_check() ? loss_of(board.get_side_to_move()) : GameResult::Draw;
+  }
+  if (position.is_threefold_repetition() || board.has_insufficient_material() ||
+      board.get_state().m_halfmove_clock >= Const::MAX_HALF_MOVES_BEFORE_DRAW) {
+    return GameResult::Draw;
+  }
+  return std::nullopt;
+}
+
+/**
+ * Plays the opening moves: book moves while in book, random moves after.
+ * @return false if the game ended during the opening
+ */
+bool play_opening(Position& position, const SharedRun& run, std::uint64_t& seed) {
+  std::vector<Move> moves;
+  for (int ply = 0; ply < run.options.opening_plies; ++ply) {
+    const Board& board = position.get_board();
+    moves.clear();
+    generate_legal_moves(moves, board);
+    if (rule_result(position, moves)) {
+      return false;
+    }
+    std::optional<Move> move = run.book.pick(board, Random::splitmix64(seed));
+    if (!move) {
+      move = moves[Random::splitmix64(seed) % moves.size()];
+    }
+    position.apply_move(*move);
+  }
+  return true;
+}
+
+/**
+ * Iterative deepening until the soft node limit or the maximum depth.
+ */
+Search::BestMove search(Position& position, std::vector<Move>& root_moves, const DataGenOptions& options,
+                        std::uint64_t& nodes) {
+  Search::SearchStats stats{};
+  Search::BestMove best;
+  for (int depth = 1; depth <= std::max(1, options.max_depth); ++depth) {
+    std::vector<Search::BestMove> lines =
+        Search::search_root(position, static_cast<std::size_t>(depth), 1, root_moves, stats);
+    if (!lines.empty()) {
+      best = std::move(lines.front());
+    }
+    if (stats.negamax_nodes + stats.quiescence_nodes >= options.soft_nodes) {
+      break;
+    }
+  }
+  nodes += stats.negamax_nodes + stats.quiescence_nodes;
+  return best;
+}
+
+/**
+ * Tracks how long scores stay decisive or level, in white's view.
+ */
+class Adjudicator {
+ private:
+  const DataGenOptions& m_options;
+  int m_win_plies = 0;
+  int m_draw_plies = 0;
+  int m_last_sign = 0;
+
+ public:
+  explicit Adjudicator(const DataGenOptions& options) : m_options(options) {}
+
+  std::optional<GameResult> add(int white_score, int ply) {
+    const int sign = (white_score > 0) - (white_score < 0);
+    if (std::abs(white_score) >= m_options.win_score) {
+      m_win_plies = sign == m_last_sign ? m_win_plies + 1 : 1;
+    } else {
+      m_win_plies = 0;
+    }
+    m_last_sign = sign;
+    m_draw_plies = std::abs(white_score) <= m_options.draw_score ? m_draw_plies + 1 : 0;
+
+    if (m_win_plies >= m_options.win_plies) {
+      return sign > 0 ? GameResult::WhiteWin : GameResult::BlackWin;
+    }
+    if (ply >= m_options.draw_min_ply && m_draw_plies >= m_options.draw_plies) {
+      return GameResult::Draw;
+    }
+    return std::nullopt;
+  }
+};
+
+/**
+ * Plays one game, adding its training positions (result not set yet) to `positions`.
+ */
+GameResult play_game(const SharedRun& run, std::uint64_t seed, std::vector<TrainingPosition>& positions,
+                     DataGenStats& stats) {
+  const DataGenOptions& options = run.options;
+
+  for (int attempt = 0;; ++attempt) {
+    Board board;
+    Position position(board);
+    if (!play_opening(position, run, seed) && attempt + 1 < MAX_OPENING_ATTEMPTS) {
+      continue;
+    }
+
+    Adjudicator adjudicator(options);
+    std::vector<Move> moves;
+    for (int ply = options.opening_plies;; ++ply) {
+      moves.clear();
+      generate_legal_moves(moves, board);
+      if (const std::optional<GameResult> result = rule_result(position, moves)) {
+        return *result;
+      }
+      if (ply >= options.max_plies) {
+        ++stats.adjudicated;
+        return GameResult::Draw;
+      }
+
+      const Search::BestMove best = search(position, moves, options, stats.nodes);
+      if (!best.move) {
+        return GameResult::Draw;  // Unreachable with legal moves, kept as a safe stop
+      }
+      const Color side = board.get_side_to_move();
+      const bool is_mate_score = std::abs(best.score) >= Eval::MATE_THRESHOLD;
+      if (!is_mate_score && !position.is_in_check() && !best.move->is_capture && !best.move->is_en_passant &&
+          !best.move->promotion) {
+        CX_CONST int MAX_SCORE = std::numeric_limits<std::int16_t>::max();
+        const auto score = static_cast<std::int16_t>(std::clamp(best.score, -MAX_SCORE, MAX_SCORE));
+        positions.push_back(TrainingPosition{.board = board, .score = score, .best_move = best.move});
+      }
+
+      const int white_score = side == Color::WHITE ? best.score : -best.score;
+      if (const std::optional<GameResult> result = adjudicator.add(white_score, ply)) {
+        ++stats.adjudicated;
+        return *result;
+      }
+      position.apply_move(*best.move);
+    }
+  }
+}
+
+void run_games(SharedRun& run, DataGenStats& stats) {
+  const Nnue::SearchGuard network_guard;
+  auto tables = std::make_unique<Eval::ThreadTables>();
+  const Eval::ThreadTablesScope tables_scope(*tables);
+
+  std::vector<TrainingPosition> positions;
+  for (std::size_t game = run.next_game++; game < run.options.games; game = run.next_game++) {
+    std::uint64_t seed = run.options.seed ^ (game * 0x9E3779B97F4A7C15ULL);  // NOLINT(readability-magic-numbers)
+    positions.clear();
+    const GameResult result = play_game(run, Random::splitmix64(seed), positions, stats);
+
+    ++stats.games;
+    // clang-format off
+    switch (result) {
+      case GameResult::WhiteWin: ++stats.white_wins; break;
+      case GameResult::BlackWin: ++stats.black_wins; break;
+      default:                   ++stats.draws;      break;
+    }
+    // clang-format on
+
+    const std::scoped_lock lock(run.writer_mutex);
+    for (TrainingPosition& position : positions) {
+      position.result = result;
+      if (run.writer.write(position)) {
+        ++stats.positions;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+Tools::DataGenerator::DataGenerator(DataGenOptions options) : m_options(std::move(options)) {
+  if (m_options.threads == 0) {
+    m_options.threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  if (m_options.seed == 0) {
+    m_options.seed = static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+  }
+}
+
+Tools::DataGenStats Tools::DataGenerator::generate(const std::string& output_path) const {
+  const auto start = std::chrono::steady_clock::now();
+
+  Book::PolyglotBook book;
+  if (!m_options.book_path.empty() && !book.open(m_options.book_path)) {
+    throw std::runtime_error("cannot open book " + m_options.book_path);
+  }
+  PackedWriter writer(output_path, m_options.deduplicate);
+  SharedRun run{.options = m_options, .book = book, .writer = writer};
+
+  const auto threads =
+      static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(m_options.threads, m_options.games)));
+  std::vector<DataGenStats> thread_stats(threads);
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  const auto worker = [&](unsigned thread) {
+    try {
+      run_games(run, thread_stats[thread]);
+    } catch (...) {
+      const std::scoped_lock lock(error_mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+      run.next_game = m_options.games;
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (unsigned thread = 1; thread < threads; ++thread) {
+    pool.emplace_back(worker, thread);
+  }
+  worker(0);
+  for (std::thread& thread : pool) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  writer.close();
+
+  DataGenStats stats;
+  for (const DataGenStats& counted : thread_stats) {
+    stats.games += counted.games;
+    stats.white_wins += counted.white_wins;
+    stats.black_wins += counted.black_wins;
+    stats.draws += counted.draws;
+    stats.adjudicated += counted.adjudicated;
+    stats.positions += counted.positions;
+    stats.nodes += counted.nodes;
+  }
+  stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return stats;
+}
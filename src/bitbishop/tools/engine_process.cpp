@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <bitbishop/config.hpp>
+#include <bitbishop/tools/engine_process.hpp>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#if __has_include(<spawn.h>)
+#define BITBISHOP_ENGINE_PROCESS 1
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <csignal>
+
+extern char** environ;  // NOLINT(readability-redundant-declaration)
+#endif
+
+#ifdef BITBISHOP_ENGINE_PROCESS
+namespace {
+
+CX_CONST std::size_t READ_CHUNK = 4096;
+CX_CONST auto EXIT_GRACE = std::chrono::milliseconds(500);
+
+/**
+ * Pipes are created and handed to a child under this lock, so that no other child inherits them: an inherited
+ * write end would keep an engine's input open after its parent closed it.
+ */
+std::mutex spawn_mutex;
+
+void close_pipe(int (&descriptors)[2]) {  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+  for (int& descriptor : descriptors) {
+    if (descriptor >= 0) {
+      close(descriptor);
+      descriptor = -1;
+    }
+  }
+}
+
+}  // namespace
+
+Tools::EngineProcess::EngineProcess(const std::string& path) {
+  // A write to an engine that died must fail with EPIPE rather than kill the whole process
+  static std::once_flag ignore_sigpipe;
+  std::call_once(ignore_sigpipe, [] { std::signal(SIGPIPE, SIG_IGN); });
+
+  const std::scoped_lock lock(spawn_mutex);
+  int to_child[2] = {-1, -1};    // NOLINT(cppcoreguidelines-avoid-c-arrays)
+  int from_child[2] = {-1, -1};  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+  if (pipe(to_child) != 0 || pipe(from_child) != 0) {
+    close_pipe(to_child);
+    close_pipe(from_child);
+    throw std::runtime_error("cannot create pipes for " + path);
+  }
+  for (const int descriptor : {to_child[0], to_child[1], from_child[0], from_child[1]}) {
+    fcntl(descriptor, F_SETFD, FD_CLOEXEC);  // NOLINT(cppcoreguidelines-pro-type-vararg)
+  }
+
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_adddup2(&actions, to_child[0], STDIN_FILENO);
+  posix_spawn_file_actions_adddup2(&actions, from_child[1], STDOUT_FILENO);
+  posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+  std::string program = path;
+  char* argv[] = {program.data(), nullptr};  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+  pid_t pid = -1;
+  const int error = posix_spawn(&pid, program.c_str(), &actions, nullptr, argv, environ);
+  posix_spawn_file_actions_destroy(&actions);
+
+  close(to_child[0]);
+  close(from_child[1]);
+  if (error != 0) {
+    close(to_child[1]);
+    close(from_child[0]);
+    throw std::runtime_error("cannot start " + path);
+  }
+  m_pid = pid;
+  m_input = to_child[1];
+  m_output = from_child[0];
+}
+
+Tools::EngineProcess::~EngineProcess() {
+  close(m_input);
+  close(m_output);
+
+  // The engine exits on the end of its input; one that does not is killed
+  const auto deadline = std::chrono::steady_clock::now() + EXIT_GRACE;
+  while (waitpid(m_pid, nullptr, WNOHANG) == 0) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+      kill(m_pid, SIGKILL);
+      waitpid(m_pid, nullptr, 0);
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+void Tools::EngineProcess::send(std::string_view text) {
+  std::string line;
+  line.reserve(text.size() + 1);
+  line.append(text);
+  line.push_back('\n');
+
+  std::size_t written = 0;
+  while (written < line.size()) {
+    const ssize_t count = write(m_input, line.data() + written, line.size() - written);
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count <= 0) {
+      throw std::runtime_error("engine exited");
+    }
+    written += static_cast<std::size_t>(count);
+  }
+}
+
+std::optional<std::string_view> Tools::EngineProcess::read_line(std::chrono::steady_clock::time_point deadline) {
+  // The previous line is no longer needed
+  m_buffer.erase(0, m_line_begin);
+  m_line_begin = 0;
+
+  std::size_t scanned = 0;
+  for (;;) {
+    const std::size_t end = m_buffer.find('\n', scanned);
+    if (end != std::string::npos) {
+      m_line_begin = end + 1;
+      std::string_view line(m_buffer.data(), end);
+      if (line.ends_with('\r')) {
+        line.remove_suffix(1);
+      }
+      return line;
+    }
+    scanned = m_buffer.size();
+
+    const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+    pollfd request{.fd = m_output, .events = POLLIN, .revents = 0};
+    const int ready = poll(&request, 1, static_cast<int>(std::max<std::int64_t>(0, remaining.count())));
+    if (ready < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ready == 0) {
+      return std::nullopt;
+    }
+
+    m_buffer.resize(scanned + READ_CHUNK);
+    const ssize_t count = read(m_output, m_buffer.data() + scanned, READ_CHUNK);
+    m_buffer.resize(scanned + static_cast<std::size_t>(std::max<ssize_t>(0, count)));
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count <= 0) {
+      throw std::runtime_error("engine exited");
+    }
+  }
+}
+
+#else
+
+Tools::EngineProcess::EngineProcess(const std::string& path) {
+  throw std::runtime_error("cannot start " + path + ": engine processes are not supported on this platform");
+}
+
+Tools::EngineProcess::~EngineProcess() = default;
+
+void Tools::EngineProcess::send(std::string_view /*text*/) { throw std::runtime_error("engine exited"); }
+
+std::optional<std::string_view> Tools::EngineProcess::read_line(std::chrono::steady_clock::time_point /*deadline*/) {
+  throw std::runtime_error("engine exited");
+}
+
+#endif
+
+std::optional<std::string_view> Tools::EngineProcess::wait_for(std::string_view prefix,
+                                                               std::chrono::steady_clock::time_point deadline) {
+  for (;;) {
+    const std::optional<std::string_view> line = read_line(deadline);
+    if (!line || line->starts_with(prefix)) {
+      return line;
+    }
+  }
+}
@@ -0,0 +1,384 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitbishop/engine/eval_tables.hpp>
+#include <bitbishop/engine/nnue.hpp>
+#include <bitbishop/engine/search.hpp>
+#include <bitbishop/engine/tablebase.hpp>
+#include <bitbishop/fen.hpp>
+#include <bitbishop/movegen/legal_moves.hpp>
+#include <bitbishop/moves/position.hpp>
+#include <bitbishop/moves/san.hpp>
+#include <bitbishop/tools/epd_suite.hpp>
+#include <bitbishop/tools/time_guard.hpp>
+#include <charconv>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+using Tools::EpdResult;
+using Tools::EpdSuiteOptions;
+using Tools::EpdTest;
+
+CX_CONST std::array<int, 5> PERCENTILES = {25, 50, 75, 90, 100};
+
+std::string_view unquote(std::string_view text) {
+  if (text.size() >= 2 && text.front() == '"' && text.back() == '"') {
+    return text.substr(1, text.size() - 2);
+  }
+  return text;
+}
+
+template <typename Integer>
+bool parse_integer(std::string_view text, Integer& value) {
+  const char* end = text.data() + text.size();
+  const auto [last, error] = std::from_chars(text.data(), end, value);
+  return !text.empty() && error == std::errc{} && last == end;
+}
+
+/**
+ * Appends the SAN moves of an operand, space separated.
+ */
+bool parse_moves(const Board& board, std::string_view operand, std::vector<Move>& moves) {
+  while (!operand.empty()) {
+    const std::size_t space = operand.find(' ');
+    const std::string_view san = operand.substr(0, space);
+    if (!san.empty()) {
+      const std::optional<Move> move = San::parse(board, san);
+      if (!move) {
+        return false;
+      }
+      moves.push_back(*move);
+    }
+    operand = space == std::string_view::npos ? std::string_view{} : operand.substr(space + 1);
+  }
+  return true;
+}
+
+bool same_move(const Move& first, const Move& second) {
+  return first.from == second.from && first.to == second.to && first.promotion == second.promotion;
+}
+
+bool solves(const EpdTest& test, const Move& move) {
+  const auto matches = [&move](const Move& other) { return same_move(move, other); };
+  return (test.best_moves.empty() || std::ranges::any_of(test.best_moves, matches)) &&
+         std::ranges::none_of(test.avoid_moves, matches);
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Searches a test by iterative deepening within the budget, tracking when its solution appeared.
+ */
+EpdResult solve(const EpdTest& test, const EpdSuiteOptions& options) {
+  Board board = test.board;
+  Position position(board);
+  std::vector<Move> root_moves;
+  generate_legal_moves(root_moves, board);
+  Tablebase::filter_root_moves(position, root_moves);
+
+  std::atomic<bool> stop_flag{false};
+  Search::SearchStats stats{};
+  stats.node_limit = options.nodes.value_or(0);
+  const auto start = std::chrono::steady_clock::now();
+  std::optional<Tools::TimeGuard> time_guard;
+  if (options.movetime_ms) {
+    time_guard.emplace(stop_flag, std::chrono::milliseconds(std::max(1, *options.movetime_ms)));
+  }
+
+  EpdResult result{.id = test.id};
+  for (int depth = 1; depth <= options.max_depth && !stop_flag.load() && !root_moves.empty(); ++depth) {
+    const std::vector<Search::BestMove> lines =
+        Search::search_root(position, static_cast<std::size_t>(depth), 1, root_moves, stats, &stop_flag);
+    if (stop_flag.load() || lines.empty() || !lines.front().move) {
+      break;  // An interrupted iteration is not trusted, as in Uci::SearchWorker
+    }
+
+    result.move = lines.front().move;
+    result.depth = depth;
+    const bool solved = solves(test, *result.move);
+    if (solved && !result.solved) {
+      result.solve_depth = depth;
+      result.solve_nodes = stats.negamax_nodes + stats.quiescence_nodes;
+      result.solve_seconds = seconds_since(start);
+    }
+    result.solved = solved;
+  }
+
+  result.nodes = stats.negamax_nodes + stats.quiescence_nodes;
+  result.seconds = seconds_since(start);
+  return result;
+}
+
+void run_tests(const std::vector<EpdTest>& tests, const EpdSuiteOptions& options, std::atomic<std::size_t>& next,
+               std::vector<EpdResult>& results) {
+  const Nnue::SearchGuard network_guard;
+  auto tables = std::make_unique<Eval::ThreadTables>();
+  const Eval::ThreadTablesScope tables_scope(*tables);
+
+  for (std::size_t index = next++; index < tests.size(); index = next++) {
+    results[index] = solve(tests[index], options);
+  }
+}
+
+/**
+ * Nearest-rank percentiles of the solved tests, for the value read by `value`.
+ */
+template <typename Value>
+std::vector<double> percentiles(const std::vector<EpdResult>& results, Value&& value) {
+  std::vector<double> values;
+  for (const EpdResult& result : results) {
+    if (result.solved) {
+      values.push_back(static_cast<double>(value(result)));
+    }
+  }
+  std::ranges::sort(values);
+
+  std::vector<double> picked;
+  for (const int percentile : PERCENTILES) {
+    if (values.empty()) {
+      picked.push_back(0.0);
+      continue;
+    }
+    const std::size_t rank = std::max<std::size_t>(1, (values.size() * percentile + 99) / 100);  // NOLINT
+    picked.push_back(values[rank - 1]);
+  }
+  return picked;
+}
+
+struct Summary {
+  std::size_t solved = 0;
+  std::uint64_t nodes = 0;
+  double cpu_seconds = 0.0;
+  std::vector<double> solve_milliseconds;
+  std::vector<double> solve_nodes;
+
+  explicit Summary(const std::vector<EpdResult>& results)
+      : solve_milliseconds(percentiles(results, [](const EpdResult& result) { return result.solve_seconds * 1e3; })),
+        solve_nodes(percentiles(results, [](const EpdResult& result) { return result.solve_nodes; })) {
+    for (const EpdResult& result : results) {
+      solved += result.solved ? 1 : 0;
+      nodes += result.nodes;
+      cpu_seconds += result.seconds;
+    }
+  }
+
+  [[nodiscard]] double solved_per_cpu_second() const {
+    return cpu_seconds > 0.0 ? static_cast<double>(solved) / cpu_seconds : 0.0;
+  }
+};
+
+std::string budget_text(const EpdSuiteOptions& options) {
+  std::string text;
+  if (options.movetime_ms) {
+    text += std::to_string(*options.movetime_ms) + " ms";
+  }
+  if (options.nodes) {
+    text += (text.empty() ? "" : ", ") + std::to_string(*options.nodes) + " nodes";
+  }
+  return text.empty() ? "depth " + std::to_string(options.max_depth) : text;
+}
+
+void write_json_string(std::ostream& out, std::string_view text) {
+  out << '"';
+  for (const char character : text) {
+    if (character == '"' || character == '\\') {
+      out << '\\' << character;
+    } else if (static_cast<unsigned char>(character) < 0x20) {  // NOLINT(readability-magic-numbers)
+      out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(character) << std::dec
+          << std::setfill(' ');
+    } else {
+      out << character;
+    }
+  }
+  out << '"';
+}
+
+void write_json_percentiles(std::ostream& out, const std::vector<double>& values, int precision) {
+  out << "{" << std::setprecision(precision);
+  for (std::size_t i = 0; i < PERCENTILES.size(); ++i) {
+    out << (i == 0 ? "" : ", ") << "\"p" << PERCENTILES[i] << "\": " << values[i];
+  }
+  out << "}" << std::setprecision(3);
+}
+
+template <typename Value>
+void write_json_optional(std::ostream& out, const std::optional<Value>& value) {
+  if (value) {
+    out << *value;
+  } else {
+    out << "null";
+  }
+}
+
+}  // namespace
+
+std::optional<Tools::EpdTest> Tools::parse_epd_test(std::string_view line) {
+  EpdTest test;
+  std::string_view operations;
+  if (Fen::parse_epd(line, test.board, operations) != Fen::Error::None) {
+    return std::nullopt;
+  }
+
+  BoardState state = test.board.get_state();
+  const bool valid = Fen::for_each_operation(operations, [&](std::string_view opcode, std::string_view operand) {
+    if (opcode == "bm") {
+      return parse_moves(test.board, operand, test.best_moves);
+    }
+    if (opcode == "am") {
+      return parse_moves(test.board, operand, test.avoid_moves);
+    }
+    if (opcode == "id") {
+      test.id = unquote(operand);
+    } else if (opcode == "hmvc") {
+      return parse_integer(operand, state.m_halfmove_clock);
+    } else if (opcode == "fmvn") {
+      return parse_integer(operand, state.m_fullmove_number);
+    }
+    return true;
+  });
+  if (!valid || (test.best_moves.empty() && test.avoid_moves.empty())) {
+    return std::nullopt;
+  }
+  test.board.set_state(state);
+  return test;
+}
+
+std::vector<Tools::EpdTest> Tools::load_epd_suite(const std::string& path, std::size_t& invalid_lines) {
+  std::ifstream in(path);
+  if (!in) {
+    throw std::runtime_error("cannot read " + path);
+  }
+
+  std::vector<EpdTest> tests;
+  std::size_t line_number = 0;
+  for (std::string line; std::getline(in, line);) {
+    ++line_number;
+    if (line.find_first_not_of(" \t\r") == std::string::npos) {
+      continue;
+    }
+    std::optional<EpdTest> test = parse_epd_test(line);
+    if (!test) {
+      ++invalid_lines;
+      continue;
+    }
+    if (test->id.empty()) {
+      test->id = path + ":" + std::to_string(line_number);
+    }
+    tests.push_back(std::move(*test));
+  }
+  return tests;
+}
+
+std::vector<Tools::EpdResult> Tools::run_epd_suite(const std::vector<EpdTest>& tests, const EpdSuiteOptions& options) {
+  std::vector<EpdResult> results(tests.size());
+  std::atomic<std::size_t> next{0};
+
+  const unsigned requested = options.threads == 0 ? std::max(1U, std::thread::hardware_concurrency()) : options.threads;
+  const auto threads = static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(requested, tests.size())));
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  const auto worker = [&]() {
+    try {
+      run_tests(tests, options, next, results);
+    } catch (...) {
+      const std::scoped_lock lock(error_mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+      next = tests.size();
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (unsigned thread = 1; thread < threads; ++thread) {
+    pool.emplace_back(worker);
+  }
+  worker();
+  for (std::thread& thread : pool) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return results;
+}
+
+void Tools::write_epd_report(std::ostream& out, const std::vector<EpdResult>& results,
+                             const EpdSuiteOptions& options) {
+  const Summary summary(results);
+  const auto percent = [&results](std::size_t count) {
+    return results.empty() ? 0.0 : 100.0 * static_cast<double>(count) / static_cast<double>(results.size());
+  };
+
+  out << std::fixed << std::setprecision(1);
+  out << "solved " << summary.solved << "/" << results.size() << " (" << percent(summary.solved) << "%), budget "
+      << budget_text(options) << "\n";
+  out << "cpu time " << std::setprecision(2) << summary.cpu_seconds << "s, nodes " << summary.nodes << ", "
+      << summary.solved_per_cpu_second() << " solved per cpu second\n";
+
+  const auto write_percentiles = [&out](const char* name, const std::vector<double>& values, int precision) {
+    out << name;
+    for (std::size_t i = 0; i < PERCENTILES.size(); ++i) {
+      out << (i == 0 ? " " : ", ") << "p" << PERCENTILES[i] << " " << std::setprecision(precision) << values[i];
+    }
+    out << "\n";
+  };
+  write_percentiles("time to solution (ms):", summary.solve_milliseconds, 1);
+  write_percentiles("nodes to solution:", summary.solve_nodes, 0);
+
+  for (const EpdResult& result : results) {
+    if (!result.solved) {
+      out << "unsolved " << result.id << ": played " << (result.move ? result.move->to_uci() : "none") << " at depth "
+          << result.depth << "\n";
+    }
+  }
+}
+
+void Tools::write_epd_json(std::ostream& out, const std::vector<EpdResult>& results, const EpdSuiteOptions& options) {
+  const Summary summary(results);
+
+  out << std::fixed << std::setprecision(3) << "{\n  \"budget\": {";
+  out << "\"movetime_ms\": ";
+  write_json_optional(out, options.movetime_ms);
+  out << ", \"nodes\": ";
+  write_json_optional(out, options.nodes);
+  out << ", \"max_depth\": " << options.max_depth << "},\n";
+  out << "  \"total\": " << results.size() << ",\n  \"solved\": " << summary.solved << ",\n  \"nodes\": "
+      << summary.nodes << ",\n  \"cpu_seconds\": " << summary.cpu_seconds
+      << ",\n  \"solved_per_cpu_second\": " << summary.solved_per_cpu_second() << ",\n  \"time_to_solution_ms\": ";
+  write_json_percentiles(out, summary.solve_milliseconds, 3);
+  out << ",\n  \"nodes_to_solution\": ";
+  write_json_percentiles(out, summary.solve_nodes, 0);
+  out << ",\n  \"tests\": [";
+
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const EpdResult& result = results[i];
+    out << (i == 0 ? "\n" : ",\n") << "    {\"id\": ";
+    write_json_string(out, result.id);
+    out << ", \"solved\": " << (result.solved ? "true" : "false") << ", \"move\": ";
+    if (result.move) {
+      write_json_string(out, result.move->to_uci());
+    } else {
+      out << "null";
+    }
+    out << ", \"depth\": " << result.depth << ", \"nodes\": " << result.nodes
+        << ", \"time_ms\": " << result.seconds * 1e3;  // NOLINT(readability-magic-numbers)
+    if (result.solved) {
+      out << ", \"solve_depth\": " << result.solve_depth << ", \"solve_nodes\": " << result.solve_nodes
+          << ", \"solve_time_ms\": " << result.solve_seconds * 1e3;  // NOLINT(readability-magic-numbers)
+    }
+    out << "}";
+  }
+  out << (results.empty() ? "]\n}\n" : "\n  ]\n}\n");
+}
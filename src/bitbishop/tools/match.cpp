@@ -0,0 +1,415 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitbishop/fen.hpp>
+#include <bitbishop/movegen/legal_moves.hpp>
+#include <bitbishop/moves/position.hpp>
+#include <bitbishop/random.hpp>
+#include <bitbishop/tools/engine_process.hpp>
+#include <bitbishop/tools/match.hpp>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace {
+
+using Tools::GameEnd;
+using Tools::GameRecord;
+using Tools::GameResult;
+using Tools::MatchEngine;
+using Tools::MatchOptions;
+using Clock = std::chrono::steady_clock;
+
+CX_CONST auto HANDSHAKE_TIMEOUT = std::chrono::seconds(10);
+
+// Two-sided 95% quantile of the normal distribution
+CX_CONST double NORMAL_QUANTILE_95 = 1.959963984540054;
+
+double elo_of_score(double score) { return -400.0 * std::log10(1.0 / score - 1.0); }  // NOLINT
+
+double score_of_elo(double elo) { return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0)); }  // NOLINT
+
+// Added to each outcome count by the SPRT: half a game each, so that a few games cannot decide the test alone
+CX_CONST double SPRT_PSEUDO_COUNT = 0.5;
+
+/**
+ * Games, mean and per-game variance of the first engine's points, each outcome count increased by `pseudo_count`.
+ */
+std::array<double, 3> score_moments(const Tools::MatchScore& score, double pseudo_count = 0.0) {
+  const double wins = static_cast<double>(score.wins) + pseudo_count;
+  const double draws = static_cast<double>(score.draws) + pseudo_count;
+  const double losses = static_cast<double>(score.losses) + pseudo_count;
+  const double games = wins + draws + losses;
+  const double mean = (wins + draws / 2.0) / games;
+  const double variance = (wins * (1.0 - mean) * (1.0 - mean) + draws * (0.5 - mean) * (0.5 - mean) +  // NOLINT
+                           losses * mean * mean) /
+                          games;
+  return {games, mean, variance};
+}
+
+/**
+ * One engine of a game slot, started on first use and after a failure.
+ */
+class Player {
+ private:
+  const MatchEngine& m_engine;
+  std::unique_ptr<Tools::EngineProcess> m_process;
+
+  void start() {
+    const std::string& name = m_engine.name.empty() ? m_engine.path : m_engine.name;
+    auto process = std::make_unique<Tools::EngineProcess>(m_engine.path);
+    process->send("uci");
+    if (!process->wait_for("uciok", Clock::now() + HANDSHAKE_TIMEOUT)) {
+      throw std::runtime_error(name + " does not answer uci");
+    }
+    for (const std::string& option : m_engine.options) {
+      const std::size_t equals = option.find('=');
+      if (equals == std::string::npos) {
+        throw std::runtime_error("option " + option + " of " + name + " is not Name=Value");
+      }
+      process->send("setoption name " + option.substr(0, equals) + " value " + option.substr(equals + 1));
+    }
+    process->send("isready");
+    if (!process->wait_for("readyok", Clock::now() + HANDSHAKE_TIMEOUT)) {
+      throw std::runtime_error(name + " does not answer isready");
+    }
+    m_process = std::move(process);
+  }
+
+ public:
+  explicit Player(const MatchEngine& engine) : m_engine(engine) {}
+
+  /**
+   * Running process, started if needed; std::runtime_error if it cannot be started.
+   */
+  Tools::EngineProcess& process() {
+    if (!m_process) {
+      start();
+    }
+    return *m_process;
+  }
+
+  /**
+   * Clears the engine state; false if the engine failed, which is then restarted before its next game.
+   */
+  bool new_game() {
+    Tools::EngineProcess& engine = process();
+    try {
+      engine.send("ucinewgame\nisready");
+      // Also skips the late bestmove of a game lost on time
+      if (engine.wait_for("readyok", Clock::now() + HANDSHAKE_TIMEOUT)) {
+        return true;
+      }
+    } catch (const std::runtime_error&) {  // NOLINT(bugprone-empty-catch)
+    }
+    fail();
+    return false;
+  }
+
+  void fail() { m_process.reset(); }
+};
+
+GameResult loss_of(Color side) { return side == Color::WHITE ? GameResult::BlackWin : GameResult::WhiteWin; }
+
+/**
+ * End of a game whose side to move has no legal move, or is drawn by rule; std::nullopt if it goes on.
+ */
+std::optional<std::pair<GameResult, GameEnd>> rule_end(const Position& position, const std::vector<Move>& moves) {
+  const Board& board = position.get_board();
+  if (moves.empty()) {
+    return position.is_in_check() ? std::pair{loss_of(board.get_side_to_move()), GameEnd::Checkmate}
+                                  : std::pair{GameResult::Draw, GameEnd::Stalemate};
+  }
+  if (position.is_threefold_repetition()) {
+    return std::pair{GameResult::Draw, GameEnd::Repetition};
+  }
+  if (board.get_state().m_halfmove_clock >= Const::MAX_HALF_MOVES_BEFORE_DRAW) {
+    return std::pair{GameResult::Draw, GameEnd::FiftyMoves};
+  }
+  if (board.has_insufficient_material()) {
+    return std::pair{GameResult::Draw, GameEnd::InsufficientMaterial};
+  }
+  return std::nullopt;
+}
+
+std::int64_t to_ms(Clock::duration duration) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+}
+
+/**
+ * Plays one game from `fen`; players[0] is the first engine.
+ */
+GameRecord play_game(std::array<Player, 2>& players, const std::string& fen, const MatchOptions& options,
+                     GameRecord record) {
+  const auto finish = [&record](GameResult result, GameEnd end) {
+    record.result = result;
+    record.end = end;
+    return record;
+  };
+  const auto player_index = [&record](Color side) {
+    return (side == Color::WHITE) == record.first_is_white ? 0U : 1U;
+  };
+
+  for (const Color side : {Color::WHITE, Color::BLACK}) {
+    if (!players.at(player_index(side)).new_game()) {
+      return finish(loss_of(side), GameEnd::EngineFailure);
+    }
+  }
+
+  Board board;
+  (void)Fen::parse(fen, board);  // Validated by the caller
+  Position position(board);
+
+  const auto increment = std::chrono::milliseconds(options.time_control.increment_ms);
+  const auto margin = std::chrono::milliseconds(options.time_control.margin_ms);
+  std::array<Clock::duration, ColorUtil::SIZE> clocks;
+  clocks.fill(std::chrono::milliseconds(options.time_control.base_ms));
+
+  // The position command grows by one move per ply, the go command is rebuilt from it
+  std::string position_command = "position fen " + fen + " moves";
+  std::string command;
+  std::string best_move;
+  std::vector<Move> moves;
+  for (record.plies = 0;; ++record.plies) {
+    moves.clear();
+    generate_legal_moves(moves, board);
+    if (const auto end = rule_end(position, moves)) {
+      return finish(end->first, end->second);
+    }
+    if (record.plies >= options.max_plies) {
+      return finish(GameResult::Draw, GameEnd::MaxPlies);
+    }
+
+    const Color side = board.get_side_to_move();
+    Player& player = players.at(player_index(side));
+    Clock::duration& clock = clocks.at(ColorUtil::to_index(side));
+
+    command.assign(position_command);
+    command += "\ngo wtime ";
+    command += std::to_string(to_ms(clocks.at(ColorUtil::to_index(Color::WHITE))));
+    command += " btime ";
+    command += std::to_string(to_ms(clocks.at(ColorUtil::to_index(Color::BLACK))));
+    command += " winc ";
+    command += std::to_string(options.time_control.increment_ms);
+    command += " binc ";
+    command += std::to_string(options.time_control.increment_ms);
+
+    Clock::duration elapsed{};
+    try {
+      Tools::EngineProcess& engine = player.process();
+      const Clock::time_point start = Clock::now();
+      engine.send(command);
+      const std::optional<std::string_view> line = engine.wait_for("bestmove", start + clock + margin);
+      elapsed = Clock::now() - start;
+      if (!line) {
+        engine.send("stop");
+        return finish(loss_of(side), GameEnd::TimeForfeit);
+      }
+      std::string_view move = line->substr(std::min(line->size(), std::string_view("bestmove").size()));
+      move.remove_prefix(std::min(move.size(), move.find_first_not_of(' ')));
+      best_move.assign(move.substr(0, move.find(' ')));
+    } catch (const std::runtime_error&) {
+      player.fail();
+      return finish(loss_of(side), GameEnd::EngineFailure);
+    }
+
+    clock -= elapsed;
+    if (clock < -margin) {
+      return finish(loss_of(side), GameEnd::TimeForfeit);
+    }
+    clock = std::max(clock, Clock::duration::zero()) + increment;
+
+    const auto played = std::ranges::find_if(moves, [&best_move](const Move& move) {
+      return move.to_uci() == best_move;
+    });
+    if (played == moves.end()) {
+      return finish(loss_of(side), GameEnd::IllegalMove);
+    }
+    position.apply_move(*played);
+    position_command += ' ';
+    position_command += best_move;
+  }
+}
+
+/**
+ * State shared by the game slots of a match.
+ */
+struct SharedMatch {
+  const MatchOptions& options;
+  const std::vector<std::string>& openings;
+  const Tools::GameCallback& on_game;
+  std::atomic<std::size_t> next_game{0};
+  std::mutex result_mutex;
+  Tools::MatchResult result;
+};
+
+void run_games(SharedMatch& match) {
+  std::array<Player, 2> players{Player(match.options.first), Player(match.options.second)};
+  for (std::size_t game = match.next_game++; game < match.options.games; game = match.next_game++) {
+    GameRecord record{.game = game, .opening = (game / 2) % match.openings.size(), .first_is_white = game % 2 == 0};
+    record = play_game(players, match.openings[record.opening], match.options, record);
+
+    const bool first_is_white = record.first_is_white;
+    const std::scoped_lock lock(match.result_mutex);
+    Tools::MatchScore& score = match.result.score;
+    if (record.result == GameResult::Draw) {
+      ++score.draws;
+    } else if ((record.result == GameResult::WhiteWin) == first_is_white) {
+      ++score.wins;
+    } else {
+      ++score.losses;
+    }
+    if (record.end == GameEnd::TimeForfeit) {
+      ++match.result.time_forfeits;
+    }
+    if (match.options.sprt) {
+      match.result.llr = Tools::sprt_llr(score, *match.options.sprt);
+      // The decision stands while the games in progress finish
+      if (match.result.decision == Tools::SprtDecision::Continue) {
+        match.result.decision = Tools::sprt_decision(match.result.llr, *match.options.sprt);
+      }
+      if (match.result.decision != Tools::SprtDecision::Continue) {
+        match.next_game = match.options.games;
+      }
+    }
+    if (match.on_game) {
+      match.on_game(record, score);
+    }
+  }
+}
+
+}  // namespace
+
+Tools::EloEstimate Tools::estimate_elo(const MatchScore& score) {
+  if (score.games() == 0) {
+    return {};
+  }
+  // Half a point away from a perfect score keeps the estimate finite
+  const auto [games, mean, variance] = score_moments(score);
+  const double limit = 0.5 / games;  // NOLINT(readability-magic-numbers)
+  const double deviation = NORMAL_QUANTILE_95 * std::sqrt(variance / games);
+
+  const auto clamped_elo = [limit](double value) { return elo_of_score(std::clamp(value, limit, 1.0 - limit)); };
+  return {.elo = clamped_elo(mean), .margin = (clamped_elo(mean + deviation) - clamped_elo(mean - deviation)) / 2.0};
+}
+
+double Tools::sprt_llr(const MatchScore& score, const SprtOptions& sprt) {
+  if (score.games() == 0) {
+    return 0.0;
+  }
+  const auto [games, mean, variance] = score_moments(score, SPRT_PSEUDO_COUNT);
+  const double score0 = score_of_elo(sprt.elo0);
+  const double score1 = score_of_elo(sprt.elo1);
+  return games * (score1 - score0) * (2.0 * mean - score0 - score1) / (2.0 * variance);
+}
+
+Tools::SprtDecision Tools::sprt_decision(double llr, const SprtOptions& sprt) {
+  if (llr >= std::log((1.0 - sprt.beta) / sprt.alpha)) {
+    return SprtDecision::AcceptH1;
+  }
+  if (llr <= std::log(sprt.beta / (1.0 - sprt.alpha))) {
+    return SprtDecision::AcceptH0;
+  }
+  return SprtDecision::Continue;
+}
+
+std::string_view Tools::game_end_name(GameEnd end) noexcept {
+  // clang-format off
+  switch (end) {
+    case GameEnd::Checkmate:            return "checkmate";
+    case GameEnd::Stalemate:            return "stalemate";
+    case GameEnd::Repetition:           return "repetition";
+    case GameEnd::FiftyMoves:           return "fifty moves";
+    case GameEnd::InsufficientMaterial: return "insufficient material";
+    case GameEnd::MaxPlies:             return "ply limit";
+    case GameEnd::TimeForfeit:          return "time forfeit";
+    case GameEnd::IllegalMove:          return "illegal move";
+    case GameEnd::EngineFailure:        return "engine failure";
+  }
+  // clang-format on
+  return "unknown";
+}
+
+std::vector<std::string> Tools::load_openings(const std::string& path, std::size_t& invalid_lines) {
+  std::ifstream in(path);
+  if (!in) {
+    throw std::runtime_error("cannot read " + path);
+  }
+
+  std::vector<std::string> openings;
+  for (std::string line; std::getline(in, line);) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos) {
+      continue;
+    }
+    Board board;
+    std::string_view operations;
+    if (Fen::parse(line, board) != Fen::Error::None && Fen::parse_epd(line, board, operations) != Fen::Error::None) {
+      ++invalid_lines;
+      continue;
+    }
+    openings.push_back(board.get_fen());
+  }
+  return openings;
+}
+
+Tools::MatchResult Tools::run_match(const MatchOptions& options, const GameCallback& on_game) {
+  const auto start = Clock::now();
+
+  std::vector<std::string> openings = options.openings;
+  if (openings.empty()) {
+    openings.push_back(Board().get_fen());
+  }
+  for (const std::string& opening : openings) {
+    Board board;
+    if (Fen::parse(opening, board) != Fen::Error::None) {
+      throw std::runtime_error("invalid opening " + opening);
+    }
+  }
+  if (options.seed != 0) {
+    std::uint64_t seed = options.seed;
+    for (std::size_t i = openings.size(); i > 1; --i) {
+      std::swap(openings[i - 1], openings[Random::splitmix64(seed) % i]);
+    }
+  }
+
+  SharedMatch match{.options = options, .openings = openings, .on_game = on_game};
+  const unsigned requested = options.concurrency == 0 ? std::max(1U, std::thread::hardware_concurrency())
+                                                      : options.concurrency;
+  const auto slots = static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(requested, options.games)));
+
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  const auto worker = [&] {
+    try {
+      run_games(match);
+    } catch (...) {
+      const std::scoped_lock lock(error_mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+      match.next_game = options.games;
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(slots - 1);
+  for (unsigned slot = 1; slot < slots; ++slot) {
+    pool.emplace_back(worker);
+  }
+  worker();
+  for (std::thread& thread : pool) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  match.result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  return match.result;
+}
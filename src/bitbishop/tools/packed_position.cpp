@@ -0,0 +1,394 @@
+#include <algorithm>
+#include <bit>
+#include <bitbishop/fen.hpp>
+#include <bitbishop/moves/san.hpp>
+#include <bitbishop/tools/packed_position.hpp>
+#include <charconv>
+#include <cstdlib>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+using Tools::PackedPosition;
+
+CX_CONST std::size_t OCCUPANCY_OFFSET = 0;
+CX_CONST std::size_t PIECES_OFFSET = 8;
+CX_CONST std::size_t STATE_OFFSET = 24;
+CX_CONST std::size_t FULLMOVE_OFFSET = 26;
+CX_CONST std::size_t SCORE_OFFSET = 28;
+CX_CONST std::size_t MOVE_OFFSET = 30;
+
+CX_CONST unsigned BLACK_PIECE_BIT = 8;
+CX_CONST unsigned NIBBLE_BITS = 4;
+CX_CONST unsigned NIBBLE_MASK = 0xF;
+CX_CONST unsigned CASTLING_SHIFT = 1;
+CX_CONST unsigned EN_PASSANT_SHIFT = 5;
+CX_CONST unsigned HALFMOVE_SHIFT = 9;
+CX_CONST unsigned MAX_HALFMOVE = 127;
+CX_CONST unsigned SQUARE_BITS = 6;
+CX_CONST unsigned SQUARE_MASK = 63;
+CX_CONST unsigned PROMOTION_SHIFT = 12;
+CX_CONST unsigned RESULT_SHIFT = 14;
+CX_CONST unsigned TWO_BITS_MASK = 3;
+CX_CONST int CASTLING_DISTANCE = 2;
+
+template <typename Integer>
+Integer read_little_endian(const PackedPosition& packed, std::size_t offset) noexcept {
+  using Unsigned = std::make_unsigned_t<Integer>;
+  Unsigned value = 0;
+  for (std::size_t i = sizeof(Integer); i-- > 0;) {
+    value = static_cast<Unsigned>((value << 8) | std::to_integer<Unsigned>(packed.bytes[offset + i]));  // NOLINT
+  }
+  return static_cast<Integer>(value);
+}
+
+template <typename Integer>
+void write_little_endian(PackedPosition& packed, std::size_t offset, Integer value) noexcept {
+  auto bits = static_cast<std::make_unsigned_t<Integer>>(value);
+  for (std::size_t i = 0; i < sizeof(Integer); ++i) {
+    packed.bytes[offset + i] = static_cast<std::byte>(bits & 0xFF);  // NOLINT(readability-magic-numbers)
+    bits = static_cast<decltype(bits)>(bits >> 8);                   // NOLINT(readability-magic-numbers)
+  }
+}
+
+std::uint16_t pack_move(const std::optional<Move>& move, Tools::GameResult result) {
+  unsigned bits = static_cast<unsigned>(result) << RESULT_SHIFT;
+  if (move) {
+    bits |= static_cast<unsigned>(move->from.flat_index()) | (move->to.flat_index() << SQUARE_BITS);
+    if (move->promotion) {
+      bits |= static_cast<unsigned>(move->promotion->type() - Piece::KNIGHT) << PROMOTION_SHIFT;
+    }
+  }
+  return static_cast<std::uint16_t>(bits);
+}
+
+/**
+ * Move of a board from its origin, destination and promotion, with the flags the board implies.
+ */
+std::optional<Move> unpack_move(const Board& board, unsigned bits) {
+  const Square from(static_cast<int>(bits & SQUARE_MASK), std::in_place);
+  const Square to(static_cast<int>((bits >> SQUARE_BITS) & SQUARE_MASK), std::in_place);
+  const std::optional<Piece> piece = board.get_piece(from);
+  if (!piece) {
+    return std::nullopt;
+  }
+  const bool is_capture = board.get_piece(to).has_value();
+
+  if (piece->is_pawn() && (to.rank() == Const::RANK_1_IND || to.rank() == Const::RANK_8_IND)) {
+    const auto type = static_cast<Piece::Type>(Piece::KNIGHT + ((bits >> PROMOTION_SHIFT) & TWO_BITS_MASK));
+    return Move::make_promotion(from, to, Piece(type, piece->color()), is_capture);
+  }
+  if (piece->is_pawn() && board.en_passant_square() == to && from.file() != to.file()) {
+    return Move::make_en_passant(from, to);
+  }
+  if (piece->is_king() && std::abs(to.file() - from.file()) == CASTLING_DISTANCE) {
+    return Move::make_castling(from, to);
+  }
+  return Move::make(from, to, is_capture);
+}
+
+std::optional<Tools::GameResult> result_of(std::string_view text) {
+  if (text == "1-0") {
+    return Tools::GameResult::WhiteWin;
+  }
+  if (text == "0-1") {
+    return Tools::GameResult::BlackWin;
+  }
+  if (text == "1/2-1/2") {
+    return Tools::GameResult::Draw;
+  }
+  return std::nullopt;
+}
+
+std::string_view result_text(Tools::GameResult result) {
+  switch (result) {
+    // clang-format off
+    case Tools::GameResult::WhiteWin: return "1-0";
+    case Tools::GameResult::BlackWin: return "0-1";
+    case Tools::GameResult::Draw:     return "1/2-1/2";
+    default:                          return "*";
+    // clang-format on
+  }
+}
+
+template <typename Integer>
+bool parse_integer(std::string_view text, Integer& value) {
+  const char* end = text.data() + text.size();
+  const auto [last, error] = std::from_chars(text.data(), end, value);
+  return !text.empty() && error == std::errc{} && last == end;
+}
+
+/**
+ * Applies one EPD operation (opcode and operand) to a training position.
+ */
+bool apply_operation(std::string_view opcode, std::string_view operand, Tools::TrainingPosition& position,
+                     BoardState& state) {
+
+  if (opcode == "hmvc") {
+    return parse_integer(operand, state.m_halfmove_clock);
+  }
+  if (opcode == "fmvn") {
+    return parse_integer(operand, state.m_fullmove_number);
+  }
+  if (opcode == "ce") {
+    int score = 0;
+    if (!parse_integer(operand, score)) {
+      return false;
+    }
+    // NO_SCORE is reserved for unknown scores
+    CX_CONST int MAX_SCORE = std::numeric_limits<std::int16_t>::max();
+    position.score = static_cast<std::int16_t>(std::clamp(score, -MAX_SCORE, MAX_SCORE));
+    return true;
+  }
+  if (opcode == "bm") {
+    position.best_move = San::parse(position.board, operand.substr(0, operand.find(' ')));
+    return position.best_move.has_value();
+  }
+  if (opcode == "c9") {
+    std::string_view text = operand;
+    if (text.size() >= 2 && text.front() == '"' && text.back() == '"') {
+      text = text.substr(1, text.size() - 2);
+    }
+    position.result = result_of(text).value_or(Tools::GameResult::Unknown);
+  }
+  return true;
+}
+
+}  // namespace
+
+std::optional<PackedPosition> PackedPosition::pack(const TrainingPosition& position) noexcept {
+  const Board& board = position.board;
+  const Bitboard occupied = board.occupied();
+  if (static_cast<std::size_t>(occupied.count()) > MAX_PIECES) {
+    return std::nullopt;
+  }
+
+  PackedPosition packed;
+  write_little_endian(packed, OCCUPANCY_OFFSET, occupied.value());
+
+  // The rank of a square among the occupied ones gives its nibble
+  for (const Color color : {Color::WHITE, Color::BLACK}) {
+    for (const Piece::Type type : Piece::ALL_TYPES) {
+      const unsigned code = type | (color == Color::BLACK ? BLACK_PIECE_BIT : 0U);
+      for (const Square square : board.pieces(Piece(type, color))) {
+        const auto nibble = static_cast<std::size_t>(std::popcount(occupied.value() & ((1ULL << square.value()) - 1)));
+        packed.bytes[PIECES_OFFSET + (nibble / 2)] |= static_cast<std::byte>(code << (NIBBLE_BITS * (nibble % 2)));
+      }
+    }
+  }
+
+  const BoardState state = board.get_state();
+  unsigned flags = state.m_is_white_turn ? 0U : 1U;
+  flags |= (state.m_white_castle_kingside ? 1U : 0U) << CASTLING_SHIFT;
+  flags |= (state.m_white_castle_queenside ? 2U : 0U) << CASTLING_SHIFT;
+  flags |= (state.m_black_castle_kingside ? 4U : 0U) << CASTLING_SHIFT;
+  flags |= (state.m_black_castle_queenside ? 8U : 0U) << CASTLING_SHIFT;
+  if (state.m_en_passant_sq) {
+    flags |= static_cast<unsigned>(state.m_en_passant_sq->file() + 1) << EN_PASSANT_SHIFT;
+  }
+  flags |= static_cast<unsigned>(std::clamp(state.m_halfmove_clock, 0, static_cast<int>(MAX_HALFMOVE)))
+           << HALFMOVE_SHIFT;
+  write_little_endian(packed, STATE_OFFSET, static_cast<std::uint16_t>(flags));
+  write_little_endian(packed, FULLMOVE_OFFSET,
+                      static_cast<std::uint16_t>(std::clamp(state.m_fullmove_number, 0, UINT16_MAX)));
+  write_little_endian(packed, SCORE_OFFSET, position.score.value_or(NO_SCORE));
+  write_little_endian(packed, MOVE_OFFSET, pack_move(position.best_move, position.result));
+  return packed;
+}
+
+std::optional<Tools::TrainingPosition> PackedPosition::unpack() const {
+  static const Board EMPTY = Board::Empty();
+
+  const Bitboard occupied(read_little_endian<std::uint64_t>(*this, OCCUPANCY_OFFSET));
+  if (static_cast<std::size_t>(occupied.count()) > MAX_PIECES) {
+    return std::nullopt;
+  }
+
+  TrainingPosition position{.board = EMPTY};
+  std::size_t nibble = 0;
+  for (const Square square : occupied) {
+    const unsigned code =
+        (std::to_integer<unsigned>(bytes[PIECES_OFFSET + (nibble / 2)]) >> (NIBBLE_BITS * (nibble % 2))) & NIBBLE_MASK;
+    const unsigned type = code & ~BLACK_PIECE_BIT;
+    if (type > Piece::KING) {
+      return std::nullopt;
+    }
+    const Color color = (code & BLACK_PIECE_BIT) != 0 ? Color::BLACK : Color::WHITE;
+    position.board.set_piece(square, Piece(static_cast<Piece::Type>(type), color));
+    ++nibble;
+  }
+
+  const unsigned flags = read_little_endian<std::uint16_t>(*this, STATE_OFFSET);
+  const unsigned castling = flags >> CASTLING_SHIFT;
+  const unsigned en_passant_file = (flags >> EN_PASSANT_SHIFT) & NIBBLE_MASK;
+  if (en_passant_file > Const::BOARD_WIDTH) {
+    return std::nullopt;
+  }
+  BoardState state{};
+  state.m_is_white_turn = (flags & 1U) == 0;
+  state.m_white_castle_kingside = (castling & 1U) != 0;
+  state.m_white_castle_queenside = (castling & 2U) != 0;
+  state.m_black_castle_kingside = (castling & 4U) != 0;
+  state.m_black_castle_queenside = (castling & 8U) != 0;
+  if (en_passant_file != 0) {
+    const int rank = state.m_is_white_turn ? Const::RANK_6_IND : Const::RANK_3_IND;
+    state.m_en_passant_sq = Square((rank * Const::BOARD_WIDTH) + static_cast<int>(en_passant_file) - 1, std::in_place);
+  }
+  state.m_halfmove_clock = static_cast<int>(flags >> HALFMOVE_SHIFT);
+  state.m_fullmove_number = read_little_endian<std::uint16_t>(*this, FULLMOVE_OFFSET);
+  position.board.set_state(state);
+
+  if (const auto score = read_little_endian<std::int16_t>(*this, SCORE_OFFSET); score != NO_SCORE) {
+    position.score = score;
+  }
+  const unsigned move = read_little_endian<std::uint16_t>(*this, MOVE_OFFSET);
+  position.result = static_cast<GameResult>((move >> RESULT_SHIFT) & TWO_BITS_MASK);
+  if ((move & SQUARE_MASK) != ((move >> SQUARE_BITS) & SQUARE_MASK)) {
+    position.best_move = unpack_move(position.board, move);
+    if (!position.best_move) {
+      return std::nullopt;
+    }
+  }
+  return position;
+}
+
+bool Tools::parse_training_line(std::string_view line, TrainingPosition& position) {
+  TrainingPosition parsed{.board = position.board};
+  std::string_view operations;
+  if (Fen::parse(line, parsed.board) != Fen::Error::None &&
+      Fen::parse_epd(line, parsed.board, operations) != Fen::Error::None) {
+    return false;
+  }
+
+  BoardState state = parsed.board.get_state();
+  if (!Fen::for_each_operation(operations, [&](std::string_view opcode, std::string_view operand) {
+        return apply_operation(opcode, operand, parsed, state);
+      })) {
+    return false;
+  }
+  parsed.board.set_state(state);
+
+  position = std::move(parsed);
+  return true;
+}
+
+std::string Tools::format_training_line(const TrainingPosition& position) {
+  std::array<char, Fen::MAX_LENGTH> buffer;
+  const std::string_view fen(buffer.data(), Fen::format_to(buffer.data(), position.board));
+
+  // Position fields of the FEN, the clocks become operations
+  std::size_t end = 0;
+  for (int field = 0; field < 4; ++field) {
+    end = fen.find(' ', end + 1);
+  }
+  std::string line(fen.substr(0, end));
+
+  const BoardState state = position.board.get_state();
+  line += " hmvc " + std::to_string(state.m_halfmove_clock) + "; fmvn " + std::to_string(state.m_fullmove_number) + ";";
+  if (position.score) {
+    line += " ce " + std::to_string(*position.score) + ";";
+  }
+  if (position.best_move && position.board.get_piece(position.best_move->from)) {
+    line += " bm ";
+    line += San::write(position.board, *position.best_move).view();
+    line += ";";
+  }
+  if (position.result != GameResult::Unknown) {
+    line += " c9 \"";
+    line += result_text(position.result);
+    line += "\";";
+  }
+  return line;
+}
+
+Tools::PackedWriter::PackedWriter(const std::string& path, bool deduplicate, std::size_t buffer_positions)
+    : m_out(path, std::ios::binary | std::ios::trunc),
+      m_path(path),
+      m_buffer_positions(std::max<std::size_t>(buffer_positions, 1)),
+      m_deduplicate(deduplicate) {
+  if (!m_out) {
+    throw std::runtime_error("cannot create " + path);
+  }
+  m_buffer.reserve(m_buffer_positions * PackedPosition::SIZE);
+}
+
+Tools::PackedWriter::~PackedWriter() {
+  try {
+    close();
+  } catch (const std::exception&) {  // NOLINT(bugprone-empty-catch)
+  }
+}
+
+bool Tools::PackedWriter::write(const TrainingPosition& position) {
+  if (m_deduplicate && !m_seen.insert(position.board.get_zobrist_hash()).second) {
+    ++m_duplicates;
+    return false;
+  }
+  const std::optional<PackedPosition> packed = PackedPosition::pack(position);
+  if (!packed) {
+    ++m_rejected;
+    return false;
+  }
+  m_buffer.insert(m_buffer.end(), packed->bytes.begin(), packed->bytes.end());
+  ++m_written;
+  if (m_buffer.size() >= m_buffer_positions * PackedPosition::SIZE) {
+    flush();
+  }
+  return true;
+}
+
+void Tools::PackedWriter::flush() {
+  if (m_buffer.empty() || !m_out.is_open()) {
+    return;
+  }
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  m_out.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+  m_buffer.clear();
+  if (!m_out) {
+    throw std::runtime_error("cannot write " + m_path);
+  }
+}
+
+void Tools::PackedWriter::close() {
+  flush();
+  if (m_out.is_open()) {
+    m_out.close();
+    if (!m_out) {
+      throw std::runtime_error("cannot write " + m_path);
+    }
+  }
+}
+
+bool Tools::PackedReader::open(const std::string& path) {
+  close();
+  std::error_code error;
+  const auto size = std::filesystem::file_size(path, error);
+  if (error || size % PackedPosition::SIZE != 0) {
+    return false;
+  }
+  if (size > 0) {
+    auto file = std::make_unique<Nnue::MappedFile>();
+    if (!file->open(path)) {
+      return false;
+    }
+    m_file = std::move(file);
+  }
+  m_open = true;
+  return true;
+}
+
+void Tools::PackedReader::close() noexcept {
+  m_file.reset();
+  m_open = false;
+}
+
+std::size_t Tools::PackedReader::size() const noexcept { return m_file ? m_file->size() / PackedPosition::SIZE : 0; }
+
+Tools::PackedPosition Tools::PackedReader::record(std::size_t index) const noexcept {
+  PackedPosition packed;
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  std::copy_n(m_file->data() + (index * PackedPosition::SIZE), PackedPosition::SIZE, packed.bytes.begin());
+  return packed;
+}
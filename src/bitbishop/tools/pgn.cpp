@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <atomic>
+#include <bitbishop/tools/pgn.hpp>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace {
+
+std::optional<Tools::GameResult> result_of(std::string_view token) {
+  if (token == "1-0") {
+    return Tools::GameResult::WhiteWin;
+  }
+  if (token == "0-1") {
+    return Tools::GameResult::BlackWin;
+  }
+  if (token == "1/2-1/2") {
+    return Tools::GameResult::Draw;
+  }
+  if (token == "*") {
+    return Tools::GameResult::Unknown;
+  }
+  return std::nullopt;
+}
+
+/**
+ * Value of a `[Name "Value"]` tag line, escapes not decoded.
+ */
+std::string_view tag_value(std::string_view line) {
+  const std::size_t open = line.find('"');
+  const std::size_t close = line.rfind('"');
+  return (open == std::string_view::npos || close <= open) ? std::string_view{}
+                                                          : line.substr(open + 1, close - open - 1);
+}
+
+bool is_space(char character) {
+  return character == ' ' || character == '\n' || character == '\r' || character == '\t';
+}
+
+bool is_tag(std::string_view line, std::string_view name) {
+  return line.size() > name.size() + 1 && line.substr(1, name.size()) == name && is_space(line[name.size() + 1]);
+}
+
+bool ends_token(char character) {
+  return is_space(character) || character == '{' || character == '(' || character == ')' || character == ';';
+}
+
+std::size_t line_end(std::string_view text, std::size_t position) {
+  const std::size_t end = text.find('\n', position);
+  return end == std::string_view::npos ? text.size() : end;
+}
+
+}  // namespace
+
+void Tools::PgnGame::clear() {
+  fen = {};
+  moves.clear();
+  result = GameResult::Unknown;
+}
+
+bool Tools::PgnTokenizer::next(PgnGame& game) {
+  game.clear();
+  bool started = false;
+  bool in_movetext = false;
+  int variation_depth = 0;
+
+  while (m_position < m_text.size()) {
+    const char character = m_text[m_position];
+    const bool line_start = m_position == 0 || m_text[m_position - 1] == '\n';
+
+    if (line_start && variation_depth == 0 && character == '[') {
+      if (in_movetext) {
+        return true;  // Next game without result token
+      }
+      started = true;
+      const std::size_t end = line_end(m_text, m_position);
+      const std::string_view line = m_text.substr(m_position, end - m_position);
+      if (is_tag(line, "FEN")) {
+        game.fen = tag_value(line);
+      } else if (is_tag(line, "Result")) {
+        game.result = result_of(tag_value(line)).value_or(GameResult::Unknown);
+      }
+      m_position = end;
+    } else if ((line_start && character == '%') || character == ';') {
+      m_position = line_end(m_text, m_position);  // Escaped line, or comment to the end of the line
+    } else if (character == '{') {
+      const std::size_t end = m_text.find('}', m_position);
+      m_position = end == std::string_view::npos ? m_text.size() : end + 1;
+    } else if (character == '(') {
+      ++variation_depth;
+      ++m_position;
+    } else if (character == ')') {
+      variation_depth = std::max(variation_depth - 1, 0);
+      ++m_position;
+    } else if (is_space(character)) {
+      ++m_position;
+    } else {
+      const std::size_t begin = m_position;
+      while (m_position < m_text.size() && !ends_token(m_text[m_position])) {
+        ++m_position;
+      }
+      if (variation_depth > 0) {
+        continue;
+      }
+      std::string_view token = m_text.substr(begin, m_position - begin);
+
+      started = true;
+      in_movetext = true;
+      if (const std::optional<GameResult> result = result_of(token)) {
+        game.result = *result;
+        return true;
+      }
+      // Move numbers, possibly glued to the move ("12.e4", "12...e5"), and NAGs
+      const std::size_t digits = token.find_first_not_of("0123456789");
+      if (digits != std::string_view::npos && token[digits] == '.') {
+        token.remove_prefix(std::min(token.find_first_not_of('.', digits), token.size()));
+      } else if (digits == std::string_view::npos) {
+        continue;
+      }
+      if (!token.empty() && token.front() != '$') {
+        game.moves.push_back(token);
+      }
+    }
+  }
+  return started;
+}
+
+bool Tools::PgnFile::open(const std::string& path) {
+  std::error_code error;
+  const auto size = std::filesystem::file_size(path, error);
+  if (error) {
+    return false;
+  }
+  m_open = size == 0 || m_file.open(path);
+  return m_open;
+}
+
+std::string_view Tools::PgnFile::text() const noexcept {
+  if (!m_open || m_file.size() == 0) {
+    return {};
+  }
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  return {reinterpret_cast<const char*>(m_file.data()), m_file.size()};
+}
+
+std::vector<std::string_view> Tools::split_games(std::string_view text, std::size_t parts) {
+  std::vector<std::string_view> chunks;
+  const std::size_t target = std::max<std::size_t>(1, text.size() / std::max<std::size_t>(parts, 1));
+
+  std::size_t begin = 0;
+  while (begin < text.size()) {
+    std::size_t end = text.size();
+    for (std::size_t search = begin + target; search < text.size();) {
+      const std::size_t tag = text.find("\n[", search);
+      if (tag == std::string_view::npos) {
+        break;
+      }
+      // A blank line, possibly with a carriage return, before the tag
+      const bool after_blank_line =
+          tag > 0 && (text[tag - 1] == '\n' || (tag > 1 && text[tag - 1] == '\r' && text[tag - 2] == '\n'));
+      if (after_blank_line) {
+        end = tag + 1;
+        break;
+      }
+      search = tag + 1;
+    }
+    chunks.push_back(text.substr(begin, end - begin));
+    begin = end;
+  }
+  return chunks;
+}
+
+void Tools::for_each_game(const std::vector<std::string_view>& chunks, unsigned threads,
+                          const std::function<void(unsigned, const PgnGame&)>& visit) {
+  if (threads == 0) {
+    threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  threads = std::max(1U, std::min(threads, static_cast<unsigned>(chunks.size())));
+
+  std::atomic<std::size_t> next_chunk{0};
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  const auto worker = [&](unsigned thread) {
+    try {
+      PgnGame game;
+      for (std::size_t chunk = next_chunk++; chunk < chunks.size(); chunk = next_chunk++) {
+        PgnTokenizer tokenizer(chunks[chunk]);
+        while (tokenizer.next(game)) {
+          visit(thread, game);
+        }
+      }
+    } catch (...) {
+      const std::scoped_lock lock(error_mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+      next_chunk = chunks.size();
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (unsigned thread = 1; thread < threads; ++thread) {
+    pool.emplace_back(worker, thread);
+  }
+  worker(0);
+  for (std::thread& thread : pool) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
@@ -0,0 +1,319 @@
+#include <algorithm>
+#include <atomic>
+#include <bitbishop/attacks/checkers.hpp>
+#include <bitbishop/lookups/king_attacks.hpp>
+#include <bitbishop/movegen/legal_moves.hpp>
+#include <bitbishop/moves/position.hpp>
+#include <bitbishop/tools/tablebase_generator.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+namespace {
+
+using namespace Tablebase;
+
+CX_CONST std::size_t CHUNK_SIZE = 4096;  // Indexes handed to a worker thread at once
+
+using PendingResults = std::vector<std::pair<std::size_t, std::uint8_t>>;
+
+/**
+ * Material without tablebase: kings and at most one minor piece, no side can mate.
+ */
+bool is_trivial_draw(Material::Key key) {
+  int minors = 0;
+  for (const Color color : {Color::WHITE, Color::BLACK}) {
+    for (const Piece::Type type : {Piece::PAWN, Piece::ROOK, Piece::QUEEN}) {
+      if (Material::count(key, Piece(type, color)) > 0) {
+        return false;
+      }
+    }
+    minors += Material::count(key, Piece(Piece::BISHOP, color)) + Material::count(key, Piece(Piece::KNIGHT, color));
+  }
+  return minors <= 1;
+}
+
+/**
+ * Runs `work(thread, begin, end)` over chunks of [0, size), chunks being handed to threads as they finish.
+ */
+template <typename Work>
+void parallel_for(std::size_t size, unsigned threads, Work work) {
+  std::atomic<std::size_t> next{0};
+  const auto worker = [&](unsigned thread) {
+    for (std::size_t begin = next.fetch_add(CHUNK_SIZE); begin < size; begin = next.fetch_add(CHUNK_SIZE)) {
+      work(thread, begin, std::min(begin + CHUNK_SIZE, size));
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (unsigned thread = 1; thread < threads; ++thread) {
+    pool.emplace_back(worker, thread);
+  }
+  worker(0);
+  for (std::thread& thread : pool) {
+    thread.join();
+  }
+}
+
+/**
+ * Board reused between the positions of a chunk: only the pieces of the previous position are removed.
+ */
+class Placement {
+ private:
+  Board m_board = Board::Empty();
+  std::array<int, MAX_PIECES> m_squares{};
+  std::size_t m_count = 0;
+
+ public:
+  /**
+   * @return false if the index is not a canonical placement
+   */
+  bool place(const Layout& layout, std::size_t index) {
+    for (std::size_t slot = 0; slot < m_count; ++slot) {
+      m_board.remove_piece(Square(m_squares[slot], std::in_place));
+    }
+    m_count = 0;
+
+    Color side_to_move = Color::WHITE;
+    if (!layout.decode(index, m_squares, side_to_move)) {
+      return false;
+    }
+    m_count = layout.pieces().size();
+    for (std::size_t slot = 0; slot < m_count; ++slot) {
+      m_board.set_piece(Square(m_squares[slot], std::in_place), layout.pieces()[slot]);
+    }
+    m_board.set_side_to_move(side_to_move);
+    return true;
+  }
+
+  [[nodiscard]] Board& board() noexcept { return m_board; }
+};
+
+/**
+ * DTM byte of a position without search: illegal, mated, stalemated, or unknown.
+ */
+std::uint8_t initial_code(Board& board) {
+  const Color us = board.get_side_to_move();
+  const Color them = ColorUtil::opposite(us);
+  const Square our_king = *board.king(us).lsb();
+  const Square their_king = *board.king(them).lsb();
+  if (Lookups::KING_ATTACKS[our_king.flat_index()].test(their_king) ||
+      compute_checkers(board, their_king, us).any()) {
+    return DTM_ILLEGAL;
+  }
+
+  std::vector<Move> moves;
+  generate_legal_moves(moves, board);
+  if (!moves.empty()) {
+    return DTM_UNKNOWN;
+  }
+  return compute_checkers(board, our_king, them).any() ? dtm_code(0) : DTM_DRAW;
+}
+
+}  // namespace
+
+Tools::TablebaseGenerator::TablebaseGenerator(unsigned threads)
+    : m_threads(threads > 0 ? threads : std::max(1U, std::thread::hardware_concurrency())) {}
+
+std::optional<std::uint8_t> Tools::TablebaseGenerator::lookup(const Board& board) const {
+  const Material::Key key = board.get_material_key();
+  bool flipped = false;
+  auto entry = m_tables.find(key);
+  if (entry == m_tables.end()) {
+    entry = m_tables.find(Material::mirror(key));
+    flipped = true;
+  }
+  if (entry == m_tables.end()) {
+    return std::nullopt;
+  }
+  const Table& table = *entry->second;
+  return table.codes[table.layout.index(board, flipped)];
+}
+
+std::optional<std::uint8_t> Tools::TablebaseGenerator::child_code(const Board& board) const {
+  if (const std::optional<std::uint8_t> code = lookup(board)) {
+    return code;
+  }
+  if (is_trivial_draw(board.get_material_key()) || board.has_insufficient_material()) {
+    return DTM_DRAW;
+  }
+  return std::nullopt;
+}
+
+void Tools::TablebaseGenerator::generate(std::string_view code) {
+  auto table = std::make_unique<Table>(code);
+  const Material::Key key = table->layout.key();
+  if (m_tables.contains(key) || m_tables.contains(Material::mirror(key))) {
+    return;
+  }
+
+  // Captures remove a piece, promotions replace a pawn: their tablebases are needed first
+  std::vector<Material::Key> children;
+  for (const Piece piece : table->layout.pieces()) {
+    if (piece.is_king()) {
+      continue;
+    }
+    const Material::Key captured = key - Material::unit(piece);
+    children.push_back(captured);
+    if (piece.is_pawn()) {
+      for (const Piece::Type type : {Piece::QUEEN, Piece::ROOK, Piece::BISHOP, Piece::KNIGHT}) {
+        children.push_back(captured + Material::unit(Piece(type, piece.color())));
+      }
+    }
+  }
+
+  // Mates of the children carry over with one more ply
+  int longest_child_mate = 0;
+  for (const Material::Key child : children) {
+    if (is_trivial_draw(child)) {
+      continue;
+    }
+    generate(Layout::code_of(child));
+    const auto entry = m_tables.contains(child) ? m_tables.find(child) : m_tables.find(Material::mirror(child));
+    longest_child_mate = std::max(longest_child_mate, entry->second->longest_mate);
+  }
+
+  table->codes.assign(table->layout.size(), DTM_UNKNOWN);
+  m_memory_bytes += table->codes.size();
+  m_peak_memory_bytes = std::max(m_peak_memory_bytes, m_memory_bytes);
+
+  Table& generated = *table;
+  m_tables.emplace(key, std::move(table));
+  resolve(generated, longest_child_mate);
+}
+
+void Tools::TablebaseGenerator::resolve(Table& table, int longest_child_mate) {
+  const auto start = std::chrono::steady_clock::now();
+  const Layout& layout = table.layout;
+  std::vector<std::uint8_t>& codes = table.codes;
+
+  // Each index is written by a single thread, and nothing else is read
+  parallel_for(codes.size(), m_threads, [&](unsigned, std::size_t begin, std::size_t end) {
+    Placement placement;
+    for (std::size_t index = begin; index < end; ++index) {
+      codes[index] = placement.place(layout, index) ? initial_code(placement.board()) : DTM_ILLEGAL;
+    }
+  });
+
+  std::vector<PendingResults> pending(m_threads);
+  int quiet_passes = 0;
+  int pass = 1;
+  for (; quiet_passes < 2 || pass <= longest_child_mate + 1; ++pass) {
+    const bool winning_pass = pass % 2 == 1;
+
+    parallel_for(codes.size(), m_threads, [&](unsigned thread, std::size_t begin, std::size_t end) {
+      Placement placement;
+      std::vector<Move> moves;
+      for (std::size_t index = begin; index < end; ++index) {
+        if (codes[index] != DTM_UNKNOWN || !placement.place(layout, index)) {
+          continue;
+        }
+        Board& board = placement.board();
+        Position position(board);
+        moves.clear();
+        generate_legal_moves(moves, board);
+
+        // Winning pass: one move reaches a loss, losing pass: every move reaches a win, both found earlier
+        bool resolved = !winning_pass;
+        for (const Move& move : moves) {
+          position.apply_move(move);
+          const std::optional<std::uint8_t> child = child_code(board);
+          position.revert_move();
+
+          const bool decisive = child.has_value() && is_mate_distance(*child) && dtm_plies(*child) < pass &&
+                                (dtm_plies(*child) % 2 == 1) != winning_pass;
+          if (decisive == winning_pass) {
+            resolved = winning_pass;
+            break;
+          }
+        }
+        if (resolved) {
+          pending[thread].emplace_back(index, dtm_code(pass));
+        }
+      }
+    });
+
+    std::size_t resolved = 0;
+    for (PendingResults& results : pending) {
+      resolved += results.size();
+      m_peak_memory_bytes =
+          std::max(m_peak_memory_bytes, m_memory_bytes + (resolved * sizeof(PendingResults::value_type)));
+      for (const auto& [index, code] : results) {
+        codes[index] = code;
+      }
+      results.clear();
+    }
+
+    if (resolved == 0) {
+      ++quiet_passes;
+      continue;
+    }
+    if (pass > MAX_DTM_PLIES) {
+      throw std::runtime_error("mate of " + layout.code() + " too long for the tablebase format");
+    }
+    quiet_passes = 0;
+    table.longest_mate = pass;
+  }
+
+  TablebaseStats stats{.code = layout.code(), .positions = codes.size(), .longest_mate = table.longest_mate,
+                       .passes = pass - 1};
+  for (std::uint8_t& code : codes) {
+    if (code == DTM_UNKNOWN) {
+      code = DTM_DRAW;  // No forced mate
+    }
+    switch (wdl_of(code)) {
+      case Wdl::Win:
+        ++stats.wins;
+        break;
+      case Wdl::Loss:
+        ++stats.losses;
+        break;
+      case Wdl::Draw:
+        ++stats.draws;
+        break;
+      case Wdl::Illegal:
+        ++stats.illegal;
+        break;
+    }
+  }
+  stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  m_stats.push_back(stats);
+}
+
+bool Tools::TablebaseGenerator::write(const std::string& directory) const {
+  std::error_code error;
+  std::filesystem::create_directories(directory, error);
+
+  for (const auto& [key, table] : m_tables) {
+    const std::string& code = table->layout.code();
+    FileHeader header;
+    header.positions = table->codes.size();
+    std::copy_n(code.begin(), std::min(code.size(), header.code.size() - 1), header.code.begin());
+
+    std::vector<std::uint8_t> wdl((table->codes.size() + 3) / 4);
+    for (std::size_t index = 0; index < table->codes.size(); ++index) {
+      const auto wdl_bits = static_cast<unsigned>(wdl_of(table->codes[index]));
+      wdl[index / 4] |= static_cast<std::uint8_t>(wdl_bits << (2 * (index % 4)));
+    }
+
+    const std::filesystem::path base = std::filesystem::path(directory) / code;
+    for (const auto& [extension, magic, data] :
+         {std::tuple{WDL_EXTENSION, WDL_MAGIC, &wdl}, std::tuple{DTM_EXTENSION, DTM_MAGIC, &table->codes}}) {
+      header.magic = magic;
+      std::ofstream out(base.string() + std::string(extension), std::ios::binary);
+      // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+      out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      out.write(reinterpret_cast<const char*>(data->data()), static_cast<std::streamsize>(data->size()));
+      // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+      if (!out) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
@@ -0,0 +1,339 @@
+#include <algorithm>
+#include <array>
+#include <bitbishop/attacks/checkers.hpp>
+#include <bitbishop/engine/endgame.hpp>
+#include <bitbishop/tools/tuner.hpp>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <numbers>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+using Eval::TERM_COUNT;
+
+CX_CONST double ADAM_EPSILON = 1e-8;
+CX_CONST double K_SEARCH_MIN = 0.0;
+CX_CONST double K_SEARCH_MAX = 4.0;
+CX_CONST int K_SEARCH_STEPS = 40;
+CX_CONST double SIGMOID_SCALE = 400.0;
+
+bool in_check(const Board& board) {
+  const Color side = board.get_side_to_move();
+  const std::optional<Square> king = board.king_square(side);
+  return king && compute_checkers(board, *king, ColorUtil::opposite(side)).any();
+}
+
+std::optional<float> result_value(Tools::GameResult result) {
+  // clang-format off
+  switch (result) {
+    case Tools::GameResult::WhiteWin: return 1.0F;
+    case Tools::GameResult::Draw:     return 0.5F;  // NOLINT(readability-magic-numbers)
+    case Tools::GameResult::BlackWin: return 0.0F;
+    default:                          return std::nullopt;
+  }
+  // clang-format on
+}
+
+/**
+ * Calls `slice(begin, end, thread)` on `threads` contiguous slices of [begin, end), in parallel.
+ */
+template <typename Slice>
+void for_each_slice(std::size_t begin, std::size_t end, unsigned threads, Slice&& slice) {
+  const std::size_t count = end - begin;
+  threads = static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(threads, count)));
+  const auto bounds = [&](unsigned thread) { return begin + (count * thread / threads); };
+
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  const auto worker = [&](unsigned thread) {
+    try {
+      slice(bounds(thread), bounds(thread + 1), thread);
+    } catch (...) {
+      const std::scoped_lock lock(error_mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (unsigned thread = 1; thread < threads; ++thread) {
+    pool.emplace_back(worker, thread);
+  }
+  worker(0);
+  for (std::thread& thread : pool) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+/**
+ * Tapered evaluation of a stored position with real-valued weights.
+ */
+double evaluate(const Tools::TuningSet& set, std::size_t index, const std::vector<double>& weights) {
+  double midgame = 0.0;
+  double endgame = 0.0;
+  for (const Eval::TermCoefficient& coefficient : set.coefficients(index)) {
+    midgame += weights[2 * coefficient.term] * coefficient.coefficient;
+    endgame += weights[(2 * coefficient.term) + 1] * coefficient.coefficient;
+  }
+  const int phase = set.phase(index);
+  return ((midgame * phase) + (endgame * (Eval::MAX_PHASE - phase))) / Eval::MAX_PHASE;
+}
+
+double sigmoid(double evaluation, double k) {
+  return 1.0 / (1.0 + std::pow(10.0, -k * evaluation / SIGMOID_SCALE));  // NOLINT(readability-magic-numbers)
+}
+
+double mean_error(const Tools::TuningSet& set, const std::vector<double>& weights, double k, unsigned threads) {
+  std::vector<double> sums(threads, 0.0);
+  for_each_slice(0, set.size(), threads, [&](std::size_t begin, std::size_t end, unsigned thread) {
+    double sum = 0.0;
+    for (std::size_t index = begin; index < end; ++index) {
+      const double difference = set.result(index) - sigmoid(evaluate(set, index, weights), k);
+      sum += difference * difference;
+    }
+    sums[thread] = sum;
+  });
+  double total = 0.0;
+  for (const double sum : sums) {
+    total += sum;
+  }
+  return set.size() > 0 ? total / static_cast<double>(set.size()) : 0.0;
+}
+
+void write_row(std::ostream& out, const Eval::TermWeights& weights, std::size_t first, std::size_t count,
+               int (*value)(Eval::Score)) {
+  for (std::size_t i = 0; i < count; ++i) {
+    out << (i == 0 ? "" : ", ") << value(weights[first + i]);
+  }
+}
+
+void write_table(std::ostream& out, const std::string& name, const Eval::TermWeights& weights, std::size_t first,
+                 int (*value)(Eval::Score)) {
+  out << "CX_INLINE PieceSquareTable " << name << " = {\n    // clang-format off\n";
+  for (std::size_t rank = 0; rank < Const::BOARD_WIDTH; ++rank) {
+    out << "   ";
+    for (std::size_t file = 0; file < Const::BOARD_WIDTH; ++file) {
+      const std::size_t index = (rank * Const::BOARD_WIDTH) + file;
+      out << std::setw(4) << value(weights[first + index]) << (index + 1 < Const::BOARD_SIZE ? "," : "");
+    }
+    out << "\n";
+  }
+  out << "    // clang-format on\n};\n\n";
+}
+
+std::string score_text(Eval::Score score) {
+  return "make_score(" + std::to_string(Eval::mg_value(score)) + ", " + std::to_string(Eval::eg_value(score)) + ")";
+}
+
+}  // namespace
+
+bool Tools::TuningSet::add(const TrainingPosition& position) {
+  const Board& board = position.board;
+  const std::optional<float> result = result_value(position.result);
+  if (!result || !board.king_square(Color::WHITE) || !board.king_square(Color::BLACK) || in_check(board) ||
+      Eval::find_endgame(board.get_material_key()) != nullptr) {
+    ++m_skipped;
+    return false;
+  }
+
+  Eval::extract_terms(board, m_coefficients);
+  m_offsets.push_back(static_cast<std::uint32_t>(m_coefficients.size()));
+  m_phases.push_back(static_cast<std::uint8_t>(std::min(board.get_phase(), Eval::MAX_PHASE)));
+  m_results.push_back(*result);
+  return true;
+}
+
+void Tools::TuningSet::load(const std::string& path) {
+  if (path.ends_with(".bin")) {
+    PackedReader reader;
+    if (!reader.open(path)) {
+      throw std::runtime_error("cannot read " + path);
+    }
+    for (std::size_t index = 0; index < reader.size(); ++index) {
+      if (const std::optional<TrainingPosition> position = reader.position(index)) {
+        add(*position);
+      } else {
+        ++m_skipped;
+      }
+    }
+    return;
+  }
+
+  std::ifstream in(path);
+  if (!in) {
+    throw std::runtime_error("cannot read " + path);
+  }
+  TrainingPosition position;
+  for (std::string line; std::getline(in, line);) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos) {
+      continue;
+    }
+    if (parse_training_line(line, position)) {
+      add(position);
+    } else {
+      ++m_skipped;
+    }
+  }
+}
+
+std::size_t Tools::TuningSet::memory_bytes() const noexcept {
+  return (m_coefficients.size() * sizeof(Eval::TermCoefficient)) + (m_offsets.size() * sizeof(std::uint32_t)) +
+         (m_phases.size() * sizeof(std::uint8_t)) + (m_results.size() * sizeof(float));
+}
+
+Tools::Tuner::Tuner(const TuningSet& set, TunerOptions options)
+    : m_set(set),
+      m_options(options),
+      m_weights(2 * TERM_COUNT),
+      m_mean(2 * TERM_COUNT, 0.0),
+      m_variance(2 * TERM_COUNT, 0.0) {
+  if (m_options.threads == 0) {
+    m_options.threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  m_options.batch_size = std::max<std::size_t>(1, m_options.batch_size);
+
+  const Eval::TermWeights current = Eval::current_term_weights();
+  for (std::size_t term = 0; term < TERM_COUNT; ++term) {
+    m_weights[2 * term] = Eval::mg_value(current[term]);
+    m_weights[(2 * term) + 1] = Eval::eg_value(current[term]);
+  }
+  if (m_options.k == 0.0) {
+    m_options.k = fit_k();
+  }
+}
+
+double Tools::Tuner::fit_k() const {
+  const double ratio = (std::sqrt(5.0) - 1.0) / 2.0;  // NOLINT(readability-magic-numbers)
+  double low = K_SEARCH_MIN;
+  double high = K_SEARCH_MAX;
+  double left = high - (ratio * (high - low));
+  double right = low + (ratio * (high - low));
+  double left_error = mean_error(m_set, m_weights, left, m_options.threads);
+  double right_error = mean_error(m_set, m_weights, right, m_options.threads);
+  for (int step = 0; step < K_SEARCH_STEPS; ++step) {
+    if (left_error < right_error) {
+      high = right;
+      right = left;
+      right_error = left_error;
+      left = high - (ratio * (high - low));
+      left_error = mean_error(m_set, m_weights, left, m_options.threads);
+    } else {
+      low = left;
+      left = right;
+      left_error = right_error;
+      right = low + (ratio * (high - low));
+      right_error = mean_error(m_set, m_weights, right, m_options.threads);
+    }
+  }
+  return (low + high) / 2.0;
+}
+
+double Tools::Tuner::error() const { return mean_error(m_set, m_weights, m_options.k, m_options.threads); }
+
+void Tools::Tuner::epoch() {
+  const double k = m_options.k;
+  // Derivative of the sigmoid with respect to the evaluation is sigmoid * (1 - sigmoid) * this factor
+  const double sigmoid_factor = k * std::numbers::ln10 / SIGMOID_SCALE;
+  std::vector<std::vector<double>> gradients(m_options.threads, std::vector<double>(2 * TERM_COUNT));
+
+  for (std::size_t batch = 0; batch < m_set.size(); batch += m_options.batch_size) {
+    const std::size_t batch_end = std::min(m_set.size(), batch + m_options.batch_size);
+
+    for_each_slice(batch, batch_end, m_options.threads, [&](std::size_t begin, std::size_t end, unsigned thread) {
+      std::vector<double>& gradient = gradients[thread];
+      std::fill(gradient.begin(), gradient.end(), 0.0);
+      for (std::size_t index = begin; index < end; ++index) {
+        const double predicted = sigmoid(evaluate(m_set, index, m_weights), k);
+        const double slope =
+            -2.0 * (m_set.result(index) - predicted) * predicted * (1.0 - predicted) * sigmoid_factor;
+        const int phase = m_set.phase(index);
+        const double midgame_slope = slope * phase / Eval::MAX_PHASE;
+        const double endgame_slope = slope * (Eval::MAX_PHASE - phase) / Eval::MAX_PHASE;
+        for (const Eval::TermCoefficient& coefficient : m_set.coefficients(index)) {
+          gradient[2 * coefficient.term] += midgame_slope * coefficient.coefficient;
+          gradient[(2 * coefficient.term) + 1] += endgame_slope * coefficient.coefficient;
+        }
+      }
+    });
+
+    const unsigned used_threads =
+        static_cast<unsigned>(std::min<std::size_t>(m_options.threads, batch_end - batch));
+    ++m_steps;
+    const double mean_correction = 1.0 - std::pow(m_options.beta1, static_cast<double>(m_steps));
+    const double variance_correction = 1.0 - std::pow(m_options.beta2, static_cast<double>(m_steps));
+    const double size = static_cast<double>(batch_end - batch);
+    for (std::size_t weight = 0; weight < m_weights.size(); ++weight) {
+      double gradient = 0.0;
+      for (unsigned thread = 0; thread < used_threads; ++thread) {
+        gradient += gradients[thread][weight];
+      }
+      gradient /= size;
+      m_mean[weight] = (m_options.beta1 * m_mean[weight]) + ((1.0 - m_options.beta1) * gradient);
+      m_variance[weight] = (m_options.beta2 * m_variance[weight]) + ((1.0 - m_options.beta2) * gradient * gradient);
+      m_weights[weight] -= m_options.learning_rate * (m_mean[weight] / mean_correction) /
+                           (std::sqrt(m_variance[weight] / variance_correction) + ADAM_EPSILON);
+    }
+  }
+}
+
+Eval::TermWeights Tools::Tuner::weights() const {
+  const auto to_int = [](double weight) {
+    CX_CONST double LIMIT = std::numeric_limits<std::int16_t>::max();
+    return static_cast<int>(std::lround(std::clamp(weight, -LIMIT, LIMIT)));
+  };
+  Eval::TermWeights weights{};
+  for (std::size_t term = 0; term < TERM_COUNT; ++term) {
+    weights[term] = Eval::make_score(to_int(m_weights[2 * term]), to_int(m_weights[(2 * term) + 1]));
+  }
+  return weights;
+}
+
+void Tools::write_tuned_header(std::ostream& out, const Eval::TermWeights& weights, const std::string& comment) {
+  using namespace Eval;
+
+  static CX_CONST std::array<const char*, Piece::TYPE_COUNT> MIDGAME_NAMES = {
+      "PAWN_PSQT_WHITE", "KNIGHT_PSQT_WHITE", "BISHOP_PSQT_WHITE",
+      "ROOK_PSQT_WHITE", "QUEEN_PSQT_WHITE",  "KING_MIDGAME_PSQT_WHITE"};
+  static CX_CONST std::array<const char*, Piece::TYPE_COUNT> ENDGAME_NAMES = {
+      "PAWN_ENDGAME_PSQT_WHITE", "KNIGHT_ENDGAME_PSQT_WHITE", "BISHOP_ENDGAME_PSQT_WHITE",
+      "ROOK_ENDGAME_PSQT_WHITE", "QUEEN_ENDGAME_PSQT_WHITE",  "KING_ENDGAME_PSQT_WHITE"};
+
+  out << "#pragma once\n\n"
+      << "// " << comment << "\n\n"
+      << "#include <array>\n#include <bitbishop/config.hpp>\n#include <bitbishop/psqt.hpp>\n\n"
+      << "namespace Eval::Tuned {\n\n";
+
+  out << "CX_INLINE std::array<int, Piece::KING> MIDGAME_MATERIAL = {";
+  write_row(out, weights, MATERIAL_TERMS, Piece::KING, mg_value);
+  out << "};\n\nCX_INLINE std::array<int, Piece::KING> ENDGAME_MATERIAL = {";
+  write_row(out, weights, MATERIAL_TERMS, Piece::KING, eg_value);
+  out << "};\n\n";
+
+  for (std::size_t type = 0; type < Piece::TYPE_COUNT; ++type) {
+    write_table(out, MIDGAME_NAMES[type], weights, PSQT_TERMS + (type * Const::BOARD_SIZE), mg_value);
+  }
+  for (std::size_t type = 0; type < Piece::TYPE_COUNT; ++type) {
+    write_table(out, ENDGAME_NAMES[type], weights, PSQT_TERMS + (type * Const::BOARD_SIZE), eg_value);
+  }
+
+  out << "CX_INLINE Score DOUBLED_PAWN_PENALTY = " << score_text(weights[DOUBLED_PAWN_TERM]) << ";\n"
+      << "CX_INLINE Score ISOLATED_PAWN_PENALTY = " << score_text(weights[ISOLATED_PAWN_TERM]) << ";\n"
+      << "CX_INLINE Score BACKWARD_PAWN_PENALTY = " << score_text(weights[BACKWARD_PAWN_TERM]) << ";\n\n"
+      << "CX_INLINE std::array<Score, Const::BOARD_WIDTH> PASSED_PAWN_BONUS = {\n";
+  for (std::size_t rank = 0; rank < Const::BOARD_WIDTH; ++rank) {
+    out << "    " << score_text(weights[PASSED_PAWN_TERMS + rank]) << ",\n";
+  }
+  out << "};\n\n}  // namespace Eval::Tuned\n";
+}
@@ -1,4 +1,5 @@
 #include <bitbishop/board.hpp>
+#include <bitbishop/lookups/pawn_attacks.hpp>
 #include <bitbishop/zobrist.hpp>
 
 void Zobrist::mutate_piece(Square square, Piece piece, Zobrist::Key& key) {
@@ -64,11 +65,12 @@ Zobrist::Key Zobrist::compute_hash(const Board& board) {
 
   Key key = NULL_HASH;
 
-  for (int sq = 0; sq < Const::BOARD_SIZE; ++sq) {
-    Square square(sq);
-    std::optional<Piece> piece = board.get_piece(square);
-    if (piece) {
-      mutate_piece(square, *piece, key);
+  for (const Color color : {Color::WHITE, Color::BLACK}) {
+    for (int type = Piece::PAWN; type <= Piece::KING; ++type) {
+      const Piece piece(static_cast<Piece::Type>(type), color);
+      for (const Square square : board.pieces(piece)) {
+        mutate_piece(square, piece, key);
+      }
     }
   }
 
@@ -85,3 +87,58 @@ Zobrist::Key Zobrist::compute_hash(const Board& board) {
 
   return key;
 }
+
+Zobrist::Key Zobrist::compute_pawn_hash(const Board& board) {
+  using namespace Zobrist;
+
+  Key key = NULL_HASH;
+
+  for (const Color color : {Color::WHITE, Color::BLACK}) {
+    const Piece pawn(Piece::PAWN, color);
+    for (const Square square : board.pawns(color)) {
+      mutate_piece(square, pawn, key);
+    }
+  }
+
+  return key;
+}
+
+Zobrist::Key Zobrist::compute_polyglot_key(const Board& board) {
+  using namespace Zobrist;
+
+  const auto& random64 = polyglot_tables.random64;
+  Key key = NULL_HASH;
+
+  for (int sq = 0; sq < Const::BOARD_SIZE; ++sq) {
+    const Square square(sq);
+    const std::optional<Piece> piece = board.get_piece(square);
+    if (piece) {
+      const auto kind = (2 * static_cast<std::size_t>(piece->type())) + (piece->color() == Color::WHITE ? 1 : 0);
+      key ^= random64[PolyglotTables::PIECES_OFFSET + (kind * Const::BOARD_SIZE) + square.flat_index()];
+    }
+  }
+
+  const BoardState& state = board.get_state();
+  const std::array<bool, 4> castling = {state.m_white_castle_kingside, state.m_white_castle_queenside,
+                                        state.m_black_castle_kingside, state.m_black_castle_queenside};
+  for (std::size_t right = 0; right < castling.size(); ++right) {
+    if (castling[right]) {
+      key ^= random64[PolyglotTables::CASTLING_OFFSET + right];
+    }
+  }
+
+  // Unlike the engine key, the en passant file only counts when a pawn can actually capture
+  const Color us = board.get_side_to_move();
+  const auto epsq = board.en_passant_square();
+  if (epsq && (Lookups::PAWN_ATTACKS[ColorUtil::to_index(ColorUtil::opposite(us))][epsq->flat_index()] &
+               board.pawns(us))
+                  .any()) {
+    key ^= random64[PolyglotTables::EN_PASSANT_OFFSET + epsq->file()];
+  }
+
+  if (us == Color::WHITE) {
+    key ^= random64[PolyglotTables::TURN_OFFSET];
+  }
+
+  return key;
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/board.hpp>
+#include <bitbishop/material.hpp>
+#include <bitbishop/movegen/legal_moves.hpp>
+#include <bitbishop/moves/position.hpp>
+#include <bitbishop/random.hpp>
+#include <vector>
+
+using namespace Squares;
+using namespace Pieces;
+
+namespace {
+
+Material::Key count_material(const Board& board) {
+  Material::Key key = 0;
+  for (const Color color : {Color::WHITE, Color::BLACK}) {
+    for (const Piece::Type type : Piece::ALL_TYPES) {
+      const Piece piece(type, color);
+      key += static_cast<Material::Key>(board.pieces(piece).count()) * Material::unit(piece);
+    }
+  }
+  return key;
+}
+
+}  // namespace
+
+TEST(BoardMaterialKeyTest, MatchesPieceCounts) {
+  EXPECT_EQ(Board::Empty().get_material_key(), 0);
+  EXPECT_EQ(Board::StartingPosition().get_material_key(), Material::from_code("KQRRBBNNPPPPPPPPvKQRRBBNNPPPPPPPP"));
+  EXPECT_EQ(Board("8/8/8/4k3/8/8/8/R3K3 w Q - 0 1").get_material_key(), Material::from_code("KRvK"));
+}
+
+TEST(BoardMaterialKeyTest, SetAndRemovePieceUpdateKey) {
+  Board board("8/8/8/4k3/8/8/8/R3K3 w Q - 0 1");
+
+  board.set_piece(A1, WHITE_QUEEN);  // replaces the rook
+  EXPECT_EQ(board.get_material_key(), Material::from_code("KQvK"));
+
+  board.remove_piece(A1);
+  EXPECT_EQ(board.get_material_key(), Material::from_code("KvK"));
+}
+
+TEST(BoardMaterialKeyTest, StaysInSyncThroughMovesAndUndo) {
+  Board board("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+  const Material::Key start_key = board.get_material_key();
+  Position position(board);
+  std::uint64_t seed = 17;
+
+  for (int ply = 0; ply < 60; ++ply) {
+    std::vector<Move> moves;
+    generate_legal_moves(moves, board);
+    if (moves.empty()) {
+      break;
+    }
+    position.apply_move(moves[Random::splitmix64(seed) % moves.size()]);
+    ASSERT_EQ(board.get_material_key(), count_material(board)) << board.get_fen();
+  }
+
+  while (position.can_unmake()) {
+    position.revert_move();
+  }
+  EXPECT_EQ(board.get_material_key(), start_key);
+}
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/board.hpp>
+#include <bitbishop/engine/evaluation.hpp>
+#include <bitbishop/simd.hpp>
+#include <string>
+#include <vector>
+
+using namespace Eval;
+
+namespace {
+
+const std::vector<std::string> FENS = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "4k3/8/8/8/8/8/8/4K3 w - - 0 1",
+    "8/8/8/8/8/8/8/8 w - - 0 1",
+};
+
+}  // namespace
+
+TEST(ComputePsqtScoreTest, ScalarMatchesIncrementalScore) {
+  for (const std::string& fen : FENS) {
+    const Board board(fen);
+    EXPECT_EQ(compute_psqt_score(board, Simd::Level::Scalar), board.get_psqt_score()) << fen;
+  }
+}
+
+TEST(ComputePsqtScoreTest, VectorisedMatchesScalar) {
+  if (Simd::detect_level() < Simd::Level::Avx2) {
+    GTEST_SKIP() << "AVX2 not supported";
+  }
+  for (const std::string& fen : FENS) {
+    const Board board(fen);
+    EXPECT_EQ(compute_psqt_score(board, Simd::Level::Avx2), compute_psqt_score(board, Simd::Level::Scalar))
+        << fen;
+  }
+}
+
+TEST(ComputePsqtScoreTest, EvaluateFromScratchMatchesEvaluate) {
+  for (const std::string& fen : FENS) {
+    const Board board(fen);
+    EXPECT_EQ(evaluate_from_scratch(board), evaluate(board)) << fen;
+  }
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/board.hpp>
+#include <bitbishop/engine/endgame.hpp>
+#include <bitbishop/engine/evaluation.hpp>
+#include <bitbishop/material.hpp>
+#include <string>
+
+using namespace Eval;
+
+TEST(EndgameTest, FindsRegisteredEndgamesForBothColors) {
+  const Endgame* white_rook = find_endgame(Material::from_code("KRvK"));
+  const Endgame* black_rook = find_endgame(Material::from_code("KvKR"));
+
+  ASSERT_NE(white_rook, nullptr);
+  ASSERT_NE(black_rook, nullptr);
+  EXPECT_EQ(white_rook->strong, Color::WHITE);
+  EXPECT_EQ(black_rook->strong, Color::BLACK);
+  EXPECT_EQ(white_rook->value, black_rook->value);
+}
+
+TEST(EndgameTest, UnknownMaterialHasNoEntry) {
+  EXPECT_EQ(find_endgame(Board::StartingPosition().get_material_key()), nullptr);
+  EXPECT_EQ(find_endgame(Material::from_code("KRvKR")), nullptr);
+  EXPECT_EQ(find_endgame(0), nullptr);
+}
+
+TEST(EndgameTest, KrkIsAWinThatPushesTheKingToTheEdge) {
+  const Board centered("8/8/8/4k3/8/8/8/R3K3 w - - 0 1");
+  const Board on_edge("4k3/8/8/8/4K3/8/8/R7 w - - 0 1");  // same distance between kings
+
+  EXPECT_GT(evaluate(centered), KNOWN_WIN);
+  EXPECT_GT(evaluate(on_edge), evaluate(centered));
+
+  // Colors mirrored
+  const Board black_wins("r3k3/8/8/8/4K3/8/8/8 b - - 0 1");
+  EXPECT_EQ(evaluate(black_wins), -evaluate(centered));
+}
+
+TEST(EndgameTest, KbnkPrefersTheBishopCorner) {
+  // The c1 bishop covers h8 and a1, not a8 and h1
+  const Board right_corner("7k/8/5K2/8/8/8/8/2B1N3 w - - 0 1");
+  const Board wrong_corner("k7/8/2K5/8/8/8/8/2B1N3 w - - 0 1");
+
+  EXPECT_GT(evaluate(right_corner), KNOWN_WIN);
+  EXPECT_GT(evaluate(right_corner), evaluate(wrong_corner));
+}
+
+TEST(EndgameTest, KqkrFavoursTheQueen) {
+  const Board board("4k3/8/8/3r4/8/8/3Q4/4K3 w - - 0 1");
+  EXPECT_GT(evaluate(board), 0);
+  EXPECT_LT(evaluate(board), KNOWN_WIN);
+}
+
+TEST(EndgameTest, KpkRecognisesWinsAndDraws) {
+  // The defending king is outside the square of the pawn
+  EXPECT_GT(evaluate(Board("k7/8/8/8/6P1/8/8/4K3 b - - 0 1")), KNOWN_WIN);
+
+  // The attacking king holds a key square
+  EXPECT_GT(evaluate(Board("8/8/2k1K3/8/3P4/8/8/8 w - - 0 1")), KNOWN_WIN);
+
+  // Rook pawn with the defending king in the corner
+  EXPECT_EQ(evaluate(Board("k7/8/8/P7/8/8/8/4K3 w - - 0 1")), 0);
+
+  // The pawn falls
+  EXPECT_EQ(evaluate(Board("8/8/8/8/3k4/3P4/8/7K b - - 0 1")), 0);
+
+  // The opposition decides, which the side to move changes
+  EXPECT_EQ(evaluate(Board("8/4k3/8/4K3/4P3/8/8/8 w - - 0 1")), 0);
+  EXPECT_GT(evaluate(Board("8/4k3/8/4K3/4P3/8/8/8 b - - 0 1")), KNOWN_WIN);
+  EXPECT_LT(evaluate(Board("8/8/8/8/4p3/4k3/8/4K3 w - - 0 1")), -KNOWN_WIN);
+}
+
+TEST(EndgameTest, OnlyKpkIsExact) {
+  EXPECT_TRUE(find_endgame(Material::from_code("KPvK"))->exact);
+  EXPECT_TRUE(find_endgame(Material::from_code("KvKP"))->exact);
+  EXPECT_FALSE(find_endgame(Material::from_code("KRvK"))->exact);
+}
+
+TEST(EndgameTest, KnnkIsADraw) { EXPECT_EQ(evaluate(Board("4k3/8/8/8/8/8/8/2N1KN2 w - - 0 1")), 0); }
+
+TEST(EndgameTest, WrongRookPawnScalesToADraw) {
+  // The b1 bishop does not cover h8: the defending king holds the corner
+  EXPECT_EQ(evaluate(Board("7k/8/8/7P/8/8/8/1B2K3 w - - 0 1")), 0);
+
+  // Knight pawn: the generic evaluation stands
+  const Board knight_pawn("7k/8/8/6P1/8/8/8/2B1K3 w - - 0 1");
+  EXPECT_GT(evaluate(knight_pawn), 0);
+}
+
+TEST(EndgameTest, EvaluateMatchesFromScratch) {
+  for (const std::string fen : {"8/8/8/4k3/8/8/8/R3K3 w - - 0 1", "7k/8/5K2/8/8/8/8/2B1N3 w - - 0 1",
+                                "7k/8/8/7P/8/8/8/1B2K3 w - - 0 1", "k7/8/8/P7/8/8/8/4K3 w - - 0 1"}) {
+    const Board board(fen);
+    EXPECT_EQ(evaluate(board), evaluate_from_scratch(board)) << fen;
+  }
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/board.hpp>
+#include <bitbishop/engine/eval_cache.hpp>
+#include <bitbishop/engine/evaluation.hpp>
+#include <thread>
+#include <tuple>
+
+using namespace Eval;
+using namespace Squares;
+
+TEST(TestEvalCache, ProbeReturnsStaticEvaluation) {
+  EvalCache cache(64);
+  const Board board("r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3");
+
+  EXPECT_EQ(cache.probe(board), evaluate(board));
+  EXPECT_EQ(cache.probes(), 1);
+  EXPECT_EQ(cache.hits(), 0);
+
+  EXPECT_EQ(cache.probe(board), evaluate(board));
+  EXPECT_EQ(cache.probes(), 2);
+  EXPECT_EQ(cache.hits(), 1);
+}
+
+TEST(TestEvalCache, DifferentPositionsDoNotHit) {
+  EvalCache cache(64);
+  Board board = Board::StartingPosition();
+
+  std::ignore = cache.probe(board);
+  board.move_piece(E2, E4);
+  EXPECT_EQ(cache.probe(board), evaluate(board));
+  EXPECT_EQ(cache.hits(), 0);
+}
+
+TEST(TestEvalCache, ClearResetsEntriesAndStatistics) {
+  EvalCache cache(64);
+  const Board board = Board::StartingPosition();
+
+  std::ignore = cache.probe(board);
+  cache.clear();
+  EXPECT_EQ(cache.probes(), 0);
+
+  std::ignore = cache.probe(board);
+  EXPECT_EQ(cache.hits(), 0);
+}
+
+TEST(TestEvalCache, RepeatedClearsNeverResurrectEntries) {
+  EvalCache cache(64);
+  const Board board = Board::StartingPosition();
+
+  for (int i = 0; i < 3; ++i) {
+    std::ignore = cache.probe(board);
+    cache.clear();
+    std::ignore = cache.probe(board);
+    EXPECT_EQ(cache.hits(), 0);
+  }
+}
+
+TEST(TestEvalCache, ThreadCacheIsPerThread) {
+  EvalCache* main_cache = &thread_eval_cache();
+  EvalCache* other_cache = nullptr;
+  std::thread([&other_cache]() { other_cache = &thread_eval_cache(); }).join();
+
+  EXPECT_EQ(main_cache, &thread_eval_cache());
+  EXPECT_NE(main_cache, other_cache);
+}
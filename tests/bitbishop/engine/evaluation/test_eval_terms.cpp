@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/board.hpp>
+#include <bitbishop/engine/endgame.hpp>
+#include <bitbishop/engine/eval_terms.hpp>
+#include <bitbishop/engine/evaluation.hpp>
+#include <bitbishop/engine/pawn_structure.hpp>
+#include <string>
+#include <vector>
+
+using namespace Eval;
+
+namespace {
+
+Score score_board(const Board& board) {
+  std::vector<TermCoefficient> coefficients;
+  extract_terms(board, coefficients);
+  return score_terms(current_term_weights(), coefficients);
+}
+
+}  // namespace
+
+TEST(TestEvalTerms, CurrentWeightsReadTheTables) {
+  const TermWeights weights = current_term_weights();
+  EXPECT_EQ(weights[MATERIAL_TERMS + Piece::ROOK], make_score(ROOK, ROOK_ENDGAME));
+  EXPECT_EQ(weights[PSQT_TERMS + (Piece::KNIGHT * Const::BOARD_SIZE) + 36],
+            make_score(KNIGHT_PSQT_WHITE[36], KNIGHT_ENDGAME_PSQT_WHITE[36]));
+  EXPECT_EQ(weights[BACKWARD_PAWN_TERM], BACKWARD_PAWN_PENALTY);
+  EXPECT_EQ(weights[PASSED_PAWN_TERMS + 6], PASSED_PAWN_BONUS[6]);
+}
+
+TEST(TestEvalTerms, MirroredPiecesCancelOut) {
+  std::vector<TermCoefficient> coefficients;
+  extract_terms(Board::StartingPosition(), coefficients);
+  EXPECT_TRUE(coefficients.empty());
+}
+
+TEST(TestEvalTerms, CoefficientsAreSortedWhiteMinusBlack) {
+  // White: extra queen on d1, doubled c pawns. Black: passed h pawn on its 6th rank.
+  std::vector<TermCoefficient> coefficients;
+  extract_terms(Board("4k3/8/8/8/8/2P4p/2P5/3QK3 w - - 0 1"), coefficients);
+
+  for (std::size_t i = 1; i < coefficients.size(); ++i) {
+    EXPECT_LT(coefficients[i - 1].term, coefficients[i].term);
+  }
+  const auto coefficient_of = [&coefficients](std::size_t term) {
+    for (const TermCoefficient& coefficient : coefficients) {
+      if (coefficient.term == term) {
+        return static_cast<int>(coefficient.coefficient);
+      }
+    }
+    return 0;
+  };
+  EXPECT_EQ(coefficient_of(MATERIAL_TERMS + Piece::PAWN), 1);
+  EXPECT_EQ(coefficient_of(MATERIAL_TERMS + Piece::QUEEN), 1);
+  EXPECT_EQ(coefficient_of(DOUBLED_PAWN_TERM), 1);
+  EXPECT_EQ(coefficient_of(PASSED_PAWN_TERMS + 5), -1);
+}
+
+/**
+ * @test The weighted terms give back the hand-crafted evaluation of positions without endgame knowledge.
+ */
+TEST(TestEvalTerms, ScoreMatchesHandCraftedEvaluation) {
+  const std::vector<std::string> fens = {
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+      "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+      "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+      "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+      "4k3/1p1p4/8/8/8/2P5/1PP5/4K3 w - - 0 1",
+      "6k1/5ppp/8/8/8/8/1q3PPP/3R2K1 b - - 0 1",
+  };
+  for (const std::string& fen : fens) {
+    const Board board(fen);
+    ASSERT_EQ(find_endgame(board.get_material_key()), nullptr) << fen;
+
+    const Score score = score_board(board);
+    EXPECT_EQ(score, board.get_psqt_score() + evaluate_pawn_structure(board).score) << fen;
+    EXPECT_EQ(taper(score, board.get_phase()), evaluate_from_scratch(board)) << fen;
+  }
+}
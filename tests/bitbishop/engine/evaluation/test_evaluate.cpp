@@ -2,6 +2,10 @@
 
 #include <bitbishop/board.hpp>
 #include <bitbishop/engine/evaluation.hpp>
+#include <bitbishop/engine/pawn_structure.hpp>
+#include <bitbishop/movegen/legal_moves.hpp>
+#include <bitbishop/moves/position.hpp>
+#include <vector>
 
 using namespace Eval;
 using namespace Squares;
@@ -38,3 +42,98 @@ TEST(TestScoreEvaluation, EmptyBoardEvaluatesToZero) {
   EXPECT_EQ(white_score, 0);
   EXPECT_EQ(black_score, 0);
 }
+
+namespace {
+
+/**
+ * Rebuilding the board from its FEN recomputes the score and phase from the pieces only.
+ */
+void expect_incremental_terms_match(const Board& board) {
+  const Board rebuilt(board.get_fen());
+  EXPECT_EQ(board.get_psqt_score(), rebuilt.get_psqt_score()) << board.get_fen();
+  EXPECT_EQ(board.get_phase(), rebuilt.get_phase()) << board.get_fen();
+  EXPECT_EQ(board.get_pawn_hash(), rebuilt.get_pawn_hash()) << board.get_fen();
+}
+
+void expect_incremental_score_matches(Position& position, int depth) {
+  const Board& board = position.get_board();
+  expect_incremental_terms_match(board);
+  if (depth == 0) {
+    return;
+  }
+
+  std::vector<Move> moves;
+  generate_legal_moves(moves, board);
+  for (const Move& move : moves) {
+    position.apply_move(move);
+    expect_incremental_score_matches(position, depth - 1);
+    position.revert_move();
+  }
+}
+
+}  // namespace
+
+TEST(TestScoreEvaluation, IncrementalScoreMatchesFromScratchThroughMakeUnmake) {
+  // Kiwipete: castling, captures, promotions and en passant within two plies
+  Board board("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+  Position position(board);
+  const int initial_score = evaluate(board);
+
+  expect_incremental_score_matches(position, 2);
+
+  EXPECT_EQ(evaluate(board), initial_score);
+}
+
+TEST(TestScoreEvaluation, IncrementalScoreFollowsSetAndRemovePiece) {
+  Board board = Board::Empty();
+
+  board.set_piece(E4, WHITE_KNIGHT);
+  expect_incremental_terms_match(board);
+  EXPECT_EQ(board.get_phase(), PHASE_WEIGHTS[Piece::KNIGHT]);
+
+  board.set_piece(E4, BLACK_QUEEN);
+  expect_incremental_terms_match(board);
+  EXPECT_EQ(board.get_phase(), PHASE_WEIGHTS[Piece::QUEEN]);
+
+  board.move_piece(E4, D5);
+  expect_incremental_terms_match(board);
+
+  board.remove_piece(D5);
+  EXPECT_EQ(board.get_psqt_score(), 0);
+  EXPECT_EQ(board.get_phase(), 0);
+  EXPECT_EQ(evaluate(board), 0);
+}
+
+TEST(TestScoreEvaluation, FullPhaseUsesMidgameScore) {
+  // Starting position without the e2 pawn: every piece is still there
+  Board board("rnbqkbnr/pppppppp/8/8/8/8/PPPP1PPP/RNBQKBNR w KQkq - 0 1");
+  ASSERT_EQ(board.get_phase(), MAX_PHASE);
+
+  const int midgame = evaluate_material(board, Color::WHITE) + evaluate_psqt(board, Color::WHITE) -
+                      evaluate_material(board, Color::BLACK) - evaluate_psqt(board, Color::BLACK);
+  const int pawn_structure = mg_value(evaluate_pawn_structure(board).score);
+  EXPECT_EQ(evaluate(board), midgame + pawn_structure);
+}
+
+TEST(TestScoreEvaluation, NullPhaseUsesEndgameScore) {
+  // Two pawns, a lone pawn would be scored by the KPK endgame evaluation
+  Board board("4k3/8/8/8/8/8/P3P3/4K3 w - - 0 1");
+  ASSERT_EQ(board.get_phase(), 0);
+
+  // a2 and e2 pawns: isolated and passed
+  const int expected = (2 * PAWN_ENDGAME) + PAWN_ENDGAME_PSQT_WHITE[48] + PAWN_ENDGAME_PSQT_WHITE[52] +
+                       KING_ENDGAME_PSQT_WHITE[60] - KING_ENDGAME_PSQT_BLACK[4] +
+                       (2 * (eg_value(ISOLATED_PAWN_PENALTY) + eg_value(PASSED_PAWN_BONUS[1])));
+  EXPECT_EQ(evaluate(board), expected);
+}
+
+TEST(TestScoreEvaluation, IntermediatePhaseInterpolatesScores) {
+  Board board("3qk3/8/8/8/8/8/4P3/4K3 w - - 0 1");
+  ASSERT_EQ(board.get_phase(), PHASE_WEIGHTS[Piece::QUEEN]);
+
+  const Score score = board.get_psqt_score() + evaluate_pawn_structure(board).score;
+  const int phase = board.get_phase();
+  const int expected = ((mg_value(score) * phase) + (eg_value(score) * (MAX_PHASE - phase))) / MAX_PHASE;
+  EXPECT_EQ(evaluate(board), expected);
+  EXPECT_LT(evaluate(board), 0);
+}
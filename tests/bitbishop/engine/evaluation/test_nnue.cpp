@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/board.hpp>
+#include <bitbishop/engine/evaluation.hpp>
+#include <bitbishop/engine/nnue.hpp>
+#include <bitbishop/movegen/legal_moves.hpp>
+#include <bitbishop/moves/position.hpp>
+#include <bitbishop/random.hpp>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace Nnue;
+
+namespace {
+
+template <typename T>
+void write_value(std::ofstream& out, T value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/**
+ * Writes a network with small pseudo-random weights, returning its path.
+ */
+std::string write_network(const std::string& name, std::uint64_t seed, std::size_t truncate = 0) {
+  const std::string path = (std::filesystem::temp_directory_path() / name).string();
+  std::ofstream out(path, std::ios::binary);
+
+  const auto next = [&seed](int range) {
+    return static_cast<int>(Random::splitmix64(seed) % static_cast<std::uint64_t>((2 * range) + 1)) - range;
+  };
+
+  out.write(FILE_MAGIC.data(), FILE_MAGIC.size());
+  write_value<std::uint32_t>(out, FILE_VERSION);
+  write_value<std::uint32_t>(out, FEATURES);
+  write_value<std::uint32_t>(out, L1_SIZE);
+  for (std::size_t i = 0; i < L1_SIZE; ++i) {
+    write_value(out, static_cast<std::int16_t>(next(20)));
+  }
+  for (std::size_t i = 0; i < FEATURES * L1_SIZE; ++i) {
+    write_value(out, static_cast<std::int16_t>(next(8)));
+  }
+  for (std::size_t i = 0; i < 2 * L1_SIZE; ++i) {
+    write_value(out, static_cast<std::int8_t>(next(64)));
+  }
+  write_value<std::int32_t>(out, 100);
+  out.close();
+
+  if (truncate > 0) {
+    std::filesystem::resize_file(path, FILE_SIZE - truncate);
+  }
+  return path;
+}
+
+class NnueTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() { network_path = write_network("bitbishop_test_network.nnue", 42); }
+
+  static void TearDownTestSuite() {
+    unload_network();
+    std::filesystem::remove(network_path);
+  }
+
+  void SetUp() override { ASSERT_TRUE(load_network(network_path)); }
+
+  void TearDown() override { unload_network(); }
+
+  static inline std::string network_path;
+};
+
+}  // namespace
+
+TEST(NnueFeatureTest, FeatureIndexIsSymmetricBetweenPerspectives) {
+  using namespace Squares;
+  const Piece white_pawn('P');
+  const Piece black_pawn('p');
+
+  EXPECT_EQ(king_bucket(E1, Color::WHITE), king_bucket(E8, Color::BLACK));
+  EXPECT_EQ(feature_index(3, white_pawn, E2, Color::WHITE), feature_index(3, black_pawn, E7, Color::BLACK));
+  EXPECT_NE(feature_index(3, white_pawn, E2, Color::WHITE), feature_index(3, white_pawn, E2, Color::BLACK));
+  EXPECT_LT(feature_index(KING_BUCKETS - 1, Piece('k'), H8, Color::WHITE), FEATURES);
+}
+
+TEST(NnueKernelTest, SimdKernelsMatchScalar) {
+  std::uint64_t seed = 7;
+  std::vector<std::int16_t> values(L1_SIZE);
+  std::vector<std::int8_t> weights(L1_SIZE);
+  for (std::size_t i = 0; i < L1_SIZE; ++i) {
+    values[i] = static_cast<std::int16_t>(static_cast<int>(Random::splitmix64(seed) % 400) - 150);
+    weights[i] = static_cast<std::int8_t>(static_cast<int>(Random::splitmix64(seed) % 256) - 128);
+  }
+
+  const std::int32_t expected = clipped_dot(Simd::Level::Scalar, values.data(), weights.data(), L1_SIZE);
+  const Simd::Level best = Simd::detect_level();
+  for (const Simd::Level level : {Simd::Level::Sse2, Simd::Level::Avx2}) {
+    if (level <= best) {
+      EXPECT_EQ(clipped_dot(level, values.data(), weights.data(), L1_SIZE), expected) << Simd::level_name(level);
+    }
+  }
+}
+
+TEST(NnueKernelTest, SimdColumnUpdatesMatchScalar) {
+  std::uint64_t seed = 11;
+  std::vector<std::int16_t> values(L1_SIZE);
+  std::vector<std::int16_t> column(L1_SIZE);
+  for (std::size_t i = 0; i < L1_SIZE; ++i) {
+    values[i] = static_cast<std::int16_t>(static_cast<int>(Random::splitmix64(seed) % 2000) - 1000);
+    column[i] = static_cast<std::int16_t>(static_cast<int>(Random::splitmix64(seed) % 200) - 100);
+  }
+
+  std::vector<std::int16_t> expected_add = values;
+  std::vector<std::int16_t> expected_sub = values;
+  add_column(Simd::Level::Scalar, expected_add.data(), column.data(), L1_SIZE);
+  sub_column(Simd::Level::Scalar, expected_sub.data(), column.data(), L1_SIZE);
+
+  const Simd::Level best = Simd::detect_level();
+  for (const Simd::Level level : {Simd::Level::Sse2, Simd::Level::Avx2}) {
+    if (level <= best) {
+      std::vector<std::int16_t> added = values;
+      std::vector<std::int16_t> subtracted = values;
+      add_column(level, added.data(), column.data(), L1_SIZE);
+      sub_column(level, subtracted.data(), column.data(), L1_SIZE);
+      EXPECT_EQ(added, expected_add) << Simd::level_name(level);
+      EXPECT_EQ(subtracted, expected_sub) << Simd::level_name(level);
+    }
+  }
+}
+
+TEST(NnueLoadTest, RejectsMissingAndTruncatedFiles) {
+  EXPECT_FALSE(load_network("/nonexistent/network.nnue"));
+
+  const std::string truncated = write_network("bitbishop_truncated_network.nnue", 1, 4);
+  EXPECT_FALSE(load_network(truncated));
+  EXPECT_EQ(network(), nullptr);
+  std::filesystem::remove(truncated);
+}
+
+TEST(NnueLoadTest, RejectsBadMagic) {
+  const std::string path = write_network("bitbishop_bad_magic_network.nnue", 1);
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.write("XXXX", 4);
+  }
+
+  EXPECT_FALSE(load_network(path));
+  EXPECT_EQ(network(), nullptr);
+  std::filesystem::remove(path);
+}
+
+TEST_F(NnueTest, EvaluateUsesLoadedNetwork) {
+  const Board board = Board::StartingPosition();
+  RefreshCache cache;
+
+  ASSERT_NE(network(), nullptr);
+  EXPECT_EQ(Eval::evaluate(board), Nnue::evaluate(board, cache));
+}
+
+TEST_F(NnueTest, RefreshedEvaluationMatchesFromScratch) {
+  Board board("r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3");
+  Position position(board);
+  RefreshCache cache;
+  std::uint64_t seed = 3;
+
+  // Random walk, including king moves and captures that change buckets and remove pieces
+  for (int ply = 0; ply < 80; ++ply) {
+    ASSERT_EQ(Nnue::evaluate(board, cache), evaluate_from_scratch(board)) << "ply " << ply;
+
+    std::vector<Move> moves;
+    generate_legal_moves(moves, board);
+    if (moves.empty()) {
+      break;
+    }
+    position.apply_move(moves[Random::splitmix64(seed) % moves.size()]);
+  }
+
+  while (position.can_unmake()) {
+    position.revert_move();
+    ASSERT_EQ(Nnue::evaluate(board, cache), evaluate_from_scratch(board));
+  }
+}
+
+TEST_F(NnueTest, StackEvaluationMatchesFromScratchAlongSearchPaths) {
+  Board board("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+  Position position(board);
+  AccumulatorStack stack;
+  RefreshCache cache;
+  std::uint64_t seed = 5;
+
+  // Random descents and partial unwinds, evaluating only some plies like a search does
+  for (int walk = 0; walk < 40; ++walk) {
+    const int depth = 1 + static_cast<int>(Random::splitmix64(seed) % 12);
+    for (int ply = 0; ply < depth; ++ply) {
+      std::vector<Move> moves;
+      generate_legal_moves(moves, board);
+      if (moves.empty()) {
+        break;
+      }
+      position.apply_move(moves[Random::splitmix64(seed) % moves.size()]);
+      if (Random::splitmix64(seed) % 3 == 0) {
+        ASSERT_EQ(Nnue::evaluate(position, stack, cache), evaluate_from_scratch(board)) << board.get_fen();
+      }
+    }
+    ASSERT_EQ(Nnue::evaluate(position, stack, cache), evaluate_from_scratch(board)) << board.get_fen();
+
+    const auto unwind = static_cast<int>(Random::splitmix64(seed) % (position.get_move_history().size() + 1));
+    for (int i = 0; i < unwind; ++i) {
+      position.revert_move();
+    }
+  }
+}
+
+TEST_F(NnueTest, NetworkCannotChangeDuringSearch) {
+  const Network* loaded = network();
+  {
+    const SearchGuard guard;
+#ifdef NDEBUG
+    EXPECT_FALSE(load_network(network_path));
+    unload_network();
+#endif
+    EXPECT_EQ(network(), loaded);
+  }
+  EXPECT_TRUE(load_network(network_path));
+}
+
+TEST_F(NnueTest, ScoreIsFromWhitePerspective) {
+  const Board white_to_move("4k3/8/8/8/8/8/4P3/4K3 w - - 0 1");
+  const Board black_to_move("4k3/4p3/8/8/8/8/8/4K3 b - - 0 1");
+
+  // Mirrored positions: the side to move sees the same features
+  RefreshCache cache;
+  EXPECT_EQ(Nnue::evaluate(white_to_move, cache), -Nnue::evaluate(black_to_move, cache));
+}
+
+TEST_F(NnueTest, ReloadInvalidatesCachedAccumulators) {
+  Board board = Board::StartingPosition();
+  const Position position(board);
+  AccumulatorStack stack;
+  RefreshCache cache;
+  const int before = Nnue::evaluate(board, cache);
+  EXPECT_EQ(Nnue::evaluate(position, stack, cache), before);
+
+  const std::string other = write_network("bitbishop_other_network.nnue", 99);
+  ASSERT_TRUE(load_network(other));
+  EXPECT_EQ(Nnue::evaluate(board, cache), evaluate_from_scratch(board));
+  EXPECT_EQ(Nnue::evaluate(position, stack, cache), evaluate_from_scratch(board));
+  EXPECT_NE(Nnue::evaluate(board, cache), before);
+  std::filesystem::remove(other);
+}
+
+TEST_F(NnueTest, UnloadFallsBackToHandCraftedEvaluation) {
+  const Board board = Board::StartingPosition();
+  const int hand_crafted = [&board] {
+    unload_network();
+    return Eval::evaluate(board);
+  }();
+
+  EXPECT_EQ(network(), nullptr);
+  EXPECT_EQ(hand_crafted, 0);
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/board.hpp>
+#include <bitbishop/engine/eval_tables.hpp>
+#include <bitbishop/engine/pawn_structure.hpp>
+#include <thread>
+#include <tuple>
+
+using namespace Eval;
+using namespace Squares;
+using namespace Pieces;
+
+TEST(TestPawnHashTable, SecondProbeOfSameStructureHits) {
+  PawnHashTable table(64);
+  Board board("4k3/7p/P7/8/8/8/8/4K3 w - - 0 1");
+
+  const PawnEntry first = table.probe(board);
+  EXPECT_EQ(table.probes(), 1);
+  EXPECT_EQ(table.hits(), 0);
+
+  // Moving a king keeps the pawn structure
+  board.move_piece(E1, D1);
+  const PawnEntry second = table.probe(board);
+  EXPECT_EQ(table.probes(), 2);
+  EXPECT_EQ(table.hits(), 1);
+  EXPECT_EQ(second.score, first.score);
+}
+
+TEST(TestPawnHashTable, ProbeMatchesDirectEvaluation) {
+  PawnHashTable table(64);
+  Board board("4k3/1p1p4/8/8/8/2P5/1PP5/4K3 w - - 0 1");
+
+  EXPECT_EQ(table.probe(board).score, evaluate_pawn_structure(board).score);
+
+  board.move_piece(C3, C4);
+  EXPECT_EQ(table.probe(board).score, evaluate_pawn_structure(board).score);
+  EXPECT_EQ(table.hits(), 0);
+}
+
+TEST(TestPawnHashTable, ClearResetsStatistics) {
+  PawnHashTable table(64);
+  const Board board = Board::StartingPosition();
+
+  std::ignore = table.probe(board);
+  std::ignore = table.probe(board);
+  table.clear();
+
+  EXPECT_EQ(table.probes(), 0);
+  EXPECT_EQ(table.hits(), 0);
+  std::ignore = table.probe(board);
+  EXPECT_EQ(table.hits(), 0);
+}
+
+TEST(TestPawnHashTable, ThreadTableIsPerThread) {
+  PawnHashTable* main_table = &thread_pawn_hash_table();
+  PawnHashTable* other_table = nullptr;
+  std::thread([&other_table]() { other_table = &thread_pawn_hash_table(); }).join();
+
+  EXPECT_EQ(main_table, &thread_pawn_hash_table());
+  EXPECT_NE(main_table, other_table);
+}
+
+TEST(TestPawnHashTable, ScopeBindsTablesToCallingThread) {
+  PawnHashTable* default_table = &thread_pawn_hash_table();
+  ThreadTables tables;
+  {
+    const ThreadTablesScope scope(tables);
+    EXPECT_EQ(&thread_pawn_hash_table(), &tables.pawn_table);
+
+    // Tables are bound per thread
+    PawnHashTable* other_table = nullptr;
+    std::thread([&other_table]() { other_table = &thread_pawn_hash_table(); }).join();
+    EXPECT_NE(other_table, &tables.pawn_table);
+  }
+
+  EXPECT_EQ(&thread_pawn_hash_table(), default_table);
+}
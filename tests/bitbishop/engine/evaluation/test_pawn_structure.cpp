@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/board.hpp>
+#include <bitbishop/engine/pawn_structure.hpp>
+
+using namespace Eval;
+using namespace Squares;
+
+TEST(TestPawnStructure, StartingPositionIsBalanced) {
+  const PawnEntry entry = evaluate_pawn_structure(Board::StartingPosition());
+  EXPECT_EQ(entry.score, 0);
+  EXPECT_TRUE(entry.passed[ColorUtil::to_index(Color::WHITE)].empty());
+  EXPECT_TRUE(entry.passed[ColorUtil::to_index(Color::BLACK)].empty());
+}
+
+TEST(TestPawnStructure, EntryIsKeyedByPawnHash) {
+  const Board board = Board::StartingPosition();
+  EXPECT_EQ(evaluate_pawn_structure(board).key, board.get_pawn_hash());
+}
+
+TEST(TestPawnStructure, DoubledPawnsArePenalized) {
+  // White c2/c3 doubled, both sides with a pawn chain on other files
+  const Board board("4k3/1p1p4/8/8/8/2P5/1PP5/4K3 w - - 0 1");
+  const PawnEntry entry = evaluate_pawn_structure(board);
+  // black b7 and d7 are isolated, white pawns are connected
+  EXPECT_EQ(entry.score, DOUBLED_PAWN_PENALTY - (2 * ISOLATED_PAWN_PENALTY));
+}
+
+TEST(TestPawnStructure, IsolatedPawnsArePenalized) {
+  const Board board("4k3/pp6/8/8/8/8/P1P5/4K3 w - - 0 1");
+  const PawnEntry entry = evaluate_pawn_structure(board);
+  EXPECT_EQ(entry.score, 2 * ISOLATED_PAWN_PENALTY);
+}
+
+TEST(TestPawnStructure, PassedPawnsAreRewardedByRank) {
+  // White a6 is passed, black h7 is passed
+  const Board board("4k3/7p/P7/8/8/8/8/4K3 w - - 0 1");
+  const PawnEntry entry = evaluate_pawn_structure(board);
+
+  EXPECT_EQ(entry.passed[ColorUtil::to_index(Color::WHITE)], Bitboard(A6));
+  EXPECT_EQ(entry.passed[ColorUtil::to_index(Color::BLACK)], Bitboard(H7));
+  EXPECT_EQ(entry.score, PASSED_PAWN_BONUS[5] - PASSED_PAWN_BONUS[1]);
+}
+
+TEST(TestPawnStructure, PawnFacingAdjacentEnemyPawnIsNotPassed) {
+  const Board board("4k3/8/3p4/8/4P3/8/8/4K3 w - - 0 1");
+  const PawnEntry entry = evaluate_pawn_structure(board);
+  EXPECT_TRUE(entry.passed[ColorUtil::to_index(Color::WHITE)].empty());
+  EXPECT_TRUE(entry.passed[ColorUtil::to_index(Color::BLACK)].empty());
+}
+
+TEST(TestPawnStructure, BackwardPawnsArePenalized) {
+  // White d3 cannot be defended by another white pawn and its stop square d4 is controlled by black e5.
+  // Black e5 is defended by f6, so it is never backward.
+  const Board board("4k3/8/5p2/2P1p3/4P3/3P4/8/4K3 w - - 0 1");
+  const PawnEntry entry = evaluate_pawn_structure(board);
+  const PawnEntry reference = evaluate_pawn_structure(Board("4k3/8/5p2/2P1p3/4P3/8/3P4/4K3 w - - 0 1"));
+  EXPECT_EQ(entry.score - reference.score, BACKWARD_PAWN_PENALTY);
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/psqt.hpp>
+#include <bitbishop/square.hpp>
+
+using namespace Eval;
+using namespace Squares;
+using namespace Pieces;
+
+TEST(TestPackedScore, RoundTripsBothHalves) {
+  for (const int midgame : {0, 1, -1, 350, -350, 32'000, -32'000}) {
+    for (const int endgame : {0, 1, -1, 420, -420, 32'000, -32'000}) {
+      const Score score = make_score(midgame, endgame);
+      EXPECT_EQ(mg_value(score), midgame);
+      EXPECT_EQ(eg_value(score), endgame);
+    }
+  }
+}
+
+TEST(TestPackedScore, AdditionAddsBothHalves) {
+  const Score score = make_score(100, -20) + make_score(-250, 70) - make_score(5, -5);
+  EXPECT_EQ(mg_value(score), -155);
+  EXPECT_EQ(eg_value(score), 55);
+}
+
+TEST(TestPieceSquareScores, WhiteEntriesAddMaterialToFlippedPsqt) {
+  const int p_ind = Zobrist::piece_index(WHITE_KNIGHT);
+  EXPECT_EQ(mg_value(PIECE_SQUARE_SCORES[p_ind][G1.flat_index()]), KNIGHT + KNIGHT_PSQT_WHITE[62]);
+  EXPECT_EQ(mg_value(PIECE_SQUARE_SCORES[p_ind][E4.flat_index()]), KNIGHT + KNIGHT_PSQT_WHITE[36]);
+  EXPECT_EQ(eg_value(PIECE_SQUARE_SCORES[p_ind][G1.flat_index()]), KNIGHT_ENDGAME + KNIGHT_ENDGAME_PSQT_WHITE[62]);
+}
+
+TEST(TestPieceSquareScores, BlackEntriesAreNegatedMirrors) {
+  for (const Piece::Type type : {Piece::PAWN, Piece::KNIGHT, Piece::BISHOP, Piece::ROOK, Piece::QUEEN, Piece::KING}) {
+    const int white = Zobrist::piece_index(Piece(type, Color::WHITE));
+    const int black = Zobrist::piece_index(Piece(type, Color::BLACK));
+    for (std::size_t sq = 0; sq < Const::BOARD_SIZE; ++sq) {
+      EXPECT_EQ(PIECE_SQUARE_SCORES[black][flip_index_vertically(sq)], -PIECE_SQUARE_SCORES[white][sq]);
+    }
+  }
+}
+
+TEST(TestPieceSquareScores, KingsOnlyCarryPsqt) {
+  EXPECT_EQ(PIECE_SQUARE_SCORES[Zobrist::piece_index(WHITE_KING)][G1.flat_index()],
+            make_score(KING_MIDGAME_PSQT_WHITE[62], KING_ENDGAME_PSQT_WHITE[62]));
+  EXPECT_EQ(PIECE_SQUARE_SCORES[Zobrist::piece_index(BLACK_KING)][G8.flat_index()],
+            make_score(-KING_MIDGAME_PSQT_BLACK[6], -KING_ENDGAME_PSQT_BLACK[6]));
+}
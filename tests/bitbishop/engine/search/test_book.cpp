@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <bitbishop/engine/book.hpp>
+#include <bitbishop/moves/position.hpp>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Book;
+
+namespace {
+
+/**
+ * Writes entries sorted by key, as books are stored.
+ */
+std::string write_book(const std::string& name, std::vector<Entry> entries) {
+  std::ranges::stable_sort(entries, [](const Entry& lhs, const Entry& rhs) { return lhs.key < rhs.key; });
+  const std::string path = (std::filesystem::temp_directory_path() / name).string();
+  std::ofstream out(path, std::ios::binary);
+  for (const Entry& entry : entries) {
+    write_entry(out, entry);
+  }
+  return path;
+}
+
+Entry entry_of(const Board& board, const std::string& uci, std::uint16_t weight) {
+  const std::optional<Move> move = decode_move(board, encode_move(Move::from_uci(uci)));
+  EXPECT_TRUE(move.has_value()) << uci;
+  return Entry{.key = Zobrist::compute_polyglot_key(board), .move = encode_move(*move), .weight = weight};
+}
+
+}  // namespace
+
+/**
+ * @test Entries are stored big-endian, 16 bytes each.
+ */
+TEST(BookTest, EntriesAreBigEndian) {
+  std::ostringstream out;
+  write_entry(out, Entry{.key = 0x0102030405060708ULL, .move = 0x090A, .weight = 0x0B0C, .learn = 0x0D0E0F10});
+  const std::string bytes = out.str();
+  ASSERT_EQ(bytes.size(), ENTRY_SIZE);
+  for (std::size_t i = 0; i < ENTRY_SIZE; ++i) {
+    EXPECT_EQ(static_cast<unsigned char>(bytes[i]), i + 1);
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  const Entry entry = read_entry(reinterpret_cast<const std::byte*>(bytes.data()));
+  EXPECT_EQ(entry.key, 0x0102030405060708ULL);
+  EXPECT_EQ(entry.move, 0x090A);
+  EXPECT_EQ(entry.weight, 0x0B0C);
+  EXPECT_EQ(entry.learn, 0x0D0E0F10U);
+}
+
+/**
+ * @test Moves use the Polyglot encoding: castling as king takes rook, promotion types from knight 1 to queen 4.
+ */
+TEST(BookTest, MovesUsePolyglotEncoding) {
+  // e2e4: to e4 (28), from e2 (12)
+  EXPECT_EQ(encode_move(Move::from_uci("e2e4")), 28 | (12 << 6));
+  EXPECT_EQ(encode_move(Move::from_uci("a7a8q")), 56 | (48 << 6) | (4 << 12));
+  EXPECT_EQ(encode_move(Move::from_uci("a7a8n")), 56 | (48 << 6) | (1 << 12));
+
+  const Board board("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+  const std::optional<Move> kingside = decode_move(board, 7 | (4 << 6));  // e1h1
+  ASSERT_TRUE(kingside.has_value());
+  EXPECT_TRUE(kingside->is_castling);
+  EXPECT_EQ(kingside->to_uci(), "e1g1");
+  const std::optional<Move> queenside = decode_move(board, 0 | (4 << 6));  // e1a1
+  ASSERT_TRUE(queenside.has_value());
+  EXPECT_EQ(queenside->to_uci(), "e1c1");
+  EXPECT_EQ(encode_move(*queenside), 0 | (4 << 6));
+
+  EXPECT_FALSE(decode_move(board, 28 | (12 << 6)).has_value());  // No pawn on e2
+}
+
+/**
+ * @test Lookups find every entry of a key, and only those, wherever they are in the book.
+ */
+TEST(BookTest, FindReturnsAllEntriesOfKey) {
+  const Board start = Board::StartingPosition();
+  std::vector<Entry> entries = {entry_of(start, "e2e4", 10), entry_of(start, "d2d4", 5), entry_of(start, "g1f3", 1)};
+  for (std::uint64_t key = 1; key < 200; ++key) {
+    entries.push_back(Entry{.key = key * 0x9E3779B97F4A7C15ULL, .move = 1, .weight = 1});
+  }
+  const std::string path = write_book("bitbishop_test_book_find.bin", entries);
+
+  PolyglotBook book;
+  ASSERT_TRUE(book.open(path));
+  EXPECT_EQ(book.size(), entries.size());
+  EXPECT_EQ(book.find(Zobrist::compute_polyglot_key(start)).size(), 3);
+  EXPECT_TRUE(book.find(Zobrist::compute_polyglot_key(Board("8/8/8/8/8/8/8/K6k w - - 0 1"))).empty());
+
+  book.close();
+  EXPECT_FALSE(book.is_open());
+  EXPECT_EQ(book.size(), 0);
+  std::filesystem::remove(path);
+}
+
+/**
+ * @test Moves are picked in proportion to their weight, illegal and zero weight entries never.
+ */
+TEST(BookTest, PickFollowsWeights) {
+  const Board start = Board::StartingPosition();
+  const Board after_e4("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1");
+  const std::string path =
+      write_book("bitbishop_test_book_pick.bin",
+                 {entry_of(start, "e2e4", 3), entry_of(start, "d2d4", 1), entry_of(start, "c2c4", 0),
+                  Entry{.key = Zobrist::compute_polyglot_key(start), .move = encode_move(Move::from_uci("e2e5")),
+                        .weight = 100},
+                  entry_of(after_e4, "c7c5", 1)});
+
+  PolyglotBook book;
+  ASSERT_TRUE(book.open(path));
+
+  std::map<std::string, int> picks;
+  for (std::uint64_t random = 0; random < 400; ++random) {
+    const std::optional<Move> move = book.pick(start, random);
+    ASSERT_TRUE(move.has_value());
+    ++picks[move->to_uci()];
+  }
+  EXPECT_EQ(picks.size(), 2);
+  EXPECT_EQ(picks["e2e4"], 300);
+  EXPECT_EQ(picks["d2d4"], 100);
+
+  // Positions reached by moves are found too
+  Board board = Board::StartingPosition();
+  Position position(board);
+  position.apply_move(Move::from_uci("e2e4"));
+  ASSERT_TRUE(book.pick(board, 0).has_value());
+  EXPECT_EQ(book.pick(board, 0)->to_uci(), "c7c5");
+
+  position.apply_move(Move::from_uci("c7c5"));
+  EXPECT_FALSE(book.pick(board, 0).has_value());
+  std::filesystem::remove(path);
+}
+
+/**
+ * @test Files that are not a whole number of entries are rejected.
+ */
+TEST(BookTest, OpenRejectsInvalidFiles) {
+  PolyglotBook book;
+  EXPECT_FALSE(book.open("/nonexistent/book.bin"));
+
+  const std::string path = (std::filesystem::temp_directory_path() / "bitbishop_test_book_invalid.bin").string();
+  std::ofstream(path, std::ios::binary) << "not a book";
+  EXPECT_FALSE(book.open(path));
+  EXPECT_FALSE(book.is_open());
+  std::filesystem::remove(path);
+}
@@ -178,3 +178,44 @@ TEST(NegaMaxTest, FiftyMoveRuleIsDraw) {
 
   EXPECT_EQ(quiesce(pos, ALPHA_INIT, BETA_INIT, stats), 0);
 }
+
+/**
+ * @test The principal variation starts with the best move.
+ * @brief Scholar's mate is found at depth 2, the PV must lead with the mating move and be playable.
+ */
+TEST(NegaMaxTest, PrincipalVariationStartsWithBestMove) {
+  Board board = Board("r1bqkbnr/pppp1ppp/2n5/4p3/2B1P3/5Q2/PPPP1PPP/RNB1K1NR w KQkq - 0 1");
+  Position pos(board);
+  SearchStats stats;
+
+  BestMove best = negamax(pos, 3, ALPHA_INIT, BETA_INIT, 0, stats);
+
+  ASSERT_TRUE(best.move.has_value());
+  ASSERT_FALSE(best.pv.empty());
+  EXPECT_EQ(best.pv.front().from, best.move->from);
+  EXPECT_EQ(best.pv.front().to, best.move->to);
+
+  const Board root = board;
+  for (const Move& move : best.pv) {
+    pos.apply_move(move);
+  }
+  for (std::size_t i = 0; i < best.pv.size(); ++i) {
+    pos.revert_move();
+  }
+  EXPECT_EQ(board, root);
+}
+
+TEST(NegaMaxTest, UpcomingRepetitionCutsOffLosingWindow) {
+  Board board = Board::StartingPosition();
+  Position pos(board);
+  pos.apply_move(Move::make(G1, F3));
+  pos.apply_move(Move::make(G8, F6));
+  pos.apply_move(Move::make(F3, G1));
+
+  // Black can go back to the starting position: a draw is at least as good as the whole window.
+  SearchStats stats;
+  BestMove best = negamax(pos, 3, -200, -100, 4, stats);
+  EXPECT_EQ(best.score, 0);
+  EXPECT_EQ(stats.negamax_nodes, 1);
+  EXPECT_EQ(stats.quiescence_nodes, 0);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/engine/evaluation.hpp>
+#include <bitbishop/engine/search.hpp>
+#include <bitbishop/movegen/legal_moves.hpp>
+#include <bitbishop/moves/position.hpp>
+
+using namespace Search;
+using namespace Squares;
+
+TEST(SearchRootTest, SingleLineMatchesNegamax) {
+  Board board = Board("r1bqkbnr/pppp1ppp/2n5/4p3/2B1P3/5Q2/PPPP1PPP/RNB1K1NR w KQkq - 0 1");
+  Position pos(board);
+  SearchStats stats;
+
+  std::vector<Move> root_moves;
+  generate_legal_moves(root_moves, board);
+
+  const std::vector<BestMove> lines = search_root(pos, 2, 1, root_moves, stats);
+  const BestMove best = negamax(pos, 2, ALPHA_INIT, BETA_INIT, 0, stats);
+
+  ASSERT_EQ(lines.size(), 1);
+  EXPECT_EQ(lines.front().score, best.score);
+  EXPECT_EQ(lines.front().move->from, F3);
+  EXPECT_EQ(lines.front().move->to, F7);
+}
+
+TEST(SearchRootTest, MultipleLinesAreSortedAndDistinct) {
+  Board board = Board::StartingPosition();
+  Position pos(board);
+  SearchStats stats;
+
+  std::vector<Move> root_moves;
+  generate_legal_moves(root_moves, board);
+
+  const std::vector<BestMove> lines = search_root(pos, 2, 4, root_moves, stats);
+
+  ASSERT_EQ(lines.size(), 4);
+  for (std::size_t i = 0; i < lines.size(); ++i) {
+    ASSERT_TRUE(lines[i].move.has_value());
+    ASSERT_FALSE(lines[i].pv.empty());
+    EXPECT_EQ(lines[i].pv.front().to_uci(), lines[i].move->to_uci());
+    if (i > 0) {
+      EXPECT_GE(lines[i - 1].score, lines[i].score);
+      EXPECT_NE(lines[i - 1].move->to_uci(), lines[i].move->to_uci());
+    }
+  }
+}
+
+TEST(SearchRootTest, MultipleLinesScoresMatchIndividualSearches) {
+  Board board("r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3");
+  Position pos(board);
+  SearchStats stats;
+
+  std::vector<Move> root_moves;
+  generate_legal_moves(root_moves, board);
+
+  const std::vector<BestMove> lines = search_root(pos, 2, 3, root_moves, stats);
+  ASSERT_EQ(lines.size(), 3);
+
+  for (const BestMove& line : lines) {
+    pos.apply_move(*line.move);
+    const int score = -negamax(pos, 1, ALPHA_INIT, BETA_INIT, 1, stats).score;
+    pos.revert_move();
+    EXPECT_EQ(line.score, score) << line.move->to_uci();
+  }
+}
+
+TEST(SearchRootTest, RootMovesAreReorderedBestLinesFirst) {
+  Board board = Board::StartingPosition();
+  Position pos(board);
+  SearchStats stats;
+
+  std::vector<Move> root_moves;
+  generate_legal_moves(root_moves, board);
+  const std::size_t moves_count = root_moves.size();
+
+  const std::vector<BestMove> lines = search_root(pos, 2, 3, root_moves, stats);
+
+  ASSERT_EQ(root_moves.size(), moves_count);
+  for (std::size_t i = 0; i < lines.size(); ++i) {
+    EXPECT_EQ(root_moves[i].to_uci(), lines[i].move->to_uci());
+  }
+}
+
+TEST(SearchRootTest, MultiPvIsClampedToRootMovesCount) {
+  Board board("7k/8/8/8/8/8/8/K7 w - - 0 1");
+  board.set_piece(B2, Pieces::WHITE_PAWN);
+  Position pos(board);
+  SearchStats stats;
+
+  std::vector<Move> root_moves;
+  generate_legal_moves(root_moves, board);
+
+  const std::vector<BestMove> lines = search_root(pos, 1, 256, root_moves, stats);
+
+  EXPECT_EQ(lines.size(), root_moves.size());
+}
+
+TEST(SearchRootTest, NoRootMovesFallsBackToNegamax) {
+  Board board("K7/8/8/8/8/8/5Q2/7k b - - 0 1");
+  Position pos(board);
+  SearchStats stats;
+
+  std::vector<Move> root_moves;
+  generate_legal_moves(root_moves, board);
+  ASSERT_TRUE(root_moves.empty());
+
+  const std::vector<BestMove> lines = search_root(pos, 2, 4, root_moves, stats);
+
+  ASSERT_EQ(lines.size(), 1);
+  EXPECT_EQ(lines.front().score, 0);
+  EXPECT_FALSE(lines.front().move.has_value());
+}
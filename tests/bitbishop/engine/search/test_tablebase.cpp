@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/engine/search.hpp>
+#include <bitbishop/engine/tablebase.hpp>
+#include <bitbishop/movegen/legal_moves.hpp>
+#include <bitbishop/moves/position.hpp>
+#include <bitbishop/tools/tablebase_generator.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace Tablebase;
+
+namespace {
+
+class TablebaseTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    directory = (std::filesystem::temp_directory_path() / "bitbishop_test_tablebases").string();
+    Tools::TablebaseGenerator generator(1);
+    generator.generate("KRvK");
+    ASSERT_TRUE(generator.write(directory));
+  }
+
+  static void TearDownTestSuite() { std::filesystem::remove_all(directory); }
+
+  void SetUp() override { ASSERT_EQ(load(directory), 1); }
+
+  void TearDown() override { unload(); }
+
+  static inline std::string directory;
+};
+
+}  // namespace
+
+/**
+ * @test Identical pieces and symmetric boards share an index, indexes decode to canonical squares.
+ */
+TEST(TablebaseLayoutTest, IndexesAreCanonical) {
+  const Layout layout("KNNvK");
+  EXPECT_EQ(layout.code(), "KNNvK");
+  EXPECT_EQ(layout.size(), 10 * 64 * 2 * 64 * 64);
+  EXPECT_EQ(Layout("KPvKR").code(), "KPvKR");
+  EXPECT_EQ(Layout("KBQvK").code(), "KQBvK");
+
+  // Mirrored, flipped, transposed and with colors swapped
+  const Board board("8/8/8/8/8/2k5/1N6/1K1N4 w - - 0 1");
+  EXPECT_EQ(layout.index(board, false), layout.index(Board("8/8/8/8/8/5k2/6N1/4N1K1 w - - 0 1"), false));
+  EXPECT_EQ(layout.index(board, false), layout.index(Board("1K1N4/1N6/2k5/8/8/8/8/8 w - - 0 1"), false));
+  EXPECT_EQ(layout.index(board, false), layout.index(Board("8/8/8/8/N7/2k5/KN6/8 w - - 0 1"), false));
+  EXPECT_EQ(layout.index(board, false), layout.index(Board("8/8/8/8/8/2K5/1n6/1k1n4 b - - 0 1"), true));
+
+  std::array<int, MAX_PIECES> squares{};
+  Color side_to_move = Color::BLACK;
+  ASSERT_TRUE(layout.decode(layout.index(board, false), squares, side_to_move));
+  EXPECT_EQ(side_to_move, Color::WHITE);
+  EXPECT_EQ(squares[0], Squares::B1.flat_index());
+  EXPECT_EQ(squares[2], Squares::D1.flat_index());
+  EXPECT_EQ(squares[3], Squares::B2.flat_index());
+
+  EXPECT_THROW(Layout("KQRBNvK"), std::invalid_argument);
+  EXPECT_THROW(Layout("KQvQ"), std::invalid_argument);
+}
+
+/**
+ * @test Written files are mapped and probed for both colors.
+ */
+TEST_F(TablebaseTest, ProbesMappedFiles) {
+  EXPECT_EQ(max_pieces(), 3);
+
+  const Board mate_in_one("k7/8/1K6/8/8/8/8/7R w - - 0 1");
+  EXPECT_EQ(probe_wdl(mate_in_one), Wdl::Win);
+  EXPECT_EQ(probe_dtm(mate_in_one), 1);
+  EXPECT_EQ(probe_dtm(Board("7r/8/8/8/8/1k6/8/K7 b - - 0 1")), 1);
+  EXPECT_EQ(probe_wdl(Board("7K/8/8/8/8/8/kR6/8 b - - 0 1")), Wdl::Draw);  // The rook hangs
+  EXPECT_EQ(probe_score(mate_in_one, 3), Eval::MATE_SCORE - 3 - 1);
+
+  // Not covered: other material, castling rights
+  EXPECT_EQ(probe_wdl(Board("k7/8/1K6/8/8/8/8/7Q w - - 0 1")), std::nullopt);
+  EXPECT_EQ(probe_wdl(Board("k7/8/8/8/8/8/8/4K2R w K - 0 1")), std::nullopt);
+}
+
+/**
+ * @test Without the DTM file, wins are scored below mates.
+ */
+TEST_F(TablebaseTest, FallsBackToWdl) {
+  std::filesystem::remove(std::filesystem::path(directory) / "KRvK.bbm");
+  ASSERT_EQ(load(directory), 1);
+
+  const Board mate_in_one("k7/8/1K6/8/8/8/8/7R w - - 0 1");
+  EXPECT_EQ(probe_dtm(mate_in_one), std::nullopt);
+  EXPECT_EQ(probe_score(mate_in_one, 2), WIN_SCORE - 2);
+  TearDownTestSuite();
+  SetUpTestSuite();
+}
+
+/**
+ * @test Corrupted files are not loaded.
+ */
+TEST_F(TablebaseTest, RejectsTruncatedFiles) {
+  const std::filesystem::path path = std::filesystem::path(directory) / "KRvK.bbw";
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+  EXPECT_EQ(load(directory), 0);
+  EXPECT_EQ(max_pieces(), 0);
+  TearDownTestSuite();
+  SetUpTestSuite();
+}
+
+/**
+ * @test The search scores tablebase positions as mates, and the root keeps the fastest mates only.
+ */
+TEST_F(TablebaseTest, SearchUsesTablebases) {
+  Board board("8/8/8/3k4/8/8/8/R3K3 w - - 0 1");
+  Position position(board);
+  Search::SearchStats stats;
+
+  const Search::BestMove best = Search::negamax(position, 2, Search::ALPHA_INIT, Search::BETA_INIT, 0, stats);
+  const int dtm = *probe_dtm(board);
+  EXPECT_EQ(best.score, Eval::MATE_SCORE - dtm);
+  EXPECT_GT(stats.tablebase_hits, 0);
+
+  std::vector<Move> moves;
+  generate_legal_moves(moves, board);
+  const std::size_t legal = moves.size();
+  ASSERT_TRUE(filter_root_moves(position, moves));
+  EXPECT_LT(moves.size(), legal);
+  for (const Move& move : moves) {
+    position.apply_move(move);
+    EXPECT_EQ(probe_dtm(board), dtm - 1);
+    position.revert_move();
+  }
+}
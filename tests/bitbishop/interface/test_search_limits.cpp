@@ -82,6 +82,7 @@ TEST_P(SearchLimitsFromUciTest, ParsesCorrectly) {
   EXPECT_EQ(result.btime, param.expected.btime);
   EXPECT_EQ(result.winc, param.expected.winc);
   EXPECT_EQ(result.binc, param.expected.binc);
+  EXPECT_EQ(result.nodes, param.expected.nodes);
   EXPECT_EQ(result.infinite, param.expected.infinite);
 }
 
@@ -135,6 +136,16 @@ INSTANTIATE_TEST_SUITE_P(
       }
     },
 
+    // Nodes only -> NOT infinite
+    SearchLimitsFromUciTestCase{
+      "NodesOnly",
+      {"go", "nodes", "5000000000"},
+      Uci::SearchLimits{
+        .nodes = 5'000'000'000,
+        .infinite = false
+      }
+    },
+
     // Explicit infinite overrides depth
     SearchLimitsFromUciTestCase{
       "DepthAndInfinite",
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <bitbishop/engine/evaluation.hpp>
 #include <bitbishop/interface/search_reporter.hpp>
 #include <sstream>
 #include <thread>
@@ -53,6 +54,30 @@ TEST_F(SearchReporterTest, BenchOutputsCorrectNodeAggregation) {
   EXPECT_NE(result.find("nps"), std::string::npos);
 }
 
+TEST_F(SearchReporterTest, BenchOutputsPawnHashHitRate) {
+  BenchReporter reporter(out);
+  Search::SearchStats pawn_stats{
+      .negamax_nodes = 10, .quiescence_nodes = 20, .pawn_hash_probes = 40, .pawn_hash_hits = 30};
+
+  reporter.on_finish(best_move, pawn_stats);
+
+  const std::string result = out.str();
+  EXPECT_NE(result.find("pawn_hash_probes 40"), std::string::npos);
+  EXPECT_NE(result.find("pawn_hash_hit_rate 75%"), std::string::npos);
+}
+
+TEST_F(SearchReporterTest, BenchOutputsEvalCacheHitRate) {
+  BenchReporter reporter(out);
+  Search::SearchStats cache_stats{
+      .negamax_nodes = 10, .quiescence_nodes = 20, .eval_cache_probes = 8, .eval_cache_hits = 2};
+
+  reporter.on_finish(best_move, cache_stats);
+
+  const std::string result = out.str();
+  EXPECT_NE(result.find("eval_cache_probes 8"), std::string::npos);
+  EXPECT_NE(result.find("eval_cache_hit_rate 25%"), std::string::npos);
+}
+
 TEST_F(SearchReporterTest, BenchHandlesZeroTimeGracefully) {
   const auto start_time = std::chrono::steady_clock::now();
 
@@ -64,3 +89,54 @@ TEST_F(SearchReporterTest, BenchHandlesZeroTimeGracefully) {
   EXPECT_NE(result.find("bench nodes "), std::string::npos);
   EXPECT_NE(result.find("nps "), std::string::npos);
 }
+
+TEST_F(SearchReporterTest, UciOutputsOneInfoLinePerPrincipalVariation) {
+  const auto start_time = std::chrono::steady_clock::now();
+  UciReporter reporter(out, [start_time]() { return start_time; });
+
+  BestMove first{.move = fake_move, .score = 35, .pv = {fake_move, Move::from_uci("e7e5")}};
+  BestMove second{.move = Move::from_uci("d2d4"), .score = -12, .pv = {Move::from_uci("d2d4")}};
+
+  reporter.on_iteration({first, second}, 4, stats);
+
+  EXPECT_EQ(out.str(),
+            "info depth 4 multipv 1 score cp 35 nodes 200 nps 0 time 0 pv e2e4 e7e5\n"
+            "info depth 4 multipv 2 score cp -12 nodes 200 nps 0 time 0 pv d2d4\n");
+}
+
+TEST_F(SearchReporterTest, UciOutputsMateScoresInMoves) {
+  const auto start_time = std::chrono::steady_clock::now();
+  UciReporter reporter(out, [start_time]() { return start_time; });
+
+  BestMove mating{.move = fake_move, .score = Eval::MATE_SCORE - 3, .pv = {}};
+  BestMove mated{.move = fake_move, .score = -Eval::MATE_SCORE + 2, .pv = {}};
+
+  reporter.on_iteration({mating, mated}, 3, stats);
+
+  EXPECT_EQ(out.str(),
+            "info depth 3 multipv 1 score mate 2 nodes 200 nps 0 time 0\n"
+            "info depth 3 multipv 2 score mate -1 nodes 200 nps 0 time 0\n");
+}
+
+TEST_F(SearchReporterTest, UciOutputsTimeAndNodesPerSecond) {
+  const auto start_time = std::chrono::steady_clock::now();
+  int calls = 0;
+  UciReporter reporter(out, [start_time, &calls]() {
+    // Construction reads the start time, the iteration happens 400ms later
+    return (calls++ == 0) ? start_time : start_time + std::chrono::milliseconds(400);
+  });
+
+  reporter.on_iteration({best_move}, 2, stats);
+
+  EXPECT_NE(out.str().find(" nodes 200 nps 500 time 400"), std::string::npos);
+}
+
+TEST_F(SearchReporterTest, UciOutputsTablebaseHitsWhenAny) {
+  const auto start_time = std::chrono::steady_clock::now();
+  UciReporter reporter(out, [start_time]() { return start_time; });
+  Search::SearchStats tablebase_stats{.negamax_nodes = 120, .quiescence_nodes = 80, .tablebase_hits = 7};
+
+  reporter.on_iteration({best_move}, 2, tablebase_stats);
+
+  EXPECT_NE(out.str().find(" time 0 tbhits 7"), std::string::npos);
+}
@@ -42,6 +42,29 @@ TEST(SearchSessionTest, StartGoDepthOneProducesBestMoveAndBecomesIdle) {
   EXPECT_NE(result.find("bestmove "), std::string::npos);
 }
 
+TEST(SearchSessionTest, EvaluationTablesStayWarmAcrossSearches) {
+  std::stringstream output;
+  Uci::SearchSession session(output);
+
+  Uci::SearchLimits limits{.depth = 2};
+  const Eval::EvalCache& eval_cache = session.thread_tables().eval_cache;
+
+  session.start_go(Board::StartingPosition(), limits);
+  ASSERT_TRUE(wait_until_idle(session));
+  const std::uint64_t first_probes = eval_cache.probes();
+  const std::uint64_t first_hits = eval_cache.hits();
+  ASSERT_GT(first_probes, 0);
+
+  // The second search runs on a new thread but reuses the session tables: every evaluation is already cached
+  session.start_go(Board::StartingPosition(), limits);
+  ASSERT_TRUE(wait_until_idle(session));
+  EXPECT_EQ(eval_cache.probes() - first_probes, first_probes);
+  EXPECT_EQ(eval_cache.hits() - first_hits, first_probes);
+
+  session.clear_tables();
+  EXPECT_EQ(eval_cache.probes(), 0);
+}
+
 TEST(SearchSessionTest, StartBenchDepthOneProducesBenchSummaryAndBecomesIdle) {
   std::stringstream output;
   Uci::SearchSession session(output);
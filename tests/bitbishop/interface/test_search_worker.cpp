@@ -63,3 +63,58 @@ TEST(SearchControllerTest, MovetimeStopsSearchAutomatically) {
     return report.kind == Uci::SearchReportKind::Iteration;
   }));
 }
+
+/**
+ * @test Completed iterations stay under the node limit: the iteration reaching it is interrupted and dropped.
+ */
+TEST(SearchControllerTest, NodesStopSearchAutomatically) {
+  Board board = Board::StartingPosition();
+  Uci::SearchLimits limits;
+  limits.nodes = 20'000;
+
+  Uci::SearchWorker controller(board, limits);
+  controller.start();
+  controller.wait();
+
+  const auto reports = controller.drain_reports();
+  ASSERT_GE(reports.size(), 2);
+  EXPECT_EQ(reports.back().kind, Uci::SearchReportKind::Finish);
+  EXPECT_TRUE(reports.back().best.move.has_value());
+  for (const Uci::SearchReport& report : reports) {
+    EXPECT_LT(report.stats.negamax_nodes + report.stats.quiescence_nodes, *limits.nodes);
+  }
+}
+
+/**
+ * @test A search stopped during its first iteration still finishes with a legal move.
+ */
+TEST(SearchControllerTest, InterruptedFirstIterationFinishesWithLegalMove) {
+  Board board = Board::StartingPosition();
+  Uci::SearchLimits limits;
+  limits.nodes = 1;
+
+  Uci::SearchWorker controller(board, limits);
+  controller.start();
+  controller.wait();
+
+  const auto reports = controller.drain_reports();
+  ASSERT_EQ(reports.size(), 1);
+  EXPECT_EQ(reports.back().kind, Uci::SearchReportKind::Finish);
+  EXPECT_TRUE(reports.back().best.move.has_value());
+}
+
+TEST(SearchControllerTest, MultiPvPublishesRequestedLinesCount) {
+  Board board = Board::StartingPosition();
+  Uci::SearchLimits limits;
+  limits.depth = 2;
+
+  Uci::SearchWorker controller(board, limits, Uci::SearchOptions{.multipv = 3});
+  controller.start();
+  controller.wait();
+
+  const auto reports = controller.drain_reports();
+  ASSERT_FALSE(reports.empty());
+  EXPECT_EQ(reports.back().kind, Uci::SearchReportKind::Finish);
+  ASSERT_EQ(reports.back().lines.size(), 3);
+  EXPECT_EQ(reports.back().lines.front().move->to_uci(), reports.back().best.move->to_uci());
+}
@@ -4,6 +4,8 @@
 #include <bitbishop/helpers/async.hpp>
 #include <bitbishop/helpers/blocking_stream.hpp>
 #include <bitbishop/interface/uci_engine.hpp>
+#include <filesystem>
+#include <fstream>
 
 using namespace Squares;
 using namespace std::chrono;
@@ -253,6 +255,22 @@ TEST_F(UciEngineTest, PositionFenMovesAppliesMoves) {
   EXPECT_FALSE(origin.has_value());
 }
 
+TEST_F(UciEngineTest, PositionMovesAreResolvedAgainstTheBoard) {
+  // A rook move from e1 to c1 is not a castling
+  input.write("position fen 4k3/8/8/8/8/8/8/4R1K1 w - - 0 1 moves e1c1\n");
+
+  ASSERT_TRUE(wait_for([&] { return !engine->get_board().get_piece(E1).has_value(); }));
+  ASSERT_TRUE(engine->get_board().get_piece(C1).has_value());
+  EXPECT_TRUE(engine->get_board().get_piece(C1)->is_rook());
+  EXPECT_FALSE(engine->get_board().get_piece(D1).has_value());
+
+  // A pawn capturing onto the en passant square removes the pawn that passed it
+  input.write("position startpos moves e2e4 a7a6 e4e5 d7d5 e5d6\n");
+
+  ASSERT_TRUE(wait_for([&] { return engine->get_board().get_piece(D6).has_value(); }));
+  EXPECT_FALSE(engine->get_board().get_piece(D5).has_value());
+}
+
 TEST_F(UciEngineTest, UciNewGameResetsBoard) {
   input.write("position startpos moves e2e4\n");
 
@@ -284,6 +302,129 @@ TEST_F(UciEngineTest, GoWithoutPositionProducesBestMove) {
   assert_output_contains(output, "bestmove ");
 }
 
+TEST_F(UciEngineTest, UciCommandAdvertisesMultiPvOption) {
+  input.write("uci\n");
+
+  assert_output_contains(output, "option name MultiPV type spin default 1 min 1 max 256");
+}
+
+TEST_F(UciEngineTest, GoReportsInfoLines) {
+  input.write("go depth 2\n");
+
+  assert_output_contains(output, "bestmove ");
+  assert_output_contains(output, "info depth 2 multipv 1 score cp ");
+}
+
+TEST_F(UciEngineTest, SetOptionMultiPvReportsSeveralLines) {
+  input.write(
+      "setoption name MultiPV value 3\n"
+      "go depth 2\n");
+
+  assert_output_contains(output, "bestmove ");
+  assert_output_contains(output, "info depth 2 multipv 3 ");
+  assert_output_not_contains(output, "multipv 4 ");
+}
+
+TEST_F(UciEngineTest, SetOptionIsCaseInsensitiveAndIgnoresInvalidValues) {
+  input.write(
+      "setoption name multipv value 2\n"
+      "setoption name MultiPV value abc\n"
+      "go depth 1\n");
+
+  assert_output_contains(output, "bestmove ");
+  assert_output_contains(output, "info depth 1 multipv 2 ");
+}
+
+TEST_F(UciEngineTest, UciCommandAdvertisesEvalFileOption) {
+  input.write("uci\n");
+
+  assert_output_contains(output, "option name EvalFile type string default <empty>");
+}
+
+TEST_F(UciEngineTest, SetOptionTablebasePathReportsLoadedTablebases) {
+  input.write(
+      "uci\n"
+      "setoption name TablebasePath value /nonexistent/tablebases\n"
+      "setoption name TablebasePath value <empty>\n");
+
+  assert_output_contains(output, "option name TablebasePath type string default <empty>");
+  assert_output_contains(output, "info string loaded 0 tablebases (up to 0 pieces) from /nonexistent/tablebases");
+  assert_output_contains(output, "info string tablebases disabled");
+}
+
+TEST_F(UciEngineTest, OwnBookPlaysBookMovesWithoutSearching) {
+  const Board start = Board::StartingPosition();
+  const std::string path = (std::filesystem::temp_directory_path() / "bitbishop_test_uci_book.bin").string();
+  {
+    std::ofstream book(path, std::ios::binary);
+    Book::write_entry(book, Book::Entry{.key = Zobrist::compute_polyglot_key(start),
+                                        .move = Book::encode_move(Move::from_uci("d2d4")),
+                                        .weight = 1});
+  }
+
+  input.write(
+      "uci\n"
+      "setoption name BookFile value " +
+      path +
+      "\n"
+      "setoption name OwnBook value true\n"
+      "position startpos\n"
+      "go depth 6\n");
+
+  assert_output_contains(output, "option name OwnBook type check default false");
+  assert_output_contains(output, "info string loaded book " + path + " (1 entries)");
+  assert_output_contains(output, "info string book move d2d4");
+  assert_output_contains(output, "bestmove d2d4");
+  assert_output_not_contains(output, "info depth");
+
+  // Out of book: regular search
+  input.write(
+      "position startpos moves d2d4\n"
+      "go depth 1\n");
+  assert_output_contains(output, "info depth 1");
+  std::filesystem::remove(path);
+}
+
+TEST_F(UciEngineTest, SetOptionBookFileReportsLoadFailure) {
+  input.write(
+      "setoption name BookFile value /nonexistent/book.bin\n"
+      "setoption name BookFile value <empty>\n");
+
+  assert_output_contains(output, "info string failed to load book /nonexistent/book.bin");
+  assert_output_contains(output, "info string book disabled");
+}
+
+TEST_F(UciEngineTest, SetOptionEvalFileReportsLoadFailureAndFallback) {
+  input.write(
+      "setoption name EvalFile value /nonexistent/network.nnue\n"
+      "setoption name EvalFile value <empty>\n"
+      "go depth 1\n");
+
+  assert_output_contains(output, "info string failed to load network /nonexistent/network.nnue");
+  assert_output_contains(output, "info string using hand-crafted evaluation");
+  assert_output_contains(output, "bestmove ");
+}
+
+TEST_F(UciEngineTest, GoWithoutGameHistoryPlaysOnWhenLosing) {
+  // White is a queen down: without earlier positions, no move draws
+  input.write(
+      "position fen 3k4/8/q7/8/8/8/8/4K1N1 w - - 0 1\n"
+      "go depth 1\n");
+
+  assert_output_contains(output, "bestmove ");
+  assert_output_not_contains(output, "score cp 0 ");
+}
+
+TEST_F(UciEngineTest, GoSeesRepetitionsFromGameHistory) {
+  // The knight shuffle played twice: g1f3 now repeats the position after it for the third time
+  input.write(
+      "position fen 3k4/8/q7/8/8/8/8/4K1N1 w - - 0 1 moves g1f3 d8e8 f3g1 e8d8 g1f3 d8e8 f3g1 e8d8\n"
+      "go depth 1\n");
+
+  assert_output_contains(output, "info depth 1 multipv 1 score cp 0 ");
+  assert_output_contains(output, "bestmove g1f3");
+}
+
 TEST_F(UciEngineTest, UnknownCommandProducesNoOutput) {
   // Clear the output containing the startup message.
   assert_output_contains(output, " by ");
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/lookups/cuckoo.hpp>
+#include <bitbishop/piece.hpp>
+#include <bitbishop/square.hpp>
+#include <bitbishop/zobrist.hpp>
+
+using namespace Lookups;
+
+namespace {
+
+Zobrist::Key move_key(Piece piece, Square from, Square to) {
+  const int p_ind = Zobrist::piece_index(piece);
+  return Zobrist::tables.pieces[p_ind][from.value()] ^ Zobrist::tables.pieces[p_ind][to.value()] ^
+         Zobrist::tables.side;
+}
+
+bool contains(Zobrist::Key key) { return CUCKOO.keys[cuckoo_h1(key)] == key || CUCKOO.keys[cuckoo_h2(key)] == key; }
+
+}  // namespace
+
+/**
+ * @test Every reversible move is stored exactly once.
+ */
+TEST(CuckooTest, HoldsEveryReversibleMove) {
+  std::size_t filled = 0;
+  for (const Zobrist::Key key : CUCKOO.keys) {
+    if (key != Zobrist::NULL_HASH) {
+      ++filled;
+    }
+  }
+  EXPECT_EQ(filled, CUCKOO_MOVES_COUNT);
+}
+
+/**
+ * @test Stored moves are found at one of their two slots, with squares ordered from low to high.
+ */
+TEST(CuckooTest, StoredMovesAreReachable) {
+  for (std::size_t slot = 0; slot < CUCKOO_TABLE_SIZE; ++slot) {
+    const Zobrist::Key key = CUCKOO.keys[slot];
+    if (key == Zobrist::NULL_HASH) {
+      continue;
+    }
+    EXPECT_TRUE(slot == cuckoo_h1(key) || slot == cuckoo_h2(key));
+    EXPECT_LT(CUCKOO.from[slot], CUCKOO.to[slot]);
+  }
+}
+
+/**
+ * @test Knight and king moves are present whatever their direction; pawn moves are not.
+ */
+TEST(CuckooTest, LooksUpMovesByKey) {
+  EXPECT_TRUE(contains(move_key(Pieces::WHITE_KNIGHT, Squares::G1, Squares::F3)));
+  EXPECT_TRUE(contains(move_key(Pieces::WHITE_KNIGHT, Squares::F3, Squares::G1)));
+  EXPECT_TRUE(contains(move_key(Pieces::BLACK_KING, Squares::E8, Squares::D7)));
+  EXPECT_TRUE(contains(move_key(Pieces::BLACK_QUEEN, Squares::A1, Squares::H8)));
+
+  EXPECT_FALSE(contains(move_key(Pieces::WHITE_KNIGHT, Squares::G1, Squares::G3)));
+  EXPECT_FALSE(contains(move_key(Pieces::WHITE_PAWN, Squares::E2, Squares::E3)));
+}
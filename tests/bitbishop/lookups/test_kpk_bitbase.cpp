@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/board.hpp>
+#include <bitbishop/lookups/king_attacks.hpp>
+#include <bitbishop/lookups/kpk_bitbase.hpp>
+#include <bitbishop/lookups/pawn_attacks.hpp>
+#include <bitbishop/movegen/legal_moves.hpp>
+#include <bitbishop/moves/position.hpp>
+#include <string>
+#include <vector>
+
+using namespace Lookups;
+using namespace Squares;
+
+namespace {
+
+/**
+ * FEN of a position with a white king, white pawn and black king.
+ */
+std::string kpk_fen(int white_king, int pawn, int black_king, Color side_to_move) {
+  std::string grid(64, '.');
+  grid[white_king] = 'K';
+  grid[pawn] = 'P';
+  grid[black_king] = 'k';
+
+  std::string fen;
+  for (int rank = 7; rank >= 0; --rank) {
+    int empty = 0;
+    for (int file = 0; file < 8; ++file) {
+      const char square = grid[(rank * 8) + file];
+      if (square == '.') {
+        ++empty;
+        continue;
+      }
+      if (empty > 0) {
+        fen += std::to_string(empty);
+        empty = 0;
+      }
+      fen += square;
+    }
+    if (empty > 0) {
+      fen += std::to_string(empty);
+    }
+    fen += rank > 0 ? "/" : "";
+  }
+  return fen + (side_to_move == Color::WHITE ? " w - - 0 1" : " b - - 0 1");
+}
+
+bool is_win(const Board& board) {
+  if (board.pawns(Color::WHITE).count() != 1 || board.occupied().count() != 3) {
+    return false;  // The pawn was captured or promoted
+  }
+  return kpk_is_win(Color::WHITE, *board.king(Color::WHITE).lsb(), *board.pawns(Color::WHITE).lsb(),
+                    *board.king(Color::BLACK).lsb(), board.get_side_to_move());
+}
+
+}  // namespace
+
+/**
+ * @test Textbook positions.
+ */
+TEST(KpkBitbaseTest, ClassifiesTextbookPositions) {
+  // Opposition in front of the pawn: the side to move loses it
+  EXPECT_FALSE(kpk_is_win(Color::WHITE, E5, E4, E7, Color::WHITE));
+  EXPECT_TRUE(kpk_is_win(Color::WHITE, E5, E4, E7, Color::BLACK));
+
+  // King on a key square wins whoever is to move
+  EXPECT_TRUE(kpk_is_win(Color::WHITE, D6, D4, F6, Color::WHITE));
+  EXPECT_TRUE(kpk_is_win(Color::WHITE, D6, D4, F6, Color::BLACK));
+
+  // Rook pawn with the defending king in the corner
+  EXPECT_FALSE(kpk_is_win(Color::WHITE, E1, A5, A8, Color::WHITE));
+
+  // Outside the square of the pawn
+  EXPECT_TRUE(kpk_is_win(Color::WHITE, E1, G4, A8, Color::BLACK));
+  EXPECT_FALSE(kpk_is_win(Color::WHITE, A1, G4, C6, Color::BLACK));
+}
+
+/**
+ * @test Results do not depend on the color of the pawn or the side of the board.
+ */
+TEST(KpkBitbaseTest, IsSymmetric) {
+  for (int white_king = 0; white_king < 64; white_king += 3) {
+    for (int black_king = 0; black_king < 64; black_king += 5) {
+      for (int pawn = 8; pawn < 56; ++pawn) {
+        for (const Color side_to_move : {Color::WHITE, Color::BLACK}) {
+          const auto square = [](int index) { return Square(index, std::in_place); };
+          const bool win = kpk_is_win(Color::WHITE, square(white_king), square(pawn), square(black_king), side_to_move);
+
+          EXPECT_EQ(kpk_is_win(Color::WHITE, square(white_king ^ 7), square(pawn ^ 7), square(black_king ^ 7),
+                               side_to_move),
+                    win);
+          EXPECT_EQ(kpk_is_win(Color::BLACK, square(white_king ^ 56), square(pawn ^ 56), square(black_king ^ 56),
+                               ColorUtil::opposite(side_to_move)),
+                    win);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @test Every legal position agrees with its successors: the attacker wins when one move wins, the defender draws
+ * when one move draws.
+ */
+TEST(KpkBitbaseTest, AgreesWithLegalMoves) {
+  for (const Square pawn_square : {C2, D4, B6, C7}) {
+    const int pawn = pawn_square.flat_index();
+    for (int white_king = 0; white_king < 64; ++white_king) {
+      for (int black_king = 0; black_king < 64; ++black_king) {
+        for (const Color side_to_move : {Color::WHITE, Color::BLACK}) {
+          const Square bk(black_king, std::in_place);
+          const bool overlap = white_king == pawn || black_king == pawn || white_king == black_king;
+          if (overlap || KING_ATTACKS[white_king].test(bk) ||
+              (side_to_move == Color::WHITE && WHITE_PAWN_ATTACKS[pawn].test(bk))) {
+            continue;  // Illegal
+          }
+
+          Board board(kpk_fen(white_king, pawn, black_king, side_to_move));
+          Position position(board);
+          std::vector<Move> moves;
+          generate_legal_moves(moves, board);
+
+          bool any_win = false;
+          bool all_win = !moves.empty();
+          for (const Move& move : moves) {
+            position.apply_move(move);
+            // A queen promotion wins unless the lone king takes the queen
+            const bool safe_promotion = move.promotion.has_value() && move.promotion->type() == Piece('Q').type() &&
+                                        (!KING_ATTACKS[black_king].test(move.to) || KING_ATTACKS[white_king].test(move.to));
+            const bool win = is_win(board) || safe_promotion;
+            position.revert_move();
+            any_win |= win;
+            all_win &= win;
+          }
+
+          const bool expected = side_to_move == Color::WHITE ? any_win : all_win;
+          ASSERT_EQ(is_win(board), expected) << board.get_fen();
+        }
+      }
+    }
+  }
+}
@@ -109,3 +109,82 @@ TEST(PositionTest, RepetitionCountRollsBackOnRevert) {
   EXPECT_EQ(pos.repetition_count(), 2);
   EXPECT_FALSE(pos.is_threefold_repetition());
 }
+
+/**
+ * @test A position seeded with earlier game hashes counts repetitions of positions played before it.
+ */
+TEST(PositionTest, SeededHistoryCountsEarlierRepetitions) {
+  Board game_board = Board::StartingPosition();
+  Position game(game_board);
+  apply_knight_repetition_cycle(game);
+  game.apply_move(Move::make(Squares::G1, Squares::F3));
+  game.apply_move(Move::make(Squares::G8, Squares::F6));
+  game.apply_move(Move::make(Squares::F3, Squares::G1));
+
+  Board board = game_board;
+  Position pos(board, game.get_zobrist_history());
+  EXPECT_EQ(pos.get_zobrist_history().size(), 8);
+  EXPECT_FALSE(pos.can_unmake());
+  EXPECT_EQ(pos.repetition_count(), 2);
+
+  pos.apply_move(Move::make(Squares::F6, Squares::G8));
+  EXPECT_EQ(pos.repetition_count(), 3);
+  EXPECT_TRUE(pos.is_threefold_repetition());
+}
+
+/**
+ * @test An empty seed history only tracks the current position.
+ */
+TEST(PositionTest, EmptySeededHistoryTracksCurrentPosition) {
+  Board board = Board::StartingPosition();
+  Position pos(board, {});
+  ASSERT_EQ(pos.get_zobrist_history().size(), 1);
+  EXPECT_EQ(pos.get_zobrist_history().back(), board.get_zobrist_hash());
+  EXPECT_EQ(pos.repetition_count(), 1);
+}
+
+/**
+ * @test A reversible move going back to a position reached inside the search is an upcoming repetition.
+ */
+TEST(PositionTest, DetectsUpcomingRepetitionInsideSearch) {
+  Board board = Board::StartingPosition();
+  Position pos(board);
+  EXPECT_FALSE(pos.has_upcoming_repetition(0));
+
+  pos.apply_move(Move::make(Squares::G1, Squares::F3));
+  pos.apply_move(Move::make(Squares::G8, Squares::F6));
+  pos.apply_move(Move::make(Squares::F3, Squares::G1));
+
+  // Nf6-g8 reaches the starting position again.
+  EXPECT_TRUE(pos.has_upcoming_repetition(4));
+
+  // Before the search root, the starting position only occurred once: no draw yet.
+  EXPECT_FALSE(pos.has_upcoming_repetition(0));
+}
+
+/**
+ * @test Cycles going back before the search root count when the reached position already repeated.
+ */
+TEST(PositionTest, DetectsUpcomingRepetitionOfRepeatedGamePosition) {
+  Board board = Board::StartingPosition();
+  Position pos(board);
+  apply_knight_repetition_cycle(pos);
+  pos.apply_move(Move::make(Squares::G1, Squares::F3));
+  pos.apply_move(Move::make(Squares::G8, Squares::F6));
+  pos.apply_move(Move::make(Squares::F3, Squares::G1));
+
+  EXPECT_TRUE(pos.has_upcoming_repetition(0));
+}
+
+/**
+ * @test No single move goes back to an earlier position when both sides changed their piece placement.
+ */
+TEST(PositionTest, NoUpcomingRepetitionWithoutCycle) {
+  Board board = Board::StartingPosition();
+  Position pos(board);
+  pos.apply_move(Move::make(Squares::G1, Squares::F3));
+  pos.apply_move(Move::make(Squares::G8, Squares::F6));
+  pos.apply_move(Move::make(Squares::B1, Squares::C3));
+
+  EXPECT_FALSE(pos.has_upcoming_repetition(10));
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/movegen/legal_moves.hpp>
+#include <bitbishop/moves/san.hpp>
+#include <vector>
+
+/**
+ * @test Pawn pushes, captures and piece moves are found among the legal moves.
+ */
+TEST(SanTest, ParsesPawnAndPieceMoves) {
+  const Board start = Board::StartingPosition();
+  ASSERT_TRUE(San::parse(start, "e4").has_value());
+  EXPECT_EQ(San::parse(start, "e4")->to_uci(), "e2e4");
+  EXPECT_EQ(San::parse(start, "Nf3")->to_uci(), "g1f3");
+  EXPECT_EQ(San::parse(start, "Nf3!?")->to_uci(), "g1f3");
+  EXPECT_FALSE(San::parse(start, "e5").has_value());
+  EXPECT_FALSE(San::parse(start, "Bc4").has_value());
+  EXPECT_FALSE(San::parse(start, "").has_value());
+  EXPECT_FALSE(San::parse(start, "xyz").has_value());
+
+  const Board board("rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 2");
+  const std::optional<Move> capture = San::parse(board, "exd5");
+  ASSERT_TRUE(capture.has_value());
+  EXPECT_EQ(capture->to_uci(), "e4d5");
+  EXPECT_TRUE(capture->is_capture);
+}
+
+/**
+ * @test Disambiguation by file, rank or both selects one move, and ambiguous moves are rejected.
+ */
+TEST(SanTest, ResolvesDisambiguation) {
+  const Board board("4k3/8/8/8/8/8/4K3/R6R w - - 0 1");
+  EXPECT_FALSE(San::parse(board, "Rd1").has_value());
+  EXPECT_EQ(San::parse(board, "Rad1")->to_uci(), "a1d1");
+  EXPECT_EQ(San::parse(board, "Rhf1")->to_uci(), "h1f1");
+
+  const Board knights("4k3/8/8/8/N7/8/N7/4K3 w - - 0 1");
+  EXPECT_FALSE(San::parse(knights, "Nc3").has_value());
+  EXPECT_EQ(San::parse(knights, "N4c3")->to_uci(), "a4c3");
+  EXPECT_EQ(San::parse(knights, "Na2c3")->to_uci(), "a2c3");
+}
+
+/**
+ * @test Castling and promotions in their usual spellings.
+ */
+TEST(SanTest, ParsesCastlingAndPromotions) {
+  const Board board("r3k2r/1P6/8/8/8/8/8/R3K2R w KQkq - 0 1");
+  EXPECT_EQ(San::parse(board, "O-O")->to_uci(), "e1g1");
+  EXPECT_TRUE(San::parse(board, "O-O")->is_castling);
+  EXPECT_EQ(San::parse(board, "0-0-0")->to_uci(), "e1c1");
+  EXPECT_EQ(San::parse(board, "O-O-O+")->to_uci(), "e1c1");
+
+  EXPECT_EQ(San::parse(board, "b8=Q")->to_uci(), "b7b8q");
+  EXPECT_EQ(San::parse(board, "b8N")->to_uci(), "b7b8n");
+  EXPECT_EQ(San::parse(board, "bxa8=R+")->to_uci(), "b7a8r");
+  EXPECT_FALSE(San::parse(board, "b8").has_value());
+}
+
+/**
+ * @test Moves are written with the shortest disambiguation, capture marks, promotions and check suffixes.
+ */
+TEST(SanTest, WritesMoves) {
+  const Board board("4k3/8/8/8/8/8/4K3/R6R w - - 0 1");
+  EXPECT_EQ(San::write(board, *San::parse(board, "Rad1")).view(), "Rad1");
+  EXPECT_EQ(San::write(board, *San::parse(board, "Ra8")).view(), "Ra8+");
+
+  const Board knights("4k3/8/8/8/N7/8/N7/4K3 w - - 0 1");
+  EXPECT_EQ(San::write(knights, *San::parse(knights, "N4c3")).view(), "N4c3");
+
+  const Board queens("4k3/8/8/8/8/Q1Q5/8/Q3K3 w - - 0 1");
+  EXPECT_EQ(San::write(queens, Move::make(Squares::A3, Squares::B2)).view(), "Qa3b2");
+
+  const Board promotion("r3k2r/1P6/8/8/8/8/8/R3K2R w KQkq - 0 1");
+  EXPECT_EQ(San::write(promotion, *San::parse(promotion, "bxa8=Q")).view(), "bxa8=Q+");
+  EXPECT_EQ(San::write(promotion, *San::parse(promotion, "O-O-O")).view(), "O-O-O");
+
+  const Board mate("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1");
+  EXPECT_EQ(San::write(mate, *San::parse(mate, "Ra8")).view(), "Ra8#");
+}
+
+/**
+ * @test Every legal move written in SAN parses back to itself.
+ */
+TEST(SanTest, WrittenMovesParseBack) {
+  for (const char* fen : {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+                          "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+                          "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+                          "n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1"}) {
+    const Board board(fen);
+    std::vector<Move> moves;
+    generate_legal_moves(moves, board);
+    for (const Move& move : moves) {
+      const San::Notation notation = San::write(board, move);
+      const std::optional<Move> parsed = San::parse(board, notation.view());
+      ASSERT_TRUE(parsed.has_value()) << fen << " " << notation.view();
+      EXPECT_EQ(parsed->to_uci(), move.to_uci()) << fen << " " << notation.view();
+    }
+  }
+}
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <bitbishop/board.hpp>
+#include <bitbishop/fen.hpp>
+#include <bitbishop/zobrist.hpp>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+using namespace Squares;
+using namespace Pieces;
+
+namespace {
+
+std::string format(const Board& board) {
+  std::array<char, Fen::MAX_LENGTH> buffer{};
+  return {buffer.data(), Fen::format_to(buffer.data(), board)};
+}
+
+}  // namespace
+
+TEST(FenTest, ParsesAllFields) {
+  Board board = Board::Empty();
+  ASSERT_EQ(Fen::parse("r3k2r/8/8/3pP3/8/8/8/R3K2R w Kq d6 7 42", board), Fen::Error::None);
+
+  EXPECT_EQ(board.get_piece(A8), BLACK_ROOK);
+  EXPECT_EQ(board.get_piece(E1), WHITE_KING);
+  EXPECT_EQ(board.get_piece(D5), BLACK_PAWN);
+  EXPECT_EQ(board.pieces_count(), 8);
+  EXPECT_EQ(board.get_side_to_move(), Color::WHITE);
+  EXPECT_TRUE(board.has_kingside_castling_rights(Color::WHITE));
+  EXPECT_FALSE(board.has_queenside_castling_rights(Color::WHITE));
+  EXPECT_FALSE(board.has_kingside_castling_rights(Color::BLACK));
+  EXPECT_TRUE(board.has_queenside_castling_rights(Color::BLACK));
+  EXPECT_EQ(board.en_passant_square(), D6);
+  EXPECT_EQ(board.get_state().m_halfmove_clock, 7);
+  EXPECT_EQ(board.get_state().m_fullmove_number, 42);
+}
+
+TEST(FenTest, ClocksAreOptional) {
+  Board board;
+  ASSERT_EQ(Fen::parse("4k3/8/8/8/8/8/8/4K3 b -  -  ", board), Fen::Error::None);
+
+  EXPECT_EQ(board.get_side_to_move(), Color::BLACK);
+  EXPECT_EQ(board.get_state().m_halfmove_clock, 0);
+  EXPECT_EQ(board.get_state().m_fullmove_number, 1);
+}
+
+TEST(FenTest, ParsingReplacesThePreviousPosition) {
+  Board board;
+  ASSERT_EQ(Fen::parse("4k3/8/8/8/8/8/8/4K3 w - - 0 1", board), Fen::Error::None);
+
+  const Board expected("4k3/8/8/8/8/8/8/4K3 w - - 0 1");
+  EXPECT_EQ(board, expected);
+  EXPECT_EQ(board.get_zobrist_hash(), expected.get_zobrist_hash());
+  EXPECT_EQ(board.get_pawn_hash(), expected.get_pawn_hash());
+  EXPECT_EQ(board.get_psqt_score(), expected.get_psqt_score());
+  EXPECT_EQ(board.get_phase(), expected.get_phase());
+  EXPECT_EQ(board.get_material_key(), expected.get_material_key());
+}
+
+TEST(FenTest, HashMatchesRecomputation) {
+  Board board = Board::Empty();
+  ASSERT_EQ(Fen::parse("r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4", board),
+            Fen::Error::None);
+
+  EXPECT_EQ(board.get_zobrist_hash(), Zobrist::compute_hash(board));
+  EXPECT_EQ(board.get_pawn_hash(), Zobrist::compute_pawn_hash(board));
+}
+
+struct FenErrorCase {
+  std::string name;
+  std::string fen;
+  Fen::Error error;
+};
+
+class FenErrorTest : public ::testing::TestWithParam<FenErrorCase> {};
+
+TEST_P(FenErrorTest, ReportsErrorAndLeavesBoardUnchanged) {
+  const FenErrorCase& param = GetParam();
+  Board board;
+  EXPECT_EQ(Fen::parse(param.fen, board), param.error);
+  EXPECT_EQ(board, Board::StartingPosition());
+  EXPECT_EQ(board.get_zobrist_hash(), Board::StartingPosition().get_zobrist_hash());
+  EXPECT_THROW(Board{param.fen}, std::invalid_argument);
+}
+
+// clang-format off
+INSTANTIATE_TEST_SUITE_P(
+    Errors,
+    FenErrorTest,
+    ::testing::Values(
+        FenErrorCase{"Empty",             "",                                      Fen::Error::Placement},
+        FenErrorCase{"SevenRanks",        "8/8/8/8/8/8/8 w - - 0 1",               Fen::Error::Placement},
+        FenErrorCase{"NineRanks",         "8/8/8/8/8/8/8/8/8 w - - 0 1",           Fen::Error::Placement},
+        FenErrorCase{"ShortRank",         "8/8/8/8/8/8/8/7 w - - 0 1",             Fen::Error::Placement},
+        FenErrorCase{"LongRank",          "8/8/8/8/8/8/8/4K4 w - - 0 1",           Fen::Error::Placement},
+        FenErrorCase{"UnknownPiece",      "8/8/8/8/8/8/8/3XK3 w - - 0 1",          Fen::Error::Placement},
+        FenErrorCase{"MissingSide",       "8/8/8/8/8/8/8/8",                       Fen::Error::SideToMove},
+        FenErrorCase{"InvalidSide",       "8/8/8/8/8/8/8/8 x - - 0 1",             Fen::Error::SideToMove},
+        FenErrorCase{"InvalidCastling",   "8/8/8/8/8/8/8/8 w KX - 0 1",            Fen::Error::Castling},
+        FenErrorCase{"RepeatedCastling",  "8/8/8/8/8/8/8/8 w KK - 0 1",            Fen::Error::Castling},
+        FenErrorCase{"MissingCastling",   "8/8/8/8/8/8/8/8 w",                     Fen::Error::Castling},
+        FenErrorCase{"EnPassantRank",     "8/8/8/8/8/8/8/8 w - e4 0 1",            Fen::Error::EnPassant},
+        FenErrorCase{"EnPassantFile",     "8/8/8/8/8/8/8/8 w - i3 0 1",            Fen::Error::EnPassant},
+        FenErrorCase{"NegativeHalfmove",  "8/8/8/8/8/8/8/8 w - - -1 1",            Fen::Error::HalfmoveClock},
+        FenErrorCase{"TextHalfmove",      "8/8/8/8/8/8/8/8 w - - 1x 1",            Fen::Error::HalfmoveClock},
+        FenErrorCase{"MissingFullmove",   "8/8/8/8/8/8/8/8 w - - 0",               Fen::Error::FullmoveNumber},
+        FenErrorCase{"HugeFullmove",      "8/8/8/8/8/8/8/8 w - - 0 99999999999",   Fen::Error::FullmoveNumber},
+        FenErrorCase{"TrailingText",      "8/8/8/8/8/8/8/8 w - - 0 1 bm e4",       Fen::Error::TrailingText}
+    ),
+    [](const ::testing::TestParamInfo<FenErrorCase>& info) { return info.param.name; }
+);
+// clang-format on
+
+TEST(FenTest, ErrorMessagesAreDistinct) {
+  EXPECT_EQ(Fen::error_message(Fen::Error::None), "no error");
+  EXPECT_NE(Fen::error_message(Fen::Error::Placement), Fen::error_message(Fen::Error::Castling));
+}
+
+TEST(FenTest, ParsesEpdOperations) {
+  Board board;
+  std::string_view operations;
+  ASSERT_EQ(Fen::parse_epd("4k3/8/8/8/8/8/4P3/4K3 w - - bm e4; id \"test 1\";\r\n", board, operations),
+            Fen::Error::None);
+
+  EXPECT_EQ(board.get_piece(E2), WHITE_PAWN);
+  EXPECT_EQ(board.get_state().m_halfmove_clock, 0);
+  EXPECT_EQ(board.get_state().m_fullmove_number, 1);
+  EXPECT_EQ(operations, "bm e4; id \"test 1\";");
+}
+
+TEST(FenTest, EpdErrorLeavesOperationsUnchanged) {
+  Board board;
+  std::string_view operations = "unchanged";
+  EXPECT_EQ(Fen::parse_epd("4k3/8/8/8/8/8/4P3/4K3 w - e5 bm e4;", board, operations), Fen::Error::EnPassant);
+  EXPECT_EQ(operations, "unchanged");
+  EXPECT_EQ(board, Board::StartingPosition());
+}
+
+TEST(FenTest, FormatRoundTrips) {
+  for (const std::string fen : {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+                                "r3k2r/8/8/3pP3/8/8/8/R3K2R w Kq d6 7 42", "8/8/8/8/8/8/8/8 b - - 0 1",
+                                "1n4k1/8/8/8/8/8/8/K6Q b - - 99 1000"}) {
+    EXPECT_EQ(format(Board(fen)), fen);
+  }
+}
+
+TEST(FenTest, NegativeClocksFitMaxLength) {
+  Board board;
+  BoardState state = board.get_state();
+  state.m_halfmove_clock = std::numeric_limits<int>::min();
+  state.m_fullmove_number = std::numeric_limits<int>::min();
+  state.m_en_passant_sq = E3;
+  board.set_state(state);
+
+  const std::string fen = format(board);
+  EXPECT_EQ(fen, "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq e3 -2147483648 -2147483648");
+  EXPECT_LE(fen.size(), Fen::MAX_LENGTH);
+}
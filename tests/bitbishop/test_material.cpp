@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/material.hpp>
+#include <bitbishop/piece.hpp>
+#include <stdexcept>
+
+using namespace Material;
+using namespace Pieces;
+
+TEST(MaterialTest, FromCodeCountsPiecesOfEachColor) {
+  const Key key = from_code("KRRPvKQ");
+
+  EXPECT_EQ(count(key, WHITE_KING), 1);
+  EXPECT_EQ(count(key, WHITE_ROOK), 2);
+  EXPECT_EQ(count(key, WHITE_PAWN), 1);
+  EXPECT_EQ(count(key, WHITE_QUEEN), 0);
+  EXPECT_EQ(count(key, BLACK_KING), 1);
+  EXPECT_EQ(count(key, BLACK_QUEEN), 1);
+  EXPECT_EQ(count(key, BLACK_ROOK), 0);
+}
+
+TEST(MaterialTest, KeyIsASumOfUnits) {
+  EXPECT_EQ(from_code("KNvK"), unit(WHITE_KING) + unit(WHITE_KNIGHT) + unit(BLACK_KING));
+  EXPECT_EQ(from_code("KNvK") - unit(WHITE_KNIGHT), from_code("KvK"));
+}
+
+TEST(MaterialTest, MirrorSwapsColors) {
+  EXPECT_EQ(mirror(from_code("KRvK")), from_code("KvKR"));
+  EXPECT_EQ(mirror(mirror(from_code("KQPPvKR"))), from_code("KQPPvKR"));
+}
+
+TEST(MaterialTest, FromCodeRejectsInvalidCodes) {
+  EXPECT_THROW(std::ignore = from_code("KRK"), std::invalid_argument);
+  EXPECT_THROW(std::ignore = from_code("KXvK"), std::invalid_argument);
+}
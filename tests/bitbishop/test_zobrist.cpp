@@ -281,3 +281,56 @@ TEST(ZobristTest, IncrementalHashMatchesFullRecompute) {
 
   EXPECT_EQ(incremental, recomputed);
 }
+
+TEST(ZobristTest, PawnHashOnlyDependsOnPawns) {
+  Board board = Board::StartingPosition();
+  EXPECT_EQ(board.get_pawn_hash(), compute_pawn_hash(board));
+
+  const Key start_pawn_hash = board.get_pawn_hash();
+  board.move_piece(Squares::G1, Squares::F3);
+  EXPECT_EQ(board.get_pawn_hash(), start_pawn_hash);
+
+  board.move_piece(Squares::E2, Squares::E4);
+  EXPECT_NE(board.get_pawn_hash(), start_pawn_hash);
+  EXPECT_EQ(board.get_pawn_hash(), compute_pawn_hash(board));
+
+  board.remove_piece(Squares::E4);
+  board.set_piece(Squares::E2, Pieces::WHITE_PAWN);
+  EXPECT_EQ(board.get_pawn_hash(), start_pawn_hash);
+}
+
+TEST(ZobristTest, PolyglotKeyFollowsPolyglotLayout) {
+  const auto& random64 = polyglot_tables.random64;
+
+  // Lone kings, black to move: the white king is kind 11, the black king kind 10
+  const Board kings("8/8/8/8/8/8/8/K6k b - - 0 1");
+  EXPECT_EQ(compute_polyglot_key(kings), random64[(11 * 64) + 0] ^ random64[(10 * 64) + 7]);
+
+  Board white_to_move("8/8/8/8/8/8/8/K6k w - - 0 1");
+  EXPECT_EQ(compute_polyglot_key(white_to_move), compute_polyglot_key(kings) ^ random64[PolyglotTables::TURN_OFFSET]);
+
+  const Board castling("r3k3/8/8/8/8/8/8/4K2R w Kq - 0 1");
+  const Board no_castling("r3k3/8/8/8/8/8/8/4K2R w - - 0 1");
+  EXPECT_EQ(compute_polyglot_key(castling), compute_polyglot_key(no_castling) ^
+                                                random64[PolyglotTables::CASTLING_OFFSET + 0] ^
+                                                random64[PolyglotTables::CASTLING_OFFSET + 3]);
+}
+
+TEST(ZobristTest, PolyglotKeyOnlyHashesCapturableEnPassant) {
+  // After 1. e4 no black pawn can capture on e3
+  const Board after_e4("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1");
+  const Board after_e4_no_ep("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1");
+  EXPECT_EQ(compute_polyglot_key(after_e4), compute_polyglot_key(after_e4_no_ep));
+
+  // A black pawn on d4 can
+  const Board capturable("rnbqkbnr/ppp1pppp/8/8/3pP3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1");
+  const Board capturable_no_ep("rnbqkbnr/ppp1pppp/8/8/3pP3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1");
+  EXPECT_EQ(compute_polyglot_key(capturable),
+            compute_polyglot_key(capturable_no_ep) ^ polyglot_tables.random64[PolyglotTables::EN_PASSANT_OFFSET + 4]);
+}
+
+TEST(ZobristTest, PolyglotTableIsSeparateFromEngineTables) {
+  const Board board = Board::StartingPosition();
+  EXPECT_NE(compute_polyglot_key(board), compute_hash(board));
+  EXPECT_NE(polyglot_tables.random64[0], tables.pieces[0][0]);
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/moves/san.hpp>
+#include <bitbishop/tools/book_builder.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace Tools;
+
+namespace {
+
+class BookBuilderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    directory = std::filesystem::temp_directory_path() / "bitbishop_test_book_builder";
+    std::filesystem::create_directories(directory);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(directory); }
+
+  std::string write_pgn(const std::string& name, const std::string& text) const {
+    const std::string path = (directory / name).string();
+    std::ofstream(path) << text;
+    return path;
+  }
+
+  std::filesystem::path directory;
+};
+
+std::uint16_t book_move(const Board& board, const std::string& san) {
+  return Book::encode_move(*San::parse(board, san));
+}
+
+}  // namespace
+
+/**
+ * @test Weights are 2 per win and 1 per draw of the moving side, across files and spilled runs.
+ */
+TEST_F(BookBuilderTest, CountsWinsAndDrawsOfTheMovingSide) {
+  const std::vector<std::string> inputs = {
+      write_pgn("a.pgn", "1. e4 e5 1-0\n1. e4 c5 0-1\n1. d4 d5 1/2-1/2\n"),
+      write_pgn("b.pgn", "1. e4 e5 1-0\n1. e4 e5 2. Nf3 1/2-1/2\n1. Nf3 Qxf3 1-0\n"),
+  };
+
+  BookBuilderOptions options;
+  options.threads = 2;
+  options.memory_bytes = 0;  // Spill runs as often as possible
+  options.temp_directory = directory.string();
+  const std::string book_path = (directory / "book.bin").string();
+  const BookBuilderStats stats = BookBuilder(options).build(inputs, book_path);
+
+  EXPECT_EQ(stats.games, 6);
+  EXPECT_EQ(stats.rejected_games, 1);  // Qxf3 is illegal
+  EXPECT_EQ(stats.moves, 12);
+  EXPECT_EQ(stats.runs, stats.moves);  // One count per run
+
+  Book::PolyglotBook book;
+  ASSERT_TRUE(book.open(book_path));
+  EXPECT_EQ(book.size(), stats.entries);
+
+  const Board start = Board::StartingPosition();
+  const std::vector<Book::Entry> start_entries = book.find(Zobrist::compute_polyglot_key(start));
+  ASSERT_EQ(start_entries.size(), 3);
+  // e4: 2 + 0 + 2 + 1, heaviest first; d4: 1; Nf3: 2
+  EXPECT_EQ(start_entries[0].move, book_move(start, "e4"));
+  EXPECT_EQ(start_entries[0].weight, 5);
+  EXPECT_EQ(start_entries[1].move, book_move(start, "Nf3"));
+  EXPECT_EQ(start_entries[1].weight, 2);
+  EXPECT_EQ(start_entries[2].move, book_move(start, "d4"));
+  EXPECT_EQ(start_entries[2].weight, 1);
+
+  // After 1. e4: e5 scored 0 + 0 + 1, c5 won once
+  const Board after_e4("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1");
+  const std::vector<Book::Entry> e4_entries = book.find(Zobrist::compute_polyglot_key(after_e4));
+  ASSERT_EQ(e4_entries.size(), 2);
+  EXPECT_EQ(e4_entries[0].move, book_move(after_e4, "c5"));
+  EXPECT_EQ(e4_entries[0].weight, 2);
+  EXPECT_EQ(e4_entries[1].move, book_move(after_e4, "e5"));
+  EXPECT_EQ(e4_entries[1].weight, 1);
+
+  // Entries are sorted by key, as binary search requires
+  for (std::size_t index = 1; index < book.size(); ++index) {
+    EXPECT_LE(book.entry(index - 1).key, book.entry(index).key);
+  }
+  EXPECT_TRUE(std::filesystem::exists(book_path));
+  EXPECT_EQ(std::distance(std::filesystem::directory_iterator(directory), {}), 3);  // Runs removed
+}
+
+/**
+ * @test Plies past the depth and moves below the game count are left out.
+ */
+TEST_F(BookBuilderTest, AppliesDepthAndFrequencyCutoffs) {
+  const std::vector<std::string> inputs = {
+      write_pgn("games.pgn", "1. e4 e5 2. Nf3 1-0\n1. e4 e5 2. Nf3 1-0\n1. d4 d5 1-0\n")};
+
+  BookBuilderOptions options;
+  options.threads = 1;
+  options.max_ply = 2;
+  options.min_games = 2;
+  options.temp_directory = directory.string();
+  const std::string book_path = (directory / "book.bin").string();
+  const BookBuilderStats stats = BookBuilder(options).build(inputs, book_path);
+
+  EXPECT_EQ(stats.games, 3);
+  EXPECT_EQ(stats.moves, 6);
+  EXPECT_EQ(stats.runs, 1);
+  EXPECT_EQ(stats.entries, 1);  // Only 1. e4: e5 never scored, Nf3 is past the depth, d4 was played once
+
+  EXPECT_THROW((void)BookBuilder(options).build({(directory / "missing.pgn").string()}, book_path),
+               std::runtime_error);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/tools/datagen.hpp>
+#include <bitbishop/tools/packed_position.hpp>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+using namespace Tools;
+
+namespace {
+
+class DataGenTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    directory = std::filesystem::temp_directory_path() / "bitbishop_test_datagen";
+    std::filesystem::create_directories(directory);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(directory); }
+
+  std::filesystem::path directory;
+};
+
+DataGenOptions quick_options() {
+  DataGenOptions options;
+  options.games = 4;
+  options.threads = 2;
+  options.soft_nodes = 1;  // A single depth 1 iteration per move
+  options.max_depth = 1;
+  options.max_plies = 40;
+  options.seed = 42;
+  return options;
+}
+
+}  // namespace
+
+/**
+ * @test Every game ends with a result, and the written positions are quiet and carry that result.
+ */
+TEST_F(DataGenTest, WritesQuietScoredPositions) {
+  const std::string path = (directory / "data.bin").string();
+  const DataGenStats stats = DataGenerator(quick_options()).generate(path);
+
+  EXPECT_EQ(stats.games, 4);
+  EXPECT_EQ(stats.white_wins + stats.black_wins + stats.draws, stats.games);
+  EXPECT_GT(stats.positions, 0);
+  EXPECT_GT(stats.nodes, 0);
+
+  PackedReader reader;
+  ASSERT_TRUE(reader.open(path));
+  ASSERT_EQ(reader.size(), stats.positions);
+  for (std::size_t index = 0; index < reader.size(); ++index) {
+    const std::optional<TrainingPosition> position = reader.position(index);
+    ASSERT_TRUE(position.has_value());
+    EXPECT_TRUE(position->score.has_value());
+    ASSERT_TRUE(position->best_move.has_value());
+    EXPECT_FALSE(position->best_move->is_capture);
+    EXPECT_FALSE(position->best_move->promotion.has_value());
+    EXPECT_NE(position->result, GameResult::Unknown);
+  }
+}
+
+TEST_F(DataGenTest, SameSeedPlaysSameGames) {
+  const std::string first = (directory / "first.bin").string();
+  const std::string second = (directory / "second.bin").string();
+  DataGenOptions options = quick_options();
+  options.threads = 1;
+  DataGenerator(options).generate(first);
+  DataGenerator(options).generate(second);
+
+  PackedReader first_reader;
+  PackedReader second_reader;
+  ASSERT_TRUE(first_reader.open(first));
+  ASSERT_TRUE(second_reader.open(second));
+  ASSERT_EQ(first_reader.size(), second_reader.size());
+  for (std::size_t index = 0; index < first_reader.size(); ++index) {
+    EXPECT_EQ(first_reader.record(index).bytes, second_reader.record(index).bytes);
+  }
+}
+
+TEST_F(DataGenTest, MissingBookThrows) {
+  DataGenOptions options = quick_options();
+  options.book_path = (directory / "missing.bin").string();
+  EXPECT_THROW(DataGenerator(options).generate((directory / "data.bin").string()), std::runtime_error);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/tools/epd_suite.hpp>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace Tools;
+
+namespace {
+
+// White mates in one with Ra8#
+const std::string MATE_IN_ONE = "6k1/5ppp/8/8/8/8/8/R5K1 w - - bm Ra8#; id \"mate in one\";";
+
+// Any move but Qe2 solves it
+const std::string AVOID_BLUNDER = "3rk3/8/8/8/8/8/8/3QK3 w - - am Qe2; id \"avoid\";";
+
+EpdSuiteOptions quick_options() {
+  EpdSuiteOptions options;
+  options.threads = 2;
+  options.nodes = 20'000;
+  options.max_depth = 4;
+  return options;
+}
+
+}  // namespace
+
+TEST(EpdSuiteTest, ParsesBestAndAvoidMoves) {
+  const std::optional<EpdTest> test =
+      parse_epd_test("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - bm O-O Kf1; am Kd1; id \"a;b\"; hmvc 3; fmvn 20;");
+  ASSERT_TRUE(test.has_value());
+  EXPECT_EQ(test->id, "a;b");
+  ASSERT_EQ(test->best_moves.size(), 2);
+  EXPECT_TRUE(test->best_moves[0].is_castling);
+  EXPECT_EQ(test->best_moves[1].to_uci(), "e1f1");
+  ASSERT_EQ(test->avoid_moves.size(), 1);
+  EXPECT_EQ(test->avoid_moves[0].to_uci(), "e1d1");
+  EXPECT_EQ(test->board.get_fen(), "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 3 20");
+}
+
+TEST(EpdSuiteTest, RejectsTestsWithoutSolution) {
+  EXPECT_FALSE(parse_epd_test("4k3/8/8/8/8/8/8/4K3 w - - id \"no move\";").has_value());
+  EXPECT_FALSE(parse_epd_test("4k3/8/8/8/8/8/8/4K3 w - - bm Qh5;").has_value());
+  EXPECT_FALSE(parse_epd_test("not an epd").has_value());
+}
+
+TEST(EpdSuiteTest, LoadsSuitesAndNamesTestsWithoutId) {
+  const std::filesystem::path path = std::filesystem::temp_directory_path() / "bitbishop_test_epd_suite.epd";
+  std::ofstream(path) << MATE_IN_ONE << "\n\n4k3/8/8/8/8/8/8/3QK3 w - - bm Qd7+;\ngarbage\n";
+
+  std::size_t invalid_lines = 0;
+  const std::vector<EpdTest> tests = load_epd_suite(path.string(), invalid_lines);
+  ASSERT_EQ(tests.size(), 2);
+  EXPECT_EQ(invalid_lines, 1);
+  EXPECT_EQ(tests[0].id, "mate in one");
+  EXPECT_EQ(tests[1].id, path.string() + ":3");
+  std::filesystem::remove(path);
+
+  EXPECT_THROW((void)load_epd_suite(path.string(), invalid_lines), std::runtime_error);
+}
+
+/**
+ * @test Tests are solved in parallel within the node budget, and results keep the suite order.
+ */
+TEST(EpdSuiteTest, SolvesTestsWithinBudget) {
+  const std::vector<EpdTest> tests = {*parse_epd_test(MATE_IN_ONE), *parse_epd_test(AVOID_BLUNDER),
+                                      *parse_epd_test(MATE_IN_ONE)};
+  const std::vector<EpdResult> results = run_epd_suite(tests, quick_options());
+
+  ASSERT_EQ(results.size(), 3);
+  for (const EpdResult& result : results) {
+    EXPECT_TRUE(result.solved) << result.id;
+    EXPECT_GT(result.depth, 0);
+    EXPECT_LE(result.solve_depth, result.depth);
+    EXPECT_LE(result.solve_nodes, result.nodes);
+    EXPECT_LT(result.nodes, 20'000 + 64);  // The limit stops the search within a few nodes
+  }
+  EXPECT_EQ(results[0].id, "mate in one");
+  EXPECT_EQ(results[0].move->to_uci(), "a1a8");
+  EXPECT_GE(results[0].solve_depth, 1);
+  EXPECT_EQ(results[1].id, "avoid");
+}
+
+TEST(EpdSuiteTest, WritesTextAndJsonReports) {
+  EpdResult solved{.id = "first", .solved = true, .depth = 3, .nodes = 900, .seconds = 0.5, .solve_depth = 2,
+                   .solve_nodes = 300, .solve_seconds = 0.25};
+  EpdResult unsolved{.id = "say \"hi\"", .depth = 5, .nodes = 1000, .seconds = 0.5};
+  const std::vector<EpdResult> results = {solved, unsolved};
+  EpdSuiteOptions options;
+  options.nodes = 1000;
+
+  std::ostringstream text;
+  write_epd_report(text, results, options);
+  EXPECT_NE(text.str().find("solved 1/2 (50.0%), budget 1000 nodes"), std::string::npos);
+  EXPECT_NE(text.str().find("1.00 solved per cpu second"), std::string::npos);
+  EXPECT_NE(text.str().find("nodes to solution: p25 300,"), std::string::npos);
+  EXPECT_NE(text.str().find("unsolved say \"hi\": played none at depth 5"), std::string::npos);
+
+  std::ostringstream json;
+  write_epd_json(json, results, options);
+  EXPECT_NE(json.str().find("\"budget\": {\"movetime_ms\": null, \"nodes\": 1000, \"max_depth\": 64}"),
+            std::string::npos);
+  EXPECT_NE(json.str().find("\"solved\": 1,"), std::string::npos);
+  EXPECT_NE(json.str().find("\"time_to_solution_ms\": {\"p25\": 250.000,"), std::string::npos);
+  EXPECT_NE(json.str().find("{\"id\": \"say \\\"hi\\\"\", \"solved\": false, \"move\": null"), std::string::npos);
+  EXPECT_NE(json.str().find("\"solve_nodes\": 300"), std::string::npos);
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/tools/engine_process.hpp>
+#include <bitbishop/tools/match.hpp>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+using namespace Tools;
+
+namespace {
+
+// White mates in one with Ra8#, whoever plays it
+const std::string MATE_IN_ONE = "6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1";
+
+/**
+ * Writes a shell script speaking just enough UCI, answering every `go` with `go_answer`.
+ */
+std::string write_fake_engine(const std::string& name, const std::string& go_answer) {
+  const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+  std::ofstream(path) << "#!/bin/sh\n"
+                         "while read -r line; do\n"
+                         "  case \"$line\" in\n"
+                         "    uci) echo \"id name fake\"; echo uciok ;;\n"
+                         "    isready) echo readyok ;;\n"
+                         "    go*) "
+                      << go_answer
+                      << " ;;\n"
+                         "    quit) exit 0 ;;\n"
+                         "  esac\n"
+                         "done\n";
+  std::filesystem::permissions(path, std::filesystem::perms::owner_all);
+  return path.string();
+}
+
+MatchOptions fake_match(const std::string& first, const std::string& second) {
+  MatchOptions options;
+  options.first.path = first;
+  options.second.path = second;
+  options.games = 2;
+  options.concurrency = 2;
+  options.openings = {MATE_IN_ONE};
+  return options;
+}
+
+bool has_shell() { return std::filesystem::exists("/bin/sh"); }
+
+}  // namespace
+
+TEST(MatchTest, EstimatesEloWithConfidenceMargin) {
+  const EloEstimate even = estimate_elo(MatchScore{.wins = 30, .draws = 40, .losses = 30});
+  EXPECT_DOUBLE_EQ(even.elo, 0.0);
+  EXPECT_NEAR(even.margin, 53.158, 1e-3);
+
+  EXPECT_NEAR(estimate_elo(MatchScore{.wins = 60, .losses = 40}).elo, 70.437, 1e-3);
+  EXPECT_TRUE(std::isfinite(estimate_elo(MatchScore{.wins = 10}).elo));
+  EXPECT_DOUBLE_EQ(estimate_elo(MatchScore{}).elo, 0.0);
+}
+
+TEST(MatchTest, ComputesSprtLogLikelihoodRatio) {
+  const SprtOptions sprt{.elo0 = 0.0, .elo1 = 5.0, .alpha = 0.05, .beta = 0.05};
+  EXPECT_NEAR(sprt_llr(MatchScore{.wins = 600, .losses = 400}, sprt), 2.891, 1e-3);
+  EXPECT_NEAR(sprt_llr(MatchScore{.wins = 30, .draws = 40, .losses = 30}, sprt), -0.01749, 1e-5);
+  EXPECT_LT(sprt_llr(MatchScore{.draws = 10}, sprt), 0.0);
+  EXPECT_GT(sprt_llr(MatchScore{.wins = 10}, sprt), 0.0);
+  EXPECT_DOUBLE_EQ(sprt_llr(MatchScore{}, sprt), 0.0);
+
+  EXPECT_EQ(sprt_decision(2.9, sprt), SprtDecision::Continue);
+  EXPECT_EQ(sprt_decision(2.95, sprt), SprtDecision::AcceptH1);
+  EXPECT_EQ(sprt_decision(-2.95, sprt), SprtDecision::AcceptH0);
+}
+
+TEST(MatchTest, LoadsFenAndEpdOpenings) {
+  const std::filesystem::path path = std::filesystem::temp_directory_path() / "bitbishop_test_match_openings.epd";
+  std::ofstream(path) << MATE_IN_ONE << "\n\n4k3/8/8/8/8/8/8/3QK3 b - - id \"epd\";\ngarbage\n";
+
+  std::size_t invalid_lines = 0;
+  const std::vector<std::string> openings = load_openings(path.string(), invalid_lines);
+  ASSERT_EQ(openings.size(), 2);
+  EXPECT_EQ(invalid_lines, 1);
+  EXPECT_EQ(openings[0], MATE_IN_ONE);
+  EXPECT_EQ(openings[1], "4k3/8/8/8/8/8/8/3QK3 b - - 0 1");
+  std::filesystem::remove(path);
+
+  EXPECT_THROW((void)load_openings(path.string(), invalid_lines), std::runtime_error);
+}
+
+TEST(EngineProcessTest, ExchangesLinesAndDetectsExit) {
+  if (!has_shell()) {
+    GTEST_SKIP() << "needs /bin/sh";
+  }
+  const auto deadline = [] { return std::chrono::steady_clock::now() + std::chrono::seconds(5); };
+
+  EngineProcess cat("/bin/cat");
+  cat.send("info depth 1\nbestmove e2e4 ponder e7e5");
+  EXPECT_EQ(cat.wait_for("bestmove", deadline()), "bestmove e2e4 ponder e7e5");
+  EXPECT_FALSE(cat.read_line(std::chrono::steady_clock::now()).has_value());
+
+  EngineProcess exited("/bin/true");
+  EXPECT_THROW((void)exited.read_line(deadline()), std::runtime_error);
+  EXPECT_THROW(EngineProcess("/nonexistent/engine"), std::runtime_error);
+}
+
+/**
+ * @test Both games of an opening pair are won by the side to move, so each engine wins once.
+ */
+TEST(MatchTest, PlaysOpeningPairsWithColoursSwapped) {
+  if (!has_shell()) {
+    GTEST_SKIP() << "needs /bin/sh";
+  }
+  const std::string engine = write_fake_engine("bitbishop_test_match_mate.sh", "echo \"bestmove a1a8\"");
+
+  std::vector<GameRecord> records;
+  const auto on_game = [&records](const GameRecord& record, const MatchScore&) { records.push_back(record); };
+  const MatchResult result = run_match(fake_match(engine, engine), on_game);
+  EXPECT_EQ(result.score.wins, 1);
+  EXPECT_EQ(result.score.losses, 1);
+  EXPECT_EQ(result.time_forfeits, 0);
+  ASSERT_EQ(records.size(), 2);
+  for (const GameRecord& record : records) {
+    EXPECT_EQ(record.result, GameResult::WhiteWin);
+    EXPECT_EQ(record.end, GameEnd::Checkmate);
+    EXPECT_EQ(record.plies, 1);
+  }
+  std::filesystem::remove(engine);
+}
+
+TEST(MatchTest, ScoresIllegalMovesAndTimeForfeitsAsLosses) {
+  if (!has_shell()) {
+    GTEST_SKIP() << "needs /bin/sh";
+  }
+  const std::string mating = write_fake_engine("bitbishop_test_match_mating.sh", "echo \"bestmove a1a8\"");
+  const std::string illegal = write_fake_engine("bitbishop_test_match_illegal.sh", "echo \"bestmove a1a1\"");
+  const std::string silent = write_fake_engine("bitbishop_test_match_silent.sh", ":");
+
+  MatchOptions options = fake_match(mating, illegal);
+  const MatchResult illegal_result = run_match(options, [](const GameRecord& record, const MatchScore&) {
+    EXPECT_EQ(record.end, record.first_is_white ? GameEnd::Checkmate : GameEnd::IllegalMove);
+  });
+  EXPECT_EQ(illegal_result.score.wins, 2);
+
+  options = fake_match(mating, silent);
+  options.time_control = TimeControl{.base_ms = 50, .increment_ms = 0, .margin_ms = 10};
+  const MatchResult silent_result = run_match(options);
+  EXPECT_EQ(silent_result.score.wins, 2);
+  EXPECT_EQ(silent_result.time_forfeits, 1);
+
+  for (const std::string& engine : {mating, illegal, silent}) {
+    std::filesystem::remove(engine);
+  }
+}
+
+TEST(MatchTest, StopsOnceSprtDecides) {
+  if (!has_shell()) {
+    GTEST_SKIP() << "needs /bin/sh";
+  }
+  const std::string mating = write_fake_engine("bitbishop_test_match_sprt_mating.sh", "echo \"bestmove a1a8\"");
+  const std::string silent = write_fake_engine("bitbishop_test_match_sprt_silent.sh", ":");
+
+  // A first engine winning every game passes a wide test in a few games
+  MatchOptions options = fake_match(mating, silent);
+  options.games = 1000;
+  options.concurrency = 1;
+  options.time_control = TimeControl{.base_ms = 20, .increment_ms = 0, .margin_ms = 5};
+  options.sprt = SprtOptions{.elo0 = -200.0, .elo1 = 200.0, .alpha = 0.05, .beta = 0.05};
+  const MatchResult result = run_match(options);
+  EXPECT_EQ(result.decision, SprtDecision::AcceptH1);
+  EXPECT_LT(result.score.games(), 1000);
+  EXPECT_EQ(result.score.losses, 0);
+
+  std::filesystem::remove(mating);
+  std::filesystem::remove(silent);
+}
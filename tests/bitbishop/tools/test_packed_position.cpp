@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/moves/san.hpp>
+#include <bitbishop/tools/packed_position.hpp>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+using namespace Tools;
+
+namespace {
+
+TrainingPosition make_position(const std::string& fen, std::optional<std::int16_t> score, GameResult result,
+                               const std::string& san = "") {
+  TrainingPosition position{.board = Board(fen), .score = score, .result = result};
+  if (!san.empty()) {
+    position.best_move = San::parse(position.board, san);
+  }
+  return position;
+}
+
+void expect_same(const TrainingPosition& actual, const TrainingPosition& expected) {
+  EXPECT_EQ(actual.board.get_fen(), expected.board.get_fen());
+  EXPECT_EQ(actual.board.get_zobrist_hash(), expected.board.get_zobrist_hash());
+  EXPECT_EQ(actual.score, expected.score);
+  EXPECT_EQ(actual.result, expected.result);
+  ASSERT_EQ(actual.best_move.has_value(), expected.best_move.has_value());
+  if (expected.best_move) {
+    EXPECT_EQ(actual.best_move->to_uci(), expected.best_move->to_uci());
+    EXPECT_EQ(actual.best_move->is_capture, expected.best_move->is_capture);
+    EXPECT_EQ(actual.best_move->is_en_passant, expected.best_move->is_en_passant);
+    EXPECT_EQ(actual.best_move->is_castling, expected.best_move->is_castling);
+  }
+}
+
+class PackedFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    directory = std::filesystem::temp_directory_path() / "bitbishop_test_packed_position";
+    std::filesystem::create_directories(directory);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(directory); }
+
+  std::filesystem::path directory;
+};
+
+}  // namespace
+
+/**
+ * @test Every field survives packing: pieces, side, castling, en passant, clocks, score, result and move flags.
+ */
+TEST(PackedPositionTest, RoundTripsPositions) {
+  const std::vector<TrainingPosition> positions = {
+      make_position("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 25, GameResult::Draw, "e4"),
+      make_position("r3k2r/8/8/8/8/8/8/R3K2R b Kq - 12 40", -310, GameResult::BlackWin, "O-O-O"),
+      make_position("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 2", std::nullopt, GameResult::WhiteWin, "exd6"),
+      make_position("1r2k3/P7/8/8/8/8/8/4K3 w - - 3 60", 900, GameResult::Unknown, "axb8=N"),
+      make_position("4k3/8/8/8/8/8/8/4K3 b - - 0 1", std::nullopt, GameResult::Unknown),
+  };
+  for (const TrainingPosition& position : positions) {
+    const std::optional<PackedPosition> packed = PackedPosition::pack(position);
+    ASSERT_TRUE(packed.has_value());
+    const std::optional<TrainingPosition> unpacked = packed->unpack();
+    ASSERT_TRUE(unpacked.has_value());
+    expect_same(*unpacked, position);
+  }
+}
+
+TEST(PackedPositionTest, ClampsClocks) {
+  const TrainingPosition position =
+      make_position("4k3/8/8/8/8/8/8/4K3 w - - 200 70000", std::nullopt, GameResult::Unknown);
+  const BoardState state = PackedPosition::pack(position)->unpack()->board.get_state();
+  EXPECT_EQ(state.m_halfmove_clock, 127);
+  EXPECT_EQ(state.m_fullmove_number, 65535);
+}
+
+TEST(PackedPositionTest, RejectsMoreThan32Pieces) {
+  TrainingPosition position = make_position("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 0,
+                                            GameResult::Unknown);
+  position.board.set_piece(Squares::E4, Pieces::WHITE_QUEEN);
+  EXPECT_FALSE(PackedPosition::pack(position).has_value());
+}
+
+TEST(PackedPositionTest, RejectsCorruptedRecords) {
+  PackedPosition packed =
+      *PackedPosition::pack(make_position("4k3/8/8/8/8/8/8/4K3 w - - 0 1", 0, GameResult::Unknown));
+  packed.bytes[8] = std::byte{0x77};  // Piece type 7
+  EXPECT_FALSE(packed.unpack().has_value());
+}
+
+TEST(PackedPositionTest, ParsesAndFormatsTrainingLines) {
+  TrainingPosition position;
+  ASSERT_TRUE(parse_training_line(
+      "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - id \"a;b\"; hmvc 4; fmvn 12; ce -35; bm O-O Kf1; c9 \"0-1\";\r", position));
+
+  EXPECT_EQ(position.board.get_fen(), "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 4 12");
+  EXPECT_EQ(position.score, -35);
+  EXPECT_EQ(position.result, GameResult::BlackWin);
+  ASSERT_TRUE(position.best_move.has_value());
+  EXPECT_TRUE(position.best_move->is_castling);
+
+  const std::string line = format_training_line(position);
+  EXPECT_EQ(line, "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - hmvc 4; fmvn 12; ce -35; bm O-O; c9 \"0-1\";");
+
+  TrainingPosition reparsed;
+  ASSERT_TRUE(parse_training_line(line, reparsed));
+  expect_same(reparsed, position);
+}
+
+TEST(PackedPositionTest, ParsesPlainFens) {
+  TrainingPosition position;
+  ASSERT_TRUE(parse_training_line("4k3/8/8/8/8/8/8/4K3 b - - 7 30", position));
+  EXPECT_EQ(position.board.get_fen(), "4k3/8/8/8/8/8/8/4K3 b - - 7 30");
+  EXPECT_FALSE(position.score.has_value());
+  EXPECT_FALSE(position.best_move.has_value());
+  EXPECT_EQ(position.result, GameResult::Unknown);
+}
+
+TEST(PackedPositionTest, RejectsInvalidLines) {
+  TrainingPosition position;
+  EXPECT_FALSE(parse_training_line("not a fen", position));
+  EXPECT_FALSE(parse_training_line("4k3/8/8/8/8/8/8/4K3 w - - bm Qh5;", position));
+  EXPECT_FALSE(parse_training_line("4k3/8/8/8/8/8/8/4K3 w - - ce high;", position));
+  EXPECT_EQ(position.board, Board::StartingPosition());
+}
+
+/**
+ * @test Written positions are read back in order, duplicates and unpackable positions are skipped.
+ */
+TEST_F(PackedFileTest, WritesAndReadsRecords) {
+  const std::string path = (directory / "positions.bin").string();
+  const TrainingPosition first = make_position("4k3/8/8/8/8/8/8/4K3 w - - 0 1", 10, GameResult::Draw);
+  const TrainingPosition second = make_position("4k3/8/8/8/8/8/8/4K3 b - - 0 1", -10, GameResult::Draw);
+  TrainingPosition crowded = make_position("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 0,
+                                           GameResult::Unknown);
+  crowded.board.set_piece(Squares::E4, Pieces::WHITE_QUEEN);
+
+  {
+    PackedWriter writer(path, true, 1);
+    EXPECT_TRUE(writer.write(first));
+    EXPECT_FALSE(writer.write(first));
+    EXPECT_TRUE(writer.write(second));
+    EXPECT_FALSE(writer.write(crowded));
+    writer.close();
+    EXPECT_EQ(writer.written(), 2);
+    EXPECT_EQ(writer.duplicates(), 1);
+    EXPECT_EQ(writer.rejected(), 1);
+  }
+  EXPECT_EQ(std::filesystem::file_size(path), 2 * PackedPosition::SIZE);
+
+  PackedReader reader;
+  ASSERT_TRUE(reader.open(path));
+  ASSERT_EQ(reader.size(), 2);
+  expect_same(*reader.position(0), first);
+  expect_same(*reader.position(1), second);
+}
+
+TEST_F(PackedFileTest, DestructorFlushesBuffer) {
+  const std::string path = (directory / "positions.bin").string();
+  {
+    PackedWriter writer(path);
+    writer.write(make_position("4k3/8/8/8/8/8/8/4K3 w - - 0 1", 0, GameResult::Unknown));
+    writer.write(make_position("4k3/8/8/8/8/8/8/4K3 w - - 0 1", 0, GameResult::Unknown));
+  }
+  EXPECT_EQ(std::filesystem::file_size(path), 2 * PackedPosition::SIZE);
+}
+
+TEST_F(PackedFileTest, OpensEmptyFiles) {
+  const std::string path = (directory / "empty.bin").string();
+  std::ofstream{path};
+  PackedReader reader;
+  ASSERT_TRUE(reader.open(path));
+  EXPECT_EQ(reader.size(), 0);
+}
+
+TEST_F(PackedFileTest, RejectsPartialRecordsAndMissingFiles) {
+  const std::string path = (directory / "partial.bin").string();
+  std::ofstream(path) << "truncated";
+  PackedReader reader;
+  EXPECT_FALSE(reader.open(path));
+  EXPECT_FALSE(reader.open((directory / "missing.bin").string()));
+  EXPECT_FALSE(reader.is_open());
+  EXPECT_THROW(PackedWriter((directory / "missing" / "out.bin").string()), std::runtime_error);
+}
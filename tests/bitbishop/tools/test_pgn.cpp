@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <bitbishop/tools/pgn.hpp>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Tools;
+
+namespace {
+
+std::vector<std::string> strings_of(const std::vector<std::string_view>& views) {
+  return {views.begin(), views.end()};
+}
+
+}  // namespace
+
+/**
+ * @test Tags, move numbers, comments, variations and NAGs are handled, games end with their result.
+ */
+TEST(PgnTokenizerTest, ReadsMainLines) {
+  const std::string text =
+      "[Event \"Test\"]\n"
+      "[Result \"1-0\"]\n"
+      "\n"
+      "1. e4 {best by test} e5 2.Nf3 (2. f4 exf4) Nc6 $1 3... ; comment\n"
+      "3. Bb5 {a comment\n"
+      "over two lines} a6 1-0\n"
+      "\n"
+      "[FEN \"4k3/8/8/8/8/8/8/4K2R w K - 0 1\"]\n"
+      "[Result \"1/2-1/2\"]\n"
+      "\n"
+      "1. O-O Kd7 1/2-1/2\n"
+      "%escaped line 1. e4\n"
+      "1. d4 d5 *\n";
+  PgnTokenizer tokenizer(text);
+  PgnGame game;
+
+  ASSERT_TRUE(tokenizer.next(game));
+  EXPECT_TRUE(game.fen.empty());
+  EXPECT_EQ(strings_of(game.moves), (std::vector<std::string>{"e4", "e5", "Nf3", "Nc6", "Bb5", "a6"}));
+  EXPECT_EQ(game.result, GameResult::WhiteWin);
+
+  ASSERT_TRUE(tokenizer.next(game));
+  EXPECT_EQ(game.fen, "4k3/8/8/8/8/8/8/4K2R w K - 0 1");
+  EXPECT_EQ(strings_of(game.moves), (std::vector<std::string>{"O-O", "Kd7"}));
+  EXPECT_EQ(game.result, GameResult::Draw);
+
+  ASSERT_TRUE(tokenizer.next(game));
+  EXPECT_EQ(strings_of(game.moves), (std::vector<std::string>{"d4", "d5"}));
+  EXPECT_EQ(game.result, GameResult::Unknown);
+
+  EXPECT_FALSE(tokenizer.next(game));
+}
+
+/**
+ * @test Games without a result token end where the next tags start, the Result tag giving the outcome.
+ */
+TEST(PgnTokenizerTest, SplitsGamesWithoutResultToken) {
+  const std::string text =
+      "[Result \"0-1\"]\r\n"
+      "1. f3 e5 2. g4 Qh4#\r\n"
+      "[Result \"1-0\"]\r\n"
+      "1. e4\r\n";
+  PgnTokenizer tokenizer(text);
+  PgnGame game;
+
+  ASSERT_TRUE(tokenizer.next(game));
+  EXPECT_EQ(strings_of(game.moves), (std::vector<std::string>{"f3", "e5", "g4", "Qh4#"}));
+  EXPECT_EQ(game.result, GameResult::BlackWin);
+
+  ASSERT_TRUE(tokenizer.next(game));
+  EXPECT_EQ(strings_of(game.moves), (std::vector<std::string>{"e4"}));
+  EXPECT_EQ(game.result, GameResult::WhiteWin);
+  EXPECT_FALSE(tokenizer.next(game));
+}
+
+/**
+ * @test Chunks cover the whole text and only start at a game, after a blank line.
+ */
+TEST(PgnSplitTest, ChunksStartAtGames) {
+  std::string text;
+  for (int index = 0; index < 50; ++index) {
+    text += "[Event \"" + std::to_string(index) + "\"]\n[Result \"1-0\"]\n\n1. e4 e5 1-0\n\n";
+  }
+
+  const std::vector<std::string_view> chunks = split_games(text, 8);
+  EXPECT_GE(chunks.size(), 7);
+  EXPECT_LE(chunks.size(), 9);
+  std::size_t size = 0;
+  for (const std::string_view chunk : chunks) {
+    EXPECT_TRUE(chunk.starts_with("[Event ")) << chunk.substr(0, 20);
+    size += chunk.size();
+  }
+  EXPECT_EQ(size, text.size());
+
+  EXPECT_EQ(split_games(text, 1).size(), 1);
+  EXPECT_TRUE(split_games("", 4).empty());
+}
+
+/**
+ * @test Every game of every chunk is visited once, and exceptions of visits reach the caller.
+ */
+TEST(PgnSplitTest, ForEachGameVisitsAllGames) {
+  const std::filesystem::path path = std::filesystem::temp_directory_path() / "bitbishop_test_games.pgn";
+  {
+    std::ofstream out(path);
+    for (int index = 0; index < 500; ++index) {
+      out << "[Result \"1/2-1/2\"]\n\n1. d4 d5 2. c4 1/2-1/2\n\n";
+    }
+  }
+  PgnFile file;
+  ASSERT_TRUE(file.open(path.string()));
+
+  std::atomic<std::size_t> games{0};
+  std::atomic<std::size_t> moves{0};
+  for_each_game(split_games(file.text(), 16), 4, [&](unsigned thread, const PgnGame& game) {
+    EXPECT_LT(thread, 4);
+    ++games;
+    moves += game.moves.size();
+  });
+  EXPECT_EQ(games, 500);
+  EXPECT_EQ(moves, 1500);
+
+  EXPECT_THROW(for_each_game(split_games(file.text(), 4), 2,
+                             [](unsigned, const PgnGame&) { throw std::runtime_error("visit failed"); }),
+               std::runtime_error);
+
+  PgnFile missing;
+  EXPECT_FALSE(missing.open("/nonexistent/games.pgn"));
+  std::filesystem::remove(path);
+}
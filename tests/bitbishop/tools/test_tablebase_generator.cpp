@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/board.hpp>
+#include <bitbishop/engine/tablebase.hpp>
+#include <bitbishop/lookups/kpk_bitbase.hpp>
+#include <bitbishop/tools/tablebase_generator.hpp>
+#include <optional>
+
+using namespace Tablebase;
+using Tools::TablebaseGenerator;
+
+namespace {
+
+class TablebaseGeneratorTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    generator.emplace(2);
+    generator->generate("KPvK");  // Also generates KQvK and KRvK for promotions
+  }
+
+  static void TearDownTestSuite() { generator.reset(); }
+
+  static const Tools::TablebaseStats& stats_of(const std::string& code) {
+    for (const Tools::TablebaseStats& stats : generator->stats()) {
+      if (stats.code == code) {
+        return stats;
+      }
+    }
+    throw std::out_of_range(code);
+  }
+
+  static inline std::optional<TablebaseGenerator> generator;
+};
+
+}  // namespace
+
+/**
+ * @test Promotions need the KQK and KRK tablebases first, minor pieces cannot mate.
+ */
+TEST_F(TablebaseGeneratorTest, GeneratesPromotionTablebasesFirst) {
+  ASSERT_EQ(generator->stats().size(), 3);
+  EXPECT_EQ(generator->stats().back().code, "KPvK");
+  EXPECT_NO_THROW(std::ignore = stats_of("KQvK"));
+  EXPECT_NO_THROW(std::ignore = stats_of("KRvK"));
+}
+
+/**
+ * @test Longest mates are the known ones: 10 moves for KQK, 16 for KRK (plus the ply of the mated side).
+ */
+TEST_F(TablebaseGeneratorTest, FindsTheLongestKnownMates) {
+  EXPECT_EQ(stats_of("KQvK").longest_mate, 20);
+  EXPECT_EQ(stats_of("KRvK").longest_mate, 32);
+  EXPECT_EQ(stats_of("KQvK").draws + stats_of("KQvK").wins + stats_of("KQvK").losses + stats_of("KQvK").illegal,
+            stats_of("KQvK").positions);
+}
+
+/**
+ * @test Mates and mates in one.
+ */
+TEST_F(TablebaseGeneratorTest, ScoresMatesInPlies) {
+  EXPECT_EQ(generator->lookup(Board("k7/1Q6/1K6/8/8/8/8/8 b - - 0 1")), dtm_code(0));
+  EXPECT_EQ(generator->lookup(Board("k7/8/1K6/8/8/8/8/6Q1 w - - 0 1")), dtm_code(1));
+  EXPECT_EQ(generator->lookup(Board("8/8/8/8/8/1k6/8/K6q w - - 0 1")), dtm_code(0));  // Colors swapped
+  EXPECT_EQ(generator->lookup(Board("k7/2Q5/1K6/8/8/8/8/8 b - - 0 1")), DTM_DRAW);   // Stalemate
+}
+
+/**
+ * @test The KPK tablebase agrees with the KPK bitbase on every legal position.
+ */
+TEST_F(TablebaseGeneratorTest, KpkMatchesTheBitbase) {
+  const Layout layout("KPvK");
+  std::array<int, MAX_PIECES> squares{};
+  Color side_to_move = Color::WHITE;
+  std::size_t compared = 0;
+
+  for (std::size_t index = 0; index < layout.size(); ++index) {
+    if (!layout.decode(index, squares, side_to_move)) {
+      continue;
+    }
+    Board board = Board::Empty();
+    for (std::size_t slot = 0; slot < layout.pieces().size(); ++slot) {
+      board.set_piece(Square(squares[slot], std::in_place), layout.pieces()[slot]);
+    }
+    board.set_side_to_move(side_to_move);
+
+    const std::uint8_t code = *generator->lookup(board);
+    if (code == DTM_ILLEGAL) {
+      continue;
+    }
+    const bool white_wins = wdl_of(code) == (side_to_move == Color::WHITE ? Wdl::Win : Wdl::Loss);
+    ASSERT_EQ(white_wins, Lookups::kpk_is_win(Color::WHITE, Square(squares[0], std::in_place),
+                                              Square(squares[2], std::in_place), Square(squares[1], std::in_place),
+                                              side_to_move))
+        << board.get_fen();
+    ++compared;
+  }
+  EXPECT_GT(compared, 100'000);
+}
+
+/**
+ * @test Signatures are generated once, whatever their color orientation.
+ */
+TEST(TablebaseGeneratorStandaloneTest, ReusesMirroredSignatures) {
+  TablebaseGenerator generator(1);
+  generator.generate("KQvK");
+  generator.generate("KvKQ");
+
+  ASSERT_EQ(generator.stats().size(), 1);
+  EXPECT_EQ(generator.lookup(Board("8/8/8/8/8/1k6/8/K6q w - - 0 1")),
+            generator.lookup(Board("k6Q/8/1K6/8/8/8/8/8 b - - 0 1")));
+  EXPECT_THROW(generator.generate("KQRBNvK"), std::invalid_argument);
+  EXPECT_THROW(generator.generate("KQvQ"), std::invalid_argument);
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <bitbishop/tools/tuner.hpp>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace Tools;
+
+namespace {
+
+TrainingPosition make_position(const std::string& fen, GameResult result) {
+  return TrainingPosition{.board = Board(fen), .result = result};
+}
+
+/**
+ * Positions where the side a rook up wins, and level positions drawn.
+ */
+TuningSet make_set() {
+  TuningSet set;
+  for (int copy = 0; copy < 8; ++copy) {
+    set.add(make_position("r3k3/pppp4/8/8/8/8/PPPP4/R3K2R w - - 0 1", GameResult::WhiteWin));
+    set.add(make_position("r3k2r/pppp4/8/8/8/8/PPPP4/R3K3 b - - 0 1", GameResult::BlackWin));
+    set.add(make_position("r3k3/pppp4/8/8/8/8/PPPP4/R3K3 w - - 0 1", GameResult::Draw));
+    set.add(make_position("4k3/1ppp4/8/8/8/8/PPP5/1N2K3 w - - 0 1", GameResult::WhiteWin));
+  }
+  return set;
+}
+
+TunerOptions quick_options(unsigned threads) {
+  TunerOptions options;
+  options.threads = threads;
+  options.batch_size = 8;
+  options.learning_rate = 5.0;
+  return options;
+}
+
+}  // namespace
+
+TEST(TuningSetTest, SkipsPoorTargets) {
+  TuningSet set;
+  EXPECT_TRUE(set.add(make_position("r3k3/pppp4/8/8/8/8/PPPP4/R3K2R w - - 0 1", GameResult::Draw)));
+  EXPECT_FALSE(set.add(make_position("r3k3/pppp4/8/8/8/8/PPPP4/R3K2R w - - 0 1", GameResult::Unknown)));
+  EXPECT_FALSE(set.add(make_position("4k3/8/8/8/8/8/8/R3K3 b - - 0 1", GameResult::WhiteWin)));  // KRK
+  EXPECT_FALSE(set.add(make_position("4k3/pppp4/8/8/8/8/PPPP4/4R1K1 b - - 0 1", GameResult::WhiteWin)));  // Check
+
+  ASSERT_EQ(set.size(), 1);
+  EXPECT_EQ(set.skipped(), 3);
+  EXPECT_EQ(set.phase(0), 6);
+  EXPECT_DOUBLE_EQ(set.result(0), 0.5);
+  EXPECT_FALSE(set.coefficients(0).empty());
+}
+
+TEST(TuningSetTest, LoadsPackedAndTextFiles) {
+  const std::filesystem::path directory = std::filesystem::temp_directory_path() / "bitbishop_test_tuner";
+  std::filesystem::create_directories(directory);
+  const std::string packed = (directory / "positions.bin").string();
+  const std::string text = (directory / "positions.epd").string();
+  {
+    PackedWriter writer(packed);
+    writer.write(make_position("r3k3/pppp4/8/8/8/8/PPPP4/R3K2R w - - 0 1", GameResult::WhiteWin));
+    writer.write(make_position("r3k3/pppp4/8/8/8/8/PPPP4/R3K2R w - - 0 1", GameResult::Unknown));
+  }
+  std::ofstream(text) << "r3k3/pppp4/8/8/8/8/PPPP4/R3K2R w - - c9 \"1/2-1/2\";\nnot a fen\n\n";
+
+  TuningSet set;
+  set.load(packed);
+  set.load(text);
+  EXPECT_EQ(set.size(), 2);
+  EXPECT_EQ(set.skipped(), 2);
+  EXPECT_DOUBLE_EQ(set.result(1), 0.5);
+  EXPECT_THROW(set.load((directory / "missing.epd").string()), std::runtime_error);
+  std::filesystem::remove_all(directory);
+}
+
+/**
+ * @test Epochs lower the error, and splitting batches across threads does not change the steps.
+ */
+TEST(TunerTest, EpochsLowerTheError) {
+  const TuningSet set = make_set();
+  Tuner single(set, quick_options(1));
+  Tuner parallel(set, quick_options(3));
+  EXPECT_GT(single.k(), 0.0);
+  EXPECT_NEAR(single.k(), parallel.k(), 1e-6);
+
+  const double initial = single.error();
+  for (int epoch = 0; epoch < 20; ++epoch) {
+    single.epoch();
+    parallel.epoch();
+  }
+  EXPECT_LT(single.error(), initial);
+  EXPECT_NEAR(single.error(), parallel.error(), 1e-6);
+}
+
+TEST(TunerTest, StartsFromCurrentWeights) {
+  const TuningSet set = make_set();
+  TunerOptions options = quick_options(1);
+  options.k = 1.0;
+  const Tuner tuner(set, options);
+  EXPECT_DOUBLE_EQ(tuner.k(), 1.0);
+  EXPECT_EQ(tuner.weights(), Eval::current_term_weights());
+}
+
+TEST(TunerTest, WritesTunedTables) {
+  std::ostringstream out;
+  write_tuned_header(out, Eval::current_term_weights(), "Generated for a test");
+  const std::string header = out.str();
+
+  EXPECT_EQ(header.find("#pragma once\n\n// Generated for a test\n"), 0);
+  EXPECT_NE(header.find("MIDGAME_MATERIAL = {100, 320, 330, 500, 900};"), std::string::npos);
+  EXPECT_NE(header.find("ENDGAME_MATERIAL = {120, 300, 320, 530, 940};"), std::string::npos);
+  EXPECT_NE(header.find("CX_INLINE PieceSquareTable KING_ENDGAME_PSQT_WHITE = {"), std::string::npos);
+  EXPECT_NE(header.find("  50,  50,  50,  50,  50,  50,  50,  50,"), std::string::npos);
+  EXPECT_NE(header.find("DOUBLED_PAWN_PENALTY = make_score(-10, -20);"), std::string::npos);
+  EXPECT_NE(header.find("    make_score(70, 110),\n"), std::string::npos);
+}